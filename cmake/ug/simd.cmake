@@ -0,0 +1,60 @@
+# Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+# 
+# This file is part of UG4.
+# 
+# UG4 is free software: you can redistribute it and/or modify it under the
+# terms of the GNU Lesser General Public License version 3 (as published by the
+# Free Software Foundation) with the following additional attribution
+# requirements (according to LGPL/GPL v3 §7):
+# 
+# (1) The following notice must be displayed in the Appropriate Legal Notices
+# of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+# 
+# (2) The following notice must be displayed at a prominent place in the
+# terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+# 
+# (3) The following bibliography is recommended for citation and must be
+# preserved in all covered files:
+# "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+#   parallel geometric multigrid solver on hierarchically distributed grids.
+#   Computing and visualization in science 16, 4 (2013), 151-164"
+# "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+#   flexible software system for simulating pde based models on high performance
+#   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+
+# included from ug_includes.cmake
+########################################
+# SIMD_BLOCK_KERNELS
+# The AVX2/FMA kernels of densematrix_simd.h (SpMV of CPUBlockAlgebra<2..4>)
+# are only compiled in if the compiler generates AVX2 and FMA code. The flags
+# are added if the compiler accepts them and the configuring host executes
+# such code. The resulting binaries then require AVX2 and FMA.
+if(SIMD_BLOCK_KERNELS)
+	include(CheckCXXSourceRuns)
+	set(CMAKE_REQUIRED_FLAGS "-mavx2 -mfma")
+	check_cxx_source_runs("
+		#include <immintrin.h>
+		int main()
+		{
+			if(!__builtin_cpu_supports(\"avx2\") || !__builtin_cpu_supports(\"fma\"))
+				return 1;
+			double r[4];
+			__m256d a = _mm256_set1_pd(1.0);
+			_mm256_storeu_pd(r, _mm256_fmadd_pd(a, a, a));
+			return (r[0] == 2.0) ? 0 : 1;
+		}" UG_AVX2_FMA_RUNS)
+	unset(CMAKE_REQUIRED_FLAGS)
+
+	if(UG_AVX2_FMA_RUNS)
+		add_cxx_flags("-mavx2 -mfma")
+		message(STATUS "Info: Using the AVX2/FMA block kernels")
+	else(UG_AVX2_FMA_RUNS)
+		message(WARNING "SIMD_BLOCK_KERNELS requested, but compiler or host do not support AVX2 and FMA. Using the generic block kernels.")
+		set(SIMD_BLOCK_KERNELS OFF)
+	endif(UG_AVX2_FMA_RUNS)
+endif(SIMD_BLOCK_KERNELS)
@@ -0,0 +1,114 @@
+#include "lib_algebra/small_algebra/small_algebra.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+
+#include "common/stopwatch.h"
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+// block SpMV micro-benchmark: generic block kernels against the SIMD kernels
+// of densematrix_simd.h (only compiled in with AVX2 and FMA, see BLOCK_SPMV_ARCH
+// in the Makefile). Only the verdicts are written to stdout, timings to stderr.
+
+template<size_t N>
+struct BlockCRS
+{
+	typedef ug::DenseMatrix<ug::FixedArray2<double, N, N> > block_type;
+	typedef ug::DenseVector<ug::FixedArray1<double, N> > vector_type;
+
+	std::vector<int> rowStart;
+	std::vector<int> cols;
+	std::vector<block_type> values;
+
+	// 7-point stencil like pattern
+	BlockCRS(int numRows)
+	{
+		const int offsets[] = {-1000, -100, -1, 0, 1, 100, 1000};
+		rowStart.push_back(0);
+		for(int r=0; r<numRows; ++r){
+			for(int i=0; i<7; ++i){
+				const int c = r + offsets[i];
+				if(c < 0 || c >= numRows) continue;
+				block_type b;
+				for(size_t k=0; k<N; ++k)
+					for(size_t l=0; l<N; ++l)
+						b(k,l) = (k==l && c==r) ? 8.0 : sin(r*N*N + k*N + l + c);
+				cols.push_back(c);
+				values.push_back(b);
+			}
+			rowStart.push_back(cols.size());
+		}
+	}
+
+	// dest = dest - A*w, generic kernels
+	void mat_mult_add_generic(std::vector<vector_type> &dest, const std::vector<vector_type> &w) const
+	{
+		for(size_t r=0; r+1<rowStart.size(); ++r)
+			for(int k=rowStart[r]; k<rowStart[r+1]; ++k)
+				ug::MatMultAdd<ug::FixedArray1<double, N>, ug::FixedArray2<double, N, N> >
+					(dest[r], 1.0, dest[r], -1.0, values[k], w[cols[k]]);
+	}
+
+	// dest = dest - A*w, kernels chosen by overload resolution (as in SparseMatrix)
+	void mat_mult_add(std::vector<vector_type> &dest, const std::vector<vector_type> &w) const
+	{
+		for(size_t r=0; r+1<rowStart.size(); ++r)
+			for(int k=rowStart[r]; k<rowStart[r+1]; ++k)
+				ug::MatMultAdd(dest[r], 1.0, dest[r], -1.0, values[k], w[cols[k]]);
+	}
+};
+
+template<size_t N>
+void test(int numRows, int numIter)
+{
+	typedef typename BlockCRS<N>::vector_type vector_type;
+	BlockCRS<N> A(numRows);
+
+	std::vector<vector_type> w(numRows), d1(numRows), d2(numRows);
+	for(int r=0; r<numRows; ++r)
+		for(size_t k=0; k<N; ++k){
+			w[r][k] = cos(r*N + k);
+			d1[r][k] = d2[r][k] = 0.0;
+		}
+
+	double t1 = -ug::get_clock_s();
+	for(int i=0; i<numIter; ++i)
+		A.mat_mult_add_generic(d1, w);
+	t1 += ug::get_clock_s();
+
+	double t2 = -ug::get_clock_s();
+	for(int i=0; i<numIter; ++i)
+		A.mat_mult_add(d2, w);
+	t2 += ug::get_clock_s();
+
+	double maxDiff = 0, maxVal = 0;
+	for(int r=0; r<numRows; ++r)
+		for(size_t k=0; k<N; ++k){
+			maxDiff = std::max(maxDiff, fabs(d1[r][k]-d2[r][k]));
+			maxVal = std::max(maxVal, fabs(d1[r][k]));
+		}
+	assert(maxDiff <= 1e-12*maxVal);
+
+	std::cout << "block size " << N << ", " << A.cols.size() << " blocks: "
+			<< (maxDiff <= 1e-12*maxVal ? "results match" : "results differ") << "\n";
+	// timings are machine dependent, not part of the expected output
+	std::cerr << "block size " << N << ": generic " << t1 << " s, dispatched " << t2 << " s\n";
+}
+
+int main()
+{
+#ifdef UG_SIMD_BLOCK_KERNELS
+	std::cerr << "SIMD block kernels enabled\n";
+#else
+	std::cerr << "SIMD block kernels disabled, comparing generic against generic\n";
+#endif
+	test<2>(20000, 300);
+	test<3>(20000, 300);
+	test<4>(20000, 300);
+}
@@ -0,0 +1,233 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "lib_algebra/operator/linear_solver/gmres.h"
+#include "lib_algebra/operator/convergence_check.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// batched dot products and norms must match the single products, and GMRES
+// with classical Gram-Schmidt and reorthogonalization (CGS2) must converge
+// like GMRES with modified Gram-Schmidt
+
+using namespace ug;
+
+static int failed = 0;
+
+static double random_value()
+{
+	return (double)rand() / RAND_MAX - 0.5;
+}
+
+template<class TVector>
+void random_vector(TVector& v, size_t n)
+{
+	v.resize(n);
+	for(size_t i=0; i<n; ++i)
+		for(size_t k=0; k<GetSize(v[i]); ++k)
+			BlockRef(v[i], k) = random_value();
+}
+
+// compares dotprods and norms of numVec vectors of size n with dotprod and norm
+template<class TAlgebra>
+void check_dotprods(size_t n, size_t numVec)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+
+	vector_type v;
+	random_vector(v, n);
+	std::vector<vector_type> w(numVec);
+	std::vector<const vector_type*> pw(numVec);
+	for(size_t k=0; k<numVec; ++k){
+		random_vector(w[k], n);
+		pw[k] = &w[k];
+	}
+
+	std::vector<double> prods, norms;
+	v.dotprods(prods, pw);
+	vector_type::norms(norms, pw);
+
+	double maxDiff = 0;
+	bool ok = prods.size() == numVec && norms.size() == numVec;
+	for(size_t k=0; ok && k<numVec; ++k){
+		maxDiff = std::max(maxDiff, fabs(prods[k] - v.dotprod(w[k])));
+		maxDiff = std::max(maxDiff, fabs(norms[k] - w[k].norm()));
+	}
+	ok = ok && maxDiff < 1e-12;
+
+	std::cout << "dotprods (block size " << block_traits<typename TAlgebra::vector_type::value_type>::static_size
+			<< ", n = " << n << ", " << numVec << " vectors): " << (ok ? "match" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  max difference " << maxDiff << "\n";
+		++failed;
+	}
+}
+
+// a += s*b
+void scale_append(CPUAlgebra::vector_type& a, const CPUAlgebra::vector_type& b, double s)
+{
+	for(size_t i=0; i<a.size(); ++i)
+		a[i] += s*b[i];
+}
+
+// upwind discretization of -laplace u + b*grad u on a n x n grid
+void convection_diffusion(CPUAlgebra::matrix_type& A, size_t n, double bx, double by)
+{
+	A.resize_and_clear(n*n, n*n);
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			A(i, i) = 4.0 + bx + by;
+			if(x > 0) A(i, i-1) = -1.0 - bx;
+			if(x+1 < n) A(i, i+1) = -1.0;
+			if(y > 0) A(i, i-n) = -1.0 - by;
+			if(y+1 < n) A(i, i+n) = -1.0;
+		}
+	A.defragment();
+}
+
+// restarted GMRES with modified Gram-Schmidt, without preconditioner. As in
+// GMRES, convergence is only checked at the end of a cycle. Returns the number
+// of steps needed to reduce the defect by reduction
+int mgs_gmres(const CPUAlgebra::matrix_type& A, CPUAlgebra::vector_type& x,
+              const CPUAlgebra::vector_type& b, size_t restart, double reduction, int maxSteps)
+{
+	typedef CPUAlgebra::vector_type vector_type;
+	const size_t n = b.size();
+
+	vector_type r(n);
+	r = b;
+	A.matmul_minus(r, x);
+	const double startNorm = r.norm();
+
+	std::vector<vector_type> v(restart+1, vector_type(n));
+	std::vector<std::vector<double> > h(restart+1, std::vector<double>(restart+1, 0.0));
+	std::vector<double> gamma(restart+1), c(restart+1), s(restart+1);
+
+	int steps = 0;
+	while(steps < maxSteps)
+	{
+		gamma[0] = r.norm();
+		if(gamma[0] <= reduction*startNorm) break;
+		v[0] = r;
+		v[0] *= 1./gamma[0];
+
+		size_t numIter = 0;
+		for(size_t j=0; j<restart; ++j)
+		{
+			numIter = j;
+			A.apply(v[j+1], v[j]);
+			for(size_t i=0; i<=j; ++i){
+				h[i][j] = v[j+1].dotprod(v[i]);
+				scale_append(v[j+1], v[i], -h[i][j]);
+			}
+			h[j+1][j] = v[j+1].norm();
+
+			for(size_t i=0; i<j; ++i){
+				const double hij = h[i][j], hi1j = h[i+1][j];
+				h[i][j]   = c[i+1]*hij + s[i+1]*hi1j;
+				h[i+1][j] = s[i+1]*hij - c[i+1]*hi1j;
+			}
+			const double alpha = sqrt(h[j][j]*h[j][j] + h[j+1][j]*h[j+1][j]);
+			s[j+1] = h[j+1][j] / alpha;
+			c[j+1] = h[j][j] / alpha;
+			h[j][j] = alpha;
+			gamma[j+1] = s[j+1]*gamma[j];
+			gamma[j] = c[j+1]*gamma[j];
+			++steps;
+
+			v[j+1] *= 1./h[j+1][j];
+		}
+
+		for(size_t i=numIter; ; --i){
+			for(size_t j=i+1; j<=numIter; ++j)
+				gamma[i] -= h[i][j] * gamma[j];
+			gamma[i] /= h[i][i];
+			scale_append(x, v[i], gamma[i]);
+			if(i == 0) break;
+		}
+
+		r = b;
+		A.matmul_minus(r, x);
+	}
+	return steps;
+}
+
+// solves a convection diffusion problem with GMRES(restart) and compares the
+// number of steps and the solution with the MGS variant
+void check_gmres(size_t n, double convection, size_t restart)
+{
+	typedef CPUAlgebra::matrix_type matrix_type;
+	typedef CPUAlgebra::vector_type vector_type;
+	const double reduction = 1e-10;
+	const int maxSteps = 2000;
+
+	SmartPtr<MatrixOperator<matrix_type, vector_type> > spOp
+		= make_sp(new MatrixOperator<matrix_type, vector_type>);
+	convection_diffusion(spOp->get_matrix(), n, convection, 0.5*convection);
+
+	vector_type b;
+	random_vector(b, n*n);
+
+	SmartPtr<StdConvCheck<vector_type> > spConvCheck
+		= make_sp(new StdConvCheck<vector_type>(maxSteps, 1e-50, reduction, false));
+	GMRES<vector_type> gmres(restart);
+	gmres.set_convergence_check(spConvCheck);
+
+	vector_type x(n*n), bCopy(n*n);
+	x.set(0.0);
+	bCopy = b;
+	const bool bConverged = gmres.init(spOp) && gmres.apply_return_defect(x, bCopy);
+	const int steps = spConvCheck->step();
+
+	vector_type xMGS(n*n);
+	xMGS.set(0.0);
+	const int stepsMGS = mgs_gmres(spOp->get_matrix(), xMGS, b, restart, reduction, maxSteps);
+
+	xMGS -= x;
+	const double diff = xMGS.norm() / x.norm();
+
+	const bool ok = bConverged && abs(steps - stepsMGS) <= 1 && diff < 1e-8;
+	std::cout << "GMRES(" << restart << "), convection " << convection << ": "
+			<< (ok ? "converges like MGS" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  " << steps << " steps (MGS " << stepsMGS << "), solution difference " << diff << "\n";
+		++failed;
+	}
+}
+
+int main()
+{
+	srand(1);
+	for(size_t numVec=1; numVec<=9; numVec+=4){
+		check_dotprods<CPUAlgebra>(1000, numVec);
+		check_dotprods<CPUAlgebra>(10000, numVec);
+		check_dotprods<CPUBlockAlgebra<3> >(1000, numVec);
+	}
+
+	check_gmres(20, 0.0, 30);
+	check_gmres(20, 2.0, 30);
+	check_gmres(20, 2.0, 10);
+	check_gmres(30, 10.0, 50);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
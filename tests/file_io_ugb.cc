@@ -0,0 +1,231 @@
+#include "lib_grid/grid/grid.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+#include "lib_grid/file_io/file_io.h"
+#include "lib_grid/global_attachments.h"
+#include "lib_grid/common_attachments.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+// the binary ugb format: a grid with subsets and global attachments written to
+// ugb must load like the same grid written to ugx. Truncated and corrupted
+// files have to be rejected, leaving the grid options unchanged.
+// Links against the ug4 library (build ugshell first).
+
+using namespace ug;
+using namespace std;
+
+static int failed = 0;
+
+static const char* gridFile = "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx";
+
+static void report(const char* name, bool ok, const string& msg = string())
+{
+	cout << name << ": " << (ok ? "ok" : "FAILED") << "\n";
+	if(!ok){
+		if(!msg.empty()) cout << "  " << msg << "\n";
+		++failed;
+	}
+}
+
+template <class TElem>
+static string corners(Grid& g, TElem* e, Grid::VertexAttachmentAccessor<APosition2>& aaPos)
+{
+	stringstream ss;
+	for(size_t i=0; i<e->num_vertices(); ++i)
+		ss << aaPos[e->vertex(i)] << " ";
+	return ss.str();
+}
+
+static string corners(Grid& g, Vertex* v, Grid::VertexAttachmentAccessor<APosition2>& aaPos)
+{
+	stringstream ss;
+	ss << aaPos[v];
+	return ss.str();
+}
+
+// compares the elements of type TElem (in iteration order) of two grids: the
+// corner coordinates, the subset indices and the values of the given attachment
+template <class TElem>
+static bool compare_elems(Grid& g1, SubsetHandler& sh1, Grid& g2, SubsetHandler& sh2,
+                          const char* attName, stringstream& msg)
+{
+	Grid::VertexAttachmentAccessor<APosition2> aaPos1(g1, aPosition2), aaPos2(g2, aPosition2);
+	if(g1.num<TElem>() != g2.num<TElem>()){
+		msg << g2.num<TElem>() << " instead of " << g1.num<TElem>() << " elements";
+		return false;
+	}
+
+	ANumber aVal = GlobalAttachments::attachment<ANumber>(attName);
+	const bool bAttached = g1.has_attachment<TElem>(aVal);
+	if(bAttached != g2.has_attachment<TElem>(aVal)){
+		msg << "attachment '" << attName << "' not attached";
+		return false;
+	}
+	Grid::AttachmentAccessor<TElem, ANumber> aaVal1, aaVal2;
+	if(bAttached){
+		aaVal1.access(g1, aVal);
+		aaVal2.access(g2, aVal);
+	}
+
+	typename geometry_traits<TElem>::iterator it1 = g1.begin<TElem>(), it2 = g2.begin<TElem>();
+	for(size_t i=0; it1 != g1.end<TElem>(); ++it1, ++it2, ++i){
+		TElem* e1 = *it1; TElem* e2 = *it2;
+		if(corners(g1, e1, aaPos1) != corners(g2, e2, aaPos2)){
+			msg << "corners of element " << i << " differ";
+			return false;
+		}
+		if(sh1.get_subset_index(e1) != sh2.get_subset_index(e2)){
+			msg << "subset of element " << i << " differs";
+			return false;
+		}
+		if(bAttached && aaVal1[e1] != aaVal2[e2]){
+			msg << "attachment value of element " << i << " differs";
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool compare_subsets(SubsetHandler& sh1, SubsetHandler& sh2, stringstream& msg)
+{
+	if(sh1.num_subsets() != sh2.num_subsets()){
+		msg << sh2.num_subsets() << " instead of " << sh1.num_subsets() << " subsets";
+		return false;
+	}
+	for(int i=0; i<sh1.num_subsets(); ++i){
+		if(sh1.subset_info(i).name != sh2.subset_info(i).name){
+			msg << "name of subset " << i << " differs";
+			return false;
+		}
+	}
+	return true;
+}
+
+// loads the grid, adds global attachments on vertices and faces and writes it
+// to ugx and ugb. Both files are loaded again and compared.
+void check_round_trip()
+{
+	GlobalAttachments::declare_attachment<ANumber>("ugbTestVrtValue");
+	GlobalAttachments::declare_attachment<ANumber>("ugbTestFaceValue");
+
+	Grid g;
+	SubsetHandler sh(g);
+	if(!LoadGridFromFile(g, sh, gridFile, aPosition2)){
+		report("load ugx", false, "could not load " + string(gridFile));
+		return;
+	}
+
+	GlobalAttachments::attach<Vertex>(g, "ugbTestVrtValue");
+	GlobalAttachments::attach<Face>(g, "ugbTestFaceValue");
+	ANumber aVrtVal = GlobalAttachments::attachment<ANumber>("ugbTestVrtValue");
+	ANumber aFaceVal = GlobalAttachments::attachment<ANumber>("ugbTestFaceValue");
+	Grid::VertexAttachmentAccessor<ANumber> aaVrtVal(g, aVrtVal);
+	Grid::FaceAttachmentAccessor<ANumber> aaFaceVal(g, aFaceVal);
+//	(ugx writes the values with the default stream precision, so they are
+//	chosen to be exact with a few digits)
+	int i = 0;
+	for(VertexIterator it = g.begin<Vertex>(); it != g.end<Vertex>(); ++it, ++i)
+		aaVrtVal[*it] = 0.25 * i + 0.5;
+	i = 0;
+	for(FaceIterator it = g.begin<Face>(); it != g.end<Face>(); ++it, ++i)
+		aaFaceVal[*it] = -0.5 * i - 0.125;
+
+	const bool bSaved = SaveGridToFile(g, sh, "ugb_test.ugx", aPosition2)
+						&& SaveGridToFile(g, sh, "ugb_test.ugb", aPosition2);
+	report("save ugx and ugb", bSaved);
+	if(!bSaved) return;
+
+	Grid gUGX, gUGB;
+	SubsetHandler shUGX(gUGX), shUGB(gUGB);
+	const bool bLoaded = LoadGridFromFile(gUGX, shUGX, "ugb_test.ugx", aPosition2)
+						&& LoadGridFromFile(gUGB, shUGB, "ugb_test.ugb", aPosition2);
+	report("load ugx and ugb", bLoaded);
+	if(!bLoaded) return;
+
+	stringstream msg;
+	bool ok = compare_subsets(shUGX, shUGB, msg);
+	report("ugb round trip, subsets", ok, msg.str());
+	msg.str("");
+	ok = compare_elems<Vertex>(gUGX, shUGX, gUGB, shUGB, "ugbTestVrtValue", msg);
+	report("ugb round trip, vertices", ok, msg.str());
+	msg.str("");
+	ok = compare_elems<Edge>(gUGX, shUGX, gUGB, shUGB, "ugbTestVrtValue", msg);
+	report("ugb round trip, edges", ok, msg.str());
+	msg.str("");
+	ok = compare_elems<Face>(gUGX, shUGX, gUGB, shUGB, "ugbTestFaceValue", msg);
+	report("ugb round trip, faces", ok, msg.str());
+
+//	both files have to reproduce the original grid
+	msg.str("");
+	ok = compare_elems<Face>(g, sh, gUGX, shUGX, "ugbTestFaceValue", msg);
+	report("ugx round trip, faces", ok, msg.str());
+	msg.str("");
+	ok = compare_elems<Face>(g, sh, gUGB, shUGB, "ugbTestFaceValue", msg);
+	report("ugb round trip, faces of the original grid", ok, msg.str());
+}
+
+// loads a damaged file into a grid with non-default options. The load has to
+// fail and the options have to be restored.
+void check_damaged(const char* name, const vector<char>& data)
+{
+	{
+		ofstream out("ugb_test_damaged.ugb", ios::binary);
+		out.write(&data.front(), data.size());
+	}
+
+	Grid g(GRIDOPT_FULL_INTERCONNECTION);
+	SubsetHandler sh(g);
+	const uint options = g.get_options();
+	const bool bLoaded = LoadGridFromFile(g, sh, "ugb_test_damaged.ugb", aPosition2);
+
+	stringstream msg;
+	if(bLoaded) msg << "damaged file loaded";
+	else if(g.get_options() != options) msg << "grid options not restored";
+	report(name, !bLoaded && g.get_options() == options, msg.str());
+	remove("ugb_test_damaged.ugb");
+}
+
+void check_damaged_files()
+{
+	ifstream in("ugb_test.ugb", ios::binary);
+	vector<char> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	if(data.size() < 64){
+		report("damaged ugb files", false, "no ugb file written");
+		return;
+	}
+
+//	cut off in the middle of a section and right before the end section
+	check_damaged("truncated ugb file", vector<char>(data.begin(), data.begin() + data.size() / 2));
+	check_damaged("ugb file without end section", vector<char>(data.begin(), data.end() - 16));
+
+//	garbage in the middle of the file, e.g. invalid vertex indices or counts
+	vector<char> corrupt = data;
+	for(size_t i = data.size() / 2; i < data.size() / 2 + 64 && i < data.size(); ++i)
+		corrupt[i] = (char)0x7f;
+	check_damaged("corrupt ugb file", corrupt);
+
+//	a bad header
+	vector<char> badHeader = data;
+	badHeader[0] = 'x';
+	check_damaged("ugb file with bad header", badHeader);
+}
+
+int main()
+{
+	check_round_trip();
+	check_damaged_files();
+	remove("ugb_test.ugx");
+	remove("ugb_test.ugb");
+
+	if(failed){
+		cout << failed << " tests failed\n";
+		return 1;
+	}
+	cout << "done\n";
+	return 0;
+}
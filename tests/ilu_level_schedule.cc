@@ -0,0 +1,184 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/preconditioner/ilu.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+#include "lib_algebra/cpu_algebra/algebra_threads.cpp" // ?
+#include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.cpp" // ?
+#include "lib_algebra/algebra_common/permutation_util.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// level scheduled ILU(0): factorization and triangular solves must be bitwise
+// identical to the sequential ILU on unstructured matrices. Build with
+// -fopenmp -DUG_OPENMP to run the levels with several threads.
+
+using namespace ug;
+
+static int failed = 0;
+
+static double random_value()
+{
+	return (double)rand() / RAND_MAX - 0.5;
+}
+
+// random unsymmetric pattern and values, diagonally dominant to be regular
+template<class TAlgebra>
+void random_matrix(typename TAlgebra::matrix_type& A, size_t n)
+{
+	typedef typename TAlgebra::matrix_type::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+
+	A.resize_and_clear(n, n);
+	for(size_t r=0; r<n; ++r){
+		for(size_t k=0; k<5; ++k){
+			const size_t c = rand() % n;
+			if(c == r) continue;
+			block_type& b = A(r, c);
+			for(size_t i=0; i<N; ++i)
+				for(size_t j=0; j<N; ++j)
+					BlockRef(b, i, j) = random_value();
+		}
+	}
+	for(size_t r=0; r<n; ++r){
+		block_type& d = A(r, r);
+		for(size_t i=0; i<N; ++i)
+			for(size_t j=0; j<N; ++j)
+				BlockRef(d, i, j) = (i==j) ? 6.0*N + random_value() : random_value();
+	}
+	A.defragment();
+}
+
+template<class TVector>
+void random_vector(TVector& v, size_t n)
+{
+	v.resize(n);
+	for(size_t i=0; i<n; ++i)
+		for(size_t k=0; k<GetSize(v[i]); ++k)
+			BlockRef(v[i], k) = random_value();
+}
+
+// number of entries differing between a and b (bitwise comparison)
+template<class TVector>
+size_t num_differences(const TVector& a, const TVector& b)
+{
+	size_t num = 0;
+	for(size_t i=0; i<a.size(); ++i)
+		for(size_t k=0; k<GetSize(a[i]); ++k)
+			if(BlockRef(a[i], k) != BlockRef(b[i], k)) ++num;
+	return num;
+}
+
+static void report(const char* name, size_t n, size_t numDiff)
+{
+	std::cout << name << " (n = " << n << "): " << (numDiff == 0 ? "identical" : "FAILED") << "\n";
+	if(numDiff){
+		std::cout << "  " << numDiff << " entries differ\n";
+		++failed;
+	}
+}
+
+// compares LevelScheduledILU with FactorizeILUSorted, invert_L and invert_U
+template<class TAlgebra>
+void check_factorization(size_t n)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef typename TAlgebra::vector_type vector_type;
+
+	matrix_type A, LU;
+	random_matrix<TAlgebra>(A, n);
+	LU = A;
+	FactorizeILUSorted(LU, 1e-50);
+
+	LevelScheduledILU<typename matrix_type::value_type> levelLU;
+	if(!levelLU.init(A)){
+		std::cout << "level scheduled ILU: init FAILED\n";
+		++failed;
+		return;
+	}
+	levelLU.factorize(1e-50);
+
+	vector_type b, x, xLevel;
+	random_vector(b, n);
+	x.resize(n); xLevel.resize(n);
+
+	invert_L(LU, x, b);
+	levelLU.invert_L(xLevel, b);
+	report("level scheduled invert_L", n, num_differences(x, xLevel));
+
+	invert_U(LU, x, b, 1e-8);
+	levelLU.invert_U(xLevel, b, 1e-8);
+	report("level scheduled invert_U", n, num_differences(x, xLevel));
+
+	// the solves only match if the factors do
+	if(levelLU.num_lower_levels() < 2 || levelLU.num_upper_levels() < 2){
+		std::cout << "level scheduled ILU: only " << levelLU.num_lower_levels()
+				<< " levels, FAILED\n";
+		++failed;
+	}
+}
+
+// compares the ILU preconditioner with and without level scheduling
+template<class TAlgebra>
+void check_preconditioner(size_t n)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef typename TAlgebra::vector_type vector_type;
+
+	SmartPtr<MatrixOperator<matrix_type, vector_type> > spOp
+		= make_sp(new MatrixOperator<matrix_type, vector_type>);
+	random_matrix<TAlgebra>(spOp->get_matrix(), n);
+
+	ILU<TAlgebra> ilu, iluLevel;
+	iluLevel.set_level_scheduling(true);
+	ILinearIterator<vector_type>& B = ilu;
+	ILinearIterator<vector_type>& BLevel = iluLevel;
+
+	vector_type d, c(n), cLevel(n);
+	random_vector(d, n);
+	const bool bApplied = B.init(spOp) && BLevel.init(spOp)
+							&& B.apply(c, d) && BLevel.apply(cLevel, d);
+	if(!bApplied){
+		std::cout << "ILU with level scheduling: apply FAILED\n";
+		++failed;
+		return;
+	}
+	report("ILU with level scheduling", n, num_differences(c, cLevel));
+}
+
+template<class TAlgebra>
+void test(size_t n)
+{
+	check_factorization<TAlgebra>(n);
+	check_preconditioner<TAlgebra>(n);
+}
+
+int main()
+{
+	srand(1);
+#ifdef UG_OPENMP
+	SetAlgebraNumThreads(4);
+	SetAlgebraThreadMinRows(1);
+#endif
+
+	test<CPUAlgebra>(2000);
+	test<CPUBlockAlgebra<3> >(500);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
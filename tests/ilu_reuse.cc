@@ -0,0 +1,201 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/preconditioner/ilu.h"
+#include "lib_algebra/operator/preconditioner/ilut.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+#include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.cpp" // ?
+#include "lib_algebra/algebra_common/permutation_util.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// pattern reuse of ILU and ILUT: a second init with the same pattern and
+// new values must give the same factors as an init of a fresh preconditioner
+
+using namespace ug;
+
+static int failed = 0;
+
+static double random_value()
+{
+	return (double)rand() / RAND_MAX - 0.5;
+}
+
+// cuthill-mckee ordering counting its computations
+template<class TAlgebra>
+class CountingOrdering : public NativeCuthillMcKeeOrdering<TAlgebra, std::vector<size_t> >
+{
+	public:
+		CountingOrdering() : m_numComputed(0) {}
+		void compute() {++m_numComputed; NativeCuthillMcKeeOrdering<TAlgebra, std::vector<size_t> >::compute();}
+		size_t num_computed() const {return m_numComputed;}
+
+	private:
+		size_t m_numComputed;
+};
+
+// 5-point stencil on a n x n grid with random values, diagonally dominant.
+// if bExtra, some additional connections change the pattern
+template<class TAlgebra>
+SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, typename TAlgebra::vector_type> >
+random_stencil(size_t n, bool bExtra)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename matrix_type::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+
+	SmartPtr<MatrixOperator<matrix_type, vector_type> > spOp
+		= make_sp(new MatrixOperator<matrix_type, vector_type>);
+	matrix_type& A = spOp->get_matrix();
+	A.resize_and_clear(n*n, n*n);
+
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			std::vector<size_t> vNb;
+			if(x > 0) vNb.push_back(i-1);
+			if(x+1 < n) vNb.push_back(i+1);
+			if(y > 0) vNb.push_back(i-n);
+			if(y+1 < n) vNb.push_back(i+n);
+			if(bExtra && x+1 < n && y+1 < n) vNb.push_back(i+n+1);
+			for(size_t k=0; k<vNb.size(); ++k){
+				block_type& b = A(i, vNb[k]);
+				for(size_t r=0; r<N; ++r)
+					for(size_t c=0; c<N; ++c)
+						BlockRef(b, r, c) = (r==c) ? -1.0 + random_value() : 0.2*random_value();
+			}
+			block_type& d = A(i, i);
+			for(size_t r=0; r<N; ++r)
+				for(size_t c=0; c<N; ++c)
+					BlockRef(d, r, c) = (r==c) ? 6.0 + random_value() : 0.2*random_value();
+		}
+	A.defragment();
+	return spOp;
+}
+
+// inits B with spOp and applies it to a fixed defect
+template<class TAlgebra>
+bool apply(ILinearIterator<typename TAlgebra::vector_type>& B,
+		SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, typename TAlgebra::vector_type> > spOp,
+		typename TAlgebra::vector_type& c)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	const size_t n = spOp->num_rows();
+
+	vector_type d(n);
+	for(size_t i=0; i<n; ++i)
+		for(size_t k=0; k<GetSize(d[i]); ++k)
+			BlockRef(d[i], k) = sin(0.3*(i*GetSize(d[i])+k) + 0.1);
+	c.resize(n);
+	c.set(0.0);
+
+	if(!B.init(spOp)) return false;
+	return B.apply(c, d);
+}
+
+// inits a preconditioner with reuse enabled twice (second time with new values
+// of the same pattern, third time with a changed pattern) and compares the
+// results with fresh preconditioners after each init
+template<class TAlgebra, class TPrecond>
+void compare(const char* name, SmartPtr<TPrecond> spReused, SmartPtr<TPrecond> spFresh, size_t n)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+
+	SmartPtr<CountingOrdering<TAlgebra> > spOrdering = make_sp(new CountingOrdering<TAlgebra>);
+	spReused->set_ordering_algorithm(spOrdering);
+	spReused->set_reuse_pattern(true);
+	spFresh->set_ordering_algorithm(make_sp(new NativeCuthillMcKeeOrdering<TAlgebra, std::vector<size_t> >));
+
+	const char* vStage[] = {"first init", "same pattern", "changed pattern"};
+	const size_t vNumComputed[] = {1, 1, 2};
+	for(size_t s=0; s<3; ++s){
+		SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, vector_type> > spOp
+			= random_stencil<TAlgebra>(n, s == 2);
+
+		SmartPtr<ILinearIterator<vector_type> > spCopy = spFresh->clone();
+		vector_type cReused, cFresh;
+		const bool bApplied = apply<TAlgebra>(*spReused, spOp, cReused)
+								&& apply<TAlgebra>(*spCopy, spOp, cFresh);
+		cReused -= cFresh;
+		const double diff = bApplied ? cReused.norm() / cFresh.norm() : -1.0;
+
+		const bool ok = bApplied && diff < 1e-14 && spOrdering->num_computed() == vNumComputed[s];
+		std::cout << name << " (block size " << block_traits<typename TAlgebra::matrix_type::value_type>::static_num_rows
+				<< "), " << vStage[s] << ": " << (ok ? "factors match" : "FAILED") << "\n";
+		if(!ok){
+			std::cout << "  difference " << diff << ", " << spOrdering->num_computed() << " orderings computed\n";
+			++failed;
+		}
+	}
+}
+
+// without enabling reuse, the ordering must be computed in every init
+template<class TAlgebra, class TPrecond>
+void check_default(const char* name, SmartPtr<TPrecond> sp, size_t n)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+
+	SmartPtr<CountingOrdering<TAlgebra> > spOrdering = make_sp(new CountingOrdering<TAlgebra>);
+	sp->set_ordering_algorithm(spOrdering);
+
+	bool bApplied = true;
+	for(size_t s=0; s<2; ++s){
+		vector_type c;
+		bApplied = bApplied && apply<TAlgebra>(*sp, random_stencil<TAlgebra>(n, false), c);
+	}
+
+	const bool ok = bApplied && spOrdering->num_computed() == 2;
+	std::cout << name << " (block size " << block_traits<typename TAlgebra::matrix_type::value_type>::static_num_rows
+			<< "), default: " << (ok ? "ordering recomputed" : "FAILED") << "\n";
+	if(!ok) ++failed;
+}
+
+template<class TAlgebra>
+void test(size_t n)
+{
+	compare<TAlgebra>("ILU", make_sp(new ILU<TAlgebra>), make_sp(new ILU<TAlgebra>), n);
+	compare<TAlgebra>("ILU beta", make_sp(new ILU<TAlgebra>(0.5)), make_sp(new ILU<TAlgebra>(0.5)), n);
+
+	SmartPtr<ILU<TAlgebra> > spLevel = make_sp(new ILU<TAlgebra>);
+	SmartPtr<ILU<TAlgebra> > spLevelFresh = make_sp(new ILU<TAlgebra>);
+	spLevel->set_level_scheduling(true);
+	spLevelFresh->set_level_scheduling(true);
+	compare<TAlgebra>("level scheduled ILU", spLevel, spLevelFresh, n);
+
+	SmartPtr<ILUTPreconditioner<TAlgebra> > spILUT = make_sp(new ILUTPreconditioner<TAlgebra>(1e-3));
+	SmartPtr<ILUTPreconditioner<TAlgebra> > spILUTFresh = make_sp(new ILUTPreconditioner<TAlgebra>(1e-3));
+	spILUT->set_show_progress(false);
+	spILUTFresh->set_show_progress(false);
+	compare<TAlgebra>("ILUT", spILUT, spILUTFresh, n);
+
+	check_default<TAlgebra>("ILU", make_sp(new ILU<TAlgebra>), n);
+	SmartPtr<ILUTPreconditioner<TAlgebra> > spILUTDefault = make_sp(new ILUTPreconditioner<TAlgebra>(1e-3));
+	spILUTDefault->set_show_progress(false);
+	check_default<TAlgebra>("ILUT", spILUTDefault, n);
+}
+
+int main()
+{
+	srand(1);
+	test<CPUAlgebra>(16);
+	test<CPUBlockAlgebra<3> >(8);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
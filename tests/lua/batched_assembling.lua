@@ -0,0 +1,93 @@
+--------------------------------------------------------------------------------
+--  Compares the batched element loops of the domain discretization with the
+--  per-element ones for NeumannBoundaryFV1. With constant boundary data the
+--  fluxes are computed for blocks of elements, such that those loops have to
+--  be batched. Lua callbacks have to be evaluated at the integration points,
+--  thus discs using them have to fall back to the per-element loops.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+batchSize = util.GetParamNumber("-batchSize", 16, "Number of elements per batch")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, 0)
+util.refinement.CreateRegularHierarchy(dom, numRefs, true)
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+function NeumannFlux(x, y, t)
+	return 1.0 + x*y
+end
+
+function CreateDomainDisc(size, bLuaFlux)
+	local neumannDisc = NeumannBoundaryFV1("u")
+	neumannDisc:add(2.0, "Dirichlet", "Inner")
+	neumannDisc:add({0.5, -1.0}, "Dirichlet", "Inner")
+	if bLuaFlux then
+		neumannDisc:add("NeumannFlux", "Dirichlet", "Inner")
+	end
+
+	local domainDisc = DomainDiscretization(approxSpace)
+	domainDisc:add(neumannDisc)
+	domainDisc:ass_tuner():set_elem_batch_size(size)
+	return domainDisc
+end
+
+function RelDiff(a, b)
+	local diff = a:clone()
+	VecScaleAdd2(diff, 1.0, a, -1.0, b)
+	return VecNorm(diff) / math.max(VecNorm(b), 1e-30)
+end
+
+u = GridFunction(approxSpace)
+u:set_random(-1.0, 1.0)
+
+function Compare(name, bLuaFlux)
+	local elemDisc = CreateDomainDisc(0, bLuaFlux)
+	local batchDisc = CreateDomainDisc(batchSize, bLuaFlux)
+
+	local elemDef = GridFunction(approxSpace)
+	local batchDef = GridFunction(approxSpace)
+	elemDisc:assemble_defect(elemDef, u)
+	batchDisc:assemble_defect(batchDef, u)
+
+	local elemJ = AssembledLinearOperator(elemDisc)
+	local batchJ = AssembledLinearOperator(batchDisc)
+	elemDisc:assemble_jacobian(elemJ, u)
+	batchDisc:assemble_jacobian(batchJ, u)
+
+	local elemJu = GridFunction(approxSpace)
+	local batchJu = GridFunction(approxSpace)
+	elemJ:apply(elemJu, u)
+	batchJ:apply(batchJu, u)
+
+	local defDiff = RelDiff(batchDef, elemDef)
+	local jacDiff = VecNorm(batchJu) + VecNorm(elemJu)
+	if VecNorm(elemJu) > 0 then jacDiff = RelDiff(batchJu, elemJu) end
+	local numBatched = batchDisc:ass_tuner():num_batched_elem_loops()
+	print(name..": defect diff "..defDiff..", jacobian diff "..jacDiff
+			..", batched loops "..numBatched)
+
+	assert(VecNorm(elemDef) > 0, name..": no boundary contribution assembled")
+	assert(defDiff < 1e-12, name..": batched defect differs")
+	assert(jacDiff < 1e-12, name..": batched jacobian differs")
+	assert(elemDisc:ass_tuner():num_batched_elem_loops() == 0, name..": batch size 0 assembled in batches")
+	if bLuaFlux then
+		assert(numBatched == 0, name..": lua callbacks assembled in batches")
+	else
+		assert(numBatched > 0, name..": batched element loop not used")
+	end
+end
+
+Compare("NeumannBoundaryFV1", false)
+Compare("NeumannBoundaryFV1 (lua flux)", true)
+
+print("done")
@@ -0,0 +1,81 @@
+--------------------------------------------------------------------------------
+--  Checks the flat element index tables of the dof distributions after global
+--  refinement, reordering and adaptive refinement and coarsening: for every
+--  element, the indices served from the tables must equal the indices
+--  extracted from the grid.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 2, "Number of regular refinements")
+numSteps = util.GetParamNumber("-numSteps", 4, "Number of adaption steps")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {})
+
+-- P2 places indices on edges, the incremental reinit requires the same number
+-- of indices on all objects
+function CreateApproxSpace(orderV, bIncremental)
+	local approxSpace = ApproximationSpace(dom)
+	approxSpace:add_fct("u", "Lagrange", 1)
+	approxSpace:add_fct("v", "Lagrange", orderV)
+	approxSpace:init_levels()
+	approxSpace:init_top_surface()
+	approxSpace:enable_elem_index_tables(true)
+	if bIncremental then approxSpace:enable_incremental_reinit(true) end
+	assert(approxSpace:elem_index_tables_enabled(), "element index tables not enabled")
+	return approxSpace
+end
+
+spaces = {
+	{name = "P1/P2", approxSpace = CreateApproxSpace(2, false)},
+	{name = "P1/P1, incremental", approxSpace = CreateApproxSpace(1, true)}
+}
+
+function Check(stage)
+	for _, s in ipairs(spaces) do
+		assert(s.approxSpace:check_elem_index_tables(),
+				stage..", "..s.name..": element index tables differ from the grid")
+	end
+	print(stage..": element index tables match the grid")
+end
+
+Check("initial grid")
+
+globalRefiner = GlobalDomainRefiner(dom)
+globalRefiner:refine()
+Check("global refinement")
+
+-- (only reorders the P1/P1 space, the P2 indices on the edges are not sortable)
+for _, s in ipairs(spaces) do
+	OrderLex(s.approxSpace, "-x")
+end
+Check("reordered")
+
+refiner = HangingNodeDomainRefiner(dom)
+radius = 0.2
+
+prevCenter = nil
+for step = 1, numSteps do
+	local t = step / (numSteps + 1)
+	local center = MakeVec(t, 1.0 - t)
+
+	MarkForAdaption_VerticesInSphere(dom, refiner, center, radius, "refine")
+	refiner:refine()
+	refiner:clear_marks()
+	Check("step "..step..", refined")
+
+	if prevCenter ~= nil then
+		MarkForAdaption_VerticesInSphere(dom, refiner, prevCenter, radius, "coarsen")
+		refiner:coarsen()
+		refiner:clear_marks()
+		Check("step "..step..", coarsened")
+	end
+	prevCenter = center
+end
+
+print("done")
@@ -0,0 +1,93 @@
+PluginRequired("ConvectionDiffusion")
+
+--------------------------------------------------------------------------------
+--  Solves a Poisson problem with a geometric multigrid using double and mixed
+--  precision smoothers. The single precision copies only perturb the
+--  smoothers, so the number of steps of the linear solver must be about the
+--  same for both variants.
+--  Can also be run in parallel, e.g. with 'mpirun -np 4'.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 5, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {"Inner", "Dirichlet"})
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+elemDisc = ConvectionDiffusionFV1("u", "Inner")
+elemDisc:set_diffusion(1.0)
+elemDisc:set_source(1.0)
+
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add(0.0, "u", "Dirichlet")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+A = AssembledLinearOperator(domainDisc)
+b = GridFunction(approxSpace)
+u0 = GridFunction(approxSpace)
+u0:set(0.0)
+domainDisc:adjust_solution(u0)
+domainDisc:assemble_linear(A, b)
+
+-- solves A*x = b with a multigrid using the given smoother, returns the
+-- solution and the number of steps
+function Solve(smoother)
+	local gmg = GeometricMultiGrid(approxSpace)
+	gmg:set_discretization(domainDisc)
+	gmg:set_base_level(0)
+	gmg:set_base_solver(LU())
+	gmg:set_smoother(smoother)
+	gmg:set_cycle_type(1)
+	gmg:set_num_presmooth(3)
+	gmg:set_num_postsmooth(3)
+
+	local solver = LinearSolver()
+	solver:set_preconditioner(gmg)
+	solver:set_convergence_check(ConvCheck(100, 1e-14, 1e-10, false))
+
+	local x = u0:clone()
+	solver:init(A, x)
+	assert(solver:apply(x, b), smoother:config_string().." did not converge")
+	return x, solver:step()
+end
+
+smoothers = {
+	{"Jacobi", function() return Jacobi(0.66) end},
+	{"GaussSeidel", function() return GaussSeidel() end},
+	{"SymmetricGaussSeidel", function() return SymmetricGaussSeidel() end},
+	{"ILU", function() return ILU() end},
+	{"ILUT", function() return ILUT(1e-3) end}
+}
+
+for _, s in ipairs(smoothers) do
+	local name, create = s[1], s[2]
+	local mixed = create()
+	mixed:set_mixed_precision(true)
+
+	local xDouble, stepsDouble = Solve(create())
+	local xMixed, stepsMixed = Solve(mixed)
+
+	local diff = xMixed:clone()
+	VecScaleAdd2(diff, 1.0, xMixed, -1.0, xDouble)
+	local relDiff = VecNorm(diff) / VecNorm(xDouble)
+	print(name..": double "..stepsDouble.." steps, mixed "..stepsMixed.." steps, solution diff "..relDiff)
+
+	assert(VecNorm(xDouble) > 0, name..": zero solution")
+	assert(math.abs(stepsMixed - stepsDouble) <= 1, name..": different number of steps")
+	assert(relDiff < 1e-6, name..": solutions differ")
+end
+
+print("done")
@@ -0,0 +1,84 @@
+--------------------------------------------------------------------------------
+--  Compacts the object storage of a refined grid on which approximation spaces
+--  and grid functions are already defined. The compaction replaces all grid
+--  objects and is announced as a grid adaption: the grid functions must keep
+--  their values, the DoF indices must be reassigned and point evaluations must
+--  not use search trees built for the replaced objects.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numRefs = util.GetParamNumber("-numRefs", 3, "Number of regular refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, numRefs, {})
+
+function Value(x, y, t)
+	return math.sin(3*x) * math.cos(2*y) + x*y
+end
+
+-- the incremental reinit requires the same number of indices on all objects
+function CreateApproxSpace(bIncremental, orderV)
+	local approxSpace = ApproximationSpace(dom)
+	approxSpace:add_fct("u", "Lagrange", 1)
+	approxSpace:add_fct("v", "Lagrange", orderV)
+	approxSpace:init_levels()
+	approxSpace:init_top_surface()
+	if bIncremental then approxSpace:enable_incremental_reinit(true) end
+	return approxSpace
+end
+
+spaces = {
+	{name = "full reinit", approxSpace = CreateApproxSpace(false, 2)},
+	{name = "incremental", approxSpace = CreateApproxSpace(true, 1)}
+}
+
+points = {}
+for i = 0, 20 do
+	points[#points+1] = {i/20, (i*7 % 20)/20}
+end
+
+function EvaluateAll(u)
+	local values = {}
+	for i, p in ipairs(points) do
+		values[i] = EvaluateAtClosestVertex(MakeVec(p[1], p[2]), u, "u", "Inner", dom:subset_handler())
+	end
+	return values
+end
+
+for _, s in ipairs(spaces) do
+	s.u = GridFunction(s.approxSpace)
+	Interpolate("Value", s.u, "u")
+	Interpolate("Value", s.u, "v")
+	s.numDoFs = s.u:num_dofs()
+	-- builds the cached search trees
+	s.values = EvaluateAll(s.u)
+end
+
+numRelocated = CompactGridObjectStorage(dom:grid())
+assert(numRelocated > 0, "no objects relocated")
+
+for _, s in ipairs(spaces) do
+	local msg = s.name..": "
+	assert(s.u:num_dofs() == s.numDoFs, msg.."number of DoFs changed from "
+			..s.numDoFs.." to "..s.u:num_dofs())
+
+	local fresh = GridFunction(s.approxSpace)
+	Interpolate("Value", fresh, "u")
+	Interpolate("Value", fresh, "v")
+	VecScaleAdd2(fresh, 1.0, fresh, -1.0, s.u)
+	local diff = VecNorm(fresh)
+	assert(diff < 1e-12, msg.."values changed by compaction, difference "..diff)
+
+	local values = EvaluateAll(s.u)
+	for i = 1, #points do
+		assert(math.abs(values[i] - s.values[i]) < 1e-12, msg
+				.."evaluation at point "..i.." changed from "..s.values[i].." to "..values[i])
+	end
+end
+
+print("grid compaction: "..numRelocated.." objects relocated, values preserved")
+print("done")
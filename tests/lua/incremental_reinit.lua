@@ -0,0 +1,140 @@
+--------------------------------------------------------------------------------
+--  Refines and coarsens a grid adaptively with and without incremental
+--  reinitialization of the DoF indices. After each adaption, the number of
+--  DoFs, the values of the (adapted and freshly interpolated) grid functions
+--  and the parallel index layouts must be the same for all approximation
+--  spaces, only the numbering of the indices may differ. On one process, the
+--  incremental reinit only visits the adapted region (checked if the profiler
+--  is available).
+--  Can also be run in parallel, e.g. with 'mpirun -np 4'.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 3, "Number of regular refinements")
+numSteps = util.GetParamNumber("-numSteps", 6, "Number of adaption steps")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {})
+
+-- approximation spaces without incremental reinit, with incremental reinit
+-- and the default defragmentation threshold and with incremental reinit and
+-- a threshold high enough to never renumber the indices
+function CreateApproxSpace(bIncremental, threshold)
+	local approxSpace = ApproximationSpace(dom)
+	approxSpace:add_fct("u", "Lagrange", 1)
+	approxSpace:add_fct("v", "Lagrange", 1)
+	approxSpace:init_levels()
+	approxSpace:init_top_surface()
+	if bIncremental then
+		approxSpace:enable_incremental_reinit(true)
+		if threshold ~= nil then approxSpace:set_defragmentation_threshold(threshold) end
+		assert(approxSpace:incremental_reinit_enabled(), "incremental reinit not enabled")
+	end
+	return approxSpace
+end
+
+function InitialValue(x, y, t)
+	return math.sin(3*x) * math.cos(2*y) + x*y
+end
+
+function FreshValue(x, y, t)
+	return math.exp(x - y) + 0.5*x*x
+end
+
+spaces = {
+	{name = "full reinit", approxSpace = CreateApproxSpace(false)},
+	{name = "incremental", approxSpace = CreateApproxSpace(true)},
+	{name = "incremental (no renumbering)", approxSpace = CreateApproxSpace(true, 1e10)}
+}
+
+-- the managed grid functions are adapted together with the grid
+for _, s in ipairs(spaces) do
+	s.u = GridFunction(s.approxSpace)
+	Interpolate("InitialValue", s.u, "u")
+	Interpolate("FreshValue", s.u, "v")
+end
+
+function Compare(stage)
+	local ref = spaces[1]
+
+	-- the number of unique DoFs is computed using the master and slave
+	-- layouts, it only matches if the layouts cover the same DoFs
+	local refOnes = GridFunction(ref.approxSpace)
+	refOnes:set(1.0)
+	local refNumGlobal = VecNorm(refOnes)^2
+
+	for i = 2, #spaces do
+		local s = spaces[i]
+		local msg = stage..", "..s.name..": "
+
+		assert(s.u:num_dofs() == ref.u:num_dofs(), msg.."number of DoFs differs: "
+				..s.u:num_dofs().." instead of "..ref.u:num_dofs())
+
+		local ones = GridFunction(s.approxSpace)
+		ones:set(1.0)
+		local numGlobal = VecNorm(ones)^2
+		assert(math.abs(numGlobal - refNumGlobal) < 0.5, msg.."global number of DoFs differs: "
+				..numGlobal.." instead of "..refNumGlobal)
+		assert(CheckDoFPositions(s.u), msg.."DoF positions of the layouts differ")
+
+		-- adapted values
+		for _, cmp in ipairs({"u", "v"}) do
+			local diff = L2Error(s.u, cmp, ref.u, cmp, 2)
+			local norm = L2Norm(ref.u, cmp, 2)
+			assert(norm > 0, msg.."zero grid function")
+			assert(diff < 1e-12*norm, msg.."adapted values of '"..cmp.."' differ by "..diff)
+		end
+
+		-- freshly interpolated values
+		local fresh = GridFunction(s.approxSpace)
+		local refFresh = GridFunction(ref.approxSpace)
+		Interpolate("FreshValue", fresh, "u")
+		Interpolate("FreshValue", refFresh, "u")
+		Interpolate("InitialValue", fresh, "v")
+		Interpolate("InitialValue", refFresh, "v")
+		for _, cmp in ipairs({"u", "v"}) do
+			local diff = L2Error(fresh, cmp, refFresh, cmp, 2)
+			assert(diff < 1e-12*L2Norm(refFresh, cmp, 2), msg.."interpolated values of '"..cmp.."' differ by "..diff)
+		end
+	end
+	print(stage..": "..ref.u:num_dofs().." DoFs, "..refNumGlobal.." global DoFs, all spaces match")
+end
+
+Compare("initial grid")
+
+refiner = HangingNodeDomainRefiner(dom)
+radius = 0.15
+
+-- moves a refined region along the diagonal, the region refined in the
+-- previous step is coarsened again
+prevCenter = nil
+for step = 1, numSteps do
+	local t = step / (numSteps + 1)
+	local center = MakeVec(t, 1.0 - t)
+
+	MarkForAdaption_VerticesInSphere(dom, refiner, center, radius, "refine")
+	refiner:refine()
+	refiner:clear_marks()
+	Compare("step "..step..", refined")
+
+	if prevCenter ~= nil then
+		MarkForAdaption_VerticesInSphere(dom, refiner, prevCenter, radius, "coarsen")
+		refiner:coarsen()
+		refiner:clear_marks()
+		Compare("step "..step..", coarsened")
+	end
+	prevCenter = center
+end
+
+-- the adaptions of the incremental spaces only visited the changed objects
+if GetProfilerAvailable() and NumProcs() == 1 then
+	local pn = GetProfileNode("DoFDistribution_ReinitRegion")
+	assert(pn:is_valid() and pn:get_avg_entry_count() > 0, "region reinit not used")
+end
+
+print("done")
@@ -0,0 +1,135 @@
+PluginRequired("ConvectionDiffusion")
+
+--------------------------------------------------------------------------------
+--  Solves a Poisson problem with the assembled matrix and with the
+--  MatrixFreeJacobianOperator. GMRES with Jacobi and a geometric multigrid must
+--  give the same solutions and about the same number of steps for both
+--  operators. Without RAP, the multigrid must not assemble the surface matrix
+--  of the matrix-free operator (checked if the profiler is available).
+--  Matrix based preconditioners needing more than the diagonal (e.g. ILU) must
+--  reject the matrix-free operator.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, 0)
+util.refinement.CreateRegularHierarchy(dom, numRefs, true)
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+elemDisc = ConvectionDiffusionFV1("u", "Inner")
+elemDisc:set_diffusion(1.0)
+elemDisc:set_source(1.0)
+
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add(0.0, "u", "Dirichlet")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+-- assembled system
+A = AssembledLinearOperator(domainDisc)
+b = GridFunction(approxSpace)
+u0 = GridFunction(approxSpace)
+u0:set(0.0)
+domainDisc:adjust_solution(u0)
+domainDisc:assemble_linear(A, b)
+
+-- matrix-free operator, linearized at u0
+mfOp = MatrixFreeJacobianOperator(domainDisc)
+mfOp:init(u0)
+
+function RelDiff(a, b)
+	local diff = a:clone()
+	VecScaleAdd2(diff, 1.0, a, -1.0, b)
+	return VecNorm(diff) / math.max(VecNorm(b), 1e-30)
+end
+
+function CreateGMG(bRAP)
+	local gmg = GeometricMultiGrid(approxSpace)
+	gmg:set_rap(bRAP == true)
+	gmg:set_discretization(domainDisc)
+	gmg:set_base_level(0)
+	gmg:set_base_solver(LU())
+	gmg:set_smoother(Jacobi(0.66))
+	gmg:set_cycle_type(1)
+	gmg:set_num_presmooth(3)
+	gmg:set_num_postsmooth(3)
+	return gmg
+end
+
+-- solves op*x = b, returns the solution and the number of steps
+function Solve(solver, op)
+	solver:set_convergence_check(ConvCheck(200, 1e-14, 1e-10, false))
+	local x = u0:clone()
+	solver:init(op, x)
+	assert(solver:apply(x, b), solver:config_string().." did not converge")
+	return x, solver:step()
+end
+
+solvers = {
+	{"GMRES + Jacobi", function()
+		local gmres = GMRES(30)
+		gmres:set_preconditioner(Jacobi(0.66))
+		return gmres
+	end},
+	{"LinearSolver + GMG", function()
+		local linSolver = LinearSolver()
+		linSolver:set_preconditioner(CreateGMG())
+		return linSolver
+	end},
+	{"GMRES + GMG", function()
+		local gmres = GMRES(30)
+		gmres:set_preconditioner(CreateGMG())
+		return gmres
+	end},
+	{"LinearSolver + GMG (RAP)", function()
+		local linSolver = LinearSolver()
+		linSolver:set_preconditioner(CreateGMG(true))
+		return linSolver
+	end, true}
+}
+
+-- number of surface matrix assemblies of matrix-free operators in the GMG
+function NumSurfaceAssemblies()
+	if not GetProfilerAvailable() then return 0 end
+	local pn = GetProfileNode("GMG_Init_AssembleSurfaceMatrix")
+	if not pn:is_valid() then return 0 end
+	return pn:get_avg_entry_count()
+end
+
+for _, s in ipairs(solvers) do
+	local name, create, bNeedsSurfaceMat = s[1], s[2], s[3]
+	local xA, stepsA = Solve(create(), A)
+	local numAssembled = NumSurfaceAssemblies()
+	local xMF, stepsMF = Solve(create(), mfOp)
+	numAssembled = NumSurfaceAssemblies() - numAssembled
+	local diff = RelDiff(xMF, xA)
+	print(name..": assembled "..stepsA.." steps, matrix-free "..stepsMF.." steps, solution diff "..diff)
+
+	assert(VecNorm(xA) > 0, name..": zero solution")
+	assert(math.abs(stepsMF - stepsA) <= 1, name..": different number of steps")
+	assert(diff < 1e-8, name..": solutions differ")
+	if GetProfilerAvailable() then
+		assert(bNeedsSurfaceMat or numAssembled == 0, name..": surface matrix assembled")
+		assert(not bNeedsSurfaceMat or numAssembled > 0, name..": surface matrix not assembled")
+	end
+end
+
+-- preconditioners needing the matrix must not silently use the diagonal
+ok = pcall(function() ILU():init(mfOp, u0) end)
+assert(not ok, "ILU accepted the matrix-free operator")
+ok = pcall(function() GaussSeidel():init(mfOp, u0) end)
+assert(not ok, "GaussSeidel accepted the matrix-free operator")
+
+print("done")
@@ -0,0 +1,89 @@
+PluginRequired("ConvectionDiffusion")
+
+--------------------------------------------------------------------------------
+--  Solves a Poisson problem on a distributed grid with GMRES using the
+--  assembled matrix and the MatrixFreeJacobianOperator. The matrix-free
+--  operator does not accept additive input, so GMRES must make the Krylov
+--  vectors consistent before applying it. Both operators must give the same
+--  solutions and about the same number of steps.
+--  Run in parallel, e.g. with 'mpirun -np 2'.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {"Inner", "Dirichlet"})
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+elemDisc = ConvectionDiffusionFV1("u", "Inner")
+elemDisc:set_diffusion(1.0)
+elemDisc:set_source(1.0)
+
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add(0.0, "u", "Dirichlet")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+-- assembled system
+A = AssembledLinearOperator(domainDisc)
+b = GridFunction(approxSpace)
+u0 = GridFunction(approxSpace)
+u0:set(0.0)
+domainDisc:adjust_solution(u0)
+domainDisc:assemble_linear(A, b)
+
+-- matrix-free operator, linearized at u0
+mfOp = MatrixFreeJacobianOperator(domainDisc)
+mfOp:init(u0)
+
+function RelDiff(a, b)
+	local diff = a:clone()
+	VecScaleAdd2(diff, 1.0, a, -1.0, b)
+	return VecNorm(diff) / math.max(VecNorm(b), 1e-30)
+end
+
+-- solves op*x = b, returns the solution and the number of steps
+function Solve(solver, op)
+	solver:set_convergence_check(ConvCheck(500, 1e-14, 1e-10, false))
+	local x = u0:clone()
+	solver:init(op, x)
+	assert(solver:apply(x, b), solver:config_string().." did not converge")
+	return x, solver:step()
+end
+
+solvers = {
+	{"GMRES", function()
+		return GMRES(30)
+	end},
+	{"GMRES + Jacobi", function()
+		local gmres = GMRES(30)
+		gmres:set_preconditioner(Jacobi(0.66))
+		return gmres
+	end}
+}
+
+for _, s in ipairs(solvers) do
+	local name, create = s[1], s[2]
+	local xA, stepsA = Solve(create(), A)
+	local xMF, stepsMF = Solve(create(), mfOp)
+	local diff = RelDiff(xMF, xA)
+	print(name..": assembled "..stepsA.." steps, matrix-free "..stepsMF.." steps, solution diff "..diff)
+
+	assert(VecNorm(xA) > 0, name..": zero solution")
+	assert(math.abs(stepsMF - stepsA) <= 1, name..": different number of steps")
+	assert(diff < 1e-8, name..": solutions differ")
+end
+
+print("done")
@@ -0,0 +1,76 @@
+PluginRequired("ConvectionDiffusion")
+
+--------------------------------------------------------------------------------
+--  Multiplies the assembled matrix of a Poisson problem on a distributed grid
+--  with an additive vector. The matrix then makes the vector consistent
+--  itself, overlapping the communication with the multiplication of the
+--  inner rows. The product must be the same as for the consistent vector, and
+--  the additive input must afterwards be consistent, representing the same
+--  vector as before.
+--  Run in parallel, e.g. with 'mpirun -np 2'.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {"Inner", "Dirichlet"})
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+elemDisc = ConvectionDiffusionFV1("u", "Inner")
+elemDisc:set_diffusion(1.0)
+elemDisc:set_source(1.0)
+
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add(0.0, "u", "Dirichlet")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+-- the assembled rhs b is additive
+A = AssembledLinearOperator(domainDisc)
+b = GridFunction(approxSpace)
+u0 = GridFunction(approxSpace)
+u0:set(0.0)
+domainDisc:adjust_solution(u0)
+domainDisc:assemble_linear(A, b)
+
+function RelDiff(a, b)
+	local diff = a:clone()
+	VecScaleAdd2(diff, 1.0, a, -1.0, b)
+	return VecNorm(diff) / math.max(VecNorm(b), 1e-30)
+end
+
+xAdditive = b:clone()
+xConsistent = b:clone()
+xConsistent:enforce_consistent_type()
+
+fAdditive = b:clone()
+fConsistent = b:clone()
+A:apply(fAdditive, xAdditive)
+A:apply(fConsistent, xConsistent)
+
+productDiff = RelDiff(fAdditive, fConsistent)
+inputDiff = RelDiff(xAdditive, xConsistent)
+print("product diff "..productDiff..", input diff "..inputDiff)
+
+assert(VecNorm(fConsistent) > 0, "zero product")
+assert(productDiff < 1e-12, "products differ")
+assert(inputDiff < 1e-12, "the additive input has been changed")
+
+-- the converted input is consistent now, a second product must be the same
+fSecond = b:clone()
+A:apply(fSecond, xAdditive)
+assert(RelDiff(fSecond, fConsistent) < 1e-12, "products with the converted input differ")
+
+print("done")
@@ -0,0 +1,89 @@
+--------------------------------------------------------------------------------
+--  Saves a distributed domain with SavePartitionedDomain and loads it again
+--  with LoadPartitionedDomain. Every process must get back its local grid
+--  with the same levels and subsets, and the restored positions and interfaces
+--  must give the same parallel norms of an interpolated grid function.
+--  Run in parallel, e.g. with 'mpirun -np 2'. The file is kept, afterwards
+--  '-mode mismatch' run with a different number of processes checks that
+--  loading it fails.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 3, "Number of refinements")
+fileName = util.GetParam("-file", "partitioned_grid_io_test.bin", "File of the partitioned grid")
+mode = util.GetParam("-mode", "roundtrip", "Save and load, or load with a different number of processes",
+					{"roundtrip", "mismatch"})
+
+InitUG(2, AlgebraType("CPU", 1))
+
+if mode == "mismatch" then
+	local dom = Domain()
+	-- the reason (number of processes in the file) is logged by LoadPartitionedGrid
+	local ok = pcall(LoadPartitionedDomain, dom, fileName)
+	assert(not ok, "loading "..fileName.." with "..NumProcs().." processes did not fail")
+	print("loading with "..NumProcs().." processes failed as expected")
+	print("done")
+	return
+end
+
+assert(NumProcs() > 1, "the round trip has to be run in parallel")
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {"Inner", "Dirichlet"})
+
+-- a description of the local grid: numbers of elements per level and the
+-- subset names (the positions enter the norms below)
+function LocalGridInfo(dom)
+	local grid = dom:grid()
+	local sh = dom:subset_handler()
+	local info = "levels "..grid:num_levels()
+	for lvl = 0, grid:num_levels() - 1 do
+		info = info..", level "..lvl..": "..grid:num_vertices(lvl).." "
+				..grid:num_edges(lvl).." "..grid:num_faces(lvl)
+	end
+	for si = 0, sh:num_subsets() - 1 do
+		info = info..", subset "..sh:get_subset_name(si)
+	end
+	return info
+end
+
+function Value(x, y, t)
+	return math.sin(3*x) * math.cos(2*y) + x*y
+end
+
+-- parallel norms of the interpolated function, they use the interfaces
+function Norms(dom)
+	local approxSpace = ApproximationSpace(dom)
+	approxSpace:add_fct("u", "Lagrange", 1)
+	approxSpace:init_levels()
+	approxSpace:init_top_surface()
+
+	local u = GridFunction(approxSpace)
+	Interpolate("Value", u, "u")
+	return {VecNorm(u), L2Norm(u, "u", 2), ParallelSum(u:num_dofs())}
+end
+
+infoSaved = LocalGridInfo(dom)
+normsSaved = Norms(dom)
+
+SavePartitionedDomain(dom, fileName)
+
+domLoaded = Domain()
+LoadPartitionedDomain(domLoaded, fileName)
+
+infoLoaded = LocalGridInfo(domLoaded)
+assert(infoLoaded == infoSaved, "proc "..ProcRank()..": loaded grid differs.\n"
+		.."saved:  "..infoSaved.."\nloaded: "..infoLoaded)
+
+normsLoaded = Norms(domLoaded)
+names = {"vector norm", "L2 norm", "sum of local dofs"}
+for i = 1, #names do
+	assert(math.abs(normsLoaded[i] - normsSaved[i]) <= 1e-12 * math.abs(normsSaved[i]),
+			names[i].." changed from "..normsSaved[i].." to "..normsLoaded[i])
+end
+
+print("partitioned grid io: "..infoLoaded)
+print("done")
@@ -0,0 +1,81 @@
+PluginRequired("ConvectionDiffusion")
+
+--------------------------------------------------------------------------------
+--  Solves a Poisson problem with CG and BiCGStab and their pipelined variants.
+--  The pipelined solvers are mathematically equivalent, so they must need
+--  about the same number of iterations and give the same solutions.
+--  Can also be run in parallel, e.g. with 'mpirun -np 2', where the reductions
+--  of the pipelined solvers are non-blocking.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numPreRefs = util.GetParamNumber("-numPreRefs", 1, "Number of refinements before distribution")
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateAndDistributeDomain(gridName, numRefs, numPreRefs, {"Inner", "Dirichlet"})
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+elemDisc = ConvectionDiffusionFV1("u", "Inner")
+elemDisc:set_diffusion(1.0)
+elemDisc:set_source(1.0)
+
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add(0.0, "u", "Dirichlet")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+A = AssembledLinearOperator(domainDisc)
+b = GridFunction(approxSpace)
+u0 = GridFunction(approxSpace)
+u0:set(0.0)
+domainDisc:adjust_solution(u0)
+domainDisc:assemble_linear(A, b)
+
+function RelDiff(a, b)
+	local diff = a:clone()
+	VecScaleAdd2(diff, 1.0, a, -1.0, b)
+	return VecNorm(diff) / math.max(VecNorm(b), 1e-30)
+end
+
+-- solves A*x = b, returns the solution and the number of convergence checks
+function Solve(solver)
+	local convCheck = ConvCheck(1000, 1e-14, 1e-10, false)
+	solver:set_preconditioner(Jacobi(0.66))
+	solver:set_convergence_check(convCheck)
+	local x = u0:clone()
+	solver:init(A, x)
+	assert(solver:apply(x, b), solver:config_string().." did not converge")
+	return x, convCheck:step()
+end
+
+-- BiCGStab checks the defect twice per iteration, the pipelined variant once
+solverPairs = {
+	{"CG", CG, PipelinedCG, 1},
+	{"BiCGStab", BiCGStab, PipelinedBiCGStab, 2}
+}
+
+for _, p in ipairs(solverPairs) do
+	local name, createStd, createPipe, numChecks = p[1], p[2], p[3], p[4]
+	local xStd, checksStd = Solve(createStd())
+	local xPipe, stepsPipe = Solve(createPipe())
+	local stepsStd = math.ceil(checksStd / numChecks)
+	local diff = RelDiff(xPipe, xStd)
+	print(name..": "..stepsStd.." iterations, pipelined "..stepsPipe.." iterations, solution diff "..diff)
+
+	assert(VecNorm(xStd) > 0, name..": zero solution")
+	assert(math.abs(stepsPipe - stepsStd) <= math.max(2, stepsStd / 20), name..": different number of iterations")
+	assert(diff < 1e-7, name..": solutions differ")
+end
+
+print("done")
@@ -0,0 +1,81 @@
+--------------------------------------------------------------------------------
+--  Sorts an adaptively refined grid with hanging nodes along a space filling
+--  curve. All objects, including the constrained and constraining ones, must
+--  be relocated, the links between them must be transferred to the new
+--  instances, and the grid must afterwards still be refinable and
+--  coarsenable. A linear function interpolated on the sorted grid has to be
+--  reproduced exactly.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numRefs = util.GetParamNumber("-numRefs", 2, "Number of regular refinements")
+curve = util.GetParam("-curve", "hilbert", "Space filling curve", {"hilbert", "morton"})
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, numRefs, {})
+refiner = HangingNodeDomainRefiner(dom)
+
+function Refine(center, radius)
+	MarkForAdaption_VerticesInSphere(dom, refiner, center, radius, "refine")
+	refiner:refine()
+	refiner:clear_marks()
+end
+
+function Coarsen(center, radius)
+	MarkForAdaption_VerticesInSphere(dom, refiner, center, radius, "coarsen")
+	refiner:coarsen()
+	refiner:clear_marks()
+end
+
+function Check(stage)
+	assert(CheckHangingNodeConsistency(dom:grid()), stage..": hanging nodes are not consistent")
+	print(stage..": hanging nodes are consistent")
+end
+
+function NumObjects()
+	local grid = dom:grid()
+	return grid:num_vertices() + grid:num_edges() + grid:num_faces()
+end
+
+Refine(MakeVec(0.3, 0.6), 0.25)
+Refine(MakeVec(0.3, 0.6), 0.15)
+Check("refined")
+
+numObjects = NumObjects()
+numRelocated = SortDomainAlongSpaceFillingCurve(dom, curve)
+assert(numRelocated == numObjects, "only "..numRelocated.." of "..numObjects.." objects relocated")
+Check("sorted along the "..curve.." curve")
+
+Refine(MakeVec(0.7, 0.3), 0.2)
+Check("refined after sorting")
+Coarsen(MakeVec(0.3, 0.6), 0.15)
+Check("coarsened after sorting")
+
+numRelocated = SortDomainAlongSpaceFillingCurve(dom, curve)
+assert(numRelocated == NumObjects(), "only "..numRelocated.." of "..NumObjects().." objects relocated")
+Check("sorted again")
+
+function Linear(x, y, t)
+	return 2*x - y + 0.5
+end
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+u = GridFunction(approxSpace)
+Interpolate("Linear", u, "u")
+
+-- the surface has to cover the square [-1,1]^2 and P1 has to reproduce the function
+area = Integral(1.0, u)
+assert(math.abs(area - 4.0) < 1e-12, "area of the surface grid is "..area)
+err = L2Error("Linear", u, "u", 0.0, 2)
+assert(err < 1e-12, "interpolation error "..err)
+
+print("space filling curve with hanging nodes: "..numRelocated.." objects relocated")
+print("done")
@@ -0,0 +1,96 @@
+--------------------------------------------------------------------------------
+--  Compares the threaded element loops of the domain discretization with the
+--  sequential ones for the Neumann boundary discs. Constant boundary data can
+--  be copied for each thread, such that those loops have to be assembled by
+--  threads (in builds with OpenMP). Lua callbacks can not be evaluated
+--  concurrently, thus discs using them have to fall back to the sequential
+--  loops.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_unstructured_tris_coarse_left_dirichlet.ugx"
+
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+numThreads = util.GetParamNumber("-numThreads", 4, "Number of threads in the element loops")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, 0)
+util.refinement.CreateRegularHierarchy(dom, numRefs, true)
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+function NeumannFlux(x, y, t)
+	return 1.0 + x*y
+end
+
+function CreateDomainDisc(discType, threads, bLuaFlux)
+	local neumannDisc = _G["NeumannBoundary"..discType]("u")
+	neumannDisc:add(2.0, "Dirichlet", "Inner")
+	neumannDisc:add({0.5, -1.0}, "Dirichlet", "Inner")
+	if bLuaFlux then
+		neumannDisc:add("NeumannFlux", "Dirichlet", "Inner")
+	end
+
+	local domainDisc = DomainDiscretization(approxSpace)
+	domainDisc:add(neumannDisc)
+	domainDisc:ass_tuner():set_num_threads(threads)
+	domainDisc:ass_tuner():set_thread_chunk_size(8)
+	return domainDisc
+end
+
+function RelDiff(a, b)
+	local diff = a:clone()
+	VecScaleAdd2(diff, 1.0, a, -1.0, b)
+	return VecNorm(diff) / math.max(VecNorm(b), 1e-30)
+end
+
+u = GridFunction(approxSpace)
+u:set_random(-1.0, 1.0)
+
+function Compare(name, discType, bLuaFlux)
+	local seqDisc = CreateDomainDisc(discType, 1, bLuaFlux)
+	local thrDisc = CreateDomainDisc(discType, numThreads, bLuaFlux)
+
+	local seqDef = GridFunction(approxSpace)
+	local thrDef = GridFunction(approxSpace)
+	seqDisc:assemble_defect(seqDef, u)
+	thrDisc:assemble_defect(thrDef, u)
+
+	local seqJ = AssembledLinearOperator(seqDisc)
+	local thrJ = AssembledLinearOperator(thrDisc)
+	seqDisc:assemble_jacobian(seqJ, u)
+	thrDisc:assemble_jacobian(thrJ, u)
+
+	local seqJu = GridFunction(approxSpace)
+	local thrJu = GridFunction(approxSpace)
+	seqJ:apply(seqJu, u)
+	thrJ:apply(thrJu, u)
+
+	local defDiff = RelDiff(thrDef, seqDef)
+	local jacDiff = RelDiff(thrJu, seqJu)
+	local numThreaded = thrDisc:ass_tuner():num_threaded_elem_loops()
+	print(name..": defect diff "..defDiff..", jacobian diff "..jacDiff
+			..", threaded loops "..numThreaded)
+
+	assert(VecNorm(seqDef) > 0, name..": no boundary contribution assembled")
+	assert(defDiff < 1e-12, name..": threaded defect differs")
+	assert(jacDiff < 1e-12, name..": threaded jacobian differs")
+	assert(seqDisc:ass_tuner():num_threaded_elem_loops() == 0, name..": sequential disc assembled by threads")
+	if bLuaFlux or not IsDefinedUG_OPENMP() then
+		assert(numThreaded == 0, name..": lua callbacks evaluated by threads")
+	else
+		assert(numThreaded > 0, name..": threaded element loop not used")
+	end
+end
+
+for _, discType in ipairs({"FV1", "FV", "FE"}) do
+	Compare("NeumannBoundary"..discType, discType, false)
+	Compare("NeumannBoundary"..discType.." (lua flux)", discType, true)
+end
+
+print("done")
@@ -0,0 +1,187 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/spatial_disc/local_to_global/matrix_pattern_cache.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// assembling with the MatrixPatternCache: the second pass over an unchanged
+// sequence of local matrices must replay the cached slots, and every pass must
+// give the same matrix as adding the local matrices in the usual way, also if
+// the sequence changes during a replayed pass
+
+using namespace ug;
+
+static int failed = 0;
+
+// an element couples the dofs at the corners of a quadrilateral
+typedef std::vector<size_t> Element;
+
+// quadrilaterals of a n x n grid, numbered with the lexicographic node order
+std::vector<Element> quad_grid(size_t n)
+{
+	std::vector<Element> vElem;
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			Element e(4);
+			e[0] = y*(n+1) + x;
+			e[1] = e[0] + 1;
+			e[2] = e[0] + n + 2;
+			e[3] = e[0] + n + 1;
+			vElem.push_back(e);
+		}
+	return vElem;
+}
+
+// assembles the local matrices of all elements with numFct functions per
+// index (as components of the blocks). The local values depend on the element,
+// the local position and on pass.
+template<typename TMatrix, typename TAdd>
+void assemble(TMatrix& A, const std::vector<Element>& vElem, size_t numFct,
+              int pass, TAdd add)
+{
+	LocalIndices ind;
+	LocalMatrix lmat;
+	for(size_t e=0; e<vElem.size(); ++e){
+		ind.clear();
+		ind.resize_fct(numFct);
+		for(size_t fct=0; fct<numFct; ++fct)
+			for(size_t i=0; i<vElem[e].size(); ++i)
+				ind.push_back_multi_index(fct, vElem[e][i], fct);
+
+		lmat.resize(ind);
+		for(size_t fct1=0; fct1<numFct; ++fct1)
+			for(size_t i=0; i<vElem[e].size(); ++i)
+				for(size_t fct2=0; fct2<numFct; ++fct2)
+					for(size_t j=0; j<vElem[e].size(); ++j)
+						lmat(fct1, i, fct2, j) = (i == j && fct1 == fct2)
+							? 4.0 + 0.01*e : sin(0.1*e + i + 2.0*j + fct1 + 0.5*fct2 + pass);
+		add(A, lmat);
+	}
+}
+
+struct AddUsual
+{
+	template<typename TMatrix>
+	void operator()(TMatrix& A, const LocalMatrix& lmat) const {AddLocalMatrixToGlobal(A, lmat);}
+};
+
+struct AddCached
+{
+	AddCached(MatrixPatternCache& cache) : m_cache(cache) {}
+	template<typename TMatrix>
+	void operator()(TMatrix& A, const LocalMatrix& lmat) const {m_cache.add_local_mat_to_global(A, lmat);}
+	MatrixPatternCache& m_cache;
+};
+
+// number of entries of A and B which differ (bitwise comparison)
+template<typename TMatrix>
+size_t num_differences(const TMatrix& A, const TMatrix& B)
+{
+	typedef typename TMatrix::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+	size_t num = 0;
+	for(size_t r=0; r<A.num_rows(); ++r){
+		for(typename TMatrix::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+			for(size_t i=0; i<N; ++i)
+				for(size_t j=0; j<N; ++j)
+					if(BlockRef(it.value(), i, j) != BlockRef(B(r, it.index()), i, j)) ++num;
+		for(typename TMatrix::const_row_iterator it = B.begin_row(r); it != B.end_row(r); ++it)
+			if(!A.has_connection(r, it.index())) ++num;
+	}
+	return num;
+}
+
+// one assembling pass with and without the cache. Checks if the cache
+// replayed the pass as expected and if the matrices are identical.
+template<typename TMatrix>
+void check_pass(const char* name, MatrixPatternCache& cache, TMatrix& A,
+                const std::vector<Element>& vElem, size_t numIndex, size_t numFct,
+                int pass, bool bReplayBegin, bool bReplayEnd)
+{
+	cache.resize_and_clear(A, numIndex, false);
+	const bool bReplayingBegin = cache.replaying();
+	assemble(A, vElem, numFct, pass, AddCached(cache));
+	const bool bReplayingEnd = cache.replaying();
+
+	TMatrix B;
+	B.resize_and_clear(numIndex, numIndex);
+	assemble(B, vElem, numFct, pass, AddUsual());
+	const size_t numDiff = num_differences(A, B);
+
+	const bool ok = numDiff == 0 && bReplayingBegin == bReplayBegin
+					&& bReplayingEnd == bReplayEnd;
+	std::cout << name << ": " << (ok ? (bReplayEnd ? "replayed, identical" : "identical") : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  replaying at begin " << bReplayingBegin << ", at end " << bReplayingEnd
+				<< ", " << numDiff << " entries differ\n";
+		++failed;
+	}
+}
+
+template<typename TAlgebra>
+void test(size_t numFct)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	std::cout << "block size " << numFct << "\n";
+
+	const size_t n = 20;
+	const size_t numIndex = (n+1)*(n+1);
+	std::vector<Element> vElem = quad_grid(n);
+
+	MatrixPatternCache cache;
+	matrix_type A;
+
+//	the first pass records the pattern, the following ones replay it
+	check_pass("first pass", cache, A, vElem, numIndex, numFct, 0, false, false);
+	check_pass("second pass", cache, A, vElem, numIndex, numFct, 1, true, true);
+	check_pass("third pass", cache, A, vElem, numIndex, numFct, 2, true, true);
+
+//	an additional coupling in a replayed pass: the rest of the pass is added
+//	in the usual way, and the pattern is recorded again in the next pass
+	std::vector<Element> vElemChanged = vElem;
+	Element cpl(2);
+	cpl[0] = 0; cpl[1] = numIndex - 1;
+	vElemChanged.insert(vElemChanged.begin() + vElem.size()/2, cpl);
+	check_pass("changed pattern", cache, A, vElemChanged, numIndex, numFct, 3, true, false);
+	check_pass("changed pattern, recorded again", cache, A, vElemChanged, numIndex, numFct, 4, false, false);
+	check_pass("changed pattern, second pass", cache, A, vElemChanged, numIndex, numFct, 5, true, true);
+
+//	a different order of the elements
+	std::vector<Element> vElemReversed(vElemChanged.rbegin(), vElemChanged.rend());
+	check_pass("changed order", cache, A, vElemReversed, numIndex, numFct, 6, true, false);
+	check_pass("changed order, second pass", cache, A, vElemReversed, numIndex, numFct, 7, false, false);
+	check_pass("changed order, third pass", cache, A, vElemReversed, numIndex, numFct, 8, true, true);
+
+//	a different number of indices
+	const size_t m = 15;
+	std::vector<Element> vElemSmall = quad_grid(m);
+	check_pass("resized", cache, A, vElemSmall, (m+1)*(m+1), numFct, 9, false, false);
+	check_pass("resized, second pass", cache, A, vElemSmall, (m+1)*(m+1), numFct, 10, true, true);
+}
+
+int main()
+{
+	test<CPUAlgebra>(1);
+	test<CPUBlockAlgebra<2> >(2);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
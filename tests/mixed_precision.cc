@@ -0,0 +1,198 @@
+
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/preconditioner/gauss_seidel.h"
+#include "lib_algebra/operator/preconditioner/ilu.h"
+#include "lib_algebra/operator/preconditioner/ilut.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+#include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.cpp" // ?
+#include "lib_algebra/algebra_common/permutation_util.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// mixed precision preconditioners: the float copy must not change the
+// convergence of the outer (double precision) iteration
+
+using namespace ug;
+
+static int failed = 0;
+
+// 5-point stencil on a n x n grid, the components coupled in the diagonal blocks
+template<class TAlgebra>
+SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, typename TAlgebra::vector_type> >
+poisson(size_t n)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename matrix_type::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+
+	SmartPtr<MatrixOperator<matrix_type, vector_type> > spOp
+		= make_sp(new MatrixOperator<matrix_type, vector_type>);
+	matrix_type& A = spOp->get_matrix();
+	A.resize_and_clear(n*n, n*n);
+
+	block_type diag, offdiag;
+	for(size_t k=0; k<N; ++k)
+		for(size_t l=0; l<N; ++l){
+			BlockRef(diag, k, l) = (k==l) ? 4.5 + 0.5*k : -0.5;
+			BlockRef(offdiag, k, l) = (k==l) ? -1.0 : 0.0;
+		}
+
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			A(i, i) = diag;
+			if(x > 0) A(i, i-1) = offdiag;
+			if(x+1 < n) A(i, i+1) = offdiag;
+			if(y > 0) A(i, i-n) = offdiag;
+			if(y+1 < n) A(i, i+n) = offdiag;
+		}
+	A.defragment();
+	return spOp;
+}
+
+// preconditioned richardson iteration, returns the number of steps
+// needed to reduce the defect by 'reduction'
+template<class TAlgebra>
+int richardson(ILinearIterator<typename TAlgebra::vector_type>& B,
+		SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, typename TAlgebra::vector_type> > spOp,
+		number reduction, int maxSteps)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	const size_t n = spOp->num_rows();
+
+	vector_type x(n), b(n), d(n), c(n);
+	for(size_t i=0; i<n; ++i)
+		for(size_t k=0; k<GetSize(b[i]); ++k)
+			BlockRef(b[i], k) = sin(0.1*(i*GetSize(b[i])+k));
+	x.set(0.0);
+	d = b;
+
+	if(!B.init(spOp)){
+		std::cout << B.name() << ": init failed\n";
+		++failed;
+		return -1;
+	}
+
+	const number norm0 = d.norm();
+	for(int step=1; step<=maxSteps; ++step){
+		B.apply(c, d);
+		x += c;
+		spOp->apply(d, x);
+		d *= -1.0;
+		d += b;
+		if(d.norm() < reduction*norm0)
+			return step;
+	}
+	return maxSteps+1;
+}
+
+// compares the double preconditioner with a clone of its mixed precision
+// configured parent, as done for the level smoothers of the multigrid cycle
+template<class TAlgebra, class TPrecond>
+void compare(const char* name, SmartPtr<TPrecond> spDouble, SmartPtr<TPrecond> spMixed, size_t n)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, vector_type> > spOp = poisson<TAlgebra>(n);
+
+	spMixed->set_mixed_precision(true);
+	SmartPtr<ILinearIterator<vector_type> > spClone = spMixed->clone();
+
+	const int maxSteps = 2000;
+	const int stepsDouble = richardson<TAlgebra>(*spDouble, spOp, 1e-10, maxSteps);
+	const int stepsMixed = richardson<TAlgebra>(*spClone, spOp, 1e-10, maxSteps);
+
+	const bool ok = stepsDouble <= maxSteps && std::abs(stepsMixed - stepsDouble) <= 1;
+	std::cout << name << " (block size " << block_traits<typename TAlgebra::matrix_type::value_type>::static_num_rows
+			<< "): double " << stepsDouble << " steps, mixed " << (ok ? "ok" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  mixed " << stepsMixed << " steps\n";
+		++failed;
+	}
+}
+
+// 1d neumann problem with the last diagonal slightly increased: the last
+// diagonal entry of U is 2^-40, which is exact in double and in float. The
+// mixed precision ILU must treat it as near-zero just like the double ILU.
+void near_zero_pivot(size_t n)
+{
+	typedef CPUAlgebra::matrix_type matrix_type;
+	typedef CPUAlgebra::vector_type vector_type;
+
+	SmartPtr<MatrixOperator<matrix_type, vector_type> > spOp
+		= make_sp(new MatrixOperator<matrix_type, vector_type>);
+	matrix_type& A = spOp->get_matrix();
+	A.resize_and_clear(n, n);
+	for(size_t i=0; i<n; ++i){
+		A(i, i) = (i == 0) ? 1.0 : 2.0;
+		if(i > 0) A(i, i-1) = -1.0;
+		if(i+1 < n) A(i, i+1) = -1.0;
+	}
+	A(n-1, n-1) = 1.0 + ldexp(1.0, -40);
+
+	vector_type d(n), cDouble(n), cMixed(n);
+	d.set(1.0);
+
+	ILU<CPUAlgebra> ilu, iluMixed;
+	iluMixed.set_mixed_precision(true);
+	ILinearIterator<vector_type>& B = ilu;
+	ILinearIterator<vector_type>& BMixed = iluMixed;
+	B.init(spOp);
+	BMixed.init(spOp);
+	B.apply(cDouble, d);
+	BMixed.apply(cMixed, d);
+
+	const double last = cMixed[n-1];
+	cMixed -= cDouble;
+	const bool ok = cDouble[n-1] == 0.0 && last == 0.0 && cMixed.norm() < 1e-5 * cDouble.norm();
+	std::cout << "ILU near-zero last pivot: mixed " << (ok ? "ok" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  last entry " << last << ", difference " << cMixed.norm() << "\n";
+		++failed;
+	}
+}
+
+template<class TAlgebra>
+void test(size_t n)
+{
+	compare<TAlgebra>("Jacobi", make_sp(new Jacobi<TAlgebra>(0.8)), make_sp(new Jacobi<TAlgebra>(0.8)), n);
+	compare<TAlgebra>("GaussSeidel", make_sp(new GaussSeidel<TAlgebra>), make_sp(new GaussSeidel<TAlgebra>), n);
+	compare<TAlgebra>("BackwardGaussSeidel", make_sp(new BackwardGaussSeidel<TAlgebra>), make_sp(new BackwardGaussSeidel<TAlgebra>), n);
+	compare<TAlgebra>("SymmetricGaussSeidel", make_sp(new SymmetricGaussSeidel<TAlgebra>), make_sp(new SymmetricGaussSeidel<TAlgebra>), n);
+	compare<TAlgebra>("ILU", make_sp(new ILU<TAlgebra>), make_sp(new ILU<TAlgebra>), n);
+
+	SmartPtr<ILUTPreconditioner<TAlgebra> > spILUT = make_sp(new ILUTPreconditioner<TAlgebra>(1e-3));
+	SmartPtr<ILUTPreconditioner<TAlgebra> > spILUTMixed = make_sp(new ILUTPreconditioner<TAlgebra>(1e-3));
+	spILUT->set_show_progress(false);
+	spILUTMixed->set_show_progress(false);
+	compare<TAlgebra>("ILUT", spILUT, spILUTMixed, n);
+}
+
+int main()
+{
+	test<CPUAlgebra>(16);
+	test<CPUBlockAlgebra<2> >(16);
+	test<CPUBlockAlgebra<3> >(8);
+	near_zero_pivot(50);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
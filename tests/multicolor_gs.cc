@@ -0,0 +1,184 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/preconditioner/gauss_seidel.h"
+#include "lib_algebra/operator/linear_solver/linear_solver.h"
+#include "lib_algebra/operator/convergence_check.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+#include "lib_algebra/cpu_algebra/algebra_threads.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// multicolor Gauss-Seidel: no two coupled rows may have the same color, the
+// result must not depend on the number of threads, and GS/SGS with the
+// multicolor variant must converge on Laplace problems. Build with
+// -fopenmp -DUG_OPENMP to process the colors with several threads.
+
+using namespace ug;
+
+typedef CPUAlgebra::matrix_type matrix_type;
+typedef CPUAlgebra::vector_type vector_type;
+typedef MatrixOperator<matrix_type, vector_type> matrix_operator_type;
+
+static int failed = 0;
+
+static double random_value()
+{
+	return (double)rand() / RAND_MAX - 0.5;
+}
+
+// 5-point (or 9-point) stencil of -laplace u on a n x n grid
+SmartPtr<matrix_operator_type> laplace(size_t n, bool bNinePoint)
+{
+	SmartPtr<matrix_operator_type> spOp = make_sp(new matrix_operator_type);
+	matrix_type& A = spOp->get_matrix();
+	A.resize_and_clear(n*n, n*n);
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			double diag = 0.0;
+			for(int dy=-1; dy<=1; ++dy)
+				for(int dx=-1; dx<=1; ++dx){
+					if((dx == 0 && dy == 0) || (!bNinePoint && dx != 0 && dy != 0)) continue;
+					const long nx = (long)x + dx, ny = (long)y + dy;
+					diag += 1.0;
+					if(nx < 0 || ny < 0 || nx >= (long)n || ny >= (long)n) continue;
+					A(i, ny*n + nx) = -1.0;
+				}
+			A(i, i) = diag;
+		}
+	A.defragment();
+	return spOp;
+}
+
+// random unsymmetric pattern, diagonally dominant
+SmartPtr<matrix_operator_type> random_matrix(size_t n)
+{
+	SmartPtr<matrix_operator_type> spOp = make_sp(new matrix_operator_type);
+	matrix_type& A = spOp->get_matrix();
+	A.resize_and_clear(n, n);
+	for(size_t r=0; r<n; ++r){
+		for(size_t k=0; k<5; ++k){
+			const size_t c = rand() % n;
+			if(c != r) A(r, c) = random_value();
+		}
+		A(r, r) = 4.0 + random_value();
+	}
+	A.defragment();
+	return spOp;
+}
+
+// checks that no coupled rows share a color and that one step with several
+// threads gives the same result as with one thread
+void check_coloring(const char* name, SmartPtr<matrix_operator_type> spOp, size_t expectedColors)
+{
+	const matrix_type& A = spOp->get_matrix();
+	MulticolorGaussSeidel<matrix_type::value_type> mc;
+	size_t numConflicts = 0;
+	if(mc.init(A)){
+		for(size_t i=0; i<A.num_rows(); ++i)
+			for(matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				if(it.index() != i && mc.color(it.index()) == mc.color(i))
+					++numConflicts;
+	}
+
+	const bool ok = mc.valid() && numConflicts == 0
+					&& (expectedColors == 0 || mc.num_colors() == expectedColors);
+	std::cout << name << ": " << (ok ? "valid coloring" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  " << mc.num_colors() << " colors, " << numConflicts << " coupled rows with the same color\n";
+		++failed;
+	}
+
+	vector_type d(A.num_rows()), c(A.num_rows()), cThreads(A.num_rows());
+	for(size_t i=0; i<d.size(); ++i) d[i] = sin(0.1*i);
+#ifdef UG_OPENMP
+	SetAlgebraNumThreads(1);
+#endif
+	mc.sgs_step(A, c, d, 1.0);
+#ifdef UG_OPENMP
+	SetAlgebraNumThreads(4);
+#endif
+	mc.sgs_step(A, cThreads, d, 1.0);
+
+	size_t numDiff = 0;
+	for(size_t i=0; i<c.size(); ++i)
+		if(c[i] != cThreads[i]) ++numDiff;
+	std::cout << name << ", threaded step: " << (numDiff == 0 ? "identical" : "FAILED") << "\n";
+	if(numDiff) ++failed;
+}
+
+// solves a Laplace problem with a linear iteration of the given smoother,
+// returns the number of steps or -1 if it did not converge
+int solve(SmartPtr<ILinearIterator<vector_type> > spSmoother, SmartPtr<matrix_operator_type> spOp)
+{
+	const size_t n = spOp->num_rows();
+	SmartPtr<StdConvCheck<vector_type> > spConvCheck
+		= make_sp(new StdConvCheck<vector_type>(2000, 1e-50, 1e-8, false));
+	LinearSolver<vector_type> solver(spSmoother, spConvCheck);
+
+	vector_type x(n), b(n);
+	for(size_t i=0; i<n; ++i) b[i] = 1.0;
+	x.set(0.0);
+	if(!solver.init(spOp) || !solver.apply_return_defect(x, b))
+		return -1;
+	return spConvCheck->step();
+}
+
+// the multicolor GS and SGS must converge at least about as fast as GS in the
+// natural ordering. (For few colors, the backward sweep of SGS mostly repeats
+// the updates of the forward sweep, e.g. with two colors the update of the
+// last color is identical, so multicolor SGS is not faster than GS.)
+void check_convergence(const char* name, SmartPtr<matrix_operator_type> spOp)
+{
+	const int steps = solve(make_sp(new GaussSeidel<CPUAlgebra>), spOp);
+
+	SmartPtr<GaussSeidel<CPUAlgebra> > spGS = make_sp(new GaussSeidel<CPUAlgebra>);
+	SmartPtr<SymmetricGaussSeidel<CPUAlgebra> > spSGS = make_sp(new SymmetricGaussSeidel<CPUAlgebra>);
+	spGS->set_multicolor(true);
+	spSGS->set_multicolor(true);
+	const int stepsGS = solve(spGS, spOp);
+	const int stepsSGS = solve(spSGS, spOp);
+
+	const bool ok = steps > 0 && stepsGS > 0 && stepsSGS > 0
+					&& stepsGS <= 1.2*steps && stepsSGS <= 1.2*steps;
+	std::cout << name << ": " << (ok ? "multicolor GS and SGS converge" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  GS " << stepsGS << " steps, SGS " << stepsSGS << " steps (GS in natural ordering " << steps << ")\n";
+		++failed;
+	}
+}
+
+int main()
+{
+	srand(1);
+#ifdef UG_OPENMP
+	SetAlgebraThreadMinRows(1);
+#endif
+
+	check_coloring("5-point laplace", laplace(32, false), 2);
+	check_coloring("9-point laplace", laplace(32, true), 4);
+	check_coloring("random matrix", random_matrix(2000), 0);
+
+	check_convergence("5-point laplace", laplace(24, false));
+	check_convergence("9-point laplace", laplace(24, true));
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/linear_solver/cg.h"
+#include "lib_algebra/operator/linear_solver/pipelined_cg.h"
+#include "lib_algebra/operator/linear_solver/bicgstab.h"
+#include "lib_algebra/operator/linear_solver/pipelined_bicgstab.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/convergence_check.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// the pipelined CG and BiCGStab are mathematically equivalent to CG and
+// BiCGStab: they must need about the same number of steps and compute the
+// same solution up to the accuracy of the solve
+
+using namespace ug;
+
+typedef CPUAlgebra::matrix_type matrix_type;
+typedef CPUAlgebra::vector_type vector_type;
+typedef MatrixOperator<matrix_type, vector_type> matrix_operator_type;
+
+static int failed = 0;
+
+// 5-point stencil of -laplace u + b*grad u (upwind) on a n x n grid with
+// dirichlet boundary conditions
+SmartPtr<matrix_operator_type> convection_diffusion(size_t n, double bx, double by)
+{
+	SmartPtr<matrix_operator_type> spOp = make_sp(new matrix_operator_type);
+	matrix_type& A = spOp->get_matrix();
+	A.resize_and_clear(n*n, n*n);
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			A(i, i) = 4.0 + bx + by;
+			if(x > 0) A(i, i-1) = -1.0 - bx;
+			if(x+1 < n) A(i, i+1) = -1.0;
+			if(y > 0) A(i, i-n) = -1.0 - by;
+			if(y+1 < n) A(i, i+n) = -1.0;
+		}
+	A.defragment();
+	return spOp;
+}
+
+// solves A*x = b with x = 0 as start, returns the number of steps or -1
+int solve(ILinearOperatorInverse<vector_type>& solver, SmartPtr<matrix_operator_type> spOp,
+          vector_type& x, StdConvCheck<vector_type>& convCheck)
+{
+	const size_t n = spOp->num_rows();
+	vector_type b(n);
+	for(size_t i=0; i<n; ++i)
+		b[i] = sin(0.01*i) + 1.0;
+	x.resize(n);
+	x.set(0.0);
+
+	if(!solver.init(spOp) || !solver.apply_return_defect(x, b))
+		return -1;
+	return convCheck.step();
+}
+
+// compares the steps and solutions of the standard and the pipelined solver.
+// numChecks is the number of convergence checks per iteration of the standard
+// solver (BiCGStab also checks the intermediate defect s, the pipelined
+// variant only the defect at the end of an iteration)
+void compare(const char* name, IPreconditionedLinearOperatorInverse<vector_type>& standard,
+             IPreconditionedLinearOperatorInverse<vector_type>& pipelined,
+             SmartPtr<matrix_operator_type> spOp, bool bPrecond, int numChecks)
+{
+	const double reduction = 1e-10;
+	SmartPtr<StdConvCheck<vector_type> > spCheck
+		= make_sp(new StdConvCheck<vector_type>(1000, 1e-50, reduction, false));
+	SmartPtr<StdConvCheck<vector_type> > spPipeCheck
+		= make_sp(new StdConvCheck<vector_type>(1000, 1e-50, reduction, false));
+	standard.set_convergence_check(spCheck);
+	pipelined.set_convergence_check(spPipeCheck);
+	if(bPrecond){
+		standard.set_preconditioner(make_sp(new Jacobi<CPUAlgebra>(0.8)));
+		pipelined.set_preconditioner(make_sp(new Jacobi<CPUAlgebra>(0.8)));
+	}
+
+	vector_type x, xPipe;
+	const int checks = solve(standard, spOp, x, *spCheck);
+	const int steps = (checks < 0) ? -1 : (checks + numChecks - 1) / numChecks;
+	const int stepsPipe = solve(pipelined, spOp, xPipe, *spPipeCheck);
+
+	xPipe -= x;
+	const double diff = xPipe.norm() / x.norm();
+
+	// the additional recurrences may cost a few steps
+	const int maxStepDiff = std::max(2, steps / 20);
+	const bool ok = steps > 0 && stepsPipe > 0
+					&& abs(stepsPipe - steps) <= maxStepDiff && diff < 1e-7;
+	std::cout << name << (bPrecond ? " (jacobi)" : "") << ": "
+			<< (ok ? "converges like the standard solver" : "FAILED") << "\n";
+	if(!ok){
+		std::cout << "  " << stepsPipe << " steps (standard " << steps << "), solution difference " << diff << "\n";
+		++failed;
+	}
+}
+
+int main()
+{
+	for(int p=0; p<2; ++p){
+		const bool bPrecond = (p == 1);
+		{
+			CG<vector_type> cg;
+			PipelinedCG<vector_type> pipelinedCG;
+			compare("PipelinedCG, laplace", cg, pipelinedCG, convection_diffusion(32, 0.0, 0.0), bPrecond, 1);
+		}
+		{
+			BiCGStab<vector_type> bicgstab;
+			PipelinedBiCGStab<vector_type> pipelinedBiCGStab;
+			compare("PipelinedBiCGStab, laplace", bicgstab, pipelinedBiCGStab, convection_diffusion(32, 0.0, 0.0), bPrecond, 2);
+		}
+		{
+			BiCGStab<vector_type> bicgstab;
+			PipelinedBiCGStab<vector_type> pipelinedBiCGStab;
+			compare("PipelinedBiCGStab, convection diffusion", bicgstab, pipelinedBiCGStab, convection_diffusion(32, 4.0, 2.0), bPrecond, 2);
+		}
+	}
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
@@ -0,0 +1,153 @@
+
+#include "lib_algebra/cpu_algebra_types.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// sparse matrix frozen CRS mode: the SpMV must give the same results in
+// frozen and non-frozen mode, also after value and structure changes
+
+using namespace ug;
+
+static int failed = 0;
+
+// dest = A*x using the row iterators
+template<class TAlgebra>
+void apply_rowwise(typename TAlgebra::vector_type& dest,
+		const typename TAlgebra::matrix_type& A, const typename TAlgebra::vector_type& x)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	for(size_t r=0; r<A.num_rows(); ++r){
+		dest[r] = 0.0;
+		for(typename matrix_type::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+			MatMultAdd(dest[r], 1.0, dest[r], 1.0, it.value(), x[it.index()]);
+	}
+}
+
+template<class TAlgebra>
+void check(const char* name, const typename TAlgebra::matrix_type& A,
+		const typename TAlgebra::vector_type& x, bool bFrozen)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	vector_type y(A.num_rows()), yRef(A.num_rows());
+	A.apply(y, x);
+	apply_rowwise<TAlgebra>(yRef, A, x);
+	y -= yRef;
+
+	const bool ok = (A.is_frozen() == bFrozen) && y.norm() <= 1e-12*yRef.norm();
+	std::cout << name << (bFrozen ? " (frozen)" : "") << ": results " << (ok ? "match" : "DIFFER") << "\n";
+	if(!ok) ++failed;
+}
+
+template<class TMatrix>
+void check_not_copied(const char* name, const TMatrix& A, const typename TMatrix::value_type* pFirst)
+{
+	const bool ok = (&A.value_at(0) == pFirst);
+	std::cout << name << ": " << (ok ? "not copied" : "COPIED") << "\n";
+	if(!ok) ++failed;
+}
+
+template<class TAlgebra>
+void test(size_t n)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename matrix_type::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+	std::cout << "== block size " << N << "\n";
+
+	matrix_type A;
+	A.resize_and_clear(n, n);
+
+	block_type b;
+	for(size_t k=0; k<N; ++k)
+		for(size_t l=0; l<N; ++l)
+			BlockRef(b, k, l) = 1.0 + k + 0.5*l;
+
+	// entries inserted in a scattered order, this fragments the storage
+	// (every 7th row stays empty)
+	for(size_t i=0; i<5*n; ++i){
+		const size_t r = (i*37) % n, c = (i*101 + r) % n;
+		if(r % 7 == 3) continue;
+		A(r, c) += (1.0 + 0.01*i) * b;
+		A(r, r) += 2.0 * b;
+	}
+
+	vector_type x(n);
+	for(size_t i=0; i<n; ++i)
+		for(size_t k=0; k<N; ++k)
+			BlockRef(x[i], k) = sin(0.3*(i*N+k));
+
+	check<TAlgebra>("assembled", A, x, false);
+
+	A.freeze();
+	check<TAlgebra>("assembled", A, x, true);
+
+	// changing values keeps the frozen mode
+	for(size_t r=0; r<n; r+=5)
+		if(r % 7 != 3) A(r, r) *= 3.0;
+	check<TAlgebra>("changed values", A, x, true);
+
+	// defragmenting a frozen matrix keeps the frozen mode
+	A.defragment();
+	check<TAlgebra>("defragmented", A, x, true);
+
+	// a new connection leaves the frozen mode
+	A(3, (n/2) | 1) = b;
+	check<TAlgebra>("new connection", A, x, false);
+
+	A.freeze();
+	check<TAlgebra>("new connection", A, x, true);
+
+	// copies are not frozen
+	matrix_type B;
+	B.set_as_copy_of(A);
+	check<TAlgebra>("copy", B, x, false);
+
+	A.unfreeze();
+	check<TAlgebra>("unfrozen", A, x, false);
+
+	// a defragmented matrix is frozen without copying
+	A.defragment();
+	const block_type* pFirst = &A.value_at(0);
+	A.freeze();
+	check<TAlgebra>("defragmented, then frozen", A, x, true);
+	check_not_copied("defragmented, then frozen", A, pFirst);
+
+	// diagonal entries inserted in ascending order fit into the initial
+	// storage and are contiguous, except for the empty rows
+	matrix_type C;
+	C.resize_and_clear(n, n);
+	for(size_t r=0; r<n; ++r)
+		if(r % 7 != 3) C(r, r) = 4.0 * b;
+	pFirst = &C.value_at(0);
+	C.freeze();
+	check<TAlgebra>("ascending diagonal", C, x, true);
+	check_not_copied("ascending diagonal", C, pFirst);
+}
+
+int main()
+{
+	test<CPUAlgebra>(500);
+	test<CPUBlockAlgebra<3> >(200);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
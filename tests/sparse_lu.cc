@@ -0,0 +1,194 @@
+
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/linear_solver/lu.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/util/file_util.cpp" // ?
+#include "common/util/os_dependent_impl/file_util_posix.cpp" // ?
+#include "common/util/os_dependent_impl/os_info_linux.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/progress.cpp" // ?
+#include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.cpp" // ?
+#include "lib_algebra/algebra_common/permutation_util.cpp" // ?
+#include "lib_algebra/operator/linear_solver/supernodal_lu_factorization.cpp" // ?
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+// sparse LU: the supernodal factorization (and its fallback for zero pivots)
+// and the ILUT(0) based sparse LU must solve the same systems as the dense LU
+
+using namespace ug;
+
+static int failed = 0;
+
+static double random_value()
+{
+	return (double)rand() / RAND_MAX - 0.5;
+}
+
+// random unsymmetric pattern and values, diagonally dominant to be regular
+template<class TAlgebra>
+void random_matrix(typename TAlgebra::matrix_type& A, size_t n)
+{
+	typedef typename TAlgebra::matrix_type::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+
+	A.resize_and_clear(n, n);
+	for(size_t r=0; r<n; ++r){
+		for(size_t k=0; k<4; ++k){
+			const size_t c = rand() % n;
+			if(c == r) continue;
+			block_type& b = A(r, c);
+			for(size_t i=0; i<N; ++i)
+				for(size_t j=0; j<N; ++j)
+					BlockRef(b, i, j) = random_value();
+		}
+	}
+	for(size_t r=0; r<n; ++r){
+		block_type& d = A(r, r);
+		for(size_t i=0; i<N; ++i)
+			for(size_t j=0; j<N; ++j)
+				BlockRef(d, i, j) = (i==j) ? 4.0*N + 8.0*N*random_value() : random_value();
+	}
+}
+
+// stokes-like saddle point matrix [K B^T; B 0] on a line of m nodes
+// block size 1: the m velocities are numbered first, then the m-1 pressures
+// block size 3: each block holds two velocities and the pressure of a node
+template<class TAlgebra>
+void saddle_point_matrix(typename TAlgebra::matrix_type& A, size_t m)
+{
+	typedef typename TAlgebra::matrix_type::value_type block_type;
+	const size_t N = block_traits<block_type>::static_num_rows;
+
+	if(N == 1){
+		A.resize_and_clear(2*m-1, 2*m-1);
+		for(size_t i=0; i<m; ++i){
+			BlockRef(A(i, i), 0, 0) = 2.0;
+			if(i > 0) BlockRef(A(i, i-1), 0, 0) = -1.0;
+			if(i+1 < m) BlockRef(A(i, i+1), 0, 0) = -1.0;
+		}
+		for(size_t p=0; p<m-1; ++p){
+			const size_t r = m + p;
+			BlockRef(A(r, p), 0, 0) = -1.0;
+			BlockRef(A(r, p+1), 0, 0) = 1.0;
+			BlockRef(A(p, r), 0, 0) = -1.0;
+			BlockRef(A(p+1, r), 0, 0) = 1.0;
+		}
+		return;
+	}
+
+	A.resize_and_clear(m, m);
+	for(size_t i=0; i<m; ++i){
+		block_type& d = A(i, i);
+		d = 0.0;
+		BlockRef(d, 0, 0) = 2.0;
+		BlockRef(d, 1, 1) = 2.0;
+		BlockRef(d, 0, 2) = BlockRef(d, 2, 0) = 1.0;
+		BlockRef(d, 1, 2) = BlockRef(d, 2, 1) = 0.5;
+		for(size_t k=0; k<2; ++k){
+			if(k == 0 && i == 0) continue;
+			if(k == 1 && i+1 == m) continue;
+			const size_t j = (k == 0) ? i-1 : i+1;
+			block_type& o = A(i, j);
+			o = 0.0;
+			BlockRef(o, 0, 0) = BlockRef(o, 1, 1) = -1.0;
+			BlockRef(o, 0, 2) = BlockRef(o, 2, 0) = (k == 0) ? -0.5 : 0.5;
+		}
+	}
+}
+
+enum LUType {DENSE, ILUT0, SUPERNODAL};
+
+// solves A*x = b with the given LU and returns the relative residual
+template<class TAlgebra>
+double solve(SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, typename TAlgebra::vector_type> > spOp,
+		LUType type, typename TAlgebra::vector_type& x)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	const typename TAlgebra::matrix_type& A = spOp->get_matrix();
+
+	vector_type b(A.num_rows()), d(A.num_rows());
+	for(size_t i=0; i<b.size(); ++i)
+		for(size_t k=0; k<GetSize(b[i]); ++k)
+			BlockRef(b[i], k) = sin(0.7*(i*GetSize(b[i])+k) + 0.3);
+	x.resize(A.num_rows());
+	x.set(0.0);
+
+	LU<TAlgebra> lu;
+	lu.set_minimum_for_sparse(type == DENSE ? 100000 : 0);
+	lu.set_show_progress(false);
+	lu.set_supernodal(type == SUPERNODAL);
+//	ILUT(0) (also as fallback of the supernodal LU) does not pivot, the
+//	saddle point matrices can be factorized in their natural ordering only
+	lu.set_sort_sparse(false);
+	if(!lu.init(spOp) || !lu.apply(x, b))
+		return -1.0;
+
+	A.apply(d, x);
+	d -= b;
+	return d.norm() / b.norm();
+}
+
+// compares the sparse LUs with the dense LU
+template<class TAlgebra>
+void compare(const char* name, SmartPtr<MatrixOperator<typename TAlgebra::matrix_type, typename TAlgebra::vector_type> > spOp)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	vector_type xRef;
+	const double resRef = solve<TAlgebra>(spOp, DENSE, xRef);
+
+	const LUType vType[] = {ILUT0, SUPERNODAL};
+	const char* vTypeName[] = {"ILUT(0)", "supernodal"};
+	for(size_t t=0; t<2; ++t){
+		vector_type x;
+		const double res = solve<TAlgebra>(spOp, vType[t], x);
+		x -= xRef;
+		const double diff = x.norm() / xRef.norm();
+
+		const bool ok = resRef >= 0 && resRef < 1e-10 && res >= 0 && res < 1e-10 && diff < 1e-8;
+		std::cout << name << " (block size " << block_traits<typename TAlgebra::matrix_type::value_type>::static_num_rows
+				<< "), " << vTypeName[t] << ": " << (ok ? "solutions match" : "FAILED") << "\n";
+		if(!ok){
+			std::cout << "  residual " << res << ", dense residual " << resRef << ", difference " << diff << "\n";
+			++failed;
+		}
+	}
+}
+
+template<class TAlgebra>
+void test(size_t n)
+{
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef MatrixOperator<matrix_type, vector_type> op_type;
+
+	SmartPtr<op_type> spRandom = make_sp(new op_type);
+	random_matrix<TAlgebra>(spRandom->get_matrix(), n);
+	compare<TAlgebra>("random", spRandom);
+
+	SmartPtr<op_type> spSaddle = make_sp(new op_type);
+	saddle_point_matrix<TAlgebra>(spSaddle->get_matrix(), n);
+	compare<TAlgebra>("saddle point", spSaddle);
+}
+
+int main()
+{
+	srand(1);
+	test<CPUAlgebra>(300);
+	test<CPUBlockAlgebra<3> >(100);
+
+	if(failed){
+		std::cout << failed << " tests failed\n";
+		return 1;
+	}
+	std::cout << "done\n";
+	return 0;
+}
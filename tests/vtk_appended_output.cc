@@ -0,0 +1,394 @@
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/io/vtkoutput.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+
+#include <zlib.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <stdint.h>
+
+// the appended vtu output: a grid function written inline (base64), appended
+// raw and appended zlib compressed must give the same arrays. In the appended
+// files, the offsets of the data arrays have to be contiguous, the byte counts
+// and block headers have to match the sizes given by the piece, and the zlib
+// blocks have to decompress to the sizes in their header. The cached grid of
+// a second time step has to be the same as a freshly written one.
+// Links against the ug4 library (build ugshell first).
+
+using namespace ug;
+using namespace std;
+
+typedef Domain2d domain_type;
+typedef GridFunction<domain_type, CPUAlgebra> function_type;
+
+static int failed = 0;
+
+static const char* gridFile = "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx";
+
+static void report(const string& name, bool ok, const string& msg = string())
+{
+	cout << name << ": " << (ok ? "ok" : "FAILED") << "\n";
+	if(!ok){
+		if(!msg.empty()) cout << "  " << msg << "\n";
+		++failed;
+	}
+}
+
+//	a data array of a vtu file and its decoded bytes (without the byte count)
+struct DataArray
+{
+	string section;
+	string name;
+	string type;
+	string format;
+	int numCmp;
+	size_t offset;
+	string inlineData;
+	vector<unsigned char> data;
+};
+
+struct VTUFile
+{
+	size_t numPoints, numCells;
+	bool bCompressed;
+	vector<DataArray> arrays;
+	string appended;	// the bytes between '_' and </AppendedData>
+};
+
+static string attribute(const string& tag, const string& name)
+{
+	size_t pos = tag.find(" " + name + "=\"");
+	if(pos == string::npos) return string();
+	pos += name.size() + 3;
+	return tag.substr(pos, tag.find('"', pos) - pos);
+}
+
+static size_t type_size(const string& type)
+{
+	if(type == "Float32" || type == "Int32" || type == "UInt32") return 4;
+	if(type == "Float64" || type == "Int64" || type == "UInt64") return 8;
+	if(type == "Int8" || type == "UInt8") return 1;
+	return 0;
+}
+
+static uint32_t read_uint32(const unsigned char* p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static vector<unsigned char> decode_base64(const string& s)
+{
+	static const string chars =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	vector<unsigned char> out;
+	int quad[4], n = 0, numPad = 0;
+	for(size_t i = 0; i < s.size(); ++i){
+		const char c = s[i];
+		if(c == '=') { quad[n++] = 0; ++numPad; }
+		else{
+			size_t v = chars.find(c);
+			if(v == string::npos) continue;
+			quad[n++] = (int)v;
+		}
+		if(n < 4) continue;
+	//	(a padded group may be followed by the next encoded block)
+		const unsigned char b[3] = {
+			(unsigned char)((quad[0] << 2) | (quad[1] >> 4)),
+			(unsigned char)(((quad[1] & 15) << 4) | (quad[2] >> 2)),
+			(unsigned char)(((quad[2] & 3) << 6) | quad[3])};
+		out.insert(out.end(), b, b + 3 - numPad);
+		n = numPad = 0;
+	}
+	return out;
+}
+
+//	reads the xml part of a vtu file written by VTKOutput (one tag per line)
+static bool read_vtu(const char* filename, VTUFile& f, string& msg)
+{
+	ifstream in(filename, ios::binary);
+	if(!in){ msg = string("could not open ") + filename; return false; }
+	string content((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+	size_t xmlEnd = content.find("<AppendedData");
+	if(xmlEnd != string::npos){
+		size_t begin = content.find('_', xmlEnd) + 1;
+		size_t end = content.rfind("\n  </AppendedData>");
+		if(begin == 0 || end == string::npos || end < begin){
+			msg = "bad AppendedData section"; return false;
+		}
+		f.appended = content.substr(begin, end - begin);
+	}
+	else xmlEnd = content.size();
+
+	f.numPoints = f.numCells = 0;
+	f.bCompressed = content.find("compressor=\"vtkZLibDataCompressor\"") < xmlEnd;
+	f.arrays.clear();
+
+	string section;
+	size_t pos = 0;
+	while((pos = content.find('<', pos)) < xmlEnd){
+		size_t end = content.find('>', pos);
+		const string tag = content.substr(pos, end - pos);
+		pos = end + 1;
+
+		if(tag.compare(0, 6, "<Piece") == 0){
+			f.numPoints = atoi(attribute(tag, "NumberOfPoints").c_str());
+			f.numCells = atoi(attribute(tag, "NumberOfCells").c_str());
+		}
+		else if(tag == "<Points" || tag == "<Cells" || tag.compare(0, 10, "<PointData") == 0
+				|| tag.compare(0, 9, "<CellData") == 0)
+			section = tag.substr(1, tag.find_first_of(" />", 1) - 1);
+		else if(tag.compare(0, 10, "<DataArray") == 0){
+			DataArray a;
+			a.section = section;
+			a.name = attribute(tag, "Name");
+			a.type = attribute(tag, "type");
+			a.format = attribute(tag, "format");
+			string cmp = attribute(tag, "NumberOfComponents");
+			a.numCmp = cmp.empty() ? 1 : atoi(cmp.c_str());
+			a.offset = atoi(attribute(tag, "offset").c_str());
+			if(a.format == "binary"){
+				size_t close = content.find("</DataArray>", pos);
+				a.inlineData = content.substr(pos, close - pos);
+			}
+			f.arrays.push_back(a);
+		}
+	}
+	return true;
+}
+
+//	the number of bytes of an array as given by the piece
+static size_t expected_size(const VTUFile& f, const DataArray& a, const vector<unsigned char>& connOffsets)
+{
+	const size_t ts = type_size(a.type);
+	if(a.section == "Points") return f.numPoints * 3 * ts;
+	if(a.section == "PointData") return f.numPoints * a.numCmp * ts;
+	if(a.section == "CellData") return f.numCells * a.numCmp * ts;
+	if(a.name == "connectivity"){
+	//	the last cell offset is the length of the connectivity
+		if(connOffsets.size() < 4) return 0;
+		return read_uint32(&connOffsets[connOffsets.size() - 4]) * ts;
+	}
+	return f.numCells * ts;
+}
+
+//	decodes all arrays of a vtu file and checks the offsets, byte counts and
+//	compression headers of the appended data
+static bool decode_vtu(VTUFile& f, string& msg)
+{
+	stringstream ss;
+	size_t nextOffset = 0;
+	for(size_t i = 0; i < f.arrays.size(); ++i){
+		DataArray& a = f.arrays[i];
+		const string what = a.section + "/" + a.name;
+
+		if(a.format == "binary"){
+			vector<unsigned char> bytes = decode_base64(a.inlineData);
+			if(bytes.size() < 4 || read_uint32(&bytes[0]) != bytes.size() - 4){
+				ss << what << ": bad inline byte count"; msg = ss.str(); return false;
+			}
+			a.data.assign(bytes.begin() + 4, bytes.end());
+			continue;
+		}
+
+		if(a.format != "appended"){
+			ss << what << ": unexpected format '" << a.format << "'"; msg = ss.str(); return false;
+		}
+		if(a.offset != nextOffset){
+			ss << what << ": offset " << a.offset << " instead of " << nextOffset;
+			msg = ss.str(); return false;
+		}
+		const unsigned char* p = (const unsigned char*) f.appended.data() + a.offset;
+		const size_t avail = f.appended.size() - a.offset;
+
+		if(!f.bCompressed){
+			const size_t n = read_uint32(p);
+			if(4 + n > avail){
+				ss << what << ": byte count " << n << " exceeds the appended data";
+				msg = ss.str(); return false;
+			}
+			a.data.assign(p + 4, p + 4 + n);
+			nextOffset = a.offset + 4 + n;
+			continue;
+		}
+
+	//	header of the compressed blocks: number of blocks, block size, size of
+	//	the last block and the compressed sizes
+		const size_t numBlocks = read_uint32(p), blockSize = read_uint32(p + 4),
+					lastSize = read_uint32(p + 8);
+		if(numBlocks == 0 || blockSize != 32768 || 4 * (3 + numBlocks) > avail){
+			ss << what << ": bad compression header"; msg = ss.str(); return false;
+		}
+		size_t pos = 4 * (3 + numBlocks);
+		for(size_t b = 0; b < numBlocks; ++b){
+			const size_t compSize = read_uint32(p + 12 + 4 * b);
+			const size_t size = (b + 1 < numBlocks || lastSize == 0) ? blockSize : lastSize;
+			if(pos + compSize > avail){
+				ss << what << ": block " << b << " exceeds the appended data";
+				msg = ss.str(); return false;
+			}
+			vector<unsigned char> block(size);
+			uLongf len = size;
+			if(uncompress(&block[0], &len, p + pos, compSize) != Z_OK || len != size){
+				ss << what << ": block " << b << " does not decompress to " << size << " bytes";
+				msg = ss.str(); return false;
+			}
+			a.data.insert(a.data.end(), block.begin(), block.end());
+			pos += compSize;
+		}
+		nextOffset = a.offset + pos;
+	}
+
+//	the appended arrays have to fill the appended section exactly
+	if(!f.appended.empty() && nextOffset != f.appended.size()){
+		ss << "appended data has " << f.appended.size() << " bytes, the arrays end at " << nextOffset;
+		msg = ss.str(); return false;
+	}
+
+//	the sizes have to match the piece
+	vector<unsigned char> connOffsets;
+	for(size_t i = 0; i < f.arrays.size(); ++i)
+		if(f.arrays[i].name == "offsets") connOffsets = f.arrays[i].data;
+	for(size_t i = 0; i < f.arrays.size(); ++i){
+		const DataArray& a = f.arrays[i];
+		const size_t expected = expected_size(f, a, connOffsets);
+		if(a.data.size() != expected){
+			ss << a.section << "/" << a.name << ": " << a.data.size() << " bytes instead of " << expected;
+			msg = ss.str(); return false;
+		}
+	}
+	return true;
+}
+
+static bool load_vtu(const string& name, const string& filename, VTUFile& f)
+{
+	string msg;
+	bool ok = read_vtu(filename.c_str(), f, msg) && decode_vtu(f, msg);
+	if(ok && f.arrays.empty()){ ok = false; msg = "no data arrays"; }
+	report(name, ok, msg);
+	return ok;
+}
+
+//	compares the decoded arrays of the given sections
+static bool same_arrays(const VTUFile& f1, const VTUFile& f2, const string& sections, string& msg)
+{
+	map<string, const DataArray*> m2;
+	for(size_t i = 0; i < f2.arrays.size(); ++i)
+		m2[f2.arrays[i].section + "/" + f2.arrays[i].name] = &f2.arrays[i];
+
+	size_t n = 0;
+	for(size_t i = 0; i < f1.arrays.size(); ++i){
+		const DataArray& a = f1.arrays[i];
+		if(sections.find(a.section) == string::npos) continue;
+		++n;
+		const string key = a.section + "/" + a.name;
+		if(!m2.count(key)){ msg = key + " missing"; return false; }
+		if(m2[key]->data != a.data){ msg = key + " differs"; return false; }
+	}
+	if(n == 0){ msg = "no arrays compared"; return false; }
+	return true;
+}
+
+static void check_same(const string& name, const VTUFile& f1, const VTUFile& f2, const string& sections)
+{
+	string msg;
+	bool ok = same_arrays(f1, f2, sections, msg);
+	report(name, ok, msg);
+}
+
+static void set_values(function_type& u, int step)
+{
+	for(size_t i = 0; i < u.size(); ++i)
+		u[i] = 0.001 * i + step;
+}
+
+int main()
+{
+	SmartPtr<domain_type> spDom = make_sp(new domain_type());
+	LoadDomain(*spDom, gridFile);
+	GlobalMultiGridRefiner refiner(*spDom->grid());
+	for(int i = 0; i < 6; ++i)
+		refiner.refine();
+
+	SmartPtr<ApproximationSpace<domain_type> > spApprox =
+		make_sp(new ApproximationSpace<domain_type>(spDom));
+	spApprox->add("u", "Lagrange", 1);
+	spApprox->add("c", "piecewise-constant");
+	spApprox->init_levels();
+	spApprox->init_top_surface();
+
+	function_type u(spApprox);
+
+//	two time steps in each mode, the second one uses the cached grid
+	const char* modes[] = {"inline", "raw", "zlib"};
+	for(int m = 0; m < 3; ++m){
+		VTKOutput<2> out;
+		out.select_all(true);
+		out.set_appended(m > 0);
+		out.set_compressed(m == 2);
+		out.set_cache_grid(true);
+		const string base = string("vtk_test_") + modes[m];
+		for(int step = 0; step < 2; ++step){
+			set_values(u, step);
+			out.print(base.c_str(), u, step, step, false);
+		}
+	}
+
+	VTUFile f[3][2];
+	bool bLoaded = true;
+	for(int m = 0; m < 3; ++m)
+		for(int step = 0; step < 2; ++step){
+			char filename[64];
+			sprintf(filename, "vtk_test_%s_t%04d.vtu", modes[m], step);
+			stringstream name;
+			name << modes[m] << " vtu, step " << step;
+			bLoaded &= load_vtu(name.str(), filename, f[m][step]);
+		}
+
+	if(bLoaded){
+		report("multiple zlib blocks", f[2][0].arrays[0].data.size() > 32768);
+		for(int m = 1; m < 3; ++m)
+			for(int step = 0; step < 2; ++step){
+				stringstream name;
+				name << modes[m] << " vtu equals inline vtu, step " << step;
+				check_same(name.str(), f[0][step], f[m][step], "Points Cells PointData CellData");
+			}
+		for(int m = 0; m < 3; ++m){
+			check_same(string(modes[m]) + " vtu, grid unchanged in step 1",
+			           f[m][0], f[m][1], "Points Cells");
+			string msg;
+			report(string(modes[m]) + " vtu, data changed in step 1",
+			       !same_arrays(f[m][0], f[m][1], "PointData", msg));
+		}
+	}
+
+	for(int m = 0; m < 3; ++m){
+		for(int step = 0; step < 2; ++step){
+			char filename[64];
+			sprintf(filename, "vtk_test_%s_t%04d.vtu", modes[m], step);
+			remove(filename);
+		}
+		remove((string("vtk_test_") + modes[m] + ".pvd").c_str());
+	}
+
+	if(failed){
+		cout << failed << " tests failed\n";
+		return 1;
+	}
+	cout << "done\n";
+	return 0;
+}
@@ -0,0 +1,360 @@
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/io/vtkoutput.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <stdint.h>
+
+// the xdmf time series: the xmf file has to describe the binary mesh and data
+// files exactly, i.e. the seeks and dimensions of the data items have to match
+// the file sizes and the mixed topology has to contain the given number of
+// cells. The mesh is written once while the grid is unchanged and again after
+// a refinement. Points, cells and data have to equal those of a vtu file
+// written (appended raw) for the same time step.
+// Links against the ug4 library (build ugshell first).
+
+using namespace ug;
+using namespace std;
+
+typedef Domain2d domain_type;
+typedef GridFunction<domain_type, CPUAlgebra> function_type;
+
+static int failed = 0;
+
+static const char* gridFile = "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx";
+
+static void report(const string& name, bool ok, const string& msg = string())
+{
+	cout << name << ": " << (ok ? "ok" : "FAILED") << "\n";
+	if(!ok){
+		if(!msg.empty()) cout << "  " << msg << "\n";
+		++failed;
+	}
+}
+
+static string attribute(const string& tag, const string& name)
+{
+	size_t pos = tag.find(" " + name + "=\"");
+	if(pos == string::npos) return string();
+	pos += name.size() + 3;
+	return tag.substr(pos, tag.find('"', pos) - pos);
+}
+
+static string read_file(const string& filename)
+{
+	ifstream in(filename.c_str(), ios::binary);
+	return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+static bool file_exists(const string& filename)
+{
+	return ifstream(filename.c_str()).good();
+}
+
+static int read_int(const string& s, size_t pos)
+{
+	int32_t v;
+	memcpy(&v, s.data() + pos, sizeof(v));
+	return v;
+}
+
+//	the arrays of a vtu file written with appended raw data (without byte counts)
+static map<string, string> read_vtu_raw(const string& filename)
+{
+	map<string, string> arrays;
+	const string content = read_file(filename);
+	const size_t xmlEnd = content.find("<AppendedData");
+	if(xmlEnd == string::npos) return arrays;
+	const size_t appended = content.find('_', xmlEnd) + 1;
+
+	string section;
+	size_t pos = 0;
+	while((pos = content.find('<', pos)) < xmlEnd){
+		size_t end = content.find('>', pos);
+		const string tag = content.substr(pos, end - pos);
+		pos = end + 1;
+		if(tag == "<Points" || tag == "<Cells" || tag.compare(0, 10, "<PointData") == 0
+				|| tag.compare(0, 9, "<CellData") == 0)
+			section = tag.substr(1, tag.find_first_of(" />", 1) - 1);
+		else if(tag.compare(0, 10, "<DataArray") == 0){
+			const size_t offset = appended + atoi(attribute(tag, "offset").c_str());
+			const size_t n = (uint32_t) read_int(content, offset);
+			arrays[section + "/" + attribute(tag, "Name")] = content.substr(offset + 4, n);
+		}
+	}
+	return arrays;
+}
+
+//	a data item of the xmf file
+struct DataItem
+{
+	string file;
+	size_t seek;
+	size_t num, numCmp, precision;
+	size_t bytes() const {return num * numCmp * precision;}
+};
+
+struct Attribute
+{
+	string name, center;
+	DataItem item;
+};
+
+//	a time step of the xmf file (the piece of a single process)
+struct Step
+{
+	double time;
+	size_t numElem;
+	DataItem topology, geometry;
+	vector<Attribute> attributes;
+};
+
+static DataItem data_item(const string& content, size_t& pos)
+{
+	DataItem item;
+	size_t begin = content.find("<DataItem", pos);
+	size_t end = content.find('>', begin);
+	const string tag = content.substr(begin, end - begin);
+	pos = content.find("</DataItem>", end);
+	item.file = content.substr(end + 1, pos - end - 1);
+	item.seek = atoi(attribute(tag, "Seek").c_str());
+	item.precision = atoi(attribute(tag, "Precision").c_str());
+	item.num = item.numCmp = 1;
+	sscanf(attribute(tag, "Dimensions").c_str(), "%lu %lu", &item.num, &item.numCmp);
+	return item;
+}
+
+//	reads the steps of the xmf file written by VTKOutput
+static vector<Step> read_xmf(const string& filename)
+{
+	vector<Step> steps;
+	const string content = read_file(filename);
+	size_t pos = 0;
+	while((pos = content.find("<Time Value=\"", pos)) != string::npos){
+		Step step;
+		step.time = atof(content.c_str() + pos + 13);
+		size_t end = content.find("</Grid>", pos);
+
+		pos = content.find("<Topology", pos);
+		step.numElem = atoi(attribute(content.substr(pos, 100), "NumberOfElements").c_str());
+		step.topology = data_item(content, pos);
+		step.geometry = data_item(content, pos);
+		while((pos = content.find("<Attribute", pos)) < end){
+			Attribute a;
+			const string tag = content.substr(pos, content.find('>', pos) - pos);
+			a.name = attribute(tag, "Name");
+			a.center = attribute(tag, "Center");
+			a.item = data_item(content, pos);
+			step.attributes.push_back(a);
+		}
+		pos = end;
+		steps.push_back(step);
+	}
+	return steps;
+}
+
+//	checks the mesh file of a step: points followed by the mixed topology
+static bool check_mesh(const Step& step, string& msg)
+{
+	stringstream ss;
+	const DataItem& geom = step.geometry;
+	const DataItem& topo = step.topology;
+	const string mesh = read_file(geom.file);
+	if(topo.file != geom.file || geom.numCmp != 3 || geom.precision != 4 || geom.seek != 0
+		|| topo.seek != geom.bytes() || topo.precision != 4){
+		msg = "bad geometry or topology data item"; return false;
+	}
+	if(mesh.size() != topo.seek + topo.bytes()){
+		ss << geom.file << " has " << mesh.size() << " bytes instead of " << topo.seek + topo.bytes();
+		msg = ss.str(); return false;
+	}
+
+//	walk through the cells: the xdmf type, the number of corners for poly
+//	cells and the corners
+	size_t i = 0, numElem = 0;
+	while(i < topo.num){
+		const int type = read_int(mesh, topo.seek + 4 * i++);
+		int numCorners;
+		switch(type){
+			case 1: case 2: numCorners = read_int(mesh, topo.seek + 4 * i++); break;
+			case 4: numCorners = 3; break;
+			case 5: numCorners = 4; break;
+			default: ss << "unexpected cell type " << type; msg = ss.str(); return false;
+		}
+		for(int c = 0; c < numCorners; ++c, ++i){
+			const int vrt = read_int(mesh, topo.seek + 4 * i);
+			if(i >= topo.num || vrt < 0 || vrt >= (int)geom.num){
+				ss << "bad corner of cell " << numElem; msg = ss.str(); return false;
+			}
+		}
+		++numElem;
+	}
+	if(numElem != step.numElem){
+		ss << numElem << " cells in the topology instead of " << step.numElem;
+		msg = ss.str(); return false;
+	}
+	return true;
+}
+
+//	checks the data file of a step: the arrays are stored one after another
+static bool check_data(const Step& step, string& msg)
+{
+	stringstream ss;
+	if(step.attributes.empty()){ msg = "no attributes"; return false; }
+	const string data = read_file(step.attributes[0].item.file);
+	size_t seek = 0;
+	for(size_t i = 0; i < step.attributes.size(); ++i){
+		const Attribute& a = step.attributes[i];
+		const size_t num = (a.center == "Node") ? step.geometry.num : step.numElem;
+		if(a.item.file != step.attributes[0].item.file || a.item.seek != seek || a.item.num != num){
+			ss << a.name << ": bad data item"; msg = ss.str(); return false;
+		}
+		seek += a.item.bytes();
+	}
+	if(data.size() != seek){
+		ss << step.attributes[0].item.file << " has " << data.size() << " bytes instead of " << seek;
+		msg = ss.str(); return false;
+	}
+	return true;
+}
+
+//	compares a step with a vtu file of the same time step
+static bool compare_with_vtu(const Step& step, const string& vtuFile, string& msg)
+{
+	map<string, string> vtu = read_vtu_raw(vtuFile);
+	if(vtu.empty()){ msg = "could not read " + vtuFile; return false; }
+
+	const string mesh = read_file(step.geometry.file);
+	if(mesh.compare(0, step.geometry.bytes(), vtu["Points/"]) != 0){
+		msg = "points differ"; return false;
+	}
+
+//	the corners of the cells have to be those of the vtu connectivity
+	string corners;
+	size_t i = 0;
+	while(i < step.topology.num){
+		const int type = read_int(mesh, step.topology.seek + 4 * i++);
+		size_t numCorners = (type == 4) ? 3 : 4;
+		if(type == 1 || type == 2) numCorners = read_int(mesh, step.topology.seek + 4 * i++);
+		corners += mesh.substr(step.topology.seek + 4 * i, 4 * numCorners);
+		i += numCorners;
+	}
+	if(corners != vtu["Cells/connectivity"]){ msg = "cells differ"; return false; }
+
+	const string data = read_file(step.attributes[0].item.file);
+	for(size_t i = 0; i < step.attributes.size(); ++i){
+		const Attribute& a = step.attributes[i];
+		const string key = string(a.center == "Node" ? "PointData/" : "CellData/") + a.name;
+		if(!vtu.count(key) || data.compare(a.item.seek, a.item.bytes(), vtu[key]) != 0){
+			msg = key + " differs"; return false;
+		}
+	}
+	return true;
+}
+
+static void set_values(function_type& u, int step)
+{
+	for(size_t i = 0; i < u.size(); ++i)
+		u[i] = 0.001 * i + step;
+}
+
+int main()
+{
+	SmartPtr<domain_type> spDom = make_sp(new domain_type());
+	LoadDomain(*spDom, gridFile);
+	GlobalMultiGridRefiner refiner(*spDom->grid());
+	for(int i = 0; i < 3; ++i)
+		refiner.refine();
+
+	SmartPtr<ApproximationSpace<domain_type> > spApprox =
+		make_sp(new ApproximationSpace<domain_type>(spDom));
+	spApprox->add("u", "Lagrange", 1);
+	spApprox->add("c", "piecewise-constant");
+	spApprox->init_levels();
+	spApprox->init_top_surface();
+
+	function_type u(spApprox);
+
+//	the time series and vtu files of the same steps for comparison. The grid
+//	is refined before the last step.
+	VTKOutput<2> out, outVTU;
+	out.select_all(true);
+	out.set_xdmf_time_series(true);
+	outVTU.select_all(true);
+	outVTU.set_appended(true);
+
+	const int numSteps = 3;
+	for(int step = 0; step < numSteps; ++step){
+		if(step == numSteps - 1)
+			refiner.refine();
+		set_values(u, step);
+		out.print("xdmf_test", u, step, 0.5 * step, false);
+		outVTU.print("xdmf_test_vtu", u, step, 0.5 * step, false);
+	}
+	out.write_time_pvd("xdmf_test", u);
+
+	vector<Step> steps = read_xmf("xdmf_test.xmf");
+	stringstream msg;
+	if((int)steps.size() != numSteps) msg << steps.size() << " steps instead of " << numSteps;
+	report("xmf file", (int)steps.size() == numSteps, msg.str());
+
+	if((int)steps.size() == numSteps){
+		bool ok = true;
+		for(int step = 0; step < numSteps; ++step)
+			ok &= (steps[step].time == 0.5 * step);
+		report("time values", ok);
+
+	//	the mesh is written again only after the refinement
+		report("mesh written once for the unchanged grid",
+		       steps[0].geometry.file == "xdmf_test_mesh0000.bin"
+		       && steps[1].geometry.file == "xdmf_test_mesh0000.bin"
+		       && steps[2].geometry.file == "xdmf_test_mesh0001.bin"
+		       && !file_exists("xdmf_test_mesh0002.bin"));
+		report("refined mesh", steps[2].numElem == 4 * steps[0].numElem);
+
+		for(int step = 0; step < numSteps; ++step){
+			stringstream name;
+			name << "step " << step;
+			string msg;
+			bool ok = check_mesh(steps[step], msg);
+			report(name.str() + ", mesh file", ok, msg);
+			ok = check_data(steps[step], msg);
+			report(name.str() + ", data file", ok, msg);
+
+			char vtuFile[64];
+			sprintf(vtuFile, "xdmf_test_vtu_t%04d.vtu", step);
+			ok = compare_with_vtu(steps[step], vtuFile, msg);
+			report(name.str() + ", same as vtu", ok, msg);
+		}
+	}
+
+	remove("xdmf_test.xmf");
+	for(int i = 0; i < numSteps; ++i){
+		char filename[64];
+		sprintf(filename, "xdmf_test_mesh%04d.bin", i);
+		remove(filename);
+		sprintf(filename, "xdmf_test_t%04d.bin", i);
+		remove(filename);
+		sprintf(filename, "xdmf_test_vtu_t%04d.vtu", i);
+		remove(filename);
+	}
+
+	if(failed){
+		cout << failed << " tests failed\n";
+		return 1;
+	}
+	cout << "done\n";
+	return 0;
+}
@@ -57,6 +57,7 @@
 #include "lib_algebra/operator/preconditioner/iterator_product.h"
 #include "lib_algebra/operator/operator_util.h"
 #include "lib_algebra/operator/vector_writer.h"
+#include "lib_algebra/cpu_algebra/algebra_threads.h"
 #include "../util_overloaded.h"
 
 #include "bridge_mat_vec_operations.h"
@@ -197,6 +198,12 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<matrix_type>(name, grp)
 			.add_constructor()
 			.add_method("print|hide=true", &matrix_type::p)
+			.add_method("freeze", &matrix_type::freeze, "", "",
+				"stores the matrix in contiguous CRS format for fast matrix-vector products")
+			.add_method("unfreeze", &matrix_type::unfreeze, "", "",
+				"leaves the frozen CRS mode")
+			.add_method("is_frozen", &matrix_type::is_frozen, "bFrozen", "",
+				"whether the matrix is in frozen CRS mode")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Matrix", tag);
 	}
@@ -502,6 +509,16 @@ static void Common(Registry& reg, string grp)
 			.add_method("compose_file_path", &T::leave_section)
 			.set_construct_as_smart_pointer(true);
 	}
+
+//	threads of the cpu algebra kernels
+	{
+		reg.add_function("SetAlgebraNumThreads", &SetAlgebraNumThreads, grp,
+				"", "numThreads", "sets the number of threads used in SpMV and vector operations (default 1, 0 = OpenMP default)");
+		reg.add_function("AlgebraNumThreads", static_cast<size_t (*)()>(&AlgebraNumThreads), grp,
+				"numThreads", "", "returns the number of threads used in SpMV and vector operations");
+		reg.add_function("SetAlgebraThreadMinRows", &SetAlgebraThreadMinRows, grp,
+				"", "minRows", "sets the minimum number of rows per thread in SpMV and vector operations");
+	}
 }
 
 }; // end Functionality
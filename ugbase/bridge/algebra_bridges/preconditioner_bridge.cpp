@@ -148,6 +148,7 @@ static void Algebra(Registry& reg, string grp)
 			.add_constructor()
 			.template add_constructor<void (*)(number)>("DampingFactor")
 			//.add_method("set_block", &T::set_block, "", "block", "if true, use block smoothing (default), else diagonal smoothing")
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "enable", "Stores the inverse diagonal in single precision.")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
@@ -160,6 +161,8 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Base")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "makes the matrix and defect consistent at the proc. interfaces")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("set_multicolor", &T::set_multicolor, "", "enable", "Enables the multicolor variant, which processes the rows of one color in parallel.")
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "enable", "Stores a single precision copy of the matrix for the smoothing steps.")
 			//.add_method("set_ordering_algorithm", &T::set_ordering_algorithm, "", "",
 			//			"sets an ordering algorithm")
 			.add_method("set_sor_relax", &T::set_sor_relax,
@@ -233,6 +236,9 @@ static void Algebra(Registry& reg, string grp)
 						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("set_level_scheduling", &T::set_level_scheduling, "", "enable", "Enables threaded level scheduled factorization and triangular solves (ILU(0) only, bitwise identical results).")
+			.add_method("set_reuse_pattern", &T::set_reuse_pattern, "", "enable", "if enabled, ordering and pattern are reused in init if the matrix pattern is unchanged. Only for orderings depending on the pattern alone. default false")
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "enable", "Stores a single precision copy of the factors for the triangular solves (disables level scheduling).")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILU", tag);
 	}
@@ -252,6 +258,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_ordering_algorithm", &T::set_ordering_algorithm, "", "",
 						"sets an ordering algorithm")
 			.add_method("set_sort", &T::set_sort, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in. default true")
+			.add_method("set_reuse_pattern", &T::set_reuse_pattern, "", "enable", "if enabled, the ordering is reused in init if the matrix pattern is unchanged. Only for orderings depending on the pattern alone. default false")
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "enable", "Stores a single precision copy of L and U for the triangular solves.")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILUT", tag);
 	}
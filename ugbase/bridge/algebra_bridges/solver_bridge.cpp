@@ -48,6 +48,8 @@
 #include "lib_algebra/operator/linear_solver/analyzing_solver.h"
 #include "lib_algebra/operator/linear_solver/cg.h"
 #include "lib_algebra/operator/linear_solver/bicgstab.h"
+#include "lib_algebra/operator/linear_solver/pipelined_cg.h"
+#include "lib_algebra/operator/linear_solver/pipelined_bicgstab.h"
 #include "lib_algebra/operator/linear_solver/gmres.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
 #include "lib_algebra/operator/linear_solver/agglomerating_solver.h"
@@ -217,6 +219,19 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "CG", tag);
 	}
 
+	// 	Pipelined CG Solver
+	{
+		typedef PipelinedCG<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipelinedCG").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined Conjugate Gradient Solver")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipelinedCG", tag);
+	}
+
 // 	BiCGStab Solver
 	{
 		typedef BiCGStab<vector_type> T;
@@ -234,6 +249,21 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "BiCGStab", tag);
 	}
 
+// 	Pipelined BiCGStab Solver
+	{
+		typedef PipelinedBiCGStab<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipelinedBiCGStab").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined BiCGStab Solver")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.add_method("set_restart", &T::set_restart)
+			.add_method("set_min_orthogonality", &T::set_min_orthogonality)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipelinedBiCGStab", tag);
+	}
+
 // 	GMRES Solver
 	{
 		typedef GMRES<vector_type> T;
@@ -258,6 +288,9 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_sort_sparse", &T::set_sort_sparse, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in in sparse LU. default true")
 			.add_method("set_info", &T::set_info, "", "bInfo", "if true, sparse LU prints some fill-in info")
 			.add_method("set_show_progress", &T::set_show_progress, "", "onoff", "switches the progress indicator on/off")
+			.add_method("set_supernodal", &T::set_supernodal, "", "bSupernodal", "if true, sparse LU uses the multifrontal supernodal factorization (falling back to ILUT(0) on zero pivots), else ILUT(0). default false")
+			.add_method("set_ordering_algorithm", &T::set_ordering_algorithm, "", "",
+						"sets the fill-reducing ordering of the supernodal sparse LU. default minimum degree")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "LU", tag);
 	}
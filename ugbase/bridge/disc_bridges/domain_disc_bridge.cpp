@@ -44,6 +44,7 @@
 #include "lib_disc/domain.h"
 #include "lib_disc/spatial_disc/domain_disc.h"
 #include "lib_disc/spatial_disc/dom_disc_embb.h"
+#include "lib_disc/operator/linear_operator/matrix_free_jacobian_operator.h"
 #include "lib_disc/parallelization/domain_distribution.h"
 #include "lib_disc/function_spaces/grid_function.h"
 
@@ -119,6 +120,23 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "DomainDiscretization", tag);
 	}
 
+//	MatrixFreeJacobianOperator
+	{
+		typedef MatrixFreeJacobianOperator<TDomain, TAlgebra> T;
+		typedef typename TAlgebra::vector_type vector_type;
+		typedef ILinearOperator<vector_type> TBase;
+		string name = string("MatrixFreeJacobianOperator").append(suffix);
+		reg.add_class_<T, TBase>(name, domDiscGrp)
+			.template add_constructor<void (*)(SmartPtr<DomainDiscretization<TDomain, TAlgebra> >)>("DomainDiscretization")
+			.template add_constructor<void (*)(SmartPtr<DomainDiscretization<TDomain, TAlgebra> >, const GridLevel&)>("DomainDiscretization#GridLevel")
+			.add_method("init", static_cast<void (T::*)(const vector_type&)>(&T::init), "", "u", "stores the linearization point and assembles the diagonal")
+			.add_method("set_level", &T::set_level, "", "gridLevel")
+			.add_method("level", &T::level, "gridLevel")
+			.add_method("diagonal", &T::diagonal, "diagonal", "", "(block) diagonal of the jacobian")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MatrixFreeJacobianOperator", tag);
+	}
+
 //	IDiscretizationItem
 	{
 		typedef IDiscretizationItem<TDomain, TAlgebra> T;
@@ -251,6 +269,28 @@ static void Algebra(Registry& reg, string grp)
 				"whether matrix is constant in time", "")
 			.add_method("set_matrix_structure_is_const", &T::set_matrix_structure_is_const, "",
 				"whether matrix has constant in time structure", "")
+			.add_method("set_num_threads", &T::set_num_threads, "", "numThreads",
+				"number of threads used in the element loops")
+			.add_method("num_threads", &T::num_threads, "numThreads", "",
+				"number of threads used in the element loops")
+			.add_method("set_thread_chunk_size", &T::set_thread_chunk_size, "", "chunkSize",
+				"number of elements per thread and chunk in threaded element loops")
+			.add_method("num_threaded_elem_loops", &T::num_threaded_elem_loops, "numLoops", "",
+				"number of element loops that have been assembled by threads")
+			.add_method("set_elem_batch_size", &T::set_elem_batch_size, "", "batchSize",
+				"number of elements assembled at once in batched element loops (0: disabled)")
+			.add_method("num_batched_elem_loops", &T::num_batched_elem_loops, "numLoops", "",
+				"number of element loops that have been assembled in batches")
+			.add_method("enable_pattern_caching", &T::enable_pattern_caching, "", "bEnable",
+				"reuse the matrix sparsity pattern in repeated assemblings")
+			.add_method("pattern_caching_enabled", &T::pattern_caching_enabled, "bEnabled", "",
+				"whether the matrix sparsity pattern is reused")
+			.add_method("clear_pattern_cache", &T::clear_pattern_cache, "", "",
+				"discards all cached matrix sparsity patterns")
+			.add_method("enable_matrix_freezing", &T::enable_matrix_freezing, "", "bEnable",
+				"freeze the assembled matrices (contiguous CRS storage). default false")
+			.add_method("matrix_freezing_enabled", &T::matrix_freezing_enabled, "bEnabled", "",
+				"whether the assembled matrices are frozen")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name+suffix, name, tag);
 	}
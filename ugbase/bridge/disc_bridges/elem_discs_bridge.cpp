@@ -105,6 +105,8 @@ static void Domain(Registry& reg, string grp)
 			string name = string("IElemError").append(suffix);
 			reg.add_class_<T>(name, elemGrp)
 	 			.add_method("set_stationary", static_cast<void (T::*)()>(&T::set_stationary))
+	 			.add_method("set_thread_safe_assembling", &T::set_thread_safe_assembling, "", "bThreadSafe",
+	 					"allows concurrent element-wise assembling in threaded element loops")
 	 		//	.add_method("add_elem_modifier", &T::add_elem_modifier, "", "")
 	 			.add_method("set_error_estimator", static_cast<void (T::*)(SmartPtr<IErrEstData<TDomain> >)>(&T::set_error_estimator));
 	 		reg.add_class_to_group(name, "IElemError", tag);
@@ -45,6 +45,7 @@
 // lib_disc includes
 #include "lib_disc/dof_manager/dof_distribution.h"
 #include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/function_spaces/grid_function_point_locator.h"
 
 // user data
 #include "lib_disc/spatial_disc/user_data/user_data.h"
@@ -782,6 +783,163 @@ struct PointEvaluatorFactory
 
 };
 
+///	marks cached search trees of a grid as outdated
+/**	CloseVertexExists and EvaluateAtClosestVertex are usually called with the
+ * same grid many times, e.g. once per time step. Their search trees are thus
+ * cached. The cache entries observe the grid: they are rebuilt if vertices are
+ * created or erased and dropped if the grid is destroyed. They do not keep
+ * the grid or any grid function alive.*/
+class CachedTreeObserver : public GridObserver
+{
+	public:
+		CachedTreeObserver(Grid& grid, const ISubsetHandler* sh, const SubsetGroup& ssGrp)
+			: m_pSH(sh), m_vSubset(ssGrp.index_vector()), m_pGrid(&grid), m_bChanged(true)
+		{
+			grid.register_observer(this, OT_GRID_OBSERVER | OT_VERTEX_OBSERVER);
+		}
+
+		virtual ~CachedTreeObserver()
+		{
+			if(m_pGrid) m_pGrid->unregister_observer(this);
+		}
+
+		virtual void grid_to_be_destroyed(Grid* grid)	{m_pGrid = NULL;}
+
+		virtual void vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent = NULL,
+									bool replacesParent = false)	{m_bChanged = true;}
+
+		virtual void vertex_to_be_erased(Grid* grid, Vertex* vrt,
+										 Vertex* replacedBy = NULL)	{m_bChanged = true;}
+
+	///	returns the observed grid or NULL if it has been destroyed
+		Grid* grid() const	{return m_pGrid;}
+
+	///	returns if the entry was created for the given grid and subsets
+		bool matches(Grid* grid, const ISubsetHandler* sh, const SubsetGroup& ssGrp) const
+		{
+			return m_pGrid == grid && m_pSH == sh && m_vSubset == ssGrp.index_vector();
+		}
+
+	///	returns if vertices were created or erased since the last call
+		bool changed()	{const bool bChanged = m_bChanged; m_bChanged = false; return bChanged;}
+
+	protected:
+		const ISubsetHandler*	m_pSH;
+		std::vector<int>		m_vSubset;
+		Grid*					m_pGrid;
+		bool					m_bChanged;
+};
+
+///	returns the cache entry for the grid and subsets, creates it if necessary
+template <typename TEntry, typename TArg>
+TEntry& CachedEntry(TArg& arg, Grid* grid, const ISubsetHandler* sh, const SubsetGroup& ssGrp)
+{
+	static std::vector<SmartPtr<TEntry> > vCache;
+
+//	drop the entries of destroyed grids
+	for(size_t i = 0; i < vCache.size();){
+		if(vCache[i]->grid() == NULL){
+			vCache[i] = vCache.back();
+			vCache.pop_back();
+		}
+		else ++i;
+	}
+
+	for(size_t i = 0; i < vCache.size(); ++i)
+		if(vCache[i]->matches(grid, sh, ssGrp))
+			return *vCache[i];
+
+	vCache.push_back(make_sp(new TEntry(arg, sh, ssGrp)));
+	return *vCache.back();
+}
+
+///	cached tree of the vertices without children of a domain
+template <typename TDomain>
+class CachedVertexTree : public CachedTreeObserver
+{
+	public:
+		typedef lg_ntree<TDomain::dim, TDomain::dim, Vertex> tree_t;
+
+		CachedVertexTree(TDomain& dom, const ISubsetHandler* sh, const SubsetGroup& ssGrp)
+			: CachedTreeObserver(*dom.grid(), sh, ssGrp),
+			  m_pMG(dom.grid().get()),
+			  m_tree(*dom.grid(), dom.position_attachment())
+		{}
+
+	///	returns the tree, recreated if the grid has changed
+		const tree_t& tree(typename TDomain::subset_handler_type& sh)
+		{
+			if(!changed()) return m_tree;
+
+			typedef typename TDomain::subset_handler_type subset_handler_type;
+			typename subset_handler_type::template traits<Vertex>::const_iterator iterEnd, iter;
+			std::vector<Vertex*> vVrt;
+
+			#ifdef UG_PARALLEL
+				DistributedGridManager* dgm = m_pMG->distributed_grid_manager();
+			#endif
+
+			for(size_t i = 0; i < m_vSubset.size(); ++i)
+			{
+			//	get subset index
+				const int si = m_vSubset[i];
+			// 	iterate over all elements
+				for(size_t lvl = 0; lvl < sh.num_levels(); ++lvl){
+					iterEnd = sh.template end<Vertex>(si, lvl);
+					iter = sh.template begin<Vertex>(si, lvl);
+					for(; iter != iterEnd; ++iter)
+					{
+						Vertex* vrt = *iter;
+						if(m_pMG->has_children(vrt)) continue;
+
+						#ifdef UG_PARALLEL
+							if(dgm->is_ghost(vrt))	continue;
+							if(dgm->contains_status(vrt, INT_H_SLAVE)) continue;
+						#endif
+
+						vVrt.push_back(vrt);
+					}
+				}
+			}
+
+			m_tree.create_tree(vVrt.begin(), vVrt.end());
+			return m_tree;
+		}
+
+	protected:
+		typename TDomain::grid_type*	m_pMG;
+		tree_t							m_tree;
+};
+
+///	cached point locator of the surface vertices of a grid function
+/**	The grid function is only referenced during a query.*/
+template <typename TGridFunction>
+class CachedPointLocator : public CachedTreeObserver,
+						   public GridFunctionPointLocator<TGridFunction>
+{
+	public:
+		typedef GridFunctionPointLocator<TGridFunction> locator_t;
+
+		CachedPointLocator(SmartPtr<TGridFunction> spGridFct, const ISubsetHandler* sh,
+						   const SubsetGroup& ssGrp)
+			: CachedTreeObserver(*spGridFct->domain()->grid(), sh, ssGrp),
+			  locator_t(spGridFct, ssGrp)
+		{
+			this->m_spGridFct = SPNULL;
+		}
+
+	///	returns the closest vertex carrying dofs of the function
+		Vertex* closest_vertex(SmartPtr<TGridFunction> spGridFct, const MathVector<TGridFunction::dim>& x,
+							   size_t fct, number& distSqOut)
+		{
+			if(changed()) this->rebuild();
+			this->m_spGridFct = spGridFct;
+			Vertex* vrt = locator_t::closest_vertex(x, fct, &distSqOut);
+			this->m_spGridFct = SPNULL;
+			return vrt;
+		}
+};
+
 template <typename TDomain>
 bool CloseVertexExists(const MathVector<TDomain::dim>& globPos,
 					   TDomain* dom,
@@ -789,61 +947,40 @@ bool CloseVertexExists(const MathVector<TDomain::dim>& globPos,
 					   SmartPtr<typename TDomain::subset_handler_type> sh,
 					   number maxDist)
 {
-//	domain type
-	typedef TDomain domain_type;
-	typedef typename domain_type::grid_type grid_type;
-	typedef typename domain_type::subset_handler_type subset_handler_type;
-// get position accessor
-	grid_type* grid = dom->grid().get();
-
-	const typename domain_type::position_accessor_type& aaPos
-										= dom->position_accessor();
-
-	typename subset_handler_type::template traits<Vertex>::const_iterator iterEnd, iter;
-	number minDistanceSq = numeric_limits<number>::max();
-
-	#ifdef UG_PARALLEL
-		DistributedGridManager* dgm = grid->distributed_grid_manager();
-	#endif
-
 	SubsetGroup ssGrp(sh);
 	if(subsets != NULL)
 		ssGrp.add(TokenizeString(subsets));
 	else
 		ssGrp.add_all();
 
-	for(size_t i = 0; i < ssGrp.size(); ++i)
-	{
-	//	get subset index
-		const int si = ssGrp[i];
-	// 	iterate over all elements
-		for(size_t lvl = 0; lvl < sh->num_levels(); ++lvl){
-			iterEnd = sh->template end<Vertex>(si, lvl);
-			iter = sh->template begin<Vertex>(si, lvl);
-			for(; iter != iterEnd; ++iter)
-			{
-			//	get element
-			//todo: replace most of the following checks by a spGridFct->contains(...)
-
-				Vertex* vrt = *iter;
-				if(grid->has_children(vrt)) continue;
-
-				#ifdef UG_PARALLEL
-					if(dgm->is_ghost(vrt))	continue;
-					if(dgm->contains_status(vrt, INT_H_SLAVE)) continue;
-				#endif
-			//	global position
-				number buffer = VecDistanceSq(globPos, aaPos[vrt]);
-				if(buffer < minDistanceSq)
-				{
-					minDistanceSq = buffer;
-				}
-			}
-		}
-	}
+	CachedVertexTree<TDomain>& entry
+		= CachedEntry<CachedVertexTree<TDomain> >(*dom, dom->grid().get(), sh.get(), ssGrp);
+
+	Vertex* vrt = NULL;
+	number minDistanceSq = numeric_limits<number>::max();
+	if(!FindClosestElement(vrt, minDistanceSq, entry.tree(*sh), globPos))
+		return false;
+
 	return 	minDistanceSq < sq(maxDist);
 }
 
+///	accepts vertices in subsets in which a function is defined
+template <typename TGridFunction>
+struct FunctionDefinedOnVertex
+{
+	FunctionDefinedOnVertex(const TGridFunction& gridFct, size_t fct) :
+		m_pGridFct(&gridFct), m_fct(fct)	{}
+
+	bool operator()(Vertex* vrt) const
+	{
+		return m_pGridFct->is_def_in_subset
+				(m_fct, m_pGridFct->domain()->subset_handler()->get_subset_index(vrt));
+	}
+
+	const TGridFunction*	m_pGridFct;
+	size_t					m_fct;
+};
+
 /**
  * \defgroup interpolate_bridge Interpolation Bridge
  * \ingroup disc_bridge
@@ -858,65 +995,28 @@ number EvaluateAtVertex(const MathVector<TGridFunction::dim>& globPos,
 						typename TGridFunction::domain_type::subset_handler_type* sh,
 						bool minimizeOverAllProcs = false)
 {
-
 //	domain type
 	typedef typename TGridFunction::domain_type domain_type;
-	typedef typename domain_type::grid_type grid_type;
-	typedef typename domain_type::subset_handler_type subset_handler_type;
-// get position accessor
 	domain_type* dom = spGridFct->domain().get();
-	grid_type* grid = dom->grid().get();
-
-	subset_handler_type* domSH = dom->subset_handler().get();
-
-	const typename domain_type::position_accessor_type& aaPos
-										= dom->position_accessor();
+	Grid* grid = dom->grid().get();
 
 	std::vector<DoFIndex> ind;
 	Vertex* chosen = NULL;
-
-	typename subset_handler_type::template traits<Vertex>::const_iterator iterEnd, iter;
 	number minDistanceSq = std::numeric_limits<double>::max();
 
-	#ifdef UG_PARALLEL
-		DistributedGridManager* dgm = grid->distributed_grid_manager();
-	#endif
-
-	for(size_t i = 0; i < ssGrp.size(); ++i)
-	{
-	//	get subset index
-		const int si = ssGrp[i];
-
-	// 	iterate over all elements
-		for(size_t lvl = 0; lvl < sh->num_levels(); ++lvl){
-			iterEnd = sh->template end<Vertex>(si, lvl);
-			iter = sh->template begin<Vertex>(si, lvl);
-			for(; iter != iterEnd; ++iter)
-			{
-			//	get element
-			//todo: replace most of the following checks by a spGridFct->contains(...)
-				Vertex* vrt = *iter;
-				if(grid->has_children(vrt)) continue;
-
-				#ifdef UG_PARALLEL
-					if(dgm->is_ghost(vrt))	continue;
-					if(dgm->contains_status(vrt, INT_H_SLAVE)) continue;
-				#endif
-
-				int domSI = domSH->get_subset_index(vrt);
-
-			//	skip if function is not defined in subset
-				if(!spGridFct->is_def_in_subset(fct, domSI)) continue;
-
-			//	global position
-				number buffer = VecDistanceSq(globPos, aaPos[vrt]);
-				if(buffer < minDistanceSq)
-				{
-					minDistanceSq = buffer;
-					chosen = *iter;
-				}
-			}
-		}
+//	subsets of the domain: surface vertices of the grid function, otherwise
+//	the vertices without children in the subsets of the passed handler
+	if(sh == dom->subset_handler().get()){
+		CachedPointLocator<TGridFunction>& locator
+			= CachedEntry<CachedPointLocator<TGridFunction> >(spGridFct, grid, sh, ssGrp);
+		chosen = locator.closest_vertex(spGridFct, globPos, fct, minDistanceSq);
+	}
+	else{
+		CachedVertexTree<domain_type>& entry
+			= CachedEntry<CachedVertexTree<domain_type> >(*dom, grid, sh, ssGrp);
+		if(!FindClosestElement(chosen, minDistanceSq, entry.tree(*sh), globPos,
+							   FunctionDefinedOnVertex<TGridFunction>(*spGridFct, fct)))
+			chosen = NULL;
 	}
 
 	// get corresponding value (if vertex found, otherwise take 0)
@@ -926,6 +1026,8 @@ number EvaluateAtVertex(const MathVector<TGridFunction::dim>& globPos,
 		spGridFct->inner_dof_indices(chosen, fct, ind);
 		value = DoFRef(*spGridFct, ind[0]);
 	}
+	else
+		minDistanceSq = std::numeric_limits<double>::max();
 
 	// in parallel environment, find global minimal distance and corresponding value
 #ifdef UG_PARALLEL
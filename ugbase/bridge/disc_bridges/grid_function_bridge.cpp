@@ -47,6 +47,7 @@
 #include "lib_disc/function_spaces/grid_function_user_data.h"
 #include "lib_disc/function_spaces/dof_position_util.h"
 #include "lib_disc/function_spaces/grid_function_global_user_data.h"
+#include "lib_disc/function_spaces/grid_function_point_locator.h"
 #include "lib_disc/function_spaces/grid_function_user_data_explicit.h"
 #include "lib_disc/function_spaces/grid_function_coordinate_util.h"
 #include "lib_disc/function_spaces/metric_spaces.h"
@@ -190,6 +191,24 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GridFunctionGradientComponentData", tag);
 	}
+//	GridFunctionPointLocator
+	{
+		string name = string("GridFunctionPointLocator").append(suffix);
+		typedef GridFunctionPointLocator<TFct> T;
+		reg.add_class_<T>(name, grp)
+			.template add_constructor<void (*)(SmartPtr<TFct>)>("GridFunction")
+			.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Subsets")
+			.add_method("set_grid_function", &T::set_grid_function, "", "GridFunction")
+			.add_method("rebuild", &T::rebuild)
+			.add_method("evaluate", &T::evaluate_lua, "Values", "Coordinates#Component")
+			.add_method("evaluate_global", &T::evaluate_global_lua, "Values", "Coordinates#Component")
+			.add_method("evaluate_at_closest_vertex", &T::evaluate_at_closest_vertex_lua, "Values", "Coordinates#Component")
+			.add_method("evaluate_at_closest_vertex_global", &T::evaluate_at_closest_vertex_global_lua, "Values", "Coordinates#Component")
+			.add_method("closest_vertex_distances", &T::closest_vertex_distances, "Distances", "Coordinates#Component")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "GridFunctionPointLocator", tag);
+	}
+
 //	GlobalGridFunctionNumberData
 	{
 		string name = string("GlobalGridFunctionNumberData").append(suffix);
@@ -197,6 +216,7 @@ static void DomainAlgebra(Registry& reg, string grp)
 		typedef CplUserData<number, dim> TBase;
 		reg.add_class_<T, TBase>(name, grp)
 			.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Component")
+			.template add_constructor<void (*)(SmartPtr<TFct>, const char*, SmartPtr<GridFunctionPointLocator<TFct> >)>("GridFunction#Component#Locator")
 			.add_method("evaluate", static_cast<number (T::*)(const MathVector<dim>&) const>(&T::evaluate))
 			.add_method("evaluate_global", static_cast<number (T::*)(std::vector<number>)>(&T::evaluate_global))
 			.set_construct_as_smart_pointer(true);
@@ -225,6 +245,7 @@ static void DomainAlgebra(Registry& reg, string grp)
 		typedef CplUserData<MathVector<dim>, dim> TBase;
 		reg.add_class_<T, TBase>(name, grp)
 			.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Component")
+			.template add_constructor<void (*)(SmartPtr<TFct>, const char*, SmartPtr<GridFunctionPointLocator<TFct> >)>("GridFunction#Component#Locator")
 			.add_method("evaluate_global", static_cast<std::vector<number> (T::*)(std::vector<number>)>(&T::evaluate_global))
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GlobalGridFunctionGradientData", tag);
@@ -602,6 +623,12 @@ static void Common(Registry& reg, string grp)
 		.add_method("init_levels", &T::init_levels)
 		.add_method("init_surfaces", &T::init_surfaces)
 		.add_method("init_top_surface", &T::init_top_surface)
+		.add_method("enable_elem_index_tables", &T::enable_elem_index_tables, "", "bEnable", "stores the element DoF indices in flat tables")
+		.add_method("elem_index_tables_enabled", &T::elem_index_tables_enabled)
+		.add_method("check_elem_index_tables", &T::check_elem_index_tables, "valid", "", "compares the element index tables with the indices in the grid")
+		.add_method("enable_incremental_reinit", &T::enable_incremental_reinit, "", "bEnable", "keeps the indices of unchanged objects on grid adaption")
+		.add_method("incremental_reinit_enabled", &T::incremental_reinit_enabled)
+		.add_method("set_defragmentation_threshold", &T::set_defragmentation_threshold, "", "threshold", "fraction of displaced indices triggering a renumbering")
 
 		.add_method("clear", &T::clear)
 		.add_method("add_fct", static_cast<void (T::*)(const char*, const char*, int, const char*)>(&T::add),
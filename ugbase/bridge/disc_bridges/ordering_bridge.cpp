@@ -107,6 +107,18 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "LexOrdering", tag);
 	}
 
+//	Space filling curve ordering
+	{
+		typedef SpaceFillingCurveOrdering<TAlgebra, TDomain, ordering_container_type> T;
+		typedef IOrderingAlgorithm<TAlgebra, ordering_container_type> TBase;
+		string name = string("SpaceFillingCurveOrdering").append(suffix);
+		reg.add_class_<T, TBase>(name, grp, "SpaceFillingCurveOrdering")
+			.add_constructor()
+			.add_method("set_curve", &T::set_curve, "", "hilbert | morton")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "SpaceFillingCurveOrdering", tag);
+	}
+
 //	River ordering (topological ordering beginning at selected sources)
 	{
 		typedef RiverOrdering<TAlgebra, TDomain, ordering_container_type> T;
@@ -198,6 +210,11 @@ static void Domain(Registry& reg, string grp)
 	{
 		reg.add_function("OrderLex", static_cast<void (*)(approximation_space_type&, const char*)>(&OrderLex<TDomain>), grp);
 	}
+//	Order along a space filling curve
+	{
+		reg.add_function("OrderSpaceFillingCurve", &OrderSpaceFillingCurve<TDomain>, grp,
+						 "", "approxSpace#curve", "orders the DoFs along a 'hilbert' or 'morton' curve");
+	}
 //	Order in downwind direction
 	{
 		reg.add_function("OrderDownwind", static_cast<void (*)(approximation_space_type&, SmartPtr<UserData<MathVector<TDomain::dim>, TDomain::dim> >)> (&ug::OrderDownwind<TDomain>), grp);
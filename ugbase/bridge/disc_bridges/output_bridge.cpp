@@ -290,6 +290,11 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("set_write_grid", static_cast<void (T::*)(bool)>(&T::set_write_grid))
 			.add_method("set_write_subset_indices", static_cast<void (T::*)(bool)>(&T::set_write_subset_indices))
 			.add_method("set_write_proc_ranks", static_cast<void (T::*)(bool)>(&T::set_write_proc_ranks))
+			.add_method("set_appended", &T::set_appended, "", "bAppended", "should binary data be appended raw instead of inline base64")
+			.add_method("set_compressed", &T::set_compressed, "", "bCompressed", "should appended binary data be compressed by zlib")
+			.add_method("set_io_group_size", &T::set_io_group_size, "", "groupSize", "number of processes writing one file (1: one per process, 0: one per node)")
+			.add_method("set_cache_grid", &T::set_cache_grid, "", "bCache", "should the unchanged grid be reused between outputs (appended modes)")
+			.add_method("set_xdmf_time_series", &T::set_xdmf_time_series, "", "bXDMF", "should time series be written as xdmf with the grid written only once")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "VTKOutput", tag);
 	}
@@ -53,6 +53,7 @@
 #include "lib_grid/algorithms/grid_statistics.h"
 
 #include "lib_grid/algorithms/subset_util.h"
+#include "lib_grid/algorithms/space_filling_curve_util.h"
 
 #ifdef UG_PARALLEL
 	#include "lib_disc/parallelization/domain_load_balancer.h"
@@ -81,6 +82,13 @@ static void MinimizeMemoryFootprint(TDomain& dom)
 							 | GRIDOPT_AUTOGENERATE_SIDES);
 }
 
+template <typename TDomain>
+static size_t SortDomainAlongSpaceFillingCurve(TDomain& dom, const char* type)
+{
+	return SortGridObjectsAlongSpaceFillingCurve(*dom.grid(), dom.position_accessor(),
+												 SpaceFillingCurveTypeFromString(type));
+}
+
 template <typename TDomain>
 static void LoadAndRefineDomain(TDomain& domain, const char* filename,
 								int numRefs)
@@ -466,6 +474,18 @@ static void Domain(Registry& reg, string grp)
 					"", "Domain # Filename|save-dialog| endings=[\"ugx\"]",
 					"Saves a domain", "No help");
 
+#ifdef UG_PARALLEL
+//	SavePartitionedDomain
+	reg.add_function("SavePartitionedDomain", &SavePartitionedDomain<TDomain>, grp,
+					"", "Domain # Filename|save-dialog",
+					"Saves the local parts of a distributed domain to one combined file", "No help");
+//	LoadPartitionedDomain
+	reg.add_function("LoadPartitionedDomain", &LoadPartitionedDomain<TDomain>, grp,
+					"", "Domain # Filename|load-dialog",
+					"Loads a distributed domain where each process reads its own part. "
+					"Requires the number of processes used for saving.", "No help");
+#endif
+
 //	SavePartitionMap
 	reg.add_function("SavePartitionMap", &SavePartitionMap<TDomain>, grp,
 					"Success", "PartitionMap # Domain # Filename|save-dialog",
@@ -515,6 +535,8 @@ static void Domain(Registry& reg, string grp)
 	reg.add_function("TestDomainInterfaces", static_cast<bool (*)(TDomain*, bool)>(&TestDomainInterfaces<TDomain>), grp);
 
 	reg.add_function("MinimizeMemoryFootprint", &MinimizeMemoryFootprint<TDomain>, grp);
+	reg.add_function("SortDomainAlongSpaceFillingCurve", &SortDomainAlongSpaceFillingCurve<TDomain>, grp,
+					 "numRelocated", "dom#curve", "reorders the grid objects along a 'hilbert' or 'morton' curve. Call before creating approximation spaces.");
 }
 
 /**
@@ -37,6 +37,10 @@
 #include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/grid_debug.h"
+#include "lib_grid/grid/grid_object_pool.h"
+#include "lib_grid/algorithms/compaction_util.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include "common/stopwatch.h"
 
 using namespace std;
 
@@ -95,6 +99,78 @@ bool TestNTree(const char* filename)
 	return true;
 }
 
+///	refines a hexahedron and measures refinement, iteration and destruction
+/**	The benchmark is performed with the global operator new, with pool
+ * allocation and with pool allocation followed by CompactGridObjectStorage.*/
+void TestGridObjectPool(int numRefs, int numIterations)
+{
+	PROFILE_FUNC_GROUP("grid");
+	const bool poolWasEnabled = GridObjectPool::enabled();
+	const char* modeNames[] = {"operator new", "pool", "pool + compaction"};
+
+	for(int mode = 0; mode < 3; ++mode){
+		GridObjectPool::enable(mode > 0);
+
+		MultiGrid* mg = new MultiGrid(GRIDOPT_STANDARD_INTERCONNECTION);
+		mg->attach_to_vertices(aPosition);
+		Grid::VertexAttachmentAccessor<APosition> aaPos(*mg, aPosition);
+
+		Vertex* vrts[8];
+		for(int i = 0; i < 8; ++i){
+			vrts[i] = *mg->create<RegularVertex>();
+			aaPos[vrts[i]] = vector3((i & 1) ^ ((i >> 1) & 1), (i >> 1) & 1, (i >> 2) & 1);
+		}
+		mg->create<Hexahedron>(HexahedronDescriptor(vrts[0], vrts[1], vrts[2], vrts[3],
+													vrts[4], vrts[5], vrts[6], vrts[7]));
+
+		double tStart = get_clock_s();
+		{
+			GlobalMultiGridRefiner ref(*mg);
+			for(int i = 0; i < numRefs; ++i)
+				ref.refine();
+		}
+		const double tRefine = get_clock_s() - tStart;
+
+		tStart = get_clock_s();
+		if(mode == 2)
+			CompactGridObjectStorage(*mg);
+		const double tCompact = get_clock_s() - tStart;
+
+	//	sum up the corner coordinates of all volumes on the top level
+		const int topLvl = (int)mg->top_level();
+		number sum = 0;
+		tStart = get_clock_s();
+		for(int i = 0; i < numIterations; ++i){
+			for(VolumeIterator iter = mg->begin<Volume>(topLvl);
+				iter != mg->end<Volume>(topLvl); ++iter)
+			{
+				Volume::ConstVertexArray vrt = (*iter)->vertices();
+				const size_t numVrts = (*iter)->num_vertices();
+				for(size_t j = 0; j < numVrts; ++j)
+					sum += aaPos[vrt[j]].x();
+			}
+		}
+		const double tIterate = get_clock_s() - tStart;
+		const size_t numVols = mg->num<Volume>(topLvl);
+
+		tStart = get_clock_s();
+		delete mg;
+		const double tDestroy = get_clock_s() - tStart;
+
+		UG_LOG(modeNames[mode] << ": " << numVols << " volumes on top level, refine "
+			   << tRefine << " s, compact " << tCompact << " s, iterate "
+			   << tIterate << " s, destroy " << tDestroy << " s (checksum "
+			   << sum << ")\n");
+	}
+
+	GridObjectPool::enable(poolWasEnabled);
+}
+
+void EnableGridObjectPool(bool bEnable)
+{
+	GridObjectPool::enable(bEnable);
+}
+
 void RegisterGridBridge_Misc(Registry& reg, string parentGroup)
 {
 	string grp = parentGroup;
@@ -103,6 +179,13 @@ void RegisterGridBridge_Misc(Registry& reg, string parentGroup)
 		.add_function("PrintAttachmentInfo", &PrintAttachmentInfo, grp);
 	
 	reg.add_function("TestNTree", &TestNTree, grp);
+	reg.add_function("TestGridObjectPool", &TestGridObjectPool, grp,
+					 "", "numRefinements#numIterations");
+
+	reg.add_function("EnableGridObjectPool", &EnableGridObjectPool, grp,
+					 "", "enable", "Allocates newly created grid objects from pools")
+		.add_function("CompactGridObjectStorage", &CompactGridObjectStorage, grp,
+					 "numRelocated", "grid", "Reallocates the grid objects in their iteration order");
 	
 	reg.add_function("CreateGridGlobalDebugInfoProvider", static_cast<void (*) (Grid&,ISubsetHandler&)>(&grid_global_debug_info_provider::create), grp);
 }
@@ -277,6 +277,12 @@ bool IsDefinedUG_JSON() { return true; }
 bool IsDefinedUG_JSON() { return false; }
 #endif
 
+#ifdef UG_OPENMP
+bool IsDefinedUG_OPENMP() { return true; }
+#else
+bool IsDefinedUG_OPENMP() { return false; }
+#endif
+
 /// prints CMake build parameters in a quite compact (pairwise) form
 void PrintBuildConfiguration()
 {
@@ -540,6 +546,7 @@ void RegisterBridge_Misc(Registry &reg, string parentGroup)
 		ADD_DEFINED_FUNC(UG_HYPRE);
 		ADD_DEFINED_FUNC(UG_HLIBPRO);
 		ADD_DEFINED_FUNC(UG_JSON);
+		ADD_DEFINED_FUNC(UG_OPENMP);
 
 		reg.add_function("PrintBuildConfiguration", &PrintBuildConfiguration, grp, "");
 		reg.add_function("PrintBuildConfigurationExtended", &PrintBuildConfigurationExtended, grp, "");
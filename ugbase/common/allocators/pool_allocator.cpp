@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <cassert>
+#include "pool_allocator.h"
+
+namespace ug{
+
+PoolAllocator::
+PoolAllocator(std::size_t blockSize, std::size_t numBlocksPerChunk) :
+	m_blockSize(blockSize),
+	m_numBlocksPerChunk(numBlocksPerChunk),
+	m_numUsedBlocks(0),
+	m_bSequential(false),
+	m_seqChunk(NULL)
+{
+	assert(blockSize >= sizeof(void*));
+	assert(numBlocksPerChunk > 0);
+}
+
+PoolAllocator::
+~PoolAllocator()
+{
+	for(ChunkMap::iterator iter = m_chunks.begin(); iter != m_chunks.end(); ++iter){
+		delete[] iter->second->m_pData;
+		delete iter->second;
+	}
+}
+
+PoolAllocator::Chunk* PoolAllocator::
+new_chunk()
+{
+	Chunk* chunk = new Chunk;
+	chunk->m_pData = new unsigned char[m_blockSize * m_numBlocksPerChunk];
+	chunk->m_numTouched = 0;
+	chunk->m_numUsed = 0;
+	chunk->m_pFree = NULL;
+	m_chunks[chunk->m_pData] = chunk;
+	m_freeChunks.insert(chunk);
+	return chunk;
+}
+
+void PoolAllocator::
+release_chunk(Chunk* chunk)
+{
+	assert(chunk->m_numUsed == 0);
+	if(chunk == m_seqChunk)
+		m_seqChunk = NULL;
+	m_freeChunks.erase(chunk);
+	m_chunks.erase(chunk->m_pData);
+	delete[] chunk->m_pData;
+	delete chunk;
+}
+
+PoolAllocator::Chunk* PoolAllocator::
+find_chunk(const void* p) const
+{
+	const unsigned char* pc = static_cast<const unsigned char*>(p);
+//	the owning chunk is the last one which starts at or before p
+	ChunkMap::const_iterator iter = m_chunks.upper_bound(pc);
+	if(iter == m_chunks.begin())
+		return NULL;
+	--iter;
+	if(pc >= iter->first + m_blockSize * m_numBlocksPerChunk)
+		return NULL;
+	return iter->second;
+}
+
+void* PoolAllocator::
+allocate_from(Chunk* chunk)
+{
+	void* p;
+	if(chunk->m_pFree){
+		p = chunk->m_pFree;
+		chunk->m_pFree = *static_cast<void**>(p);
+	}
+	else{
+		assert(chunk->m_numTouched < m_numBlocksPerChunk);
+		p = chunk->m_pData + chunk->m_numTouched * m_blockSize;
+		++chunk->m_numTouched;
+	}
+
+	++chunk->m_numUsed;
+	++m_numUsedBlocks;
+	if(chunk->m_numUsed == m_numBlocksPerChunk)
+		m_freeChunks.erase(chunk);
+	return p;
+}
+
+void* PoolAllocator::
+allocate()
+{
+	if(m_bSequential){
+	//	only untouched blocks of the current chunk are used, so that the
+	//	blocks are handed out in increasing address order
+		if(!m_seqChunk || m_seqChunk->m_numTouched == m_numBlocksPerChunk)
+			m_seqChunk = new_chunk();
+
+		void* p = m_seqChunk->m_pData + m_seqChunk->m_numTouched * m_blockSize;
+		++m_seqChunk->m_numTouched;
+		++m_seqChunk->m_numUsed;
+		++m_numUsedBlocks;
+		if(m_seqChunk->m_numUsed == m_numBlocksPerChunk)
+			m_freeChunks.erase(m_seqChunk);
+		return p;
+	}
+
+	if(m_freeChunks.empty())
+		new_chunk();
+
+	return allocate_from(*m_freeChunks.begin());
+}
+
+void PoolAllocator::
+deallocate(void* p)
+{
+	Chunk* chunk = find_chunk(p);
+	assert(chunk && "Pointer was not allocated by this PoolAllocator.");
+	assert((static_cast<unsigned char*>(p) - chunk->m_pData) % m_blockSize == 0);
+
+	if(chunk->m_numUsed == m_numBlocksPerChunk)
+		m_freeChunks.insert(chunk);
+
+	*static_cast<void**>(p) = chunk->m_pFree;
+	chunk->m_pFree = p;
+	--chunk->m_numUsed;
+	--m_numUsedBlocks;
+
+	if(chunk->m_numUsed == 0)
+		release_chunk(chunk);
+}
+
+bool PoolAllocator::
+owns(const void* p) const
+{
+	return find_chunk(p) != NULL;
+}
+
+void PoolAllocator::
+set_sequential(bool bSequential)
+{
+	m_bSequential = bSequential;
+	m_seqChunk = NULL;
+}
+
+}//	end of namespace
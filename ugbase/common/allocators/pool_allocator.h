@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__COMMON__POOL_ALLOCATOR__
+#define __H__UG__COMMON__POOL_ALLOCATOR__
+
+#include <cstddef>
+#include <map>
+#include <set>
+
+namespace ug{
+
+///	Allocates blocks of a fixed size from large contiguous chunks.
+/**	In contrast to the FixedAllocator in small_object_allocator.h, the number
+ * of blocks per chunk is not limited to 255 and the chunk which owns a block
+ * is found in logarithmic time. This makes the allocator suitable for
+ * millions of objects of the same size.
+ *
+ * Free blocks are always taken from the chunk with the lowest address which
+ * still has free blocks. Chunks which no longer contain any used blocks
+ * are released immediately.
+ *
+ * In sequential mode all blocks are taken from freshly allocated chunks in
+ * increasing address order, i.e. consecutively allocated objects are stored
+ * consecutively in memory. This is used to compact a set of objects by
+ * reallocating them in their iteration order.
+ *
+ * The allocator is not thread safe: allocate and deallocate modify the free
+ * lists and the chunk map without any locking. Concurrent access has to be
+ * synchronized by the caller.
+ */
+class PoolAllocator
+{
+	public:
+	///	blockSize has to be a multiple of the required alignment.
+		PoolAllocator(std::size_t blockSize, std::size_t numBlocksPerChunk);
+		~PoolAllocator();
+
+		void* allocate();
+
+	///	p has to be allocated by this instance (see owns).
+		void deallocate(void* p);
+
+	///	returns true if p lies in one of the chunks of this allocator
+		bool owns(const void* p) const;
+
+	///	enables or disables sequential mode
+		void set_sequential(bool bSequential);
+		bool sequential() const		{return m_bSequential;}
+
+		std::size_t block_size() const			{return m_blockSize;}
+		std::size_t num_blocks_per_chunk() const	{return m_numBlocksPerChunk;}
+		std::size_t num_chunks() const			{return m_chunks.size();}
+		std::size_t num_used_blocks() const		{return m_numUsedBlocks;}
+
+	private:
+		struct Chunk
+		{
+			unsigned char* m_pData;
+		///	number of blocks which have ever been handed out from this chunk
+			std::size_t m_numTouched;
+		///	number of blocks currently in use
+			std::size_t m_numUsed;
+		///	singly linked list of released blocks
+			void* m_pFree;
+		};
+
+		struct CompareChunks
+		{
+			bool operator()(const Chunk* c1, const Chunk* c2) const
+			{return c1->m_pData < c2->m_pData;}
+		};
+
+		typedef std::map<const unsigned char*, Chunk*> ChunkMap;
+		typedef std::set<Chunk*, CompareChunks> ChunkSet;
+
+	private:
+		Chunk* new_chunk();
+		void release_chunk(Chunk* chunk);
+		Chunk* find_chunk(const void* p) const;
+		void* allocate_from(Chunk* chunk);
+
+	private:
+	///	not copyable
+		PoolAllocator(const PoolAllocator&);
+		PoolAllocator& operator=(const PoolAllocator&);
+
+	private:
+		std::size_t m_blockSize;
+		std::size_t m_numBlocksPerChunk;
+		std::size_t m_numUsedBlocks;
+
+	///	all chunks sorted by their start address
+		ChunkMap m_chunks;
+	///	chunks which have free blocks left
+		ChunkSet m_freeChunks;
+
+		bool m_bSequential;
+	///	chunk from which blocks are taken in sequential mode
+		Chunk* m_seqChunk;
+};
+
+}//	end of namespace
+
+#endif
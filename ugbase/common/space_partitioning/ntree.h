@@ -42,6 +42,7 @@ namespace ug{
  * void VecSet(vector_t& vOut, real_t value);	// sets all components of 'v' to 'value'.
  * void VecAdd(vector_t& vOut, const vector_t& v1, const vector_t& v2); // performs vOut = v1 + v2.
  * void VecScale(vector_t& vOut, const vector_t& v, real_t s); // performs vOut = s * v.
+ * real_t VecDistanceSq(const vector_t& v1, const vector_t& v2); // only required by FindClosestElement.
  * \endcode
  */
 template <int tree_dim, int world_dim, class elem_t, class common_data_t>
@@ -65,6 +66,10 @@ struct ntree_traits
 
 	static bool box_contains_point(const box_t& box, const vector_t& point);
 
+///	returns the squared distance of the given point to the box (0 if the point lies inside).
+/**	only required for Traverser_FindClosestElement.*/
+	static real_t box_point_distance_sq(const box_t& box, const vector_t& point);
+
 ///	returns true if the given boxes intersect
 	static bool box_box_intersection(const box_t& box1, const box_t& box2);
 
@@ -283,6 +283,117 @@ bool FindElementsInIntersectingNodes(std::vector<typename tree_t::elem_t>& elems
 }
 
 
+///	predicate which accepts all elements. Default for FindClosestElement.
+template <class elem_t>
+struct AcceptAllElements
+{
+	bool operator()(const elem_t&) const	{return true;}
+};
+
+///	finds the element whose center is closest to a given point.
+/**	Only elements for which the given predicate returns true are considered.
+ * Nodes whose bounding box is farther away than the best candidate found so far
+ * are skipped, so that the query on average only visits a few leafs.
+ * The traits of the tree have to provide box_point_distance_sq.*/
+template <class tree_t, class TPredicate = AcceptAllElements<typename tree_t::elem_t> >
+class Traverser_FindClosestElement
+{
+	public:
+		typedef typename tree_t::elem_t		elem_t;
+		typedef typename tree_t::vector_t	vector_t;
+		typedef typename tree_t::real_t		real_t;
+
+		Traverser_FindClosestElement(const vector_t& point,
+									 const TPredicate& pred = TPredicate()) :
+			m_point(point),
+			m_pred(pred),
+			m_minDistSq(0),
+			m_foundElem(false)
+		{}
+
+		void begin_traversal(const tree_t& tree)
+		{
+			m_foundElem = false;
+			m_minDistSq = 0;
+		}
+
+		int visit_up(const tree_t& tree, size_t node)
+		{
+			if(m_foundElem
+			   && tree_t::traits::box_point_distance_sq(tree.bounding_box(node), m_point)
+			   	  >= m_minDistSq)
+			{
+				return DONT_TRAVERSE_CHILDREN;
+			}
+
+			if(tree.num_child_nodes(node) == 0){
+				for(typename tree_t::elem_iterator_t iter = tree.elems_begin(node);
+					iter != tree.elems_end(node); ++iter)
+				{
+					if(!m_pred(*iter))
+						continue;
+
+					vector_t center;
+					tree_t::traits::calculate_center(center, *iter, tree.common_data());
+					real_t distSq = VecDistanceSq(center, m_point);
+					if(!m_foundElem || distSq < m_minDistSq){
+						m_foundElem = true;
+						m_minDistSq = distSq;
+						m_elem = *iter;
+					}
+				}
+			}
+			return TRAVERSE_CHILDREN;
+		}
+
+		void visit_down(const tree_t&, size_t)	{}
+
+		void end_traversal(const tree_t&)	{}
+
+		bool result(elem_t& foundElemOut, real_t& distSqOut) const
+		{
+			if(m_foundElem){
+				foundElemOut = m_elem;
+				distSqOut = m_minDistSq;
+			}
+			return m_foundElem;
+		}
+
+	private:
+		vector_t	m_point;
+		TPredicate	m_pred;
+		elem_t		m_elem;
+		real_t		m_minDistSq;
+		bool		m_foundElem;
+};
+
+///	finds the element whose center is closest to the given point
+/**	Returns false if the tree does not contain any element accepted by pred.
+ * On success, distSqOut contains the squared distance of the center of elemOut
+ * to the given point.*/
+template <class tree_t, class TPredicate>
+bool FindClosestElement(typename tree_t::elem_t& elemOut,
+						typename tree_t::real_t& distSqOut,
+						const tree_t& tree,
+						const typename tree_t::vector_t& point,
+						const TPredicate& pred)
+{
+	Traverser_FindClosestElement<tree_t, TPredicate> trav(point, pred);
+	TraverseDepthFirst(tree, trav);
+	return trav.result(elemOut, distSqOut);
+}
+
+template <class tree_t>
+bool FindClosestElement(typename tree_t::elem_t& elemOut,
+						typename tree_t::real_t& distSqOut,
+						const tree_t& tree,
+						const typename tree_t::vector_t& point)
+{
+	return FindClosestElement(elemOut, distSqOut, tree, point,
+							  AcceptAllElements<typename tree_t::elem_t>());
+}
+
+
 
 // template <class TVector, class TData>
 // class TraceRecorder {
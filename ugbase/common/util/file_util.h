@@ -242,6 +242,43 @@ std::string FindDirInStandardPaths(const char* dirname);
  */
 std::string CurrentWorkingDirectory();
 
+////////////////////////////////////////////////////////////////////////////////
+///	Read-only view on the contents of a file.
+/**	On POSIX systems the file is mapped into memory through mmap, so that its
+ * pages are only loaded on first access and no intermediate copy is created.
+ * On other systems the file is read into an internal buffer.
+ *
+ * The returned data stays valid until close() is called or the MappedFile
+ * is destroyed.
+ *
+ * \note The implementation relies on OS specific instructions.
+ *       Implementations for POSIX-UNIX and Windows are available.
+ */
+class UG_API MappedFile
+{
+	public:
+		MappedFile();
+		~MappedFile();
+
+	///	maps the given file. Returns false if the file could not be opened.
+		bool open(const char* filename);
+
+	///	releases the mapping. Called automatically on destruction.
+		void close();
+
+		bool is_open() const			{return m_data != NULL;}
+		const char* data() const		{return m_data;}
+		size_t size() const				{return m_size;}
+
+	private:
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+
+		const char*			m_data;
+		size_t				m_size;
+		std::vector<char>	m_buffer;
+};
+
 // end group ugbase_common_io
 /// \}
 
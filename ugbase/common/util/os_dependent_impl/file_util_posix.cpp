@@ -35,6 +35,8 @@
 #include <limits.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include "common/util/file_util.h"
 #include "common/profiler/profiler.h"
 #include "common/error.h"
@@ -177,4 +179,59 @@ std::string CurrentWorkingDirectory()
 	return std::string (p_w_d);
 }
 
+MappedFile::MappedFile() : m_data(NULL), m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char* filename)
+{
+	PROFILE_FUNC(); // since i/o
+	close();
+
+	int fd = ::open(filename, O_RDONLY);
+	if(fd == -1)
+		return false;
+
+	struct stat statbuf;
+	if(fstat(fd, &statbuf) != 0){
+		::close(fd);
+		return false;
+	}
+
+	m_size = (size_t)statbuf.st_size;
+	if(m_size == 0){
+	//	mmap doesn't accept empty ranges. Use an empty buffer instead.
+		::close(fd);
+		m_buffer.resize(1);
+		m_data = &m_buffer.front();
+		return true;
+	}
+
+	void* p = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+//	the mapping stays valid after the descriptor was closed
+	::close(fd);
+
+	if(p == MAP_FAILED){
+		m_size = 0;
+		return false;
+	}
+
+	m_data = (const char*)p;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if(m_data && m_buffer.empty())
+		munmap((void*)m_data, m_size);
+	m_data = NULL;
+	m_size = 0;
+	m_buffer.clear();
+}
+
 }// end of namespace
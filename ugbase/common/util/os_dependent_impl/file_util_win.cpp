@@ -192,4 +192,48 @@ std::string CurrentWorkingDirectory()
 	return the_pwd;
 }
 
+MappedFile::MappedFile() : m_data(NULL), m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char* filename)
+{
+	PROFILE_FUNC(); // since i/o
+	close();
+
+//	no mmap on windows. We read the whole file into the buffer instead.
+	ifstream in(filename, ios::binary);
+	if(!in)
+		return false;
+
+	in.seekg(0, ios::end);
+	m_size = (size_t)in.tellg();
+	in.seekg(0, ios::beg);
+
+	m_buffer.resize(m_size + 1);
+	if(m_size > 0)
+		in.read(&m_buffer.front(), m_size);
+
+	if(!in){
+		m_buffer.clear();
+		m_size = 0;
+		return false;
+	}
+
+	m_data = &m_buffer.front();
+	return true;
+}
+
+void MappedFile::close()
+{
+	m_data = NULL;
+	m_size = 0;
+	m_buffer.clear();
+}
+
 }// end of namespace
@@ -33,6 +33,18 @@
 #ifndef __H__COMMON__UTIL__PROVIDER__
 #define __H__COMMON__UTIL__PROVIDER__
 
+/// storage class specifier for objects that are provided per thread
+/**
+ * If ug4 is compiled with thread support (OpenMP), objects declared with this
+ * specifier are instantiated once per thread. Otherwise, the specifier is empty
+ * and the objects are shared as usual.
+ */
+#ifdef UG_OPENMP
+	#define UG_THREAD_LOCAL thread_local
+#else
+	#define UG_THREAD_LOCAL
+#endif
+
 namespace ug{
 
 /// \addtogroup ugbase_common_util
@@ -57,6 +69,27 @@ class Provider
 		}
 };
 
+/// Provider, holding a single instance of an object per thread
+/**
+ * This class is used like the Provider, but returns one instance per thread
+ * (see UG_THREAD_LOCAL). It must be used for objects that are modified by the
+ * caller, e.g. geometries or mappings that are updated for an element, if the
+ * objects may be requested from several threads concurrently.
+ */
+template <typename TClass>
+class ThreadLocalProvider
+{
+	public:
+		///	type of provided object
+		typedef TClass Type;
+
+		///	returns the instance of the calling thread
+		static inline TClass& get(){
+			static UG_THREAD_LOCAL TClass inst;
+			return inst;
+		}
+};
+
 // end group ugbase_common_util
 /// \}
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__SPARSE_PATTERN_FINGERPRINT__
+#define __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__SPARSE_PATTERN_FINGERPRINT__
+
+#include <cstddef>
+#include <cstdint>
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+///	fingerprint of the sparsity pattern of a matrix
+/**
+ * Stores the size and the number of connections of a matrix together with a
+ * hash of its row lengths (i.e. the row pointers of the defragmented matrix)
+ * and column indices. The values and the internal fragmentation of the
+ * storage do not enter the fingerprint.
+ *
+ * Preconditioners use it to detect that a matrix passed to init() has the
+ * same pattern as in the previous call, in which case orderings and symbolic
+ * factorizations can be reused.
+ */
+class SparsePatternFingerprint
+{
+	public:
+		SparsePatternFingerprint() {clear();}
+
+	///	computes the fingerprint of a matrix
+		template <typename TMatrix>
+		explicit SparsePatternFingerprint(const TMatrix& A) {compute(A);}
+
+	///	computes the fingerprint of a matrix
+		template <typename TMatrix>
+		void compute(const TMatrix& A)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			m_numRows = A.num_rows();
+			m_numCols = A.num_cols();
+			m_nnz = 0;
+			m_hash = 14695981039346656037ULL;
+			for(size_t r = 0; r < m_numRows; ++r)
+			{
+				size_t len = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(r);
+					it != A.end_row(r); ++it, ++len)
+					mix(it.index());
+				mix(len);
+				m_nnz += len;
+			}
+			m_bValid = true;
+		}
+
+	///	resets to the invalid state, which matches no matrix
+		void clear()
+		{
+			m_numRows = m_numCols = m_nnz = 0;
+			m_hash = 0;
+			m_bValid = false;
+		}
+
+	///	returns if a fingerprint has been computed
+		bool valid() const {return m_bValid;}
+
+	///	number of connections of the matrix
+		size_t num_connections() const {return m_nnz;}
+
+		bool operator==(const SparsePatternFingerprint& o) const
+		{
+			return m_bValid && o.m_bValid && m_numRows == o.m_numRows
+					&& m_numCols == o.m_numCols && m_nnz == o.m_nnz
+					&& m_hash == o.m_hash;
+		}
+
+		bool operator!=(const SparsePatternFingerprint& o) const
+		{
+			return !(*this == o);
+		}
+
+	private:
+	///	FNV-1a step on a whole 64 bit word, followed by a bit mixer
+		void mix(uint64_t v)
+		{
+			m_hash ^= v;
+			m_hash *= 1099511628211ULL;
+			m_hash ^= m_hash >> 29;
+		}
+
+	private:
+		size_t m_numRows, m_numCols, m_nnz;
+		uint64_t m_hash;
+		bool m_bValid;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__SPARSE_PATTERN_FINGERPRINT__ */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include "algebra_threads.h"
+#include "common/error.h"
+
+#ifdef UG_OPENMP
+#include <omp.h>
+#endif
+
+namespace ug{
+
+///	number of threads requested by the user (0 = OpenMP default)
+static size_t s_algebraNumThreads = 1;
+
+///	minimum number of rows processed by one thread
+static size_t s_algebraThreadMinRows = 1024;
+
+void SetAlgebraNumThreads(size_t numThreads)
+{
+	s_algebraNumThreads = numThreads;
+}
+
+size_t AlgebraNumThreads()
+{
+#ifdef UG_OPENMP
+	if(s_algebraNumThreads == 0)
+		return (size_t)omp_get_max_threads();
+	return s_algebraNumThreads;
+#else
+	return 1;
+#endif
+}
+
+size_t AlgebraNumThreads(size_t numRows)
+{
+	const size_t numThreads = AlgebraNumThreads();
+	if(numThreads <= 1) return 1;
+
+	const size_t maxThreads = numRows / s_algebraThreadMinRows;
+	if(maxThreads <= 1) return 1;
+
+	return std::min(numThreads, maxThreads);
+}
+
+void SetAlgebraThreadMinRows(size_t minRows)
+{
+	if(minRows == 0)
+		UG_THROW("SetAlgebraThreadMinRows: minimum number of rows must be positive.");
+	s_algebraThreadMinRows = minRows;
+}
+
+size_t AlgebraThreadMinRows()
+{
+	return s_algebraThreadMinRows;
+}
+
+} // namespace ug
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__CPU_ALGEBRA__ALGEBRA_THREADS__
+#define __H__UG__CPU_ALGEBRA__ALGEBRA_THREADS__
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+///	@{
+
+/// sets the number of threads used by the threaded cpu algebra kernels
+/**
+ * The kernels of SparseMatrix (axpy, apply) and Vector (dotprod, norm,
+ * scale-add, ...) are OpenMP parallel if ug4 is compiled with OPENMP=ON.
+ * The default is one thread, since MPI runs usually place several processes
+ * on a node. Passing 0 uses the OpenMP default (omp_get_max_threads()). In
+ * builds without OpenMP all kernels run serial and the setting has no effect.
+ */
+void SetAlgebraNumThreads(size_t numThreads);
+
+/// returns the number of threads used by the threaded cpu algebra kernels
+size_t AlgebraNumThreads();
+
+/// returns the number of threads to use for a kernel running over numRows rows
+/**
+ * Small systems (e.g. coarse grid levels) are processed serial, since the
+ * fork/join overhead would dominate: at most numRows / AlgebraThreadMinRows()
+ * threads are used, and at least one.
+ */
+size_t AlgebraNumThreads(size_t numRows);
+
+/// sets the minimum number of rows a thread should process in an algebra kernel
+void SetAlgebraThreadMinRows(size_t minRows);
+
+/// returns the minimum number of rows a thread should process in an algebra kernel
+size_t AlgebraThreadMinRows();
+
+/// allocator leaving new elements of builtin type uninitialized
+/**
+ * std::vector value-initializes new elements on resize, hence the memory
+ * pages are touched first by the resizing thread and are placed on its NUMA
+ * node. With this allocator, elements without a user provided constructor
+ * stay uninitialized, such that the first write in a threaded loop places
+ * the pages near the thread using them later (first touch).
+ */
+template <typename T>
+class FirstTouchAllocator : public std::allocator<T>
+{
+	public:
+		template <typename U> struct rebind {typedef FirstTouchAllocator<U> other;};
+
+		FirstTouchAllocator() {}
+		template <typename U> FirstTouchAllocator(const FirstTouchAllocator<U>&) {}
+
+		template <typename U> void construct(U* p) {::new((void*)p) U;}
+
+		template <typename U, typename... TArgs> void construct(U* p, TArgs&&... args)
+		{
+			::new((void*)p) U(std::forward<TArgs>(args)...);
+		}
+};
+
+// end group cpu_algebra
+/// \}
+
+} // namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__ALGEBRA_THREADS__ */
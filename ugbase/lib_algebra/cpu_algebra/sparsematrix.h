@@ -43,6 +43,7 @@
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
 #include "../common/operations_mat/operations_mat.h"
+#include "algebra_threads.h"
 
 #define PROFILE_SPMATRIX(name) PROFILE_BEGIN_GROUP(name, "SparseMatrix algebra")
 
@@ -103,6 +104,12 @@ public:
 
 	typedef SparseMatrix<value_type> this_type;
 
+protected:
+	// values and column indices are placed by the threads copying them
+	// (see copyToNewSize)
+	typedef std::vector<int, FirstTouchAllocator<int> > col_storage_type;
+	typedef std::vector<value_type, FirstTouchAllocator<value_type> > value_storage_type;
+
 public:
 	typedef AlgebraicConnection<TValueType> connection;
 	typedef MatrixRow<this_type> row_type;
@@ -178,6 +185,19 @@ public:
 	void apply_transposed_ignore_zero_rows(vector_t &dest,
 			const number &beta1, const vector_t &w1) const;
 
+	//! calculate dest[i] = beta1*(A*w1)[i] for all rows i without connections to columns marked in colMask
+	/** The rows connected to marked columns are skipped and returned in borderRowsOut
+	 * (in ascending order). dest is not changed for those rows. colMask needs at
+	 * least num_cols() entries.*/
+	template<typename vector_t>
+	void apply_inner_rows(vector_t &dest, const number &beta1, const vector_t &w1,
+			const std::vector<char> &colMask, std::vector<size_t> &borderRowsOut) const;
+
+	//! calculate dest[i] = beta1*(A*w1)[i] for all rows i contained in rows
+	template<typename vector_t>
+	void apply_rows(vector_t &dest, const number &beta1, const vector_t &w1,
+			const std::vector<size_t> &rows) const;
+
 	// DEPRECATED!
 	//! calculate res = A x
 		// apply is deprecated because of axpy(res, 0.0, res, 1.0, beta, w1)
@@ -587,6 +607,8 @@ public:
 
 	void defragment()
     {
+		// a frozen matrix is already stored contiguously
+		if(m_bFrozen) return;
 		if(num_rows() != 0 && num_cols() != 0)
 			copyToNewSize(nnz);
     }
@@ -596,6 +618,23 @@ public:
 		(const_cast<this_type*>(this))->defragment();
 	}
 
+	/**
+	 * defragments the matrix into a contiguous CRS storage and enables the
+	 * frozen mode. In frozen mode row r is stored in [rowStart[r], rowStart[r+1])
+	 * and the SpMV only reads this row pointer array. Values may still be
+	 * changed, every structural change (new connections, resize, ...) leaves
+	 * the frozen mode automatically. Freezing a frozen matrix does nothing, a
+	 * matrix whose rows are already stored one after another is not copied.
+	 * \note must not be called while row iterators are in use
+	 */
+	void freeze();
+
+	//! leaves the frozen mode (see freeze())
+	void unfreeze() { m_bFrozen = false; }
+
+	//! returns true if the matrix is in frozen CRS mode (see freeze())
+	bool is_frozen() const { return m_bFrozen; }
+
 	/**
 	 * copies the matrix to the standard CRS format
 	 * @param numRows   	(out) num rows of A
@@ -611,9 +650,9 @@ public:
 		numRows = num_rows();
 		numCols = num_cols();
 		defragment();
-		argValues = values;
+		argValues.assign(values.begin(), values.end());
 		argRowStart = rowStart;
-		argColInd = cols;
+		argColInd.assign(cols.begin(), cols.end());
 	}
 
 	/**
@@ -647,9 +686,24 @@ public:
 	void get_values(std::vector<value_type> &argValues) const
 	{
 		defragment();
-		argValues = values;
+		argValues.assign(values.begin(), values.end());
 	}
 
+	/**
+	 * direct read access to the storage: row r is stored at the positions
+	 * [row_start(r), row_end(r)), sorted by column index. In contrast to row
+	 * iterators this does not register at the matrix and can thus be used
+	 * concurrently by several threads.
+	 * \note only valid as long as the matrix structure is not modified
+	 */
+	/// \{
+	int row_start(size_t r) const { return rowStart[r]; }
+	int row_end(size_t r) const { return rowEnd[r]; }
+	size_t col_index(int i) const { return cols[i]; }
+	const value_type &value_at(int i) const { return values[i]; }
+	value_type &value_at(int i) { return values[i]; }
+	/// \}
+
 
 public:
 	// output functions
@@ -718,9 +772,38 @@ protected:
     	copyToNewSize(newSize, num_cols());
     }
     void copyToNewSize(size_t newSize, size_t maxCols);
+
+	//! copies rows first <= r < last to the positions newStart[r] of v and c
+	void copy_rows(size_t first, size_t last, size_t maxCol,
+			const std::vector<int> &newStart, value_storage_type &v, col_storage_type &c) const;
 	void check_fragmentation() const;
 	int get_nnz_max_cols(size_t maxCols);
 
+	//! calculate dest[i] = alpha1*v1[i] + beta1*(A*w1)[i] for rows first <= i < last
+	template<typename vector_t>
+	void axpy_rows(size_t first, size_t last, vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1) const;
+
+	//! apply_inner_rows for rows first <= i < last
+	template<typename vector_t>
+	void apply_inner_rows(size_t first, size_t last, vector_t &dest,
+			const number &beta1, const vector_t &w1,
+			const std::vector<char> &colMask, std::vector<size_t> &borderRowsOut) const;
+
+	//! calculate dest[i] = beta1*(A*w1)[i] for the single row i
+	template<typename vector_t>
+	inline void apply_row(size_t i, vector_t &dest, const number &beta1, const vector_t &w1) const;
+
+	//! axpy_rows for frozen matrices using the contiguous CRS row pointers only
+	template<typename vector_t>
+	void axpy_rows_frozen(size_t first, size_t last, vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1) const;
+
+	//! returns numParts+1 row bounds splitting the rows in ranges of about equal number of connections
+	const std::vector<size_t> &row_partition(size_t numParts) const;
+
 public: // bug
 	int col(size_t i) const{
 		assert(i<cols.size());
@@ -737,15 +820,21 @@ protected:
     std::vector<int> rowStart;
     std::vector<int> rowEnd;
     std::vector<int> rowMax;
-    std::vector<int> cols;
+    col_storage_type cols;
     size_t fragmented;
     size_t nnz;
     bool bNeedsValues;
 
-    std::vector<value_type> values;
+    value_storage_type values;
     int maxValues;
     int m_numCols;
     mutable int iIterators;
+    bool m_bFrozen;
+
+    // cached row partition for threaded kernels, recomputed when nnz,
+    // num_rows() or the number of threads changes
+    mutable std::vector<size_t> m_rowPartition;
+    mutable size_t m_rowPartitionNNZ;
 
 #ifdef CHECK_ROW_ITERATORS
 public:
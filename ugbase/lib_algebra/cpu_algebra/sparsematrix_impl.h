@@ -64,6 +64,8 @@ SparseMatrix<T>::SparseMatrix()
 	nnz = 0;
 	m_numCols = 0;
 	maxValues = 0;
+	m_bFrozen = false;
+	m_rowPartitionNNZ = 0;
 	cols.resize(32);
 	if(bNeedsValues) values.resize(32);
 }
@@ -76,9 +78,10 @@ void SparseMatrix<T>::clear_and_free()
 	std::vector<int>().swap(rowEnd);
 	m_numCols = 0;
 	nnz = 0;
+	m_bFrozen = false;
 
-	std::vector<int>().swap(cols);
-	std::vector<value_type>().swap(values);
+	col_storage_type().swap(cols);
+	value_storage_type().swap(values);
 	maxValues = 0;
 
 #ifdef CHECK_ROW_ITERATORS
@@ -96,6 +99,7 @@ void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 	rowEnd.clear(); rowEnd.resize(newRows, -1);
 	m_numCols = newCols;
 	nnz = 0;
+	m_bFrozen = false;
 
 	cols.clear(); cols.resize(newRows);
 	values.clear();
@@ -116,6 +120,8 @@ void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 	if(newRows == 0 && newCols == 0)
 		return resize_and_clear(0,0);
 
+	m_bFrozen = false;
+
 	if(newRows != num_rows())
 	{
 		size_t oldrows = num_rows();
@@ -297,9 +303,38 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 {
 	PROFILE_SPMATRIX(SparseMatrix_axpy);
 	check_fragmentation();
+
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(num_rows());
+	if(numThreads > 1)
+	{
+		// rows are distributed by number of connections, not by number of rows
+		const std::vector<size_t> &part = row_partition(numThreads);
+		#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+		for(size_t t = 0; t < numThreads; t++)
+			axpy_rows(part[t], part[t+1], dest, alpha1, v1, beta1, w1);
+		return;
+	}
+#endif
+
+	axpy_rows(0, num_rows(), dest, alpha1, v1, beta1, w1);
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy_rows(size_t first, size_t last, vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1) const
+{
+	if(m_bFrozen)
+	{
+		axpy_rows_frozen(first, last, dest, alpha1, v1, beta1, w1);
+		return;
+	}
+
 	if(alpha1 == 0.0)
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		for(size_t i=first; i < last; i++)
 		{
 			size_t rowIt=rowStart[i];
 			size_t itEnd=rowEnd[i];
@@ -317,20 +352,20 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	else if(&dest == &v1)
 	{
 		if(alpha1 != 1.0) {
-			for(size_t i=0; i < num_rows(); i++)
+			for(size_t i=first; i < last; i++)
 			{
 				dest[i] *= alpha1;
 				mat_mult_add_row(i, dest[i], beta1, w1);
 			}
 		}
 		else
-			for(size_t i=0; i < num_rows(); i++)
+			for(size_t i=first; i < last; i++)
 				mat_mult_add_row(i, dest[i], beta1, w1);
 
 	}
 	else
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		for(size_t i=first; i < last; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			mat_mult_add_row(i, dest[i], beta1, w1);
@@ -338,6 +373,213 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	}
 }
 
+template<typename T>
+template<typename vector_t>
+inline void SparseMatrix<T>::apply_row(size_t i, vector_t &dest,
+		const number &beta1, const vector_t &w1) const
+{
+	int rowIt = rowStart[i];
+	const int itEnd = rowEnd[i];
+	if(rowIt == -1 || rowIt == itEnd)
+	{
+		dest[i] = 0.0;
+		return;
+	}
+	MatMult(dest[i], beta1, values[rowIt], w1[cols[rowIt]]);
+	for(++rowIt; rowIt != itEnd; ++rowIt)
+		MatMultAdd(dest[i], 1.0, dest[i], beta1, values[rowIt], w1[cols[rowIt]]);
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::apply_inner_rows(size_t first, size_t last, vector_t &dest,
+		const number &beta1, const vector_t &w1,
+		const std::vector<char> &colMask, std::vector<size_t> &borderRowsOut) const
+{
+	for(size_t i=first; i < last; i++)
+	{
+		bool border = false;
+		if(rowStart[i] != -1)
+		{
+			const int itEnd = rowEnd[i];
+			for(int rowIt = rowStart[i]; rowIt != itEnd; ++rowIt)
+				if(colMask[cols[rowIt]]) {border = true; break;}
+		}
+
+		if(border)
+			borderRowsOut.push_back(i);
+		else
+			apply_row(i, dest, beta1, w1);
+	}
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::apply_inner_rows(vector_t &dest, const number &beta1,
+		const vector_t &w1, const std::vector<char> &colMask,
+		std::vector<size_t> &borderRowsOut) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_apply_inner_rows);
+	check_fragmentation();
+	UG_ASSERT(colMask.size() >= num_cols(), "colMask too small");
+	borderRowsOut.clear();
+
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(num_rows());
+	if(numThreads > 1)
+	{
+		const std::vector<size_t> &part = row_partition(numThreads);
+		std::vector<std::vector<size_t> > vBorderRows(numThreads);
+		#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+		for(size_t t = 0; t < numThreads; t++)
+			apply_inner_rows(part[t], part[t+1], dest, beta1, w1, colMask, vBorderRows[t]);
+
+		for(size_t t = 0; t < numThreads; t++)
+			borderRowsOut.insert(borderRowsOut.end(), vBorderRows[t].begin(), vBorderRows[t].end());
+		return;
+	}
+#endif
+
+	apply_inner_rows(0, num_rows(), dest, beta1, w1, colMask, borderRowsOut);
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::apply_rows(vector_t &dest, const number &beta1,
+		const vector_t &w1, const std::vector<size_t> &rows) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_apply_rows);
+	check_fragmentation();
+
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(rows.size());
+	if(numThreads > 1)
+	{
+		#pragma omp parallel for schedule(static) num_threads(numThreads)
+		for(long k = 0; k < (long)rows.size(); k++)
+			apply_row(rows[k], dest, beta1, w1);
+		return;
+	}
+#endif
+
+	for(size_t k = 0; k < rows.size(); k++)
+		apply_row(rows[k], dest, beta1, w1);
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy_rows_frozen(size_t first, size_t last, vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1) const
+{
+	// in frozen mode row i ends where row i+1 starts and there are no empty (-1) rows
+	if(alpha1 == 0.0)
+	{
+		for(size_t i=first; i < last; i++)
+		{
+			const int itEnd = rowStart[i+1];
+			int rowIt = rowStart[i];
+			if(rowIt == itEnd)
+			{
+				dest[i] = 0.0;
+				continue;
+			}
+			MatMult(dest[i], beta1, values[rowIt], w1[cols[rowIt]]);
+			for(++rowIt; rowIt != itEnd; ++rowIt)
+				MatMultAdd(dest[i], 1.0, dest[i], beta1, values[rowIt], w1[cols[rowIt]]);
+		}
+		return;
+	}
+
+	for(size_t i=first; i < last; i++)
+	{
+		if(&dest == &v1)
+		{
+			if(alpha1 != 1.0) dest[i] *= alpha1;
+		}
+		else
+			VecScaleAssign(dest[i], alpha1, v1[i]);
+
+		const int itEnd = rowStart[i+1];
+		for(int rowIt = rowStart[i]; rowIt != itEnd; ++rowIt)
+			MatMultAdd(dest[i], 1.0, dest[i], beta1, values[rowIt], w1[cols[rowIt]]);
+	}
+}
+
+template<typename T>
+void SparseMatrix<T>::freeze()
+{
+	PROFILE_SPMATRIX(SparseMatrix_freeze);
+	if(iIterators > 0)
+		UG_THROW("SparseMatrix::freeze: not allowed while row iterators are in use.");
+	if(m_bFrozen) return;
+
+	if(num_rows() == 0) return;
+
+	// rows already stored one after another without gaps (e.g. after a
+	// defragment or a replayed pattern) do not have to be copied
+	int j = 0;
+	bool bContiguous = true;
+	for(size_t r=0; r<num_rows() && bContiguous; r++)
+	{
+		if(rowStart[r] == -1) continue;
+		bContiguous = (rowStart[r] == j);
+		j = rowEnd[r];
+	}
+
+	if(!bContiguous || j != (int)nnz)
+	{
+		// copy to exactly nnz entries, this removes all gaps and empty (-1) rows
+		copyToNewSize(nnz);
+		m_bFrozen = true;
+		return;
+	}
+
+	// only the empty rows, the reserved room and the end of the last row are set
+	j = 0;
+	for(size_t r=0; r<num_rows(); r++)
+	{
+		if(rowStart[r] == -1)
+			rowStart[r] = rowEnd[r] = j;
+		rowMax[r] = j = rowEnd[r];
+	}
+	rowStart[num_rows()] = j;
+	maxValues = j;
+	fragmented = 0;
+	m_bFrozen = true;
+}
+
+template<typename T>
+const std::vector<size_t> &SparseMatrix<T>::row_partition(size_t numParts) const
+{
+	const size_t numRows = num_rows();
+	if(m_rowPartition.size() == numParts+1 && m_rowPartition[numParts] == numRows
+		&& m_rowPartitionNNZ == nnz)
+		return m_rowPartition;
+
+	// every row counts with its connections plus one for the vector entry
+	size_t total = numRows;
+	for(size_t r=0; r<numRows; r++)
+		if(rowStart[r] != -1) total += rowEnd[r]-rowStart[r];
+
+	m_rowPartition.resize(numParts+1);
+	m_rowPartition[0] = 0;
+	size_t r = 0, sum = 0;
+	for(size_t p=1; p<numParts; p++)
+	{
+		const size_t target = (total*p)/numParts;
+		for(; r < numRows && sum < target; r++)
+		{
+			sum += 1;
+			if(rowStart[r] != -1) sum += rowEnd[r]-rowStart[r];
+		}
+		m_rowPartition[p] = r;
+	}
+	m_rowPartition[numParts] = numRows;
+	m_rowPartitionNNZ = nnz;
+	return m_rowPartition;
+}
+
 // calculate dest = alpha1*v1 + beta1*A^T*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
@@ -601,6 +843,7 @@ int SparseMatrix<T>::get_index(int r, int c)
 	{
 //		UG_LOG("new row\n");
 		// row did not start, start new row at the end of cols array
+		m_bFrozen = false;
 		assureValuesSize(maxValues+1);
 		rowStart[r] = maxValues;
 		rowEnd[r] = maxValues+1;
@@ -629,6 +872,7 @@ int SparseMatrix<T>::get_index(int r, int c)
 	// we did not find it, so we have to add it
 
 	check_row_modifiable(r);
+	m_bFrozen = false;
 
 #ifndef NDEBUG
 	assert(index == rowEnd[r] || cols[index] > c);
@@ -703,6 +947,7 @@ template<typename T>
 void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 {
 	PROFILE_SPMATRIX(SparseMatrix_copyToNewSize);
+	m_bFrozen = false;
 	/*UG_LOG("copyToNewSize: from " << values.size()  << " to " << newSize << "\n");
 	UG_LOG("sizes are " << cols.size() << " and " << values.size() << ", ");
 	UG_LOG(reset_floats << "capacities are " << cols.capacity() << " and " << values.capacity() << ", NNZ = " << nnz << ", fragmentation = " <<
@@ -719,36 +964,70 @@ void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 		return;
 	}
 
-	std::vector<value_type> v(newSize);
-	std::vector<int> c(newSize);
-	size_t j=0;
+	// new row starts
+	std::vector<int> newStart(num_rows()+1);
+	int j=0;
 	for(size_t r=0; r<num_rows(); r++)
 	{
-		if(rowStart[r] == -1)
-			rowStart[r] = rowEnd[r] = rowMax[r] = j;
+		newStart[r] = j;
+		if(rowStart[r] == -1) continue;
+		if(maxCol >= num_cols()) j += rowEnd[r]-rowStart[r];
 		else
-		{
-			size_t start=j;
 			for(int k=rowStart[r]; k<rowEnd[r]; k++)
-			{
-				if(cols[k] < (int)maxCol)
-				{
-					if(bNeedsValues) v[j] = values[k];
-					c[j] = cols[k];
-					j++;
-				}
-			}
-			rowStart[r] = start;
-			rowEnd[r] = rowMax[r] = j;
-		}
+				if(cols[k] < (int)maxCol) j++;
+	}
+	newStart[num_rows()] = j;
+
+	// the new arrays are not initialized, the rows are copied by the threads
+	// of the SpMV (same row partition), which places the pages near them
+	value_storage_type v;
+	col_storage_type c(newSize);
+	if(bNeedsValues) v.resize(newSize);
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(num_rows());
+	if(numThreads > 1)
+	{
+		const std::vector<size_t> &part = row_partition(numThreads);
+		#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+		for(size_t t = 0; t < numThreads; t++)
+			copy_rows(part[t], part[t+1], maxCol, newStart, v, c);
+	}
+	else
+#endif
+	copy_rows(0, num_rows(), maxCol, newStart, v, c);
+
+	for(size_t r=0; r<num_rows(); r++)
+	{
+		rowStart[r] = newStart[r];
+		rowEnd[r] = rowMax[r] = newStart[r+1];
 	}
-	rowStart[num_rows()] = rowEnd[num_rows()-1];
+	rowStart[num_rows()] = j;
 	fragmented = 0;
 	maxValues = j;
 	if(bNeedsValues) values.swap(v);
 	cols.swap(c);
 }
 
+template<typename T>
+void SparseMatrix<T>::copy_rows(size_t first, size_t last, size_t maxCol,
+		const std::vector<int> &newStart, value_storage_type &v, col_storage_type &c) const
+{
+	for(size_t r=first; r<last; r++)
+	{
+		if(rowStart[r] == -1) continue;
+		int j = newStart[r];
+		for(int k=rowStart[r]; k<rowEnd[r]; k++)
+		{
+			if(cols[k] < (int)maxCol)
+			{
+				if(bNeedsValues) v[j] = values[k];
+				c[j] = cols[k];
+				j++;
+			}
+		}
+	}
+}
+
 template<typename T>
 void SparseMatrix<T>::check_fragmentation() const
 {
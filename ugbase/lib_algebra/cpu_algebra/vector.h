@@ -128,6 +128,9 @@ public:
 	//! returns v.T w, that is the dotprod of this vector and w
 	double dotprod(const Vector &w); //const;
 
+	//! computes res[k] = v.T w[k] for all k in one sweep over the entries of this vector
+	void dotprods(std::vector<double> &res, const std::vector<const Vector*> &w) const;
+
 	// deprecated, use x.T() * y.
 	//inline double operator *(const Vector &w); ///< shortcut for .dotprod(w)
 
@@ -169,6 +172,10 @@ public:
 
 	inline void operator *= (const number &a)
 	{
+#ifdef UG_OPENMP
+		const size_t numThreads = AlgebraNumThreads(m_size);
+		#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 		for(size_t i=0; i<size(); i++) values[i] *= a;
 	}
 
@@ -178,6 +185,12 @@ public:
 	//! return max values[i] (max norm)
 	inline double maxnorm() const;
 
+	//! computes res[k] = sum v[k].values[i]^2 for all vectors in one sweep
+	static void norms_squared(std::vector<double> &res, const std::vector<const Vector*> &v);
+
+	//! computes res[k] = euclidian norm of v[k] for all vectors in one sweep
+	static void norms(std::vector<double> &res, const std::vector<const Vector*> &v);
+
 	size_t size() const { return m_size; }
 
 
@@ -222,6 +235,17 @@ protected:
 private:
 	void destroy();
 
+	//! adds the products of rows [first, last) to sum[k], processed in cache sized chunks
+	void dotprods_rows(size_t first, size_t last, double *sum,
+	                   const std::vector<const Vector*> &w) const;
+
+	//! adds the squared norms of rows [first, last) of v[k] to sum[k]
+	static void norms_squared_rows(size_t first, size_t last, double *sum,
+	                               const std::vector<const Vector*> &v);
+
+	//! sets values[from..to) to zero with the threads of the algebra kernels (NUMA first touch)
+	void first_touch(value_type *v, size_t from, size_t to);
+
 	size_t m_size;			///< size of the vector (vector is from 0..size-1)
 	size_t m_capacity;		///< size of the vector (vector is from 0..size-1)
 	value_type *values;		///< array where the values are stored, size m_size
@@ -37,6 +37,7 @@
 #include <fstream>
 #include <algorithm>
 #include "algebra_misc.h"
+#include "lib_algebra/common/operations_vec.h"
 #include "common/math/ugmath.h"
 #include "vector.h" // for urand
 
@@ -74,14 +75,83 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 	UG_ASSERT(m_size == w.m_size,  *this << " has not same size as " << w);
 
 	double sum=0;
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1) reduction(+:sum)
+#endif
 	for(size_t i=0; i<m_size; i++)	sum += VecProd(values[i], w[i]);
 	return sum;
 }
 
+// dotprods
+/// stride of the per-thread partial sums in dotprods and norms_squared:
+/// the sums of different threads are at least one cache line (64 bytes)
+/// apart, so that they are not written to the same line (false sharing)
+inline size_t PartialSumStride(size_t numVec)
+{
+	const size_t doublesPerLine = 64 / sizeof(double);
+	return (numVec + 2*doublesPerLine - 1) / doublesPerLine * doublesPerLine;
+}
+
+template<typename value_type>
+void Vector<value_type>::dotprods(std::vector<double> &res,
+                                  const std::vector<const Vector*> &w) const
+{
+	const size_t numVec = w.size();
+	res.assign(numVec, 0.0);
+	if(numVec == 0) return;
+	for(size_t k = 0; k < numVec; ++k)
+		UG_ASSERT(m_size == w[k]->m_size,  *this << " has not same size as " << *w[k]);
+
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	if(numThreads > 1)
+	{
+		// partial sums are added up in a fixed order to get reproducible results
+		const size_t stride = PartialSumStride(numVec);
+		std::vector<double> partial(numThreads*stride, 0.0);
+		#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+		for(size_t t = 0; t < numThreads; t++)
+			dotprods_rows(t*m_size/numThreads, (t+1)*m_size/numThreads,
+			              &partial[t*stride], w);
+		for(size_t t = 0; t < numThreads; t++)
+			for(size_t k = 0; k < numVec; ++k)
+				res[k] += partial[t*stride + k];
+		return;
+	}
+#endif
+
+	dotprods_rows(0, m_size, &res[0], w);
+}
+
+template<typename value_type>
+void Vector<value_type>::dotprods_rows(size_t first, size_t last, double *sum,
+                                       const std::vector<const Vector*> &w) const
+{
+	// a chunk of this vector stays in cache while it is multiplied with all w[k]
+	const size_t chunkSize = 512;
+	for(size_t from = first; from < last; from += chunkSize)
+	{
+		const size_t to = std::min(from + chunkSize, last);
+		for(size_t k = 0; k < w.size(); ++k)
+		{
+			const value_type *wk = w[k]->values;
+			double s = 0;
+			for(size_t i = from; i < to; ++i)
+				s += VecProd(values[i], wk[i]);
+			sum[k] += s;
+		}
+	}
+}
+
 // assign double to whole Vector
 template<typename value_type>
 inline double Vector<value_type>::operator = (double d)
 {
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = d;
 	return d;
@@ -100,6 +170,10 @@ template<typename value_type>
 inline void Vector<value_type>::operator = (const vector_type &v)
 {
 	resize(v.size());
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v[i];
 }
@@ -108,6 +182,10 @@ template<typename value_type>
 inline void Vector<value_type>::operator += (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] += v[i];
 }
@@ -116,6 +194,10 @@ template<typename value_type>
 inline void Vector<value_type>::operator -= (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] -= v[i];
 }
@@ -162,6 +244,22 @@ void Vector<value_type>::create(size_t size)
 	m_size = size;
 	values = new value_type[size];
 	m_capacity = size;
+	first_touch(values, 0, size);
+}
+
+template<typename value_type>
+void Vector<value_type>::first_touch(value_type *v, size_t from, size_t to)
+{
+//	memory pages are placed on the NUMA node of the thread touching them first.
+//	Touching them with the same static schedule as the threaded kernels keeps
+//	the entries local to the thread that later works on them.
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(to-from);
+	if(numThreads <= 1) return;
+	#pragma omp parallel for num_threads(numThreads)
+	for(size_t i=from; i<to; i++)
+		v[i] = 0.0;
+#endif
 }
 
 
@@ -197,11 +295,17 @@ void Vector<value_type>::reserve_exactly(size_t newCapacity, bool bCopyValues)
 	// we cannot use memcpy here bcs of variable blocks.
 	if(values != NULL && bCopyValues)
 	{
+#ifdef UG_OPENMP
+		const size_t numThreads = AlgebraNumThreads(m_size);
+		#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 		for(size_t i=0; i<m_size; i++)
 			std::swap(new_values[i], values[i]);
 		for(size_t i=m_size; i<newCapacity; i++)
 			new_values[i] = 0.0;
 	}
+	else
+		first_touch(new_values, 0, newCapacity);
 	if(values) delete [] values;
 	values = new_values;
 	m_capacity = newCapacity;
@@ -245,6 +349,10 @@ void Vector<value_type>::create(const Vector &v)
 	m_capacity = m_size;
 
 	// we cannot use memcpy here bcs of variable blocks.
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v.values[i];
 }
@@ -323,20 +431,181 @@ template<typename value_type>
 inline double Vector<value_type>::norm() const
 {
 	double d=0;
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1) reduction(+:d)
+#endif
 	for(size_t i=0; i<size(); ++i)
 		d+=BlockNorm2(values[i]);
 	return sqrt(d);
 }
 
+template<typename value_type>
+void Vector<value_type>::norms_squared(std::vector<double> &res,
+                                       const std::vector<const Vector*> &v)
+{
+	const size_t numVec = v.size();
+	res.assign(numVec, 0.0);
+	if(numVec == 0) return;
+	const size_t size = v[0]->m_size;
+	for(size_t k = 1; k < numVec; ++k)
+		UG_ASSERT(size == v[k]->m_size,  *v[0] << " has not same size as " << *v[k]);
+
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(size);
+	if(numThreads > 1)
+	{
+		// partial sums are added up in a fixed order to get reproducible results
+		const size_t stride = PartialSumStride(numVec);
+		std::vector<double> partial(numThreads*stride, 0.0);
+		#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+		for(size_t t = 0; t < numThreads; t++)
+			norms_squared_rows(t*size/numThreads, (t+1)*size/numThreads,
+			                   &partial[t*stride], v);
+		for(size_t t = 0; t < numThreads; t++)
+			for(size_t k = 0; k < numVec; ++k)
+				res[k] += partial[t*stride + k];
+		return;
+	}
+#endif
+
+	norms_squared_rows(0, size, &res[0], v);
+}
+
+template<typename value_type>
+void Vector<value_type>::norms_squared_rows(size_t first, size_t last, double *sum,
+                                            const std::vector<const Vector*> &v)
+{
+	for(size_t k = 0; k < v.size(); ++k)
+	{
+		const value_type *vk = v[k]->values;
+		double s = 0;
+		for(size_t i = first; i < last; ++i)
+			s += BlockNorm2(vk[i]);
+		sum[k] += s;
+	}
+}
+
+template<typename value_type>
+void Vector<value_type>::norms(std::vector<double> &res,
+                               const std::vector<const Vector*> &v)
+{
+	norms_squared(res, v);
+	for(size_t k = 0; k < res.size(); ++k)
+		res[k] = sqrt(res[k]);
+}
+
 template<typename value_type>
 inline double Vector<value_type>::maxnorm() const
 {
 	double d=0;
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1) reduction(max:d)
+#endif
 	for(size_t i=0; i<size(); ++i)
 		d = std::max(d, BlockMaxNorm(values[i]));
 	return d;
 }
 
+
+// threaded versions of the vector operations in operations_vec.h
+
+//! calculates dest = alpha1*v1
+template<typename T>
+inline void VecScaleAssign(Vector<T> &dest, double alpha1, const Vector<T> &v1)
+{
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(dest.size());
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<dest.size(); i++)
+		VecScaleAssign(dest[i], alpha1, v1[i]);
+}
+
+//! sets dest = v1 entrywise
+template<typename T>
+inline void VecAssign(Vector<T> &dest, const Vector<T> &v1)
+{
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(dest.size());
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<dest.size(); i++)
+		dest[i] = v1[i];
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2
+template<typename T>
+inline void VecScaleAdd(Vector<T> &dest, double alpha1, const Vector<T> &v1, double alpha2, const Vector<T> &v2)
+{
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(dest.size());
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<dest.size(); i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 + alpha3*v3
+template<typename T>
+inline void VecScaleAdd(Vector<T> &dest, double alpha1, const Vector<T> &v1, double alpha2, const Vector<T> &v2, double alpha3, const Vector<T> &v3)
+{
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(dest.size());
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<dest.size(); i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i], alpha3, v3[i]);
+}
+
+//! calculates s += scal<a, b>
+template<typename T>
+inline void VecProdAdd(const Vector<T> &a, const Vector<T> &b, double &s)
+{
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(a.size());
+	if(numThreads > 1)
+	{
+		double sum=0;
+		#pragma omp parallel for num_threads(numThreads) reduction(+:sum)
+		for(size_t i=0; i<a.size(); i++)
+			VecProdAdd(a[i], b[i], sum);
+		s += sum;
+		return;
+	}
+#endif
+	for(size_t i=0; i<a.size(); i++)
+		VecProdAdd(a[i], b[i], s);
+}
+
+//! calculates s += scal<a, b>
+template<typename T>
+inline void VecProd(const Vector<T> &a, const Vector<T> &b, double &sum)
+{
+	VecProdAdd(a, b, sum);
+}
+
+//! calculates s += norm_2^2(a)
+template<typename T>
+inline void VecNormSquaredAdd(const Vector<T> &a, double &s)
+{
+#ifdef UG_OPENMP
+	const size_t numThreads = AlgebraNumThreads(a.size());
+	if(numThreads > 1)
+	{
+		double sum=0;
+		#pragma omp parallel for num_threads(numThreads) reduction(+:sum)
+		for(size_t i=0; i<a.size(); i++)
+			VecNormSquaredAdd(a[i], sum);
+		s += sum;
+		return;
+	}
+#endif
+	for(size_t i=0; i<a.size(); i++)
+		VecNormSquaredAdd(a[i], s);
+}
+
 template<typename TValueType>
 void CloneVector(Vector<TValueType> &dest, const Vector<TValueType>& src)
 {
@@ -213,6 +213,20 @@ public:
 		return res;
 	}
 
+	void dotprods(std::vector<double> &res, const std::vector<const GPUVector<value_type>*> &w) const
+	{
+		res.resize(w.size());
+		for(size_t k = 0; k < w.size(); ++k)
+			res[k] = dotprod(*w[k]);
+	}
+
+	static void norms(std::vector<double> &res, const std::vector<const GPUVector<value_type>*> &v)
+	{
+		res.resize(v.size());
+		for(size_t k = 0; k < v.size(); ++k)
+			res[k] = v[k]->norm();
+	}
+
 private:
 	double *m_devValues;
 	size_t m_sizeOnGPU;
@@ -147,6 +147,14 @@ class IConvergenceCheck
 		/// clone the object
 		virtual SmartPtr<IConvergenceCheck<TVector> > clone() = 0;
 
+		/// returns true if update(d) only depends on the euclidean norm of d
+		/**
+		 * Solvers that know ||d|| from their own reductions may then call
+		 * update_defect(||d||) (and start_defect) instead of update(d) and
+		 * thereby save a global reduction.
+		 */
+		virtual bool uses_euclidean_norm() const {return false;}
+
 		/// virtual destructor
 		virtual ~IConvergenceCheck() {};
 
@@ -209,6 +217,8 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 			return ss.str();
 		}
 
+		bool uses_euclidean_norm() const {return true;}
+
 		number reduction() const {return m_currentDefect/m_initialDefect;};
 		number defect() const {return m_currentDefect;};
 		number previous_defect() const { return m_lastDefect; }
@@ -138,6 +138,16 @@ class ILinearOperator : public IOperator<X,Y>
 	 */
 		virtual void apply_sub(Y& f, const X& u) = 0;
 
+	///	returns if apply() accepts an additive u and makes it consistent itself
+	/**
+	 * Operators returning true may overlap the communication needed to make u
+	 * consistent with their computation. Although passed as const, an additive
+	 * u is then converted in place and is consistent after apply() (the
+	 * represented vector is unchanged). By default, u has to be passed in
+	 * consistent storage.
+	 */
+		virtual bool accepts_additive_input() const {return false;}
+
 	/// virtual	destructor
 		virtual ~ILinearOperator() {};
 };
@@ -34,6 +34,7 @@
 #define __H__LIB_ALGEBRA__OPERATOR__INTERFACE__MATRIX_OPERATOR__
 
 #include "linear_operator.h"
+#include "common/util/smart_pointer.h"
 #include "lib_algebra/common/operations_mat/matrix_algebra_types.h"
 
 namespace ug{
@@ -70,10 +71,36 @@ class MatrixOperator :	public virtual ILinearOperator<X,Y>,
 	// 	Apply Operator, i.e. f = f - L*u;
 		virtual void apply_sub(Y& f, const X& u) {matrix_type::matmul_minus(f,u);}
 
+	//	additive u is made consistent by ParallelMatrix::apply
+		virtual bool accepts_additive_input() const {return true;}
+
 	// 	Access to matrix
 		virtual M& get_matrix() {return *this;};
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Matrix-free linear operator
+///////////////////////////////////////////////////////////////////////////////
+
+///	linear operator not stored as matrix, providing only its (block) diagonal
+/**
+ * The operator is applied without an assembled matrix (e.g. element by
+ * element). Since it is not a matrix, matrix based preconditioners can not be
+ * used for it. Only preconditioners needing nothing but the diagonal (see
+ * IPreconditioner::needs_diagonal_only) are initialized with the diagonal
+ * matrix returned by diagonal().
+ */
+template <typename M, typename X, typename Y = X>
+class IMatrixFreeLinearOperator : public virtual ILinearOperator<X,Y>
+{
+	public:
+	///	returns the (block) diagonal of the operator (valid after init)
+		virtual SmartPtr<MatrixOperator<M,X,Y> > diagonal() = 0;
+
+	///	virtual destructor
+		virtual ~IMatrixFreeLinearOperator() {};
+};
+
 template<typename M, typename X, typename Y>
 struct matrix_algebra_type_traits<MatrixOperator<M, X, Y> >
 {
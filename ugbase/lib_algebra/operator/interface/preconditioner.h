@@ -196,6 +196,10 @@ class IPreconditioner :
 			SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp =
 					J.template cast_dynamic<MatrixOperator<matrix_type, vector_type> >();
 
+		//	matrix-free operators only provide their diagonal
+			if(pOp.invalid() && needs_diagonal_only())
+				return init_diagonal(J);
+
 		//	Check that matrix if of correct type
 			if(pOp.invalid())
 				UG_THROW(name() << "::init': Passed Operator is "
@@ -226,6 +230,10 @@ class IPreconditioner :
 			SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp =
 					L.template cast_dynamic<MatrixOperator<matrix_type, vector_type> >();
 
+		//	matrix-free operators only provide their diagonal
+			if(pOp.invalid() && needs_diagonal_only())
+				return init_diagonal(L);
+
 		//	Check that matrix if of correct type
 			if(pOp.invalid())
 				UG_THROW(name() << "::init': Passed Operator is "
@@ -362,6 +370,42 @@ class IPreconditioner :
 	/// virtual destructor
 		virtual ~IPreconditioner() {};
 
+	protected:
+	///	returns if the preconditioner only uses the (block) diagonal of the matrix
+	/**
+	 * Preconditioners returning true can also be used for matrix-free
+	 * operators (see IMatrixFreeLinearOperator). They are preprocessed for the
+	 * diagonal of the operator, while the defect is updated using the operator.
+	 */
+		virtual bool needs_diagonal_only() const {return false;}
+
+	///	initializes the preconditioner for the diagonal of a matrix-free operator
+		bool init_diagonal(SmartPtr<ILinearOperator<vector_type> > L)
+		{
+			SmartPtr<IMatrixFreeLinearOperator<matrix_type, vector_type> > spMF =
+					L.template cast_dynamic<IMatrixFreeLinearOperator<matrix_type, vector_type> >();
+			if(spMF.invalid())
+				UG_THROW(name() << "::init': Passed Operator is neither "
+						"based on matrix nor does it provide its diagonal.");
+
+			m_spApproxOperator = spMF->diagonal();
+			m_spDefectOperator = L;
+			if(m_spApproxOperator.invalid())
+				UG_THROW(name() << "::init': Diagonal of the passed "
+						"operator is invalid (operator not initialized?).");
+
+			if(!preprocess(m_spApproxOperator))
+			{
+				UG_LOG("ERROR in '"<<name()<<"::init': Preprocess failed.\n");
+				return false;
+			}
+
+			m_bInit = true;
+			return true;
+		}
+
+	public:
+
 		///	underlying matrix based operator for calculation of defect
 		SmartPtr<MatrixOperator<matrix_type, vector_type> > defect_operator()
 		{
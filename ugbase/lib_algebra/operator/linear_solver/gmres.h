@@ -49,6 +49,10 @@ namespace ug{
 /**
  * This class implements the GMRES - method for the solution of linear
  * operator problems like A*x = b, where the solution x = A^{-1} b is computed.
+ * The Krylov basis is orthogonalized by classical Gram-Schmidt with
+ * reorthogonalization, such that each iteration needs only two global
+ * reductions for the projections (plus one for the norm) independent of the
+ * number of basis vectors.
  *
  * For detailed description of the algorithm, please refer to:
  *
@@ -128,6 +132,10 @@ class GMRES
 			std::vector<number> c(m_restart+1);
 			std::vector<number> s(m_restart+1);
 
+		//	orthonormal basis of the current cycle and projections onto it
+			std::vector<const vector_type*> basis;
+			std::vector<number> proj;
+
 		//	old norm
 			number oldNorm;
 
@@ -166,6 +174,7 @@ class GMRES
 
 			//	loop gmres iterations
 				size_t numIter = 0;
+				basis.clear();
 				for(size_t j = 0; j < m_restart; ++j)
 				{
 					numIter = j;
@@ -174,8 +183,11 @@ class GMRES
 					if(v[j+1].invalid()) v[j+1] = x.clone_without_values();
 
 #ifdef UG_PARALLEL
-					if(!v[j]->change_storage_type(PST_CONSISTENT))
-						UG_THROW("GMRES: Cannot convert v["<<j+1<<"] to consistent vector.");
+				//	matrix operators make v[j] consistent themselves and overlap
+				//	the communication with the multiplication of the inner rows
+					if(!linear_operator()->accepts_additive_input())
+						if(!v[j]->change_storage_type(PST_CONSISTENT))
+							UG_THROW("GMRES: Cannot convert v["<<j+1<<"] to consistent vector.");
 #endif
 
 				//	compute r = A*v[j]
@@ -204,14 +216,23 @@ class GMRES
 				//	post-process the correction
 					m_corr_post_process.apply (*v[j+1]);
 
-				//	loop previous steps
-					for(size_t i = 0; i <= j; ++i)
+				//	orthogonalize v[j+1] against v[0], ..., v[j] by classical
+				//	Gram-Schmidt with reorthogonalization (CGS2). All products
+				//	of one pass are computed with a single global reduction.
+					basis.push_back(v[j].get());
+					for(int pass = 0; pass < 2; ++pass)
 					{
-					//	h_ij := (r, v[j])
-						h[i][j] = VecProd(*v[j+1], *v[i]);
+					//	h_ij := (v[j+1], v[i]) for all i <= j
+						v[j+1]->dotprods(proj, basis);
+
+						for(size_t i = 0; i <= j; ++i)
+						{
+							if(pass == 0) h[i][j] = proj[i];
+							else h[i][j] += proj[i];
 
-					//	v[j+1] -= h_ij * v[i]
-						VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+						//	v[j+1] -= h_ij * v[i]
+							VecScaleAppend(*v[j+1], *v[i], (-1)*proj[i]);
+						}
 					}
 
 				//	compute h_{j+1,j}
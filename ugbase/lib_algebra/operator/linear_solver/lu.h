@@ -42,6 +42,8 @@
 	#include "lib_algebra/parallelization/parallelization.h"
 #endif
 #include "../preconditioner/ilut_scalar.h"
+#include "lib_algebra/ordering_strategies/algorithms/IOrderingAlgorithm.h"
+#include "supernodal_lu_factorization.h"
 #include "../interface/preconditioned_linear_operator_inverse.h"
 #include "linear_solver.h"
 
@@ -68,6 +70,10 @@ class LU
 	///	Base type
 		typedef IMatrixOperatorInverse<matrix_type,vector_type> base_type;
 
+	///	Ordering type
+		typedef std::vector<size_t> ordering_container_type;
+		typedef IOrderingAlgorithm<TAlgebra, ordering_container_type> ordering_algo_type;
+
 		using base_type::init;
 
 	protected:
@@ -75,7 +81,8 @@ class LU
 
 	public:
 	///	constructor
-		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true)
+		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true),
+			m_bSupernodal(false)
 		{
 #ifdef LAPACK_AVAILABLE
 			m_iMinimumForSparse = 4000;
@@ -108,6 +115,23 @@ class LU
 			m_bShowProgress = b;
 		}
 
+	///	if true, the sparse LU uses the multifrontal supernodal factorization, else ILUT(0) (default)
+	/**
+	 * The supernodal factorization only pivots within the diagonal blocks of
+	 * its supernodes. If no pivot is found there, ILUT(0) is used instead.
+	 */
+		void set_supernodal(bool b)
+		{
+			m_bSupernodal = b;
+		}
+
+	///	sets the fill-reducing ordering of the supernodal LU (default: minimum degree)
+		void set_ordering_algorithm(SmartPtr<ordering_algo_type> ordering_algo)
+		{
+			m_spOrderingAlgo = ordering_algo;
+			m_blockRowStart.clear();
+		}
+
 		virtual const char* name() const {return "LU";}
 
 	private:
@@ -184,13 +208,18 @@ class LU
 			PROFILE_FUNC();
 			m_bDense = false;
 
+			if(m_bSupernodal && init_supernodal(A))
+				return true;
+
 			if(m_bInfo)
 			{
 				UG_LOG("LU using Sparse LU on ");
 				print_info(A);
 				UG_LOG("\n");
 			}
-			ilut_scalar = make_sp(new ILUTScalarPreconditioner<algebra_type>(0.0));
+		//	kept across calls to reuse the ordering for an unchanged pattern
+			if(ilut_scalar.invalid())
+				ilut_scalar = make_sp(new ILUTScalarPreconditioner<algebra_type>(0.0));
 			ilut_scalar->set_sort(m_bSortSparse);
 			ilut_scalar->set_info(m_bInfo);
 			ilut_scalar->set_show_progress(m_bShowProgress);
@@ -200,6 +229,96 @@ class LU
 			return true;
 		}
 
+		bool init_supernodal(const matrix_type &A)
+		{
+			PROFILE_FUNC();
+			ilut_scalar = SPNULL;
+			const size_t blockSize = block_traits<typename matrix_type::value_type>::static_num_rows;
+			const size_t numRows = A.num_rows();
+
+		//	block pattern
+			std::vector<size_t> blockRowStart(numRows+1, 0), blockColInd;
+			for(size_t r=0; r<numRows; r++)
+			{
+				for(typename matrix_type::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+					blockColInd.push_back(it.index());
+				blockRowStart[r+1] = blockColInd.size();
+			}
+
+		//	symbolic factorization (skipped if the pattern is unchanged)
+			if(!m_supernodal.analyzed() || blockRowStart != m_blockRowStart
+				|| blockColInd != m_blockColInd)
+			{
+				m_blockRowStart.swap(blockRowStart);
+				m_blockColInd.swap(blockColInd);
+
+				std::vector<size_t> blockPerm;
+				if(m_spOrderingAlgo.valid())
+				{
+					m_spOrderingAlgo->init(const_cast<matrix_type*>(&A));
+					m_spOrderingAlgo->compute();
+					blockPerm = m_spOrderingAlgo->ordering();
+				}
+				else
+					SupernodalLUFactorization::minimum_degree_ordering(numRows,
+							m_blockRowStart, m_blockColInd, blockPerm);
+
+				std::vector<size_t> rowStart(m_size+1, 0), colInd, perm(m_size);
+				colInd.reserve(m_blockColInd.size()*blockSize*blockSize);
+				for(size_t r=0, k=0; r<numRows; r++)
+					for(size_t bi=0; bi<blockSize; bi++, k++)
+					{
+						for(size_t j=m_blockRowStart[r]; j<m_blockRowStart[r+1]; j++)
+							for(size_t bj=0; bj<blockSize; bj++)
+								colInd.push_back(m_blockColInd[j]*blockSize + bj);
+						rowStart[k+1] = colInd.size();
+						perm[k] = blockPerm[r]*blockSize + bi;
+					}
+
+				m_supernodal.analyze(m_size, rowStart, colInd, perm);
+			}
+
+		//	numeric factorization
+			m_values.resize(m_blockColInd.size()*blockSize*blockSize);
+			for(size_t r=0, k=0; r<numRows; r++)
+				for(size_t bi=0; bi<blockSize; bi++)
+					for(typename matrix_type::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+						for(size_t bj=0; bj<blockSize; bj++)
+							m_values[k++] = BlockRef(it.value(), bi, bj);
+			if(!m_supernodal.factorize(m_values))
+			{
+				UG_LOG("LU: zero pivot in supernodal Sparse LU, using ILUT(0) instead.\n");
+				return false;
+			}
+
+			if(m_bInfo)
+			{
+				UG_LOG("LU using supernodal Sparse LU on ");
+				print_info(A);
+				UG_LOG("\n	" << m_supernodal.num_supernodes() << " supernodes, largest front "
+						<< m_supernodal.max_front_size() << ", factors need "
+						<< GetBytesSizeString(m_supernodal.num_factor_entries()*sizeof(double))
+						<< " of memory.\n");
+			}
+			return true;
+		}
+
+		bool solve_supernodal(vector_type &x, const vector_type &b)
+		{
+			PROFILE_FUNC();
+			m_rhs.resize(m_size);
+			for(size_t i=0, k=0; i<b.size(); i++)
+				for(size_t j=0; j<GetSize(b[i]); j++)
+					m_rhs[k++] = BlockRef(b[i],j);
+
+			m_supernodal.solve(&m_rhs[0]);
+
+			for(size_t i=0, k=0; i<x.size(); i++)
+				for(size_t j=0; j<GetSize(x[i]); j++)
+					BlockRef(x[i],j) = m_rhs[k++];
+			return true;
+		}
+
 		bool solve_dense(vector_type &x, const vector_type &b)
 		{
 			try{
@@ -227,6 +346,8 @@ class LU
 		bool solve_sparse(vector_type &x, const vector_type &b)
 		{
 			PROFILE_FUNC();
+			if(ilut_scalar.invalid())
+				return solve_supernodal(x, b);
 			ilut_scalar->solve(x, b);
 			return true;
 		}
@@ -386,6 +507,9 @@ class LU
 			ss << " Minimum Entries for Sparse LU: " << m_iMinimumForSparse;
 			if(m_iMinimumForSparse==0)
 				ss << " (= always Sparse LU)";
+			ss << "\n Sparse LU: " << (m_bSupernodal ? "supernodal" : "ILUT(0)");
+			if(m_bSupernodal)
+				ss << ", ordering: " << (m_spOrderingAlgo.valid() ? m_spOrderingAlgo->name() : "minimum degree");
 			return ss.str();
 		}
 
@@ -411,6 +535,13 @@ class LU
 		SmartPtr<ILUTScalarPreconditioner<algebra_type> > ilut_scalar;
 		size_t m_iMinimumForSparse;
 		bool m_bSortSparse, m_bInfo, m_bShowProgress;
+
+	///	supernodal sparse LU
+		bool m_bSupernodal;
+		SupernodalLUFactorization m_supernodal;
+		SmartPtr<ordering_algo_type> m_spOrderingAlgo;
+		std::vector<size_t> m_blockRowStart, m_blockColInd;
+		std::vector<double> m_values, m_rhs;
 };
 
 } // end namespace ug
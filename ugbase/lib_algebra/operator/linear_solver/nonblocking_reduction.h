@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__NONBLOCKING_REDUCTION__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__NONBLOCKING_REDUCTION__
+
+#include <vector>
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_methods.h"
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	collects several scalar products and computes their global sums at once
+/**
+ * Pipelined Krylov methods need a number of scalar products per iteration.
+ * Instead of reducing each of them in a blocking call (as done by
+ * ParallelVector::dotprod and ParallelVector::norm), this class gathers the
+ * process-local contributions and sums them up in one single non-blocking
+ * allreduce. Between start() and finish() the caller may perform work that
+ * does not touch the reduced values, e.g. a preconditioner application or a
+ * matrix-vector product.
+ *
+ * Note that the storage types of the vectors are not changed, i.e. the local
+ * products are only correct if the storage types fit:
+ *  - additive (unique) <-> consistent
+ *  - unique <-> unique
+ * Other combinations lead to an exception.
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class NonBlockingVecReduction
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	underlying sequential vector type
+		typedef typename TVector::vector_type seq_vector_type;
+
+	public:
+		NonBlockingVecReduction() : m_bActive(false)
+		{
+			#ifdef UG_PARALLEL
+			m_request = MPI_REQUEST_NULL;
+			#endif
+		}
+
+		~NonBlockingVecReduction() {finish();}
+
+	///	removes all registered values. Must not be called while a reduction is active.
+		void clear()
+		{
+			UG_COND_THROW(m_bActive, "NonBlockingVecReduction::clear: "
+							"Reduction still active.");
+			m_vLocal.clear();
+			m_vGlobal.clear();
+		}
+
+	///	adds the local part of (a,b) and returns the index of the value
+		size_t add_prod(const vector_type& a, const vector_type& b)
+		{
+			#ifdef UG_PARALLEL
+			if(!((a.has_storage_type(PST_ADDITIVE) && b.has_storage_type(PST_CONSISTENT))
+				|| (a.has_storage_type(PST_CONSISTENT) && b.has_storage_type(PST_ADDITIVE))
+				|| (a.has_storage_type(PST_UNIQUE) && b.has_storage_type(PST_UNIQUE))))
+				UG_THROW("NonBlockingVecReduction::add_prod: "
+						"Inadequate storage format of Vectors.");
+			#endif
+
+			double s = 0.0;
+			VecProdAdd(static_cast<const seq_vector_type&>(a),
+			           static_cast<const seq_vector_type&>(b), s);
+			return add_value(s);
+		}
+
+	///	adds the local part of ||a||^2 and returns the index of the value
+		size_t add_norm_squared(const vector_type& a)
+		{
+			#ifdef UG_PARALLEL
+			if(!a.has_storage_type(PST_UNIQUE))
+				UG_THROW("NonBlockingVecReduction::add_norm_squared: "
+						"Vector must be unique.");
+			#endif
+
+			double s = 0.0;
+			VecNormSquaredAdd(static_cast<const seq_vector_type&>(a), s);
+			return add_value(s);
+		}
+
+	///	starts the global summation of all registered values
+	/**	The process communicator is taken from the layouts of v.*/
+		void start(const vector_type& v)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			UG_COND_THROW(m_bActive, "NonBlockingVecReduction::start: "
+							"Reduction already active.");
+
+			m_vGlobal = m_vLocal;
+			#ifdef UG_PARALLEL
+			if(!m_vLocal.empty() && !v.layouts()->proc_comm().empty())
+			{
+				v.layouts()->proc_comm().iallreduce(&m_vLocal.front(), &m_vGlobal.front(),
+							(int)m_vLocal.size(), PCL_DT_DOUBLE, PCL_RO_SUM, m_request);
+			}
+			#endif
+			m_bActive = true;
+		}
+
+	///	waits until the global values are available
+		void finish()
+		{
+			if(!m_bActive) return;
+			PROFILE_FUNC_GROUP("algebra");
+			#ifdef UG_PARALLEL
+			if(m_request != MPI_REQUEST_NULL)
+				pcl::MPI_Wait(&m_request);
+			m_request = MPI_REQUEST_NULL;
+			#endif
+			m_bActive = false;
+		}
+
+	///	returns the global value with the given index (only valid after finish())
+		number value(size_t i) const
+		{
+			UG_COND_THROW(m_bActive, "NonBlockingVecReduction::value: "
+							"Reduction still active.");
+			UG_ASSERT(i < m_vGlobal.size(), "Invalid index " << i);
+			return (number)m_vGlobal[i];
+		}
+
+	///	number of registered values
+		size_t size() const {return m_vLocal.size();}
+
+	protected:
+		size_t add_value(double s)
+		{
+			UG_COND_THROW(m_bActive, "NonBlockingVecReduction: "
+							"Cannot add values while reduction is active.");
+			m_vLocal.push_back(s);
+			return m_vLocal.size() - 1;
+		}
+
+	protected:
+	///	process-local and global values
+		std::vector<double> m_vLocal;
+		std::vector<double> m_vGlobal;
+
+	///	true between start() and finish()
+		bool m_bActive;
+
+		#ifdef UG_PARALLEL
+	///	request of the pending allreduce
+		MPI_Request m_request;
+		#endif
+
+	private:
+		NonBlockingVecReduction(const NonBlockingVecReduction&);
+		NonBlockingVecReduction& operator=(const NonBlockingVecReduction&);
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__NONBLOCKING_REDUCTION__ */
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__
+
+#include <cmath>
+#include <string>
+#include <sstream>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "common/profiler/profiler.h"
+#include "common/util/string_util.h"
+#include "nonblocking_reduction.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined BiCGStab method as a solver for linear operators
+/**
+ * This class implements the pipelined BiCGStab method with right
+ * preconditioning. Compared to BiCGStab, auxiliary recurrences are used such
+ * that the scalar products of each half step are independent of each other.
+ * They are summed up in one non-blocking global reduction per half step, which
+ * is overlapped with the application of the preconditioner and the
+ * matrix-vector product of that half step. Thus, only two global
+ * synchronization points remain per iteration (compared to five for BiCGStab
+ * including the defect norms).
+ *
+ * The vectors computed by the preconditioner (r_hat, w_hat, s_hat, z_hat,
+ * p_hat, q_hat) are stored consistent, all other vectors unique.
+ *
+ * If the convergence check only needs the euclidean norm of the defect
+ * (see IConvergenceCheck::uses_euclidean_norm), this norm is computed in the
+ * same reduction. Else, the convergence check is updated with the defect
+ * vector as usual, which requires an additional reduction. In contrast to
+ * BiCGStab, the defect is only checked after full steps.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Cools, Vanroose, "The communication-hiding pipelined BiCGstab method for
+ *   the parallel solution of large unsymmetric linear systems", Parallel
+ *   Computing 65 (2017), p.1-20, Alg. 4
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedBiCGStab
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipelinedBiCGStab() :
+			m_numRestarts(0), m_minOrtho(0.0)
+		{};
+
+		PipelinedBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond ),
+			  m_numRestarts(0), m_minOrtho(0.0)
+		{}
+
+		PipelinedBiCGStab( SmartPtr<ILinearIterator<vector_type> > spPrecond,
+		                   SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type(spPrecond, spConvCheck),
+			  m_numRestarts(0), m_minOrtho(0.0)
+		{};
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedBiCGStab";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	// 	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipelinedBiCGStab_apply_return_defect, "PipelinedBiCGStab algebra");
+
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Inadequate storage format of Vectors.");
+			#endif
+
+		// 	build defect:  r := b - A*x
+			linear_operator()->apply_sub(b, x);
+			vector_type& r = b;
+
+		//	convert r to unique
+			#ifdef UG_PARALLEL
+			if(!r.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipelinedBiCGStab: Cannot convert r to unique vector.");
+			#endif
+
+		// 	create unique vectors
+			SmartPtr<vector_type> spR0 = r.clone_without_values(); vector_type& r0 = *spR0;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spT = r.clone_without_values(); vector_type& t = *spT;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spV = r.clone_without_values(); vector_type& v = *spV;
+			SmartPtr<vector_type> spQ = r.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spY = r.clone_without_values(); vector_type& y = *spY;
+
+		// 	create consistent (preconditioned) vectors
+			SmartPtr<vector_type> spRh = x.clone_without_values(); vector_type& rh = *spRh;
+			SmartPtr<vector_type> spWh = x.clone_without_values(); vector_type& wh = *spWh;
+			SmartPtr<vector_type> spSh = x.clone_without_values(); vector_type& sh = *spSh;
+			SmartPtr<vector_type> spZh = x.clone_without_values(); vector_type& zh = *spZh;
+			SmartPtr<vector_type> spPh = x.clone_without_values(); vector_type& ph = *spPh;
+			SmartPtr<vector_type> spQh = x.clone_without_values(); vector_type& qh = *spQh;
+
+		//	prepare convergence check
+			prepare_conv_check();
+			const bool bFusedNorm = convergence_check()->uses_euclidean_norm();
+
+			NonBlockingVecReduction<vector_type> reduction;
+
+		//	needed variables
+			number rho = 1, alpha = 1, omega = 1, beta = 0, norm_r0 = 0.0;
+
+		//	restart flag (set to true at first run)
+			bool bRestart = true, bFirst = true;
+
+			write_debugXR(x, r, convergence_check()->step());
+
+		// 	Iteration loop
+			for(;;)
+			{
+			//	check if start values have to be set
+				if(bRestart)
+				{
+				// 	reset arbitrary vector
+					r0 = r;
+
+				//	r_hat := M^-1 * r,  w := A * r_hat
+					if(!precondition(rh, r, convergence_check()->step(), 'r'))
+						return false;
+					apply_operator(w, rh);
+
+				//	start reduction of rho = (r0,r) = (r,r) and (r0,w)
+					reduction.clear();
+					const size_t iRho = reduction.add_prod(r0, r);
+					const size_t iR0W = reduction.add_prod(r0, w);
+					reduction.start(r);
+
+				//	overlap with w_hat := M^-1 * w,  t := A * w_hat
+					if(!precondition(wh, w, convergence_check()->step(), 'w'))
+						return false;
+					apply_operator(t, wh);
+
+					reduction.finish();
+
+					rho = reduction.value(iRho);
+					const number r0w = reduction.value(iR0W);
+
+				//	compute start defect norm
+					if(bFirst)
+					{
+						if(bFusedNorm) convergence_check()->start_defect(std::sqrt(rho));
+						else convergence_check()->start(r);
+						if(convergence_check()->iteration_ended()) break;
+						bFirst = false;
+					}
+
+				//	remember start norm
+					norm_r0 = convergence_check()->defect();
+
+				//	check validity of (r0,w)
+					if(r0w == 0.0){
+						UG_LOG("PipelinedBiCGStab: Method breakdown: (r0,w) = "<<r0w<<
+						       " is an invalid value. Aborting iteration.\n");
+						return false;
+					}
+
+				//	alpha = (r0,r) / (r0,w),  start with p_hat = r_hat (beta = 0)
+					alpha = rho / r0w;
+					beta = 0.0;
+
+				//	remove restart flag
+					bRestart = false;
+				}
+
+			//	update the directions
+				if(beta == 0.0)
+				{
+					ph = rh; s = w; sh = wh; z = t;
+				}
+				else
+				{
+				//	p_hat := r_hat + beta * (p_hat - omega * s_hat)
+					VecScaleAdd(ph, 1.0, rh, beta, ph, -beta*omega, sh);
+				//	s := w + beta * (s - omega * z)
+					VecScaleAdd(s, 1.0, w, beta, s, -beta*omega, z);
+				//	s_hat := w_hat + beta * (s_hat - omega * z_hat)
+					VecScaleAdd(sh, 1.0, wh, beta, sh, -beta*omega, zh);
+				//	z := t + beta * (z - omega * v)
+					VecScaleAdd(z, 1.0, t, beta, z, -beta*omega, v);
+				}
+
+			//	q := r - alpha * s,  q_hat := r_hat - alpha * s_hat,  y := w - alpha * z
+				VecScaleAdd(q, 1.0, r, -alpha, s);
+				VecScaleAdd(qh, 1.0, rh, -alpha, sh);
+				VecScaleAdd(y, 1.0, w, -alpha, z);
+
+			//	start reduction of (q,y) and (y,y)
+				reduction.clear();
+				const size_t iQY = reduction.add_prod(q, y);
+				const size_t iYY = reduction.add_prod(y, y);
+				reduction.start(r);
+
+			//	overlap with z_hat := M^-1 * z,  v := A * z_hat
+				if(!precondition(zh, z, convergence_check()->step(), 'z'))
+					return false;
+				apply_operator(v, zh);
+
+				reduction.finish();
+
+			//	check (y,y)
+				const number yy = reduction.value(iYY);
+				if(yy == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown (y,y) = "<<yy<<" is an "
+							"invalid value. Aborting iteration.\n");
+					return false;
+				}
+
+			// 	omega = (q,y)/(y,y)
+				omega = reduction.value(iQY) / yy;
+
+			// 	x := x + alpha * p_hat + omega * q_hat
+				VecScaleAdd(x, 1.0, x, alpha, ph, omega, qh);
+
+			//	r := q - omega * y
+				VecScaleAdd(r, 1.0, q, -omega, y);
+
+			//	r_hat := q_hat - omega * (w_hat - alpha * z_hat)
+				VecScaleAdd(rh, 1.0, qh, -omega, wh, omega*alpha, zh);
+
+			//	w := y - omega * (t - alpha * v)
+				VecScaleAdd(w, 1.0, y, -omega, t, omega*alpha, v);
+
+			//	start reduction of (r0,r), (r0,w), (r0,s), (r0,z) and (r,r)
+				reduction.clear();
+				const size_t iRho = reduction.add_prod(r0, r);
+				const size_t iR0W = reduction.add_prod(r0, w);
+				const size_t iR0S = reduction.add_prod(r0, s);
+				const size_t iR0Z = reduction.add_prod(r0, z);
+				size_t iNorm = 0;
+				if(bFusedNorm) iNorm = reduction.add_norm_squared(r);
+				reduction.start(r);
+
+			//	overlap with w_hat := M^-1 * w,  t := A * w_hat
+				if(!precondition(wh, w, convergence_check()->step(), 'w'))
+					return false;
+				apply_operator(t, wh);
+
+				reduction.finish();
+
+			// 	check convergence
+				if(bFusedNorm)
+					convergence_check()->update_defect(std::sqrt(reduction.value(iNorm)));
+				else
+					convergence_check()->update(r);
+
+				write_debugXR(x, r, convergence_check()->step());
+
+				if(convergence_check()->iteration_ended()) break;
+
+			//	check values
+				if(omega == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with omega = "<<omega<<
+					       ". Aborting iteration.\n");
+					return false;
+				}
+
+			// 	remember current rho and compute new one
+				const number rhoOld = rho;
+				rho = reduction.value(iRho);
+
+			//	check for restart based on fixed step number restart
+				if(m_numRestarts > 0 &&
+					(convergence_check()->step() % m_numRestarts == 0))
+				{
+					std::stringstream ss; ss <<
+					"Restarting: at every "<<m_numRestarts<<" Iterations";
+					convergence_check()->print_line(ss.str());
+					bRestart = true;
+					continue;
+				}
+
+			//	check for restart compare (r, r0) > m_minOrtho * ||r|| ||r0||
+				const number norm_r = convergence_check()->defect();
+				if(fabs(rho)/(norm_r * norm_r0) <= m_minOrtho)
+				{
+					std::stringstream ss; ss <<
+					"Restarting: Min Orthogonality "<<m_minOrtho<<" missed: "
+					<<"(r,r0)="<<fabs(rho)<<", ||r||="<<norm_r<<", ||r0||= "
+					<<norm_r0;
+					convergence_check()->print_line(ss.str());
+					bRestart = true;
+					continue;
+				}
+
+			//	check that rhoOld valid
+				if(rhoOld == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with rhoOld = "<<rhoOld<<
+						   ". Aborting iteration.\n");
+					return false;
+				}
+
+			// 	beta = (alpha/omega) * (rho/rhoOld)
+				beta = (rho/rhoOld) * (alpha/omega);
+
+			//	alpha = rho / ((r0,w) + beta * (r0,s) - beta * omega * (r0,z))
+				const number denom = reduction.value(iR0W) + beta * reduction.value(iR0S)
+									- beta * omega * reduction.value(iR0Z);
+				if(denom == 0.0){
+					UG_LOG("PipelinedBiCGStab: Method breakdown: alpha = "<<denom<<
+					       " is an invalid value. Aborting iteration.\n");
+					return false;
+				}
+				alpha = rho / denom;
+			}
+
+		//	print ending output
+			return convergence_check()->post();
+		}
+
+
+	///	sets to restart at given number of iteration steps
+		void set_restart(int numRestarts) {m_numRestarts = numRestarts;}
+
+	///	sets to restart if given orthogonality missed
+		void set_min_orthogonality(number minOrtho) {m_minOrtho = minOrtho;}
+
+	protected:
+	///	computes c := M^-1 * d and makes c consistent
+		bool precondition(vector_type& c, const vector_type& d, int loopCnt, char phase)
+		{
+			if(preconditioner().valid())
+			{
+				enter_precond_debug_section(loopCnt, phase);
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("PipelinedBiCGStab: Cannot apply preconditioner. Aborting.\n");
+					this->leave_vector_debug_writer_section();
+					return false;
+				}
+				this->leave_vector_debug_writer_section();
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Cannot convert vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	computes c := A * d and makes c unique
+		void apply_operator(vector_type& c, vector_type& d)
+		{
+			linear_operator()->apply(c, d);
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipelinedBiCGStab: Cannot convert vector to unique vector.");
+			#endif
+		}
+
+	///	prepares the output of the convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			std::string ext = GetStringPrintf("_iter%03d", loopCnt);
+			write_debug(r, std::string("PipelinedBiCGStab_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipelinedBiCGStab_Solution") + ext + ".vec");
+		}
+
+	/// debugger section for the preconditioner
+		void enter_precond_debug_section(int loopCnt, char phase)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			std::string ext = GetStringPrintf("-%c_iter%03d", phase, loopCnt);
+			this->enter_vector_debug_writer_section(std::string("PipelinedBiCGStab_Precond") + ext);
+		}
+
+	public:
+		virtual std::string config_string() const
+		{
+			std::stringstream ss;
+			ss << "PipelinedBiCGStab( restart = " << m_numRestarts << ", min_orthogonality = " << m_minOrtho << ")\n";
+			ss << base_type::config_string_preconditioner_convergence_check();
+			return ss.str();
+		}
+
+	protected:
+	/// restarts at every numRestarts steps (numRestarts <= 0 --> never)
+		int m_numRestarts;
+
+	///	minimal value in (0,1) accepted for Orthoginality before restart
+		number m_minOrtho;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__ */
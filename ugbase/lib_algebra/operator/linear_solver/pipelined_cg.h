@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+
+#include <cmath>
+#include <string>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "common/profiler/profiler.h"
+#include "nonblocking_reduction.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined CG method as a solver for linear operators
+/**
+ * This class implements the pipelined preconditioned CG method. It is
+ * mathematically equivalent to the CG method, but uses additional recurrences
+ * such that all scalar products of one iteration are independent of each
+ * other. They are summed up in one single non-blocking global reduction,
+ * which is overlapped with the application of the preconditioner and the
+ * matrix-vector product. Per iteration, only one global synchronization point
+ * remains (compared to two plus the defect norm for CG).
+ *
+ * If the convergence check only needs the euclidean norm of the defect
+ * (see IConvergenceCheck::uses_euclidean_norm), this norm is computed in the
+ * same reduction. Else, the convergence check is updated with the defect
+ * vector as usual, which requires an additional reduction.
+ *
+ * The additional recurrences cost four more vector updates per iteration and
+ * may lead to a slightly lower attainable accuracy than CG.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Ghysels, Vanroose, "Hiding global synchronization latency in the
+ *   preconditioned Conjugate Gradient algorithm", Parallel Computing 40 (2014),
+ *   p.224-238, Alg. 3
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedCG
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipelinedCG() : base_type() {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedCG";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	///	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipelinedCG_apply_return_defect, "PipelinedCG algebra");
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect:"
+								"Inadequate storage format of Vectors.");
+			#endif
+
+		// 	rename r as b (for convenience)
+			vector_type& r = b;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_sub(r, x);
+
+		//	make r unique, such that (r,r) can be computed locally
+			#ifdef UG_PARALLEL
+			if(!r.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipelinedCG::apply_return_defect: "
+								"Cannot convert r to unique vector.");
+			#endif
+
+		// 	create help vectors (preconditioned vectors u, m, p, q are
+		//	consistent, operator results w, n, s, z are unique)
+			SmartPtr<vector_type> spU = x.clone_without_values(); vector_type& u = *spU;
+			SmartPtr<vector_type> spM = x.clone_without_values(); vector_type& m = *spM;
+			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
+			SmartPtr<vector_type> spQ = x.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spN = r.clone_without_values(); vector_type& n = *spN;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+
+			write_debugXR(x, r, convergence_check()->step());
+
+		// 	u := M^-1 * r,  w := A * u
+			if(!precondition(u, r, convergence_check()->step()))
+				return false;
+			apply_operator(w, u);
+
+		//	prepare the convergence check
+			prepare_conv_check();
+			const bool bFusedNorm = convergence_check()->uses_euclidean_norm();
+			if(!bFusedNorm)
+				convergence_check()->start(r);
+
+			NonBlockingVecReduction<vector_type> reduction;
+			number alpha = 0.0, gammaOld = 0.0;
+
+		// 	Iteration loop
+			for(bool bFirst = true; ; bFirst = false)
+			{
+			//	start the reduction of gamma = (r,u), delta = (w,u) and (r,r)
+				reduction.clear();
+				const size_t iGamma = reduction.add_prod(r, u);
+				const size_t iDelta = reduction.add_prod(w, u);
+				size_t iNorm = 0;
+				if(bFusedNorm) iNorm = reduction.add_norm_squared(r);
+				reduction.start(r);
+
+			//	overlap the reduction with m := M^-1 * w,  n := A * m
+				if(!precondition(m, w, convergence_check()->step()))
+					return false;
+				apply_operator(n, m);
+
+				reduction.finish();
+
+			// 	Check convergence
+				if(bFusedNorm)
+				{
+					const number defect = std::sqrt(reduction.value(iNorm));
+					if(bFirst) convergence_check()->start_defect(defect);
+					else convergence_check()->update_defect(defect);
+				}
+				else if(!bFirst)
+					convergence_check()->update(r);
+
+				if(convergence_check()->iteration_ended()) break;
+
+				const number gamma = reduction.value(iGamma);
+				const number delta = reduction.value(iDelta);
+
+			//	beta = gamma / gammaOld,  alpha = gamma / (delta - beta * gamma / alphaOld)
+				number beta = 0.0;
+				number lambda = delta;
+				if(!bFirst)
+				{
+					beta = gamma / gammaOld;
+					lambda = delta - beta * gamma / alpha;
+				}
+
+			//	check lambda
+				if(lambda == 0.0)
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': lambda=" <<
+							lambda<< " is not admitted. Aborting solver.\n");
+					return false;
+				}
+				alpha = gamma / lambda;
+
+			//	update the directions
+				if(bFirst)
+				{
+					z = n; q = m; s = w; p = u;
+				}
+				else
+				{
+					VecScaleAdd(z, 1.0, n, beta, z);
+					VecScaleAdd(q, 1.0, m, beta, q);
+					VecScaleAdd(s, 1.0, w, beta, s);
+					VecScaleAdd(p, 1.0, u, beta, p);
+				}
+
+			// 	Update x := x + alpha*p,  r := r - alpha*s
+				VecScaleAdd(x, 1.0, x, alpha, p);
+				VecScaleAdd(r, 1.0, r, -alpha, s);
+
+			// 	Update u := u - alpha*q,  w := w - alpha*z
+				VecScaleAdd(u, 1.0, u, -alpha, q);
+				VecScaleAdd(w, 1.0, w, -alpha, z);
+
+				write_debugXR(x, r, convergence_check()->step()+1);
+
+			//	remember old gamma
+				gammaOld = gamma;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	computes c := M^-1 * d and makes c consistent
+		bool precondition(vector_type& c, const vector_type& d, int loopCnt)
+		{
+			if(preconditioner().valid())
+			{
+				enter_precond_debug_section(loopCnt);
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': "
+							"Cannot apply preconditioner. Aborting.\n");
+					this->leave_vector_debug_writer_section();
+					return false;
+				}
+				this->leave_vector_debug_writer_section();
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect: "
+								"Cannot convert vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	computes c := A * d and makes c unique
+		void apply_operator(vector_type& c, vector_type& d)
+		{
+			linear_operator()->apply(c, d);
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipelinedCG::apply_return_defect: "
+								"Cannot convert vector to unique vector.");
+			#endif
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; snprintf(ext, 20, "_iter%03d", loopCnt);
+			write_debug(r, std::string("PipelinedCG_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipelinedCG_Solution") + ext + ".vec");
+		}
+
+	/// debugger section for the preconditioner
+		void enter_precond_debug_section(int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; snprintf(ext, 20, "_iter%03d", loopCnt);
+			this->enter_vector_debug_writer_section(std::string("PipelinedCG_Precond_") + ext);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__ */
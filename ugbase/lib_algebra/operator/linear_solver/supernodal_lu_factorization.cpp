@@ -0,0 +1,689 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/minimum_degree_ordering.hpp>
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/cpu_algebra/algebra_threads.h"
+#include "supernodal_lu_factorization.h"
+
+#if defined(LAPACK_AVAILABLE) && defined(BLAS_AVAILABLE)
+#include "lib_algebra/small_algebra/lapack/lapack.h"
+#endif
+
+namespace ug{
+
+namespace{
+
+///	C -= A*B for column major matrices (A: m x k, B: k x n, C: m x n)
+void GemmSub(size_t m, size_t n, size_t k,
+             const double* A, size_t lda, const double* B, size_t ldb,
+             double* C, size_t ldc)
+{
+	if(m == 0 || n == 0 || k == 0) return;
+
+#if defined(LAPACK_AVAILABLE) && defined(BLAS_AVAILABLE)
+	if(m*n*k >= 4096)
+	{
+		char trans = 'N';
+		lapack_int im = (lapack_int)m, in = (lapack_int)n, ik = (lapack_int)k;
+		lapack_int ilda = (lapack_int)lda, ildb = (lapack_int)ldb, ildc = (lapack_int)ldc;
+		double alpha = -1.0, beta = 1.0;
+		dgemm_(&trans, &trans, &im, &in, &ik, &alpha, A, &ilda, B, &ildb, &beta, C, &ildc);
+		return;
+	}
+#endif
+
+//	the columns of C are independent, the inner loop runs over contiguous
+//	columns of A and C. k is blocked so that the used columns of A stay in cache.
+	const size_t kBlock = 64;
+	const int numCols = (int)n;
+
+#ifdef UG_OPENMP
+	const size_t numThreads = (m*n*k >= (size_t(1) << 18)) ? AlgebraNumThreads() : 1;
+	#pragma omp parallel for schedule(static) num_threads(numThreads)
+#endif
+	for(int jc = 0; jc < numCols; ++jc)
+	{
+		const size_t j = (size_t)jc;
+		double* c = C + j*ldc;
+		const double* b = B + j*ldb;
+		for(size_t p0 = 0; p0 < k; p0 += kBlock)
+		{
+			const size_t p1 = std::min(k, p0 + kBlock);
+			for(size_t p = p0; p < p1; ++p)
+			{
+				const double bp = b[p];
+				if(bp == 0.0) continue;
+				const double* a = A + p*lda;
+				for(size_t i = 0; i < m; ++i)
+					c[i] -= a[i] * bp;
+			}
+		}
+	}
+}
+
+}// end anonymous namespace
+
+
+SupernodalLUFactorization::SupernodalLUFactorization()
+{
+	clear();
+}
+
+void SupernodalLUFactorization::clear()
+{
+	m_n = 0;
+	m_nnz = 0;
+	m_numFactorEntries = 0;
+	m_maxFront = 0;
+	m_bAnalyzed = false;
+	m_bFactorized = false;
+
+	m_perm.clear();
+	m_snodeStart.clear();
+	m_snodeParent.clear();
+	m_numChildren.clear();
+	m_rowStart.clear();
+	m_rowIdx.clear();
+	m_relIdx.clear();
+	m_asmStart.clear();
+	m_asmEntry.clear();
+	m_asmOffset.clear();
+	m_LOffset.clear();
+	m_UOffset.clear();
+	m_pivot.clear();
+	std::vector<double>().swap(m_factor);
+}
+
+void SupernodalLUFactorization::
+build_symmetric_pattern(const std::vector<size_t>& rowStart,
+                        const std::vector<size_t>& colInd,
+                        const std::vector<size_t>& perm,
+                        std::vector<size_t>& adjStart,
+                        std::vector<size_t>& adj) const
+{
+	const size_t n = m_n;
+
+//	count entries of A+A^T (with duplicates)
+	std::vector<size_t> cnt(n+1, 0);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = rowStart[r]; k < rowStart[r+1]; ++k)
+		{
+			const size_t c = colInd[k];
+			if(c == r) continue;
+			cnt[perm[r]]++; cnt[perm[c]]++;
+		}
+
+	std::vector<size_t> tmpStart(n+1, 0);
+	for(size_t i = 0; i < n; ++i) tmpStart[i+1] = tmpStart[i] + cnt[i];
+	std::vector<size_t> tmp(tmpStart[n]);
+	std::vector<size_t> pos(tmpStart.begin(), tmpStart.end()-1);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = rowStart[r]; k < rowStart[r+1]; ++k)
+		{
+			const size_t c = colInd[k];
+			if(c == r) continue;
+			const size_t i = perm[r], j = perm[c];
+			tmp[pos[i]++] = j;
+			tmp[pos[j]++] = i;
+		}
+
+//	remove duplicates and sort
+	adjStart.assign(n+1, 0);
+	adj.clear(); adj.reserve(tmp.size());
+	std::vector<size_t> mark(n, n);
+	for(size_t i = 0; i < n; ++i)
+	{
+		const size_t first = adj.size();
+		for(size_t k = tmpStart[i]; k < tmpStart[i+1]; ++k)
+		{
+			const size_t j = tmp[k];
+			if(mark[j] == i) continue;
+			mark[j] = i;
+			adj.push_back(j);
+		}
+		std::sort(adj.begin() + first, adj.end());
+		adjStart[i+1] = adj.size();
+	}
+}
+
+void SupernodalLUFactorization::
+elimination_tree(const std::vector<size_t>& adjStart,
+                 const std::vector<size_t>& adj,
+                 std::vector<size_t>& parent) const
+{
+//	Liu's algorithm with path compression
+	const size_t n = m_n;
+	parent.assign(n, n);
+	std::vector<size_t> ancestor(n, n);
+	for(size_t i = 0; i < n; ++i)
+		for(size_t k = adjStart[i]; k < adjStart[i+1]; ++k)
+		{
+			size_t j = adj[k];
+			if(j >= i) break;
+			while(ancestor[j] != n && ancestor[j] != i)
+			{
+				const size_t next = ancestor[j];
+				ancestor[j] = i;
+				j = next;
+			}
+			if(ancestor[j] == n)
+			{
+				ancestor[j] = i;
+				parent[j] = i;
+			}
+		}
+}
+
+void SupernodalLUFactorization::
+minimum_degree_ordering(size_t n, const std::vector<size_t>& rowStart,
+                        const std::vector<size_t>& colInd,
+                        std::vector<size_t>& perm)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS> G_t;
+
+	perm.resize(n);
+	if(n == 0) return;
+
+//	the graph has to contain both directions of each edge
+	G_t g(n);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = rowStart[r]; k < rowStart[r+1]; ++k)
+		{
+			const size_t c = colInd[k];
+			if(c == r) continue;
+			boost::add_edge(r, c, g);
+			bool bSym = false;
+			for(size_t k2 = rowStart[c]; k2 < rowStart[c+1]; ++k2)
+				if(colInd[k2] == r) {bSym = true; break;}
+			if(!bSym) boost::add_edge(c, r, g);
+		}
+
+	std::vector<int> degree(n, 0), invPerm(n, 0), newToOld(n, 0), snodeSize(n, 1);
+	boost::property_map<G_t, boost::vertex_index_t>::type id = boost::get(boost::vertex_index, g);
+	boost::minimum_degree_ordering(g,
+		boost::make_iterator_property_map(&degree[0], id, degree[0]),
+		&invPerm[0], &newToOld[0],
+		boost::make_iterator_property_map(&snodeSize[0], id, snodeSize[0]),
+		0, id);
+
+	for(size_t i = 0; i < n; ++i)
+		perm[i] = (size_t)invPerm[i];
+}
+
+size_t SupernodalLUFactorization::front_index(size_t s, size_t row) const
+{
+	const size_t f = m_snodeStart[s], l = m_snodeStart[s+1];
+	if(row >= f && row < l) return row - f;
+
+	const size_t* begin = &m_rowIdx[0] + m_rowStart[s];
+	const size_t* end = &m_rowIdx[0] + m_rowStart[s+1];
+	const size_t* it = std::lower_bound(begin, end, row);
+	UG_COND_THROW(it == end || *it != row,
+	              "SupernodalLUFactorization: row " << row
+	              << " not contained in front of supernode " << s);
+	return (l - f) + (it - begin);
+}
+
+void SupernodalLUFactorization::
+analyze(size_t n, const std::vector<size_t>& rowStart,
+        const std::vector<size_t>& colInd,
+        const std::vector<size_t>& perm)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	clear();
+
+	UG_COND_THROW(rowStart.size() != n+1,
+	              "SupernodalLUFactorization: row pointer has wrong size.");
+	UG_COND_THROW(colInd.size() < rowStart[n],
+	              "SupernodalLUFactorization: column index array too short.");
+
+	m_n = n;
+	m_nnz = rowStart[n];
+
+//	initial ordering
+	std::vector<size_t> perm0(n);
+	if(perm.empty())
+		for(size_t i = 0; i < n; ++i) perm0[i] = i;
+	else
+	{
+		UG_COND_THROW(perm.size() != n,
+		              "SupernodalLUFactorization: permutation has size "
+		              << perm.size() << ", but matrix has " << n << " rows.");
+		std::vector<bool> used(n, false);
+		for(size_t i = 0; i < n; ++i)
+		{
+			UG_COND_THROW(perm[i] >= n || used[perm[i]],
+			              "SupernodalLUFactorization: invalid permutation.");
+			used[perm[i]] = true;
+			perm0[i] = perm[i];
+		}
+	}
+
+//	elimination tree in initial ordering
+	std::vector<size_t> adjStart, adj, parent;
+	build_symmetric_pattern(rowStart, colInd, perm0, adjStart, adj);
+	elimination_tree(adjStart, adj, parent);
+
+//	postorder the elimination tree, so that subtrees (and supernodes) are contiguous
+	std::vector<size_t> head(n+1, n), next(n, n);
+	for(size_t j = n; j-- > 0; )
+	{
+		next[j] = head[parent[j]];
+		head[parent[j]] = j;
+	}
+	std::vector<size_t> post(n, n);
+	{
+		std::vector<size_t> stack; stack.reserve(n);
+		size_t k = 0;
+		for(size_t root = head[n]; root != n; root = next[root])
+		{
+			stack.push_back(root);
+			while(!stack.empty())
+			{
+				const size_t p = stack.back();
+				const size_t child = head[p];
+				if(child == n)
+				{
+					stack.pop_back();
+					post[p] = k++;
+				}
+				else
+				{
+					head[p] = next[child];
+					stack.push_back(child);
+				}
+			}
+		}
+		UG_COND_THROW(k != n, "SupernodalLUFactorization: postorder failed.");
+	}
+
+	m_perm.resize(n);
+	for(size_t i = 0; i < n; ++i) m_perm[i] = post[perm0[i]];
+
+//	pattern and tree in final ordering
+	build_symmetric_pattern(rowStart, colInd, m_perm, adjStart, adj);
+	elimination_tree(adjStart, adj, parent);
+
+//	column counts of L (including diagonal)
+	std::vector<size_t> colCount(n, 1), flag(n, n);
+	for(size_t i = 0; i < n; ++i)
+	{
+		flag[i] = i;
+		for(size_t k = adjStart[i]; k < adjStart[i+1]; ++k)
+		{
+			size_t j = adj[k];
+			if(j >= i) break;
+			for(; flag[j] != i; j = parent[j])
+			{
+				flag[j] = i;
+				colCount[j]++;
+			}
+		}
+	}
+
+//	fundamental supernodes
+	std::vector<size_t> numColChildren(n+1, 0);
+	for(size_t j = 0; j < n; ++j) numColChildren[parent[j]]++;
+
+	std::vector<size_t> fundStart;
+	for(size_t j = 0; j < n; ++j)
+		if(j == 0 || parent[j-1] != j || colCount[j-1] != colCount[j] + 1
+			|| numColChildren[j] != 1)
+			fundStart.push_back(j);
+	fundStart.push_back(n);
+
+//	relaxed amalgamation: a supernode is merged into its parent if it is the
+//	last child of the parent (columns adjacent) and only few explicit zeros
+//	are stored in the merged supernode.
+	std::vector<size_t> repCol;
+	m_snodeStart.clear();
+	size_t curW = 0, curM = 0, curZeros = 0;
+	for(size_t s = 0; s+1 < fundStart.size(); ++s)
+	{
+		const size_t f = fundStart[s], l = fundStart[s+1];
+		const size_t w = l - f, m = colCount[f] - w;
+		if(!m_snodeStart.empty())
+		{
+			const size_t lastCol = f - 1;
+			if(parent[lastCol] >= f && parent[lastCol] < l)
+			{
+				const size_t W = curW + w;
+				const size_t zeros = curZeros + 2 * curW * (w + m - curM);
+				const size_t total = (W + m) * W + W * m;
+				if(W <= 4 || (W <= 16 && 5*zeros <= total) || 20*zeros <= total)
+				{
+					curW = W; curM = m; curZeros = zeros;
+					repCol.back() = f;
+					continue;
+				}
+			}
+		}
+		m_snodeStart.push_back(f);
+		repCol.push_back(f);
+		curW = w; curM = m; curZeros = 0;
+	}
+	m_snodeStart.push_back(n);
+	const size_t numSnodes = repCol.size();
+
+	std::vector<size_t> colSnode(n);
+	for(size_t s = 0; s < numSnodes; ++s)
+		for(size_t j = m_snodeStart[s]; j < m_snodeStart[s+1]; ++j)
+			colSnode[j] = s;
+
+//	row structure below the diagonal block of each supernode: structure of
+//	the representative column (first column of its topmost fundamental part)
+	m_rowStart.assign(numSnodes+1, 0);
+	for(size_t s = 0; s < numSnodes; ++s)
+		m_rowStart[s+1] = m_rowStart[s]
+		                  + colCount[repCol[s]] - (m_snodeStart[s+1] - repCol[s]);
+	m_rowIdx.resize(m_rowStart[numSnodes]);
+	{
+		std::vector<size_t> pos(m_rowStart.begin(), m_rowStart.end()-1);
+		flag.assign(n, n);
+		for(size_t i = 0; i < n; ++i)
+		{
+			flag[i] = i;
+			for(size_t k = adjStart[i]; k < adjStart[i+1]; ++k)
+			{
+				size_t j = adj[k];
+				if(j >= i) break;
+				for(; flag[j] != i; j = parent[j])
+				{
+					flag[j] = i;
+					const size_t s = colSnode[j];
+					if(j == repCol[s] && i >= m_snodeStart[s+1])
+						m_rowIdx[pos[s]++] = i;
+				}
+			}
+		}
+		for(size_t s = 0; s < numSnodes; ++s)
+			UG_COND_THROW(pos[s] != m_rowStart[s+1],
+			              "SupernodalLUFactorization: inconsistent row structure.");
+	}
+
+//	supernodal tree
+	m_snodeParent.assign(numSnodes, numSnodes);
+	m_numChildren.assign(numSnodes, 0);
+	for(size_t s = 0; s < numSnodes; ++s)
+	{
+		const size_t p = parent[m_snodeStart[s+1]-1];
+		if(p == n) continue;
+		m_snodeParent[s] = colSnode[p];
+		m_numChildren[colSnode[p]]++;
+	}
+
+//	position of rows in the parent front (for extend-add)
+	m_relIdx.resize(m_rowIdx.size());
+	for(size_t s = 0; s < numSnodes; ++s)
+	{
+		if(m_rowStart[s] == m_rowStart[s+1]) continue;
+		const size_t p = m_snodeParent[s];
+		UG_COND_THROW(p == numSnodes,
+		              "SupernodalLUFactorization: root supernode with off-diagonal rows.");
+		for(size_t k = m_rowStart[s]; k < m_rowStart[s+1]; ++k)
+			m_relIdx[k] = front_index(p, m_rowIdx[k]);
+	}
+
+//	assembly of the original entries: entry (i,j) is assembled into the
+//	front of the supernode containing min(i,j)
+	m_asmStart.assign(numSnodes+1, 0);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = rowStart[r]; k < rowStart[r+1]; ++k)
+			m_asmStart[colSnode[std::min(m_perm[r], m_perm[colInd[k]])]+1]++;
+	for(size_t s = 0; s < numSnodes; ++s) m_asmStart[s+1] += m_asmStart[s];
+	m_asmEntry.resize(m_nnz);
+	m_asmOffset.resize(m_nnz);
+	{
+		std::vector<size_t> pos(m_asmStart.begin(), m_asmStart.end()-1);
+		for(size_t r = 0; r < n; ++r)
+			for(size_t k = rowStart[r]; k < rowStart[r+1]; ++k)
+			{
+				const size_t i = m_perm[r], j = m_perm[colInd[k]];
+				const size_t s = colSnode[std::min(i,j)];
+				const size_t ld = (m_snodeStart[s+1] - m_snodeStart[s])
+				                  + (m_rowStart[s+1] - m_rowStart[s]);
+				m_asmEntry[pos[s]] = k;
+				m_asmOffset[pos[s]] = front_index(s, j)*ld + front_index(s, i);
+				pos[s]++;
+			}
+	}
+
+//	storage for the factors
+	m_LOffset.resize(numSnodes);
+	m_UOffset.resize(numSnodes);
+	size_t offset = 0;
+	m_maxFront = 0;
+	for(size_t s = 0; s < numSnodes; ++s)
+	{
+		const size_t w = m_snodeStart[s+1] - m_snodeStart[s];
+		const size_t m = m_rowStart[s+1] - m_rowStart[s];
+		m_LOffset[s] = offset; offset += (w+m)*w;
+		m_maxFront = std::max(m_maxFront, w+m);
+	}
+	for(size_t s = 0; s < numSnodes; ++s)
+	{
+		const size_t w = m_snodeStart[s+1] - m_snodeStart[s];
+		const size_t m = m_rowStart[s+1] - m_rowStart[s];
+		m_UOffset[s] = offset; offset += w*m;
+	}
+	m_numFactorEntries = offset;
+	m_pivot.resize(n);
+
+	m_bAnalyzed = true;
+}
+
+bool SupernodalLUFactorization::factorize(const std::vector<double>& values)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(!m_bAnalyzed,
+	              "SupernodalLUFactorization: factorize called before analyze.");
+	UG_COND_THROW(values.size() < m_nnz,
+	              "SupernodalLUFactorization: expected " << m_nnz << " values, got "
+	              << values.size() << ".");
+
+	m_bFactorized = false;
+	m_factor.resize(m_numFactorEntries);
+
+	const size_t numSnodes = m_snodeParent.size();
+	std::vector<double> front(m_maxFront*m_maxFront);
+
+//	stack of contribution blocks (in postorder, the children of a supernode
+//	are the topmost entries when the supernode is processed)
+	std::vector<double> stack;
+	std::vector<size_t> stackSnode, stackOffset;
+
+	for(size_t s = 0; s < numSnodes; ++s)
+	{
+		const size_t f = m_snodeStart[s];
+		const size_t w = m_snodeStart[s+1] - f;
+		const size_t m = m_rowStart[s+1] - m_rowStart[s];
+		const size_t ld = w + m;
+
+	//	assemble original entries
+		std::fill(front.begin(), front.begin() + ld*ld, 0.0);
+		for(size_t k = m_asmStart[s]; k < m_asmStart[s+1]; ++k)
+			front[m_asmOffset[k]] += values[m_asmEntry[k]];
+
+	//	extend-add contribution blocks of the children
+		for(size_t c = 0; c < m_numChildren[s]; ++c)
+		{
+			const size_t child = stackSnode.back();
+			const size_t mc = m_rowStart[child+1] - m_rowStart[child];
+			const size_t* rel = &m_relIdx[m_rowStart[child]];
+			const double* blk = &stack[stackOffset.back()];
+			for(size_t jj = 0; jj < mc; ++jj)
+			{
+				double* col = &front[rel[jj]*ld];
+				for(size_t ii = 0; ii < mc; ++ii)
+					col[rel[ii]] += blk[jj*mc + ii];
+			}
+			stack.resize(stackOffset.back());
+			stackOffset.pop_back();
+			stackSnode.pop_back();
+		}
+
+	//	factorize the supernode columns with partial pivoting in the diagonal block
+		for(size_t k = 0; k < w; ++k)
+		{
+			double* colK = &front[k*ld];
+			size_t p = k;
+			for(size_t r = k+1; r < w; ++r)
+				if(std::fabs(colK[r]) > std::fabs(colK[p])) p = r;
+
+		//	no pivot in the diagonal block, the rows of other supernodes are not
+		//	considered to keep the symbolic factorization
+			if(colK[p] == 0.0)
+				return false;
+
+			m_pivot[f+k] = p;
+			if(p != k)
+				for(size_t c = 0; c < ld; ++c)
+					std::swap(front[c*ld + k], front[c*ld + p]);
+
+			const double invPivot = 1.0 / colK[k];
+			for(size_t r = k+1; r < ld; ++r) colK[r] *= invPivot;
+
+			for(size_t c = k+1; c < w; ++c)
+			{
+				double* colC = &front[c*ld];
+				const double u = colC[k];
+				if(u == 0.0) continue;
+				for(size_t r = k+1; r < ld; ++r) colC[r] -= colK[r] * u;
+			}
+			for(size_t c = w; c < ld; ++c)
+			{
+				double* colC = &front[c*ld];
+				const double u = colC[k];
+				if(u == 0.0) continue;
+				for(size_t r = k+1; r < w; ++r) colC[r] -= colK[r] * u;
+			}
+		}
+
+	//	Schur complement F22 -= L21 * U12
+		GemmSub(m, m, w, &front[w], ld, &front[w*ld], ld, &front[w*ld + w], ld);
+
+	//	store factors
+		std::copy(front.begin(), front.begin() + ld*w, m_factor.begin() + m_LOffset[s]);
+		for(size_t c = 0; c < m; ++c)
+			std::copy(front.begin() + (w+c)*ld, front.begin() + (w+c)*ld + w,
+			          m_factor.begin() + m_UOffset[s] + c*w);
+
+	//	push contribution block
+		if(m > 0)
+		{
+			stackSnode.push_back(s);
+			stackOffset.push_back(stack.size());
+			for(size_t c = 0; c < m; ++c)
+				stack.insert(stack.end(), front.begin() + (w+c)*ld + w,
+				             front.begin() + (w+c)*ld + ld);
+		}
+	}
+
+	UG_COND_THROW(!stackSnode.empty(),
+	              "SupernodalLUFactorization: contribution blocks left after factorization.");
+	m_bFactorized = true;
+	return true;
+}
+
+void SupernodalLUFactorization::solve(double* x) const
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(!m_bFactorized,
+	              "SupernodalLUFactorization: solve called before factorize.");
+
+	const size_t n = m_n;
+	const size_t numSnodes = m_snodeParent.size();
+	std::vector<double> y(n);
+	for(size_t i = 0; i < n; ++i) y[m_perm[i]] = x[i];
+
+//	forward substitution
+	for(size_t s = 0; s < numSnodes; ++s)
+	{
+		const size_t f = m_snodeStart[s];
+		const size_t w = m_snodeStart[s+1] - f;
+		const size_t m = m_rowStart[s+1] - m_rowStart[s];
+		const size_t ld = w + m;
+		const double* L = &m_factor[m_LOffset[s]];
+		const size_t* R = m_rowIdx.empty() ? NULL : &m_rowIdx[m_rowStart[s]];
+		double* ys = &y[f];
+
+		for(size_t k = 0; k < w; ++k)
+			if(m_pivot[f+k] != k) std::swap(ys[k], ys[m_pivot[f+k]]);
+
+		for(size_t k = 0; k < w; ++k)
+		{
+			const double yk = ys[k];
+			if(yk == 0.0) continue;
+			const double* colK = L + k*ld;
+			for(size_t r = k+1; r < w; ++r) ys[r] -= colK[r] * yk;
+			for(size_t i = 0; i < m; ++i) y[R[i]] -= colK[w+i] * yk;
+		}
+	}
+
+//	backward substitution
+	for(size_t s = numSnodes; s-- > 0; )
+	{
+		const size_t f = m_snodeStart[s];
+		const size_t w = m_snodeStart[s+1] - f;
+		const size_t m = m_rowStart[s+1] - m_rowStart[s];
+		const size_t ld = w + m;
+		const double* L = &m_factor[m_LOffset[s]];
+		const double* U = m_numFactorEntries ? &m_factor[0] + m_UOffset[s] : NULL;
+		const size_t* R = m_rowIdx.empty() ? NULL : &m_rowIdx[m_rowStart[s]];
+		double* ys = &y[f];
+
+		for(size_t c = 0; c < m; ++c)
+		{
+			const double yc = y[R[c]];
+			if(yc == 0.0) continue;
+			const double* colC = U + c*w;
+			for(size_t r = 0; r < w; ++r) ys[r] -= colC[r] * yc;
+		}
+
+		for(size_t k = w; k-- > 0; )
+		{
+			const double* colK = L + k*ld;
+			ys[k] /= colK[k];
+			const double yk = ys[k];
+			for(size_t r = 0; r < k; ++r) ys[r] -= colK[r] * yk;
+		}
+	}
+
+	for(size_t i = 0; i < n; ++i) x[i] = y[m_perm[i]];
+}
+
+} // end namespace ug
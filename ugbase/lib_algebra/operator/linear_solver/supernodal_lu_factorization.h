@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SUPERNODAL_LU_FACTORIZATION__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SUPERNODAL_LU_FACTORIZATION__
+
+#include <cstddef>
+#include <vector>
+
+namespace ug{
+
+///	multifrontal supernodal LU factorization of a sparse scalar matrix
+/**
+ * The factorization is split into a symbolic and a numeric phase:
+ *
+ * - analyze() computes the elimination tree of the symmetrized pattern
+ *   A+A^T in a given fill-reducing ordering (refined by a postorder of the
+ *   tree), groups columns with (nearly) equal structure into supernodes and
+ *   prepares the maps used to assemble the frontal matrices.
+ * - factorize() computes the numeric factors. Each supernode is eliminated
+ *   in a dense frontal matrix: the original entries and the contribution
+ *   blocks of the children are assembled, the supernode columns are
+ *   factorized and the Schur complement is computed by a dense
+ *   matrix-matrix product and passed on to the parent.
+ *
+ * As long as the sparsity pattern does not change, factorize() can be
+ * called repeatedly with new values without redoing the analysis.
+ *
+ * Pivoting is restricted to the diagonal block of each supernode (partial
+ * pivoting among its rows), i.e. the fill-reducing ordering is not changed
+ * by the numeric factorization. The matrix is passed in CSR format with
+ * arbitrary (also unsymmetric) pattern.
+ */
+class SupernodalLUFactorization
+{
+	public:
+		SupernodalLUFactorization();
+
+	///	computes the symbolic factorization of a scalar matrix pattern
+	/**
+	 * \param[in]	n			number of rows (and columns)
+	 * \param[in]	rowStart	CSR row pointers (size n+1)
+	 * \param[in]	colInd		CSR column indices
+	 * \param[in]	perm		fill-reducing permutation (perm[old] = new) or
+	 * 							empty for the natural ordering
+	 */
+		void analyze(size_t n, const std::vector<size_t>& rowStart,
+		             const std::vector<size_t>& colInd,
+		             const std::vector<size_t>& perm);
+
+	///	computes the numeric factorization
+	/**	The values have to be given in the order of colInd as passed to analyze().
+	 * \returns false if no nonzero pivot is found in the diagonal block of a
+	 * supernode (e.g. for saddle point matrices in an unsuitable ordering).
+	 */
+		bool factorize(const std::vector<double>& values);
+
+	///	solves A*x = b. On entry, x contains b.
+		void solve(double* x) const;
+
+	///	releases all memory
+		void clear();
+
+	///	computes a minimum degree ordering (perm[old] = new) of the pattern A+A^T
+		static void minimum_degree_ordering(size_t n, const std::vector<size_t>& rowStart,
+		                                    const std::vector<size_t>& colInd,
+		                                    std::vector<size_t>& perm);
+
+	///	returns if analyze() has been called
+		bool analyzed() const {return m_bAnalyzed;}
+
+	///	returns if factorize() has been called
+		bool factorized() const {return m_bFactorized;}
+
+	///	number of rows
+		size_t num_rows() const {return m_n;}
+
+	///	number of supernodes
+		size_t num_supernodes() const {return m_snodeParent.size();}
+
+	///	number of entries stored in the factors L and U
+		size_t num_factor_entries() const {return m_numFactorEntries;}
+
+	///	size of the largest frontal matrix
+		size_t max_front_size() const {return m_maxFront;}
+
+	protected:
+	///	builds the pattern of P(A+A^T)P^T without diagonal, rows sorted
+		void build_symmetric_pattern(const std::vector<size_t>& rowStart,
+		                             const std::vector<size_t>& colInd,
+		                             const std::vector<size_t>& perm,
+		                             std::vector<size_t>& adjStart,
+		                             std::vector<size_t>& adj) const;
+
+	///	computes the elimination tree of a symmetric pattern
+		void elimination_tree(const std::vector<size_t>& adjStart,
+		                      const std::vector<size_t>& adj,
+		                      std::vector<size_t>& parent) const;
+
+	///	returns the position of row in the front of supernode s
+		size_t front_index(size_t s, size_t row) const;
+
+	protected:
+	///	number of rows
+		size_t m_n;
+
+	///	perm[old] = new, including the postorder of the elimination tree
+		std::vector<size_t> m_perm;
+
+	///	first column of each supernode (size numSupernodes+1)
+		std::vector<size_t> m_snodeStart;
+
+	///	parent supernode (or m_n for roots) and number of children
+		std::vector<size_t> m_snodeParent;
+		std::vector<size_t> m_numChildren;
+
+	///	rows below the diagonal block of each supernode (sorted)
+		std::vector<size_t> m_rowStart;
+		std::vector<size_t> m_rowIdx;
+
+	///	position of the rows in the front of the parent supernode
+		std::vector<size_t> m_relIdx;
+
+	///	original entries assembled into each front: CSR entry and offset in front
+		std::vector<size_t> m_asmStart;
+		std::vector<size_t> m_asmEntry;
+		std::vector<size_t> m_asmOffset;
+
+	///	offsets of the L panels ((w+m) x w) and U panels (w x m) in m_factor
+		std::vector<size_t> m_LOffset;
+		std::vector<size_t> m_UOffset;
+
+	///	local pivot rows within the diagonal blocks
+		std::vector<size_t> m_pivot;
+
+	///	storage for the factors
+		std::vector<double> m_factor;
+		size_t m_numFactorEntries;
+		size_t m_maxFront;
+
+	///	number of entries passed to analyze
+		size_t m_nnz;
+
+		bool m_bAnalyzed;
+		bool m_bFactorized;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SUPERNODAL_LU_FACTORIZATION__ */
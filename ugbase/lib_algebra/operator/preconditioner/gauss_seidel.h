@@ -44,6 +44,8 @@
 
 #include "lib_algebra/ordering_strategies/algorithms/IOrderingAlgorithm.h"
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "multicolor_gauss_seidel.h"
+#include "mixed_precision_matrix.h"
 
 namespace ug{
 
@@ -80,13 +82,17 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 		GaussSeidelBase() :
 			m_relax(1.0),
 			m_bConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_bMulticolor(false),
+			m_bMixedPrecision(false) {};
 
 	/// clone constructor
 		GaussSeidelBase( const GaussSeidelBase<TAlgebra> &parent )
 			: base_type(parent),
 			  m_bConsistentInterfaces(parent.m_bConsistentInterfaces),
 			  m_useOverlap(parent.m_useOverlap),
+			  m_bMulticolor(parent.m_bMulticolor),
+			  m_bMixedPrecision(parent.m_bMixedPrecision),
 			  m_spOrderingAlgo(parent.m_spOrderingAlgo)
 		{
 			set_sor_relax(parent.m_relax);
@@ -100,6 +106,22 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable) {m_useOverlap = enable;}
 
+	///	enables the multicolor variant, processing the rows of a color in parallel
+	/**	The coloring is computed in preprocess. Note, that the multicolor
+	 * Gauss-Seidel uses a different ordering of the rows, thus the result
+	 * differs from the natural ordering (see MulticolorGaussSeidel).*/
+		void set_multicolor(bool enable) {m_bMulticolor = enable;}
+
+	///	stores a single precision copy of the matrix for the smoothing steps
+	/**	The copy is used instead of the matrix in the steps, the multicolor
+	 * variant is not used in this mode (see MixedPrecisionMatrix).*/
+		void set_mixed_precision(bool enable)
+		{
+			UG_COND_THROW(enable && !MixedPrecisionMatrix<typename matrix_type::value_type>::supported(),
+			              name() << ": Mixed precision not supported for this algebra.");
+			m_bMixedPrecision = enable;
+		}
+
 	/// 	sets an ordering algorithm
 		void set_ordering_algorithm(SmartPtr<ordering_algo_type> ordering_algo){
 			m_spOrderingAlgo = ordering_algo;
@@ -151,6 +173,15 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 //			UG_ASSERT(CheckDiagonalInvertible(A), "GS: A has noninvertible diagonal");
 			UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
 
+		//	compute coloring of the matrix graph
+			m_multicolor.clear();
+			if(m_bMulticolor && !m_bMixedPrecision && !m_multicolor.init(*pA))
+				UG_LOG(name() << ": Multicolor variant not supported for this matrix type.\n");
+
+		//	single precision copy of the matrix
+			m_mixed.clear();
+			if(m_bMixedPrecision) m_mixed.init(*pA);
+
 			return true;
 		}
 
@@ -245,6 +276,14 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 		bool m_bConsistentInterfaces;
 		bool m_useOverlap;
 
+	///	multicolor variant (used if coloring is valid)
+		bool m_bMulticolor;
+		MulticolorGaussSeidel<typename matrix_type::value_type> m_multicolor;
+
+	///	single precision copy of the matrix (used if m_bMixedPrecision)
+		bool m_bMixedPrecision;
+		MixedPrecisionMatrix<typename matrix_type::value_type> m_mixed;
+
 
 	/// for ordering algorithms
 		SmartPtr<ordering_algo_type> m_spOrderingAlgo;
@@ -296,7 +335,12 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_LL(A, c, d, relax);
+			if(this->m_mixed.valid())
+				this->m_mixed.gs_step_LL(c, d, relax);
+			else if(this->m_multicolor.valid())
+				this->m_multicolor.gs_step_LL(A, c, d, relax);
+			else
+				gs_step_LL(A, c, d, relax);
 		}
 };
 
@@ -341,7 +385,12 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_UR(A, c, d, relax);
+			if(this->m_mixed.valid())
+				this->m_mixed.gs_step_UR(c, d, relax);
+			else if(this->m_multicolor.valid())
+				this->m_multicolor.gs_step_UR(A, c, d, relax);
+			else
+				gs_step_UR(A, c, d, relax);
 		}
 };
 
@@ -375,7 +424,12 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			sgs_step(A, c, d, relax);
+			if(this->m_mixed.valid())
+				this->m_mixed.sgs_step(c, d, relax);
+			else if(this->m_multicolor.valid())
+				this->m_multicolor.sgs_step(A, c, d, relax);
+			else
+				sgs_step(A, c, d, relax);
 		}
 };
 
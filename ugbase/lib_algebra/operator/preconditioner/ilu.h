@@ -53,6 +53,9 @@
 #include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.h" // for backward compatibility
 
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/algebra_common/sparse_pattern_fingerprint.h"
+#include "ilu_level_scheduling.h"
+#include "mixed_precision_matrix.h"
 
 namespace ug{
 
@@ -338,6 +341,9 @@ class ILU : public IPreconditioner<TAlgebra>
 	///	Base type
 		typedef IPreconditioner<TAlgebra> base_type;
 
+	///	Row iterator type
+		typedef typename matrix_type::const_row_iterator const_row_iterator;
+
 	///	Ordering type
 		typedef std::vector<size_t> ordering_container_type;
 		typedef IOrderingAlgorithm<TAlgebra, ordering_container_type> ordering_algo_type;
@@ -359,6 +365,10 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_useOverlap(false),
 			m_spOrderingAlgo(SPNULL),
 			m_bSortIsIdentity(false),
+			m_bLevelScheduling(false),
+			m_bLevelScheduledLU(false),
+			m_bReusePattern(false),
+			m_bMixedPrecision(false),
 			m_u(nullptr)
 		{};
 
@@ -373,6 +383,10 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_useOverlap(parent.m_useOverlap),
 			m_spOrderingAlgo(parent.m_spOrderingAlgo),
 			m_bSortIsIdentity(false),
+			m_bLevelScheduling(parent.m_bLevelScheduling),
+			m_bLevelScheduledLU(false),
+			m_bReusePattern(parent.m_bReusePattern),
+			m_bMixedPrecision(parent.m_bMixedPrecision),
 			m_u(nullptr)
 		{}
 
@@ -394,6 +408,7 @@ class ILU : public IPreconditioner<TAlgebra>
 	/// 	sets an ordering algorithm
 		void set_ordering_algorithm(SmartPtr<ordering_algo_type> ordering_algo){
 			m_spOrderingAlgo = ordering_algo;
+			m_patternFingerprint.clear();
 		}
 
 	/// set cuthill-mckee sort on/off
@@ -405,6 +420,7 @@ class ILU : public IPreconditioner<TAlgebra>
 			else{
 				m_spOrderingAlgo = SPNULL;
 			}
+			m_patternFingerprint.clear();
 
 			UG_LOG("\nILU: please use 'set_ordering_algorithm(..)' in the future\n");
 		}
@@ -425,6 +441,34 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable)				{m_useOverlap = enable;}
 
+	///	enables the level scheduled (threaded) factorization and triangular solves
+	/**	The results are bitwise identical to the sequential ILU. Only used for
+	 * ILU(0) (beta = 0) on cpu matrices, see LevelScheduledILU.*/
+		void set_level_scheduling(bool enable)			{m_bLevelScheduling = enable;}
+
+	///	reuse ordering and pattern if the matrix pattern is unchanged (default: false)
+	/**	If the pattern of the matrix equals the one of the last init (see
+	 * SparsePatternFingerprint), the ordering is not recomputed and the values
+	 * are copied into the permuted pattern in place. Only enable this for
+	 * orderings which depend on the matrix pattern alone (e.g. Cuthill-McKee).
+	 * Orderings using the values or u (e.g. SCCOrdering) would be reused stale.*/
+		void set_reuse_pattern(bool enable)
+		{
+			m_bReusePattern = enable;
+			m_patternFingerprint.clear();
+		}
+
+	///	stores a single precision copy of the factors for the application
+	/**	The factorization is computed in double precision, only the triangular
+	 * solves use the float copy (see MixedPrecisionMatrix). The level scheduled
+	 * factorization is not used in this mode.*/
+		void set_mixed_precision(bool enable)
+		{
+			UG_COND_THROW(enable && !MixedPrecisionMatrix<typename matrix_type::value_type>::supported(),
+			              name() << ": Mixed precision not supported for this algebra.");
+			m_bMixedPrecision = enable;
+		}
+
 	protected:
 	//	Name of preconditioner
 		virtual const char* name() const {return "ILU";}
@@ -462,6 +506,72 @@ class ILU : public IPreconditioner<TAlgebra>
 			}
 		}
 
+	///	copies the values of A into the ordered pattern of the last call
+	/**	\returns false if the pattern of A has changed, m_ILU is not touched then.*/
+		bool copy_values_reusing_pattern(const matrix_type& A)
+		{
+			if(!m_bReusePattern || !m_patternFingerprint.valid()) return false;
+
+			SparsePatternFingerprint fingerprint(A);
+			if(fingerprint != m_patternFingerprint
+				|| m_ILU.total_num_connections() != m_vSlot.size())
+				return false;
+
+			PROFILE_BEGIN_GROUP(ILU_copy_values, "algebra ILU");
+			size_t k = 0;
+			for(size_t r = 0; r < A.num_rows(); ++r)
+				for(const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+					m_ILU.value_at(m_vSlot[k++]) = it.value();
+
+			#ifdef UG_PARALLEL
+			m_ILU.set_layouts(A.layouts());
+			m_ILU.set_storage_type(A.get_storage_mask());
+			#endif
+			return true;
+		}
+
+	///	remembers the pattern of A and the position of its entries in m_ILU
+		void record_pattern(const matrix_type& A)
+		{
+			m_patternFingerprint.clear();
+			m_vSlot.clear();
+			if(!m_bReusePattern) return;
+
+			const bool bPermuted = m_spOrderingAlgo.valid() && !m_bSortIsIdentity;
+			const matrix_type& ILU = m_ILU;
+			m_vSlot.reserve(A.total_num_connections());
+			for(size_t r = 0; r < A.num_rows(); ++r)
+				for(const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+				{
+					const size_t c = it.index();
+					bool bFound;
+					const_row_iterator p = bPermuted
+						? ILU.get_connection(m_ordering[r], m_ordering[c], bFound)
+						: ILU.get_connection(r, c, bFound);
+					if(!bFound) {m_vSlot.clear(); return;}
+					m_vSlot.push_back((int)p.idx());
+				}
+
+			m_patternFingerprint.compute(A);
+		}
+
+	#ifdef UG_PARALLEL
+	///	makes the interface couplings consistent or adds the slave rows to the masters
+		void make_unique_overlap0(matrix_type& A)
+		{
+			if(m_useConsistentInterfaces){
+				MatMakeConsistentOverlap0(A);
+			}
+			else {
+				MatAddSlaveRowsToMasterRowOverlap0(A);
+			//	set dirichlet rows on slaves
+				std::vector<IndexLayout::Element> vIndex;
+				CollectUniqueElements(vIndex,  A.layouts()->slave());
+				SetDirichletRow(A, vIndex);
+			}
+		}
+	#endif
+
 	protected:
 		virtual bool init(SmartPtr<ILinearOperator<vector_type> > J,
 		                  const vector_type& u)
@@ -524,10 +634,14 @@ class ILU : public IPreconditioner<TAlgebra>
 			write_debug(mat, "ILU_PreProcess_orig_A");
 			#endif
 
-			m_ILU = mat;
+		//	matrix to be factorized, NULL if m_ILU has been set up directly.
+		//	Without pattern reuse, m_ILU is modified in place to save a copy.
+			const matrix_type* pA = &mat;
 
 			#ifdef UG_PARALLEL
+				matrix_type A;
 				if(m_useOverlap){
+					m_ILU = mat;
 					CreateOverlap(m_ILU);
 					m_oD.set_layouts(m_ILU.layouts());
 					m_oC.set_layouts(m_ILU.layouts());
@@ -540,26 +654,33 @@ class ILU : public IPreconditioner<TAlgebra>
 					                     	   *debug_writer(),
 				                      		   m_ILU.num_rows());
 					}
+					pA = NULL;
 				}
-				else if(m_useConsistentInterfaces){
-					MatMakeConsistentOverlap0(m_ILU);
+				else if(m_bReusePattern){
+				//	staged in A, whose pattern is compared with the last call
+					A = mat;
+					make_unique_overlap0(A);
+					pA = &A;
 				}
 				else {
-					MatAddSlaveRowsToMasterRowOverlap0(m_ILU);
-				//	set dirichlet rows on slaves
-					std::vector<IndexLayout::Element> vIndex;
-					CollectUniqueElements(vIndex,  m_ILU.layouts()->slave());
-					SetDirichletRow(m_ILU, vIndex);
+					m_ILU = mat;
+					make_unique_overlap0(m_ILU);
+					pA = NULL;
 				}
-			#endif
 
-			m_h.resize(m_ILU.num_cols());
-
-			#ifdef UG_PARALLEL
-			write_overlap_debug(m_ILU, "ILU_prep_02_A_AfterMakeUnique");
+			write_overlap_debug(pA ? *pA : m_ILU, "ILU_prep_02_A_AfterMakeUnique");
 			#endif
 
-			apply_ordering();
+		//	copy the matrix and apply the ordering. If the pattern is unchanged,
+		//	the ordering and the pattern of the last call are reused.
+			const bool bReused = pA && copy_values_reusing_pattern(*pA);
+			if(!bReused)
+			{
+				if(pA) m_ILU = *pA;
+				apply_ordering();
+			}
+
+			m_h.resize(m_ILU.num_cols());
 
 		//	Debug output of matrices
 			#ifdef UG_PARALLEL
@@ -570,11 +691,33 @@ class ILU : public IPreconditioner<TAlgebra>
 
 
 		// 	Compute ILU Factorization
-			if (m_beta!=0.0) FactorizeILUBeta(m_ILU, m_beta);
+			const bool bLevelScheduling = m_bLevelScheduling && !m_bMixedPrecision
+											&& m_beta == 0.0 && matrix_type::rows_sorted;
+			if(!(bReused && m_bLevelScheduledLU && bLevelScheduling && m_levelLU.update_values(m_ILU)))
+			{
+				m_bLevelScheduledLU = false;
+				m_levelLU.clear();
+				if (bLevelScheduling)
+					m_bLevelScheduledLU = m_levelLU.init(m_ILU);
+			}
+
+			if (m_bLevelScheduledLU) m_levelLU.factorize(m_sortEps);
+			else if (m_beta!=0.0) FactorizeILUBeta(m_ILU, m_beta);
 			else if(matrix_type::rows_sorted) FactorizeILUSorted(m_ILU, m_sortEps);
 			else FactorizeILU(m_ILU);
 			m_ILU.defragment();
 
+		//	single precision copy of the factors
+			m_mixedLU.clear();
+			if(m_bMixedPrecision) m_mixedLU.init(m_ILU);
+
+		//	remember the pattern for the next call
+			if(!bReused)
+			{
+				if(pA) record_pattern(*pA);
+				else m_patternFingerprint.clear();
+			}
+
 		//	Debug output of matrices
 			#ifdef UG_PARALLEL
 			write_overlap_debug(m_ILU, "ILU_prep_04_A_AfterFactorize");
@@ -587,15 +730,31 @@ class ILU : public IPreconditioner<TAlgebra>
 		}
 
 
+	///	solve x = L^-1 b, level scheduled if enabled
+		bool apply_invert_L(vector_type &x, const vector_type &b)
+		{
+			if(m_mixedLU.valid()) {m_mixedLU.invert_L(x, b); return true;}
+			if(m_bLevelScheduledLU) return m_levelLU.invert_L(x, b);
+			return invert_L(m_ILU, x, b);
+		}
+
+	///	solve x = U^-1 b, level scheduled if enabled
+		bool apply_invert_U(vector_type &x, const vector_type &b)
+		{
+			if(m_mixedLU.valid()) return m_mixedLU.invert_U(x, b, m_invEps);
+			if(m_bLevelScheduledLU) return m_levelLU.invert_U(x, b, m_invEps);
+			return invert_U(m_ILU, x, b, m_invEps);
+		}
+
 		void applyLU(vector_type &c, const vector_type &d, vector_type &tmp)
 		{
 
 			if(m_spOrderingAlgo.invalid() || m_bSortIsIdentity)
 			{
 				// 	apply iterator: c = LU^{-1}*d
-				if(! invert_L(m_ILU, tmp, d)) // h := L^-1 d
+				if(! apply_invert_L(tmp, d)) // h := L^-1 d
 					print_debugger_message("ILU: There were issues at inverting L\n");
-				if(! invert_U(m_ILU, c, tmp, m_invEps)) // c := U^-1 h = (LU)^-1 d
+				if(! apply_invert_U(c, tmp)) // c := U^-1 h = (LU)^-1 d
 					print_debugger_message("ILU: There were issues at inverting U\n");
 			}
 ///*
@@ -603,9 +762,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			{
 				// we save one vector here by renaming
 				SetVectorAsPermutation(tmp, d, m_ordering);
-				if(! invert_L(m_ILU, c, tmp)) // c = L^{-1} d
+				if(! apply_invert_L(c, tmp)) // c = L^{-1} d
 					print_debugger_message("ILU: There were issues at inverting L (after permutation)\n");
-				if(! invert_U(m_ILU, tmp, c, m_invEps)) // tmp = (LU)^{-1} d
+				if(! apply_invert_U(tmp, c)) // tmp = (LU)^{-1} d
 					print_debugger_message("ILU: There were issues at inverting U (after permutation)\n");
 				SetVectorAsPermutation(c, tmp, m_old_ordering);
 			}
@@ -733,6 +892,20 @@ class ILU : public IPreconditioner<TAlgebra>
 		std::vector<size_t> m_newIndex, m_oldIndex;
 		bool m_bSortIsIdentity;
 
+	///	level scheduled factorization (used if m_bLevelScheduledLU)
+		LevelScheduledILU<typename matrix_type::value_type> m_levelLU;
+		bool m_bLevelScheduling;
+		bool m_bLevelScheduledLU;
+
+	///	pattern of the last factorized matrix and position of its entries in m_ILU
+		bool m_bReusePattern;
+		SparsePatternFingerprint m_patternFingerprint;
+		std::vector<int> m_vSlot;
+
+	///	single precision copy of the factors (used if m_bMixedPrecision)
+		bool m_bMixedPrecision;
+		MixedPrecisionMatrix<typename matrix_type::value_type> m_mixedLU;
+
 		const vector_type* m_u;
 };
 
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_LEVEL_SCHEDULING__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_LEVEL_SCHEDULING__
+
+#include <vector>
+#include <cmath>
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/cpu_algebra/sparsematrix.h"
+#include "lib_algebra/cpu_algebra/algebra_threads.h"
+
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
+namespace ug{
+
+///	ILU(0) factorization and triangular solves using level scheduling
+/**
+ * The factorization is stored in a contiguous CRS copy of the matrix. The rows
+ * are grouped into levels, such that the rows of one level only depend on rows
+ * of previous levels (for L: via their entries left of the diagonal, for U:
+ * via their entries right of the diagonal). The rows of one level are then
+ * processed concurrently by the threads of the cpu algebra
+ * (see SetAlgebraNumThreads).
+ *
+ * Every row is computed with exactly the same operations in the same order as
+ * in FactorizeILUSorted, invert_L and invert_U. Hence, the results are bitwise
+ * identical to the sequential ILU, independent of the number of threads.
+ *
+ * The achievable parallelism is limited by the number of rows per level and
+ * thus depends on the ordering of the matrix. A multicolor ordering (e.g. set
+ * via ILU::set_ordering_algorithm) leads to few and large levels.
+ */
+template <typename TBlock>
+class LevelScheduledILU
+{
+	public:
+	///	block type
+		typedef TBlock block_type;
+
+	public:
+		LevelScheduledILU() : m_numRows(0) {}
+
+	///	copies the matrix and computes the level schedules
+	/**
+	 * \returns false if the matrix type does not support level scheduling
+	 * (i.e. is not derived from SparseMatrix)
+	 */
+		template <typename TMatrix>
+		bool init(const TMatrix& A) {return init_crs(&A);}
+
+	///	copies the values of a matrix with the same pattern as in the last init
+	/**
+	 * The level schedules are kept. \returns false if the pattern differs,
+	 * in which case init has to be called.
+	 */
+		template <typename TMatrix>
+		bool update_values(const TMatrix& A) {return update_values_crs(&A);}
+
+	///	computes the ILU(0) factorization in place (cf. FactorizeILUSorted)
+		void factorize(const number eps = 1e-50);
+
+	///	solve x = L^-1 b (cf. invert_L)
+		template <typename TVector>
+		bool invert_L(TVector& x, const TVector& b) const;
+
+	///	solve x = U^-1 b (cf. invert_U)
+		template <typename TVector>
+		bool invert_U(TVector& x, const TVector& b, const number eps = 1e-8) const;
+
+	///	returns the number of levels of the L and U schedule
+	/// \{
+		size_t num_lower_levels() const {return m_vLowerLevelStart.empty() ? 0 : m_vLowerLevelStart.size() - 1;}
+		size_t num_upper_levels() const {return m_vUpperLevelStart.empty() ? 0 : m_vUpperLevelStart.size() - 1;}
+	/// \}
+
+	///	frees all memory
+		void clear();
+
+	protected:
+	///	copies a SparseMatrix and computes the level schedules
+		bool init_crs(const SparseMatrix<TBlock>* pA);
+
+	///	other matrix types are not supported
+		bool init_crs(const void*) {return false;}
+
+	///	copies the values of a SparseMatrix into the CRS storage
+		bool update_values_crs(const SparseMatrix<TBlock>* pA);
+
+	///	other matrix types are not supported
+		bool update_values_crs(const void*) {return false;}
+
+	///	groups the rows by their level
+		static void sort_by_level(std::vector<size_t>& vLevelStart,
+		                          std::vector<size_t>& vRows,
+		                          const std::vector<size_t>& vLevel);
+
+	///	processes the rows of a schedule level by level
+		template <typename TRowOp>
+		void process_levels(TRowOp& op,
+		                    const std::vector<size_t>& vLevelStart,
+		                    const std::vector<size_t>& vRows) const;
+
+	///	returns the diagonal block of row i
+		const block_type& diag(size_t i) const
+		{
+			return (m_vDiag[i] == -1) ? m_zero : m_vValues[m_vDiag[i]];
+		}
+
+	///	row operations used in the level loops
+	/// \{
+		struct FactorizeRow;
+		template <typename TVector> struct InvertLRow;
+		template <typename TVector> struct InvertURow;
+	/// \}
+
+	protected:
+	///	number of rows
+		size_t m_numRows;
+
+	///	CRS storage, row i in [m_vRowStart[i], m_vRowStart[i+1])
+	/// \{
+		std::vector<block_type> m_vValues;
+		std::vector<int> m_vRowStart;
+		std::vector<int> m_vCols;
+	/// \}
+
+	///	position of the diagonal in each row (-1 if not present)
+		std::vector<int> m_vDiag;
+
+	///	zero block returned for missing diagonals
+		block_type m_zero;
+
+	///	schedules: rows of level l are vRows[vLevelStart[l], vLevelStart[l+1])
+	/// \{
+		std::vector<size_t> m_vLowerLevelStart, m_vLowerRows;
+		std::vector<size_t> m_vUpperLevelStart, m_vUpperRows;
+	/// \}
+};
+
+} // end namespace ug
+
+#include "ilu_level_scheduling_impl.h"
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_LEVEL_SCHEDULING__ */
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_LEVEL_SCHEDULING_IMPL__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_LEVEL_SCHEDULING_IMPL__
+
+#include "ilu_level_scheduling.h"
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+// row operations
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBlock>
+struct LevelScheduledILU<TBlock>::FactorizeRow
+{
+	FactorizeRow(LevelScheduledILU& _ilu, number _eps) : ilu(_ilu), eps(_eps) {}
+
+	void operator()(size_t i)
+	{
+		std::vector<block_type>& values = ilu.m_vValues;
+		const std::vector<int>& rowStart = ilu.m_vRowStart;
+		const std::vector<int>& cols = ilu.m_vCols;
+		const int rowEnd_i = rowStart[i+1];
+
+	//	eliminate all entries A(i, k) with k<i with rows A(k, .) and k<i
+		for(int ik = rowStart[i]; ik < rowEnd_i && cols[ik] < (int)i; ++ik)
+		{
+			const size_t k = cols[ik];
+			block_type &a_ik = values[ik];
+		//	(operator/= of DenseMatrix takes a non-const, but unmodified argument)
+			block_type &a_kk = const_cast<block_type&>(ilu.diag(k));
+
+			if(fabs(BlockNorm(a_kk)) < eps * BlockNorm(a_ik))
+				UG_THROW("ILU: Blocknorm of diagonal is near-zero for k="<<k<<
+				         " with eps: "<< eps <<", ||A_kk||="<<fabs(BlockNorm(a_kk))
+				         <<", ||A_ik||="<<BlockNorm(a_ik));
+
+			try {a_ik /= a_kk;}
+			UG_CATCH_THROW("Failed to calculate A_ik /= A_kk "
+				"with i = " << i << " and k = " << k << ".");
+
+		//	A(i, .) -= A(i,k) * A(k,.) on the pattern of row i
+			int ij = ik + 1;
+			int kj = rowStart[k];
+			const int rowEnd_k = rowStart[k+1];
+			while(ij < rowEnd_i && kj < rowEnd_k)
+			{
+				if(cols[ij] > cols[kj])
+					++kj;
+				else if(cols[ij] < cols[kj])
+					++ij;
+				else
+				{
+					values[ij] -= a_ik * values[kj];
+					++kj; ++ij;
+				}
+			}
+		}
+	}
+
+	LevelScheduledILU& ilu;
+	const number eps;
+};
+
+template <typename TBlock>
+template <typename TVector>
+struct LevelScheduledILU<TBlock>::InvertLRow
+{
+	InvertLRow(const LevelScheduledILU& _ilu, TVector& _x, const TVector& _b)
+		: ilu(_ilu), x(_x), b(_b) {}
+
+	void operator()(size_t i)
+	{
+		typename TVector::value_type s = b[i];
+		for(int j = ilu.m_vRowStart[i]; j < ilu.m_vRowStart[i+1]; ++j)
+		{
+			const size_t col = ilu.m_vCols[j];
+			if(col >= i) continue;
+			MatMultAdd(s, 1.0, s, -1.0, ilu.m_vValues[j], x[col]);
+		}
+		x[i] = s;
+	}
+
+	const LevelScheduledILU& ilu;
+	TVector& x;
+	const TVector& b;
+};
+
+template <typename TBlock>
+template <typename TVector>
+struct LevelScheduledILU<TBlock>::InvertURow
+{
+	InvertURow(const LevelScheduledILU& _ilu, TVector& _x, const TVector& _b)
+		: ilu(_ilu), x(_x), b(_b) {}
+
+	void operator()(size_t i)
+	{
+	//	the last row is handled separately (see invert_U)
+		if(i == ilu.m_numRows - 1) return;
+
+		typename TVector::value_type s = b[i];
+		for(int j = ilu.m_vRowStart[i]; j < ilu.m_vRowStart[i+1]; ++j)
+		{
+			const size_t col = ilu.m_vCols[j];
+			if(col <= i) continue;
+			MatMultAdd(s, 1.0, s, -1.0, ilu.m_vValues[j], x[col]);
+		}
+		InverseMatMult(x[i], 1.0, ilu.diag(i), s);
+	}
+
+	const LevelScheduledILU& ilu;
+	TVector& x;
+	const TVector& b;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// LevelScheduledILU
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBlock>
+bool LevelScheduledILU<TBlock>::init_crs(const SparseMatrix<TBlock>* pA)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+
+	size_t numCols;
+	pA->copy_crs(m_numRows, numCols, m_vValues, m_vRowStart, m_vCols);
+	m_zero = 0.0;
+
+//	find diagonals
+	m_vDiag.assign(m_numRows, -1);
+	for(size_t i = 0; i < m_numRows; ++i)
+		for(int j = m_vRowStart[i]; j < m_vRowStart[i+1]; ++j)
+			if(m_vCols[j] == (int)i) {m_vDiag[i] = j; break;}
+
+//	level of L: row i depends on all rows k < i with A(i,k) != 0
+	std::vector<size_t> vLevel(m_numRows, 0);
+	for(size_t i = 0; i < m_numRows; ++i)
+		for(int j = m_vRowStart[i]; j < m_vRowStart[i+1] && m_vCols[j] < (int)i; ++j)
+			vLevel[i] = std::max(vLevel[i], vLevel[m_vCols[j]] + 1);
+	sort_by_level(m_vLowerLevelStart, m_vLowerRows, vLevel);
+
+//	level of U: row i depends on all rows j > i with A(i,j) != 0
+	vLevel.assign(m_numRows, 0);
+	for(size_t i = m_numRows; i-- > 0; )
+		for(int j = m_vRowStart[i+1] - 1; j >= m_vRowStart[i] && m_vCols[j] > (int)i; --j)
+			vLevel[i] = std::max(vLevel[i], vLevel[m_vCols[j]] + 1);
+	sort_by_level(m_vUpperLevelStart, m_vUpperRows, vLevel);
+
+	return true;
+}
+
+template <typename TBlock>
+bool LevelScheduledILU<TBlock>::update_values_crs(const SparseMatrix<TBlock>* pA)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename SparseMatrix<TBlock>::const_row_iterator const_row_iterator;
+
+	if(pA->num_rows() != m_numRows) return false;
+
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		int j = m_vRowStart[i];
+		for(const_row_iterator it = pA->begin_row(i); it != pA->end_row(i); ++it, ++j)
+		{
+			if(j >= m_vRowStart[i+1] || m_vCols[j] != (int)it.index()) return false;
+			m_vValues[j] = it.value();
+		}
+		if(j != m_vRowStart[i+1]) return false;
+	}
+
+	return true;
+}
+
+template <typename TBlock>
+void LevelScheduledILU<TBlock>::
+sort_by_level(std::vector<size_t>& vLevelStart, std::vector<size_t>& vRows,
+              const std::vector<size_t>& vLevel)
+{
+	size_t numLevels = 0;
+	for(size_t i = 0; i < vLevel.size(); ++i)
+		numLevels = std::max(numLevels, vLevel[i] + 1);
+
+//	counting sort, rows of a level keep their ascending order
+	vLevelStart.assign(numLevels + 1, 0);
+	for(size_t i = 0; i < vLevel.size(); ++i)
+		vLevelStart[vLevel[i] + 1]++;
+	for(size_t l = 0; l < numLevels; ++l)
+		vLevelStart[l+1] += vLevelStart[l];
+
+	std::vector<size_t> vPos(vLevelStart.begin(), vLevelStart.end() - 1);
+	vRows.resize(vLevel.size());
+	for(size_t i = 0; i < vLevel.size(); ++i)
+		vRows[vPos[vLevel[i]]++] = i;
+}
+
+template <typename TBlock>
+template <typename TRowOp>
+void LevelScheduledILU<TBlock>::
+process_levels(TRowOp& op, const std::vector<size_t>& vLevelStart,
+               const std::vector<size_t>& vRows) const
+{
+	const size_t numLevels = vLevelStart.empty() ? 0 : vLevelStart.size() - 1;
+
+#ifdef UG_OPENMP
+	const int numThreads = (int) AlgebraNumThreads(m_numRows);
+	if(numThreads > 1)
+	{
+	//	errors must not leave the parallel region, the first one is rethrown
+		bool bFailed = false;
+		UGError failure("");
+
+		#pragma omp parallel num_threads(numThreads)
+		for(size_t l = 0; l < numLevels; ++l)
+		{
+			const long first = vLevelStart[l], last = vLevelStart[l+1];
+
+		//	implicit barrier at the end of each level
+			#pragma omp for schedule(static)
+			for(long r = first; r < last; ++r)
+			{
+				try{ op(vRows[r]); }
+				catch(UGError& err)
+				{
+					#pragma omp critical (LevelScheduledILU_Error)
+					{
+						if(!bFailed) {bFailed = true; failure = err;}
+					}
+				}
+				catch(std::exception& ex)
+				{
+					#pragma omp critical (LevelScheduledILU_Error)
+					{
+						if(!bFailed) {bFailed = true; failure = UGError("std::exception", ex, __FILE__, __LINE__);}
+					}
+				}
+			}
+		}
+
+		if(bFailed) throw failure;
+		return;
+	}
+#endif
+
+	for(size_t l = 0; l < numLevels; ++l)
+		for(size_t r = vLevelStart[l]; r < vLevelStart[l+1]; ++r)
+			op(vRows[r]);
+}
+
+template <typename TBlock>
+void LevelScheduledILU<TBlock>::factorize(const number eps)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	FactorizeRow op(*this, eps);
+	process_levels(op, m_vLowerLevelStart, m_vLowerRows);
+}
+
+template <typename TBlock>
+template <typename TVector>
+bool LevelScheduledILU<TBlock>::invert_L(TVector& x, const TVector& b) const
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	InvertLRow<TVector> op(*this, x, b);
+	process_levels(op, m_vLowerLevelStart, m_vLowerRows);
+	return true;
+}
+
+template <typename TBlock>
+template <typename TVector>
+bool LevelScheduledILU<TBlock>::invert_U(TVector& x, const TVector& b,
+                                         const number eps) const
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+
+	bool result = true;
+
+//	last row: near-zero diagonal is handled as in invert_U
+	if(m_numRows > 0)
+	{
+		const size_t i = m_numRows - 1;
+		typename TVector::value_type s = b[i];
+		if (BlockNorm(diag(i)) <= eps * BlockNorm(s))
+		{
+			UG_LOG("ILU Warning: Near-zero last diagonal entry "
+					"with norm "<<BlockNorm(diag(i))<<" in U "
+					"for non-near-zero rhs entry with norm "
+					<< BlockNorm(s) << ". Setting rhs to zero.\n"
+					"NOTE: Reduce 'eps' using e.g. ILU::set_inversion_eps(...) "
+					"to avoid this warning. Current eps: " << eps << ".\n")
+			x[i] = 0;
+			result = false;
+		} else {
+			InverseMatMult(x[i], 1.0, diag(i), s);
+		}
+	}
+	if(m_numRows <= 1) return result;
+
+	InvertURow<TVector> op(*this, x, b);
+	process_levels(op, m_vUpperLevelStart, m_vUpperRows);
+
+	return result;
+}
+
+template <typename TBlock>
+void LevelScheduledILU<TBlock>::clear()
+{
+	m_numRows = 0;
+	m_vValues.clear(); m_vRowStart.clear(); m_vCols.clear(); m_vDiag.clear();
+	m_vLowerLevelStart.clear(); m_vLowerRows.clear();
+	m_vUpperLevelStart.clear(); m_vUpperRows.clear();
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_LEVEL_SCHEDULING_IMPL__ */
@@ -17,6 +17,8 @@
 #include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.h" // for backward compatibility
 
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/algebra_common/sparse_pattern_fingerprint.h"
+#include "mixed_precision_matrix.h"
 
 namespace ug{
 
@@ -58,7 +60,8 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 	public:
 	///	Constructor
 		ILUTPreconditioner(double eps=1e-6)
-			: m_eps(eps), m_info(false), m_show_progress(true), m_bSortIsIdentity(false)
+			: m_eps(eps), m_info(false), m_show_progress(true), m_bSortIsIdentity(false),
+			  m_bReusePattern(false), m_bMixedPrecision(false)
 		{
 			//default was set true
 			m_spOrderingAlgo = make_sp(new NativeCuthillMcKeeOrdering<TAlgebra, ordering_container_type>());
@@ -71,6 +74,8 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			m_eps = parent.m_eps;
 			set_info(parent.m_info);
 			m_bSortIsIdentity = parent.m_bSortIsIdentity;
+			m_bReusePattern = parent.m_bReusePattern;
+			m_bMixedPrecision = parent.m_bMixedPrecision;
 		}
 
 	///	Clone
@@ -116,6 +121,16 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 	/// 	sets an ordering algorithm
 		void set_ordering_algorithm(SmartPtr<ordering_algo_type> ordering_algo){
 			m_spOrderingAlgo = ordering_algo;
+			m_patternFingerprint.clear();
+		}
+
+	///	reuse the ordering if the matrix pattern is unchanged (default: false)
+	/**	Only enable this for orderings which depend on the matrix pattern alone
+	 * (e.g. Cuthill-McKee), orderings using the values or u would be reused stale.*/
+		void set_reuse_pattern(bool b)
+		{
+			m_bReusePattern = b;
+			m_patternFingerprint.clear();
 		}
 
 	/// set cuthill-mckee sort on/off
@@ -127,10 +142,19 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			else{
 				m_spOrderingAlgo = SPNULL;
 			}
+			m_patternFingerprint.clear();
 
 			UG_LOG("\nILUT: please use 'set_ordering_algorithm(..)' in the future\n");
 		}
 
+	///	stores a single precision copy of L and U for the application
+		void set_mixed_precision(bool b)
+		{
+			UG_COND_THROW(b && !MixedPrecisionMatrix<block_type>::supported(),
+			              "ILUT: Mixed precision not supported for this algebra.");
+			m_bMixedPrecision = b;
+		}
+
 
 	protected:
 	//	Name of preconditioner
@@ -244,22 +268,30 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			matrix_type* A;
 			matrix_type permA;
 
-			if(m_spOrderingAlgo.valid()){
+		//	the ordering of the last call is reused if the pattern is unchanged.
+		//	The fill-in of ILUT depends on the values and is always recomputed.
+			SparsePatternFingerprint fingerprint;
+			if(m_spOrderingAlgo.valid() && m_bReusePattern)
+				fingerprint.compute(mat);
+
+			if(m_spOrderingAlgo.valid() && fingerprint != m_patternFingerprint)
+			{
 				if(m_u){
 					m_spOrderingAlgo->init(&mat, *m_u);
 				}
 				else{
 					m_spOrderingAlgo->init(&mat);
 				}
-			}
 
-			if(m_spOrderingAlgo.valid())
-			{
 				m_spOrderingAlgo->compute();
 				m_ordering = m_spOrderingAlgo->ordering();
 
 				m_bSortIsIdentity = GetInversePermutation(m_ordering, m_old_ordering);
+				m_patternFingerprint = fingerprint;
+			}
 
+			if(m_spOrderingAlgo.valid())
+			{
 				if(!m_bSortIsIdentity){
 					SetMatrixAsPermutation(permA, mat, m_ordering);
 					A = &permA;
@@ -397,6 +429,14 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 				m_U.defragment();
 			}
 
+		//	single precision copy of the factors
+			m_mixedL.clear(); m_mixedU.clear();
+			if(m_bMixedPrecision)
+			{
+				m_mixedL.init(m_L);
+				m_mixedU.init(m_U);
+			}
+
 			if (m_info==true)
 			{
 				m_L.print("L");
@@ -459,6 +499,14 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 		virtual bool applyLU(vector_type& c, const vector_type& d)
 		{
 			PROFILE_BEGIN_GROUP(ILUT_step, "ilut algebra");
+			if(m_mixedU.valid())
+			{
+				m_mixedL.invert_L(c, d);
+			//	without the near-zero check of the last row, as below
+				m_mixedU.gs_step_UR(c, c, 1.0);
+				return true;
+			}
+
 			// apply iterator: c = LU^{-1}*d (damp is not used)
 			// L
 			for(size_t i=0; i < m_L.num_rows(); i++)
@@ -627,6 +675,14 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 
 		bool m_bSortIsIdentity;
 
+	///	pattern of the matrix the ordering has been computed for
+		bool m_bReusePattern;
+		SparsePatternFingerprint m_patternFingerprint;
+
+	///	single precision copy of L and U (used if m_bMixedPrecision)
+		bool m_bMixedPrecision;
+		MixedPrecisionMatrix<block_type> m_mixedL, m_mixedU;
+
 		const vector_type* m_u;
 };
 
@@ -81,7 +81,7 @@ class ILUTScalarPreconditioner : public IPreconditioner<TAlgebra>
 			m_eps = parent.m_eps;
 			set_info(parent.m_info);
 			set_show_progress(parent.m_show_progress);
-			set_sort(parent.m_bSort);
+			m_bSort = parent.m_bSort;
 		}
 
 	///	Clone
@@ -118,6 +118,7 @@ class ILUTScalarPreconditioner : public IPreconditioner<TAlgebra>
 		
 		void set_sort(bool b)
 		{
+			if(b != m_bSort) ilut = SPNULL;
 			m_bSort = b;
 		}
 
@@ -140,10 +141,17 @@ class ILUTScalarPreconditioner : public IPreconditioner<TAlgebra>
 
 			STATIC_ASSERT(matrix_type::rows_sorted, Matrix_has_to_have_sorted_rows);
 
-			ilut = make_sp(new ILUTPreconditioner<CPUAlgebra>(m_eps));
+		//	the ILUT is kept, so that it can reuse its ordering if the pattern is unchanged
+			if(ilut.invalid())
+			{
+				ilut = make_sp(new ILUTPreconditioner<CPUAlgebra>(m_eps));
+				ilut->set_sort(m_bSort);
+			//	Cuthill-McKee depends on the pattern only
+				ilut->set_reuse_pattern(true);
+			}
+			ilut->set_threshold(m_eps);
 			ilut->set_info(m_info);
 			ilut->set_show_progress(m_show_progress);
-			ilut->set_sort(m_bSort);
 
 			mo = make_sp(new MatrixOperator<CPUAlgebra::matrix_type, CPUAlgebra::vector_type>);
 			CPUAlgebra::matrix_type &mat = mo->get_matrix();
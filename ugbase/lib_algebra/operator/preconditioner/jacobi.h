@@ -36,6 +36,7 @@
 #include "lib_algebra/operator/interface/preconditioner.h"
 #include "lib_algebra/small_algebra/additional_math.h"
 #include "lib_algebra/cpu_algebra/vector.h"
+#include "mixed_precision_matrix.h"
 
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
@@ -114,16 +115,17 @@ class Jacobi : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		Jacobi() {this->set_damp(1.0); m_bBlock = true;};
+		Jacobi() {this->set_damp(1.0); m_bBlock = true; m_bMixedPrecision = false;};
 
 	///	constructor setting the damping parameter
-		Jacobi(number damp) {this->set_damp(damp); m_bBlock = true;};
+		Jacobi(number damp) {this->set_damp(damp); m_bBlock = true; m_bMixedPrecision = false;};
 
 	/// clone constructor
 		Jacobi( const Jacobi<TAlgebra> &parent )
 			: base_type(parent)
 		{
 			set_block(parent.m_bBlock);
+			m_bMixedPrecision = parent.m_bMixedPrecision;
 		}
 
 	///	Clone
@@ -147,10 +149,21 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			m_bBlock = b;
 		}
 
+	///	stores the inverse diagonal in single precision
+		void set_mixed_precision(bool b)
+		{
+			UG_COND_THROW(b && !MixedPrecisionMatrix<typename matrix_type::value_type>::supported(),
+			              "Jacobi: Mixed precision not supported for this algebra.");
+			m_bMixedPrecision = b;
+		}
+
 	protected:
 	///	Name of preconditioner
 		virtual const char* name() const {return "Jacobi";}
 
+	///	only the (block) diagonal is used, thus matrix-free operators are supported
+		virtual bool needs_diagonal_only() const {return true;}
+
 	///	Preprocess routine
 		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
 		{
@@ -167,7 +180,10 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			}
 
 			//	resize
-			m_diagInv.resize(size);
+			m_diagInv.resize(m_bMixedPrecision ? 0 : size);
+			m_mixedDiag.clear();
+			std::vector<typename matrix_type::value_type> vDiag;
+			if(m_bMixedPrecision) vDiag.resize(size);
 #ifdef UG_PARALLEL
 					//	temporary vector for the diagonal
 			ParallelVector<Vector< typename matrix_type::value_type > > diag;
@@ -212,9 +228,13 @@ class Jacobi : public IPreconditioner<TAlgebra>
 				else
 					m = d;
 				m *= 1./damp;
-				GetInverse(m_diagInv[i], m);
+				if(m_bMixedPrecision) vDiag[i] = m;
+				else GetInverse(m_diagInv[i], m);
 			}
 
+		//	single precision inverse
+			if(m_bMixedPrecision) m_mixedDiag.init_diagonal(vDiag);
+
 		//	done
 			return true;
 		}
@@ -225,7 +245,9 @@ class Jacobi : public IPreconditioner<TAlgebra>
 
 		// 	multiply defect with diagonal, c = damp * D^{-1} * d
 		//	note, that the damping is already included in the inverse diagonal
-			for(size_t i = 0; i < m_diagInv.size(); ++i)
+			if(m_mixedDiag.valid())
+				m_mixedDiag.diag_step(c, d);
+			else for(size_t i = 0; i < m_diagInv.size(); ++i)
 			{
 			// 	c[i] = m_diagInv[i] * d[i];
 				MatMult(c[i], 1.0, m_diagInv[i], d[i]);
@@ -307,6 +329,10 @@ class Jacobi : public IPreconditioner<TAlgebra>
 		std::vector<inverse_type> m_diagInv;
 		bool m_bBlock;
 
+	///	single precision inverse diagonal (used if m_bMixedPrecision)
+		bool m_bMixedPrecision;
+		MixedPrecisionMatrix<typename matrix_type::value_type> m_mixedDiag;
+
 
 };
 
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_MATRIX__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_MATRIX__
+
+#include <vector>
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/cpu_algebra/sparsematrix.h"
+
+namespace ug{
+
+///	single precision copy of a matrix, applied to double precision vectors
+/**
+ * The off-diagonal blocks of a SparseMatrix are stored in float, the diagonal
+ * blocks are stored separately together with their inverse. The inverse is
+ * computed in double and rounded afterwards. The kernels read the float
+ * entries, but compute and accumulate in double on the (double) vectors.
+ *
+ * The application of a preconditioner is bound by the memory bandwidth, hence
+ * reading float instead of double entries nearly halves its run time. The
+ * rounding perturbs the preconditioner by a relative error of about 1e-7,
+ * which does not affect the convergence of the outer iteration in practice.
+ *
+ * The kernels mirror the ones used by the double precision preconditioners
+ * (invert_L, invert_U, gs_step_LL, gs_step_UR, sgs_step, diag_step). Only
+ * blocks of static size are supported, i.e. the CPUAlgebra and the
+ * CPUBlockAlgebra.
+ */
+template <typename TBlock>
+class MixedPrecisionMatrix
+{
+	public:
+	///	block type
+		typedef TBlock block_type;
+
+	///	size of the (static) blocks
+		enum {blockSize = block_traits<TBlock>::static_num_rows};
+
+	///	number of floats per block
+		enum {blockEntries = blockSize * blockSize};
+
+	public:
+		MixedPrecisionMatrix() : m_numRows(0) {}
+
+	///	returns if the block type is supported
+		static bool supported() {return block_traits<TBlock>::is_static;}
+
+	///	copies the matrix to float and inverts its diagonal blocks
+	/**
+	 * Missing or singular diagonal blocks get a zero inverse, i.e. the
+	 * corresponding correction is set to zero.
+	 */
+		template <typename TMatrix>
+		void init(const TMatrix& A) {init_crs(&A);}
+
+	///	stores only the inverse of the given diagonal blocks (for Jacobi)
+		void init_diagonal(const std::vector<block_type>& vDiag);
+
+	///	returns if init has been called
+		bool valid() const {return m_numRows > 0;}
+
+	///	number of rows
+		size_t num_rows() const {return m_numRows;}
+
+	///	frees all memory
+		void clear();
+
+	///	solve x = L^-1 b with unit diagonal (cf. invert_L)
+		template <typename TVector>
+		void invert_L(TVector& x, const TVector& b) const;
+
+	///	solve x = U^-1 b (cf. invert_U)
+	/**
+	 * As in invert_U, x is set to zero in the last row if its diagonal block
+	 * is near-zero compared to b. \returns false in that case.
+	 */
+		template <typename TVector>
+		bool invert_U(TVector& x, const TVector& b, const number eps = 1e-8) const;
+
+	///	c = relax * (D-L)^-1 d (cf. gs_step_LL)
+		template <typename TVector>
+		void gs_step_LL(TVector& c, const TVector& d, number relax) const;
+
+	///	c = relax * (D-U)^-1 d (cf. gs_step_UR), c and d may be the same vector
+		template <typename TVector>
+		void gs_step_UR(TVector& c, const TVector& d, number relax) const;
+
+	///	c = (D-U)^-1 D (D-L)^-1 d, with relaxation (cf. sgs_step)
+		template <typename TVector>
+		void sgs_step(TVector& c, const TVector& d, number relax) const;
+
+	///	c = D^-1 d (cf. diag_step)
+		template <typename TVector>
+		void diag_step(TVector& c, const TVector& d) const;
+
+	protected:
+	///	copies a SparseMatrix
+		void init_crs(const SparseMatrix<TBlock>* pA);
+
+	///	other matrix types are not supported
+		void init_crs(const void*)
+		{
+			UG_THROW("MixedPrecisionMatrix: Matrix type not supported.");
+		}
+
+	///	rounds a double block to float
+		static void round_block(float* dest, const block_type& src);
+
+	///	rounds the inverse of a double block to float, zero if singular
+		static void invert_block(float* dest, const block_type& src);
+
+	///	s -= A_k * x, for a float block A_k
+		template <typename TValue>
+		static void sub_mult(double* s, const float* a, const TValue& x);
+
+	///	x = relax * A * s, for a float block A
+		template <typename TValue>
+		static void assign_mult(TValue& x, number relax, const float* a, const double* s);
+
+	protected:
+	///	number of rows
+		size_t m_numRows;
+
+	///	CRS storage of the off-diagonal blocks, row i in [m_vRowStart[i], m_vRowStart[i+1])
+	/// \{
+		std::vector<int> m_vRowStart;
+		std::vector<int> m_vCols;
+		std::vector<float> m_vValues;
+	/// \}
+
+	///	position of the first block right of the diagonal in each row
+		std::vector<int> m_vUpperStart;
+
+	///	diagonal blocks and their inverse
+	/// \{
+		std::vector<float> m_vDiag;
+		std::vector<float> m_vDiagInv;
+	/// \}
+};
+
+} // end namespace ug
+
+#include "mixed_precision_matrix_impl.h"
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_MATRIX__ */
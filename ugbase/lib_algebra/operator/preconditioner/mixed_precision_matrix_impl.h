@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_MATRIX_IMPL__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_MATRIX_IMPL__
+
+#include <cmath>
+#include "common/log.h"
+#include "mixed_precision_matrix.h"
+
+//	size of the local double arrays (at least 1, also for unsupported blocks)
+#define MIXED_PRECISION_BLOCK_SIZE (blockSize > 0 ? blockSize : 1)
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+// block operations
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBlock>
+void MixedPrecisionMatrix<TBlock>::round_block(float* dest, const block_type& src)
+{
+	for(size_t r = 0; r < (size_t)blockSize; ++r)
+		for(size_t c = 0; c < (size_t)blockSize; ++c)
+			dest[r*blockSize + c] = (float) BlockRef(src, r, c);
+}
+
+template <typename TBlock>
+void MixedPrecisionMatrix<TBlock>::invert_block(float* dest, const block_type& src)
+{
+	const size_t n = blockSize;
+	const size_t N = MIXED_PRECISION_BLOCK_SIZE;
+
+//	Gauss-Jordan elimination with partial pivoting on [A | I] in double
+	double a[N][N], inv[N][N];
+	for(size_t r = 0; r < n; ++r)
+		for(size_t c = 0; c < n; ++c)
+		{
+			a[r][c] = BlockRef(src, r, c);
+			inv[r][c] = (r == c) ? 1.0 : 0.0;
+		}
+
+	for(size_t k = 0; k < n; ++k)
+	{
+		size_t p = k;
+		for(size_t r = k+1; r < n; ++r)
+			if(std::fabs(a[r][k]) > std::fabs(a[p][k])) p = r;
+
+		if(a[p][k] == 0.0)
+		{
+			for(size_t i = 0; i < n*n; ++i) dest[i] = 0.0f;
+			return;
+		}
+
+		if(p != k)
+			for(size_t c = 0; c < n; ++c)
+			{
+				std::swap(a[k][c], a[p][c]);
+				std::swap(inv[k][c], inv[p][c]);
+			}
+
+		const double invPivot = 1.0 / a[k][k];
+		for(size_t c = 0; c < n; ++c) {a[k][c] *= invPivot; inv[k][c] *= invPivot;}
+
+		for(size_t r = 0; r < n; ++r)
+		{
+			if(r == k || a[r][k] == 0.0) continue;
+			const double f = a[r][k];
+			for(size_t c = 0; c < n; ++c) {a[r][c] -= f * a[k][c]; inv[r][c] -= f * inv[k][c];}
+		}
+	}
+
+	for(size_t r = 0; r < n; ++r)
+		for(size_t c = 0; c < n; ++c)
+			dest[r*n + c] = (float) inv[r][c];
+}
+
+template <typename TBlock>
+template <typename TValue>
+inline void MixedPrecisionMatrix<TBlock>::
+sub_mult(double* s, const float* a, const TValue& x)
+{
+	for(size_t r = 0; r < (size_t)blockSize; ++r)
+		for(size_t c = 0; c < (size_t)blockSize; ++c)
+			s[r] -= (double) a[r*blockSize + c] * BlockRef(x, c);
+}
+
+template <typename TBlock>
+template <typename TValue>
+inline void MixedPrecisionMatrix<TBlock>::
+assign_mult(TValue& x, number relax, const float* a, const double* s)
+{
+	for(size_t r = 0; r < (size_t)blockSize; ++r)
+	{
+		double sum = 0.0;
+		for(size_t c = 0; c < (size_t)blockSize; ++c)
+			sum += (double) a[r*blockSize + c] * s[c];
+		BlockRef(x, r) = relax * sum;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setup
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBlock>
+void MixedPrecisionMatrix<TBlock>::clear()
+{
+	m_numRows = 0;
+	m_vRowStart.clear();
+	m_vCols.clear();
+	m_vValues.clear();
+	m_vUpperStart.clear();
+	m_vDiag.clear();
+	m_vDiagInv.clear();
+}
+
+template <typename TBlock>
+void MixedPrecisionMatrix<TBlock>::init_crs(const SparseMatrix<TBlock>* pA)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename SparseMatrix<TBlock>::const_row_iterator const_row_iterator;
+	UG_COND_THROW(!supported(), "MixedPrecisionMatrix: only blocks of static size are supported.");
+
+	const SparseMatrix<TBlock>& A = *pA;
+	clear();
+	m_numRows = A.num_rows();
+
+	m_vRowStart.resize(m_numRows + 1);
+	m_vUpperStart.resize(m_numRows);
+	m_vCols.reserve(A.total_num_connections());
+	m_vValues.reserve(A.total_num_connections() * blockEntries);
+	m_vDiag.assign(m_numRows * blockEntries, 0.0f);
+	m_vDiagInv.assign(m_numRows * blockEntries, 0.0f);
+
+	m_vRowStart[0] = 0;
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		m_vUpperStart[i] = -1;
+		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			const size_t j = it.index();
+			if(j == i)
+			{
+				round_block(&m_vDiag[i*blockEntries], it.value());
+				invert_block(&m_vDiagInv[i*blockEntries], it.value());
+				continue;
+			}
+			if(j > i && m_vUpperStart[i] == -1) m_vUpperStart[i] = (int) m_vCols.size();
+
+			m_vCols.push_back((int) j);
+			m_vValues.resize(m_vValues.size() + blockEntries);
+			round_block(&m_vValues[m_vValues.size() - blockEntries], it.value());
+		}
+		m_vRowStart[i+1] = (int) m_vCols.size();
+		if(m_vUpperStart[i] == -1) m_vUpperStart[i] = m_vRowStart[i+1];
+	}
+}
+
+template <typename TBlock>
+void MixedPrecisionMatrix<TBlock>::init_diagonal(const std::vector<block_type>& vDiag)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!supported(), "MixedPrecisionMatrix: only blocks of static size are supported.");
+
+	clear();
+	m_numRows = vDiag.size();
+	m_vRowStart.assign(m_numRows + 1, 0);
+	m_vUpperStart.assign(m_numRows, 0);
+	m_vDiag.resize(m_numRows * blockEntries);
+	m_vDiagInv.resize(m_numRows * blockEntries);
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		round_block(&m_vDiag[i*blockEntries], vDiag[i]);
+		invert_block(&m_vDiagInv[i*blockEntries], vDiag[i]);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// kernels
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TBlock>
+template <typename TVector>
+void MixedPrecisionMatrix<TBlock>::invert_L(TVector& x, const TVector& b) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	double s[MIXED_PRECISION_BLOCK_SIZE];
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(b[i], r);
+		for(int k = m_vRowStart[i]; k < m_vUpperStart[i]; ++k)
+			sub_mult(s, &m_vValues[k*blockEntries], x[m_vCols[k]]);
+		for(size_t r = 0; r < (size_t)blockSize; ++r) BlockRef(x[i], r) = s[r];
+	}
+}
+
+template <typename TBlock>
+template <typename TVector>
+void MixedPrecisionMatrix<TBlock>::
+gs_step_LL(TVector& c, const TVector& d, number relax) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	double s[MIXED_PRECISION_BLOCK_SIZE];
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(d[i], r);
+		for(int k = m_vRowStart[i]; k < m_vUpperStart[i]; ++k)
+			sub_mult(s, &m_vValues[k*blockEntries], c[m_vCols[k]]);
+		assign_mult(c[i], relax, &m_vDiagInv[i*blockEntries], s);
+	}
+}
+
+template <typename TBlock>
+template <typename TVector>
+bool MixedPrecisionMatrix<TBlock>::
+invert_U(TVector& x, const TVector& b, const number eps) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	if(m_numRows == 0) return true;
+
+	bool result = true;
+	double s[MIXED_PRECISION_BLOCK_SIZE];
+
+//	last row: near-zero diagonal is handled as in invert_U
+	const size_t last = m_numRows - 1;
+	double diagNorm2 = 0.0;
+	for(size_t k = 0; k < (size_t)blockEntries; ++k)
+		diagNorm2 += (double) m_vDiag[last*blockEntries + k] * m_vDiag[last*blockEntries + k];
+	if (std::sqrt(diagNorm2) <= eps * BlockNorm(b[last]))
+	{
+		UG_LOG("ILU Warning: Near-zero last diagonal entry "
+				"with norm "<<std::sqrt(diagNorm2)<<" in U "
+				"for non-near-zero rhs entry with norm "
+				<< BlockNorm(b[last]) << ". Setting rhs to zero.\n"
+				"NOTE: Reduce 'eps' using e.g. ILU::set_inversion_eps(...) "
+				"to avoid this warning. Current eps: " << eps << ".\n")
+		x[last] = 0;
+		result = false;
+	} else {
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(b[last], r);
+		assign_mult(x[last], 1.0, &m_vDiagInv[last*blockEntries], s);
+	}
+
+//	all other rows
+	for(size_t i = last; i-- > 0; )
+	{
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(b[i], r);
+		for(int k = m_vUpperStart[i]; k < m_vRowStart[i+1]; ++k)
+			sub_mult(s, &m_vValues[k*blockEntries], x[m_vCols[k]]);
+		assign_mult(x[i], 1.0, &m_vDiagInv[i*blockEntries], s);
+	}
+
+	return result;
+}
+
+template <typename TBlock>
+template <typename TVector>
+void MixedPrecisionMatrix<TBlock>::
+gs_step_UR(TVector& c, const TVector& d, number relax) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	double s[MIXED_PRECISION_BLOCK_SIZE];
+	for(size_t i = m_numRows; i-- > 0; )
+	{
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(d[i], r);
+		for(int k = m_vUpperStart[i]; k < m_vRowStart[i+1]; ++k)
+			sub_mult(s, &m_vValues[k*blockEntries], c[m_vCols[k]]);
+		assign_mult(c[i], relax, &m_vDiagInv[i*blockEntries], s);
+	}
+}
+
+template <typename TBlock>
+template <typename TVector>
+void MixedPrecisionMatrix<TBlock>::
+sgs_step(TVector& c, const TVector& d, number relax) const
+{
+//	c1 = (D-L)^{-1} d
+	gs_step_LL(c, d, relax);
+
+//	c2 = D c1
+	double s[MIXED_PRECISION_BLOCK_SIZE];
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(c[i], r);
+		assign_mult(c[i], 1.0, &m_vDiag[i*blockEntries], s);
+	}
+
+//	c3 = (D-U)^{-1} c2
+	gs_step_UR(c, c, relax);
+}
+
+template <typename TBlock>
+template <typename TVector>
+void MixedPrecisionMatrix<TBlock>::diag_step(TVector& c, const TVector& d) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	double s[MIXED_PRECISION_BLOCK_SIZE];
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		for(size_t r = 0; r < (size_t)blockSize; ++r) s[r] = BlockRef(d[i], r);
+		assign_mult(c[i], 1.0, &m_vDiagInv[i*blockEntries], s);
+	}
+}
+
+} // end namespace ug
+
+#undef MIXED_PRECISION_BLOCK_SIZE
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_MATRIX_IMPL__ */
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MULTICOLOR_GAUSS_SEIDEL__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MULTICOLOR_GAUSS_SEIDEL__
+
+#include <vector>
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/cpu_algebra/sparsematrix.h"
+#include "lib_algebra/cpu_algebra/algebra_threads.h"
+
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
+namespace ug{
+
+///	multicolor Gauss-Seidel / SOR steps
+/**
+ * On init, a greedy coloring of the (symmetrized) matrix graph is computed,
+ * such that no two rows of the same color are coupled. The Gauss-Seidel
+ * steps then process the colors one after another, the rows of one color
+ * concurrently by the threads of the cpu algebra (see SetAlgebraNumThreads).
+ *
+ * This is the Gauss-Seidel method for the matrix reordered by colors: in the
+ * forward step row i uses the corrections of all rows with a lower color, in
+ * the backward step those with a higher color. The result thus differs from
+ * the Gauss-Seidel step in natural ordering, but is independent of the number
+ * of threads.
+ */
+template <typename TBlock>
+class MulticolorGaussSeidel
+{
+	public:
+	///	block type
+		typedef TBlock block_type;
+
+	public:
+	///	computes the coloring of the matrix graph
+	/**
+	 * \returns false if the matrix type is not supported (i.e. not derived
+	 * from SparseMatrix)
+	 */
+		template <typename TMatrix>
+		bool init(const TMatrix& A) {return init_coloring(&A);}
+
+	///	returns if a coloring has been computed
+		bool valid() const {return !m_vColorStart.empty();}
+
+	///	returns the number of colors
+		size_t num_colors() const {return m_vColorStart.empty() ? 0 : m_vColorStart.size() - 1;}
+
+	///	returns the color of row i
+		size_t color(size_t i) const {return m_vColor[i];}
+
+	///	frees all memory
+		void clear() {m_vColor.clear(); m_vColorStart.clear(); m_vRows.clear();}
+
+	///	forward step, c = relax * (D-L)^{-1} d with L the couplings to lower colors
+		template <typename TMatrix, typename TVector>
+		void gs_step_LL(const TMatrix& A, TVector& c, const TVector& d, const number relax) const
+		{process_colors(&A, c, d, relax, true);}
+
+	///	backward step, c = relax * (D-U)^{-1} d with U the couplings to higher colors
+		template <typename TMatrix, typename TVector>
+		void gs_step_UR(const TMatrix& A, TVector& c, const TVector& d, const number relax) const
+		{process_colors(&A, c, d, relax, false);}
+
+	///	symmetric step, c = (D-U)^{-1} D (D-L)^{-1} d (cf. sgs_step)
+		template <typename TMatrix, typename TVector>
+		void sgs_step(const TMatrix& A, TVector& c, const TVector& d, const number relax) const;
+
+	protected:
+	///	computes the coloring of a SparseMatrix
+		bool init_coloring(const SparseMatrix<TBlock>* pA);
+
+	///	other matrix types are not supported
+		bool init_coloring(const void*) {return false;}
+
+	///	processes the colors in forward or backward order
+		template <typename TVector>
+		void process_colors(const SparseMatrix<TBlock>* pA, TVector& c, const TVector& d,
+		                    const number relax, bool bForward) const;
+
+		template <typename TVector>
+		void process_colors(const void*, TVector&, const TVector&, const number, bool) const
+		{UG_THROW("MulticolorGaussSeidel: Matrix type not supported.");}
+
+	///	computes the correction of one row
+		template <typename TVector>
+		void update_row(const SparseMatrix<TBlock>& A, TVector& c, const TVector& d,
+		                const number relax, size_t i, bool bForward) const;
+
+	protected:
+	///	color of each row
+		std::vector<size_t> m_vColor;
+
+	///	rows of color k are m_vRows[m_vColorStart[k], m_vColorStart[k+1])
+	/// \{
+		std::vector<size_t> m_vColorStart;
+		std::vector<size_t> m_vRows;
+	/// \}
+};
+
+template <typename TBlock>
+bool MulticolorGaussSeidel<TBlock>::init_coloring(const SparseMatrix<TBlock>* pA)
+{
+	PROFILE_FUNC_GROUP("algebra gaussseidel");
+	const SparseMatrix<TBlock>& A = *pA;
+	const size_t numRows = A.num_rows();
+
+//	symmetrized adjacency, since a row must not read the correction of a
+//	row of the same color in either direction
+	std::vector<size_t> vAdjStart(numRows + 1, 0);
+	for(size_t i = 0; i < numRows; ++i)
+		for(int k = A.row_start(i); k < A.row_end(i); ++k)
+		{
+			const size_t j = A.col_index(k);
+			if(j == i || j >= numRows) continue;
+			vAdjStart[i+1]++; vAdjStart[j+1]++;
+		}
+	for(size_t i = 0; i < numRows; ++i)
+		vAdjStart[i+1] += vAdjStart[i];
+
+	std::vector<size_t> vAdj(vAdjStart[numRows]);
+	std::vector<size_t> vPos(vAdjStart.begin(), vAdjStart.end() - 1);
+	for(size_t i = 0; i < numRows; ++i)
+		for(int k = A.row_start(i); k < A.row_end(i); ++k)
+		{
+			const size_t j = A.col_index(k);
+			if(j == i || j >= numRows) continue;
+			vAdj[vPos[i]++] = j; vAdj[vPos[j]++] = i;
+		}
+
+//	greedy coloring in natural order
+	const size_t noColor = (size_t) -1;
+	m_vColor.assign(numRows, noColor);
+	std::vector<size_t> vUsedBy;
+	size_t numColors = 0;
+	for(size_t i = 0; i < numRows; ++i)
+	{
+		for(size_t k = vAdjStart[i]; k < vAdjStart[i+1]; ++k)
+		{
+			const size_t col = m_vColor[vAdj[k]];
+			if(col != noColor) vUsedBy[col] = i;
+		}
+
+		size_t col = 0;
+		while(col < numColors && vUsedBy[col] == i) ++col;
+		if(col == numColors) {vUsedBy.push_back(noColor); ++numColors;}
+		m_vColor[i] = col;
+	}
+
+//	sort rows by color, keeping the ascending order within a color
+	m_vColorStart.assign(numColors + 1, 0);
+	for(size_t i = 0; i < numRows; ++i)
+		m_vColorStart[m_vColor[i] + 1]++;
+	for(size_t k = 0; k < numColors; ++k)
+		m_vColorStart[k+1] += m_vColorStart[k];
+
+	vPos.assign(m_vColorStart.begin(), m_vColorStart.end() - 1);
+	m_vRows.resize(numRows);
+	for(size_t i = 0; i < numRows; ++i)
+		m_vRows[vPos[m_vColor[i]]++] = i;
+
+	return true;
+}
+
+template <typename TBlock>
+template <typename TVector>
+void MulticolorGaussSeidel<TBlock>::
+update_row(const SparseMatrix<TBlock>& A, TVector& c, const TVector& d,
+           const number relax, size_t i, bool bForward) const
+{
+	typename TVector::value_type s = d[i];
+	const size_t color = m_vColor[i];
+	int diag = -1;
+
+	for(int k = A.row_start(i); k < A.row_end(i); ++k)
+	{
+		const size_t j = A.col_index(k);
+		if(j == i) {diag = k; continue;}
+
+	//	use the corrections of the already processed colors
+		if(bForward ? (m_vColor[j] < color) : (m_vColor[j] > color))
+			MatMultAdd(s, 1.0, s, -1.0, A.value_at(k), c[j]);
+	}
+
+//	c[i] = relax * s/A(i,i)
+	const block_type& A_ii = (diag != -1) ? A.value_at(diag) : block_type(0);
+	InverseMatMult(c[i], relax, A_ii, s);
+}
+
+template <typename TBlock>
+template <typename TVector>
+void MulticolorGaussSeidel<TBlock>::
+process_colors(const SparseMatrix<TBlock>* pA, TVector& c, const TVector& d,
+               const number relax, bool bForward) const
+{
+	PROFILE_FUNC_GROUP("algebra gaussseidel");
+	const SparseMatrix<TBlock>& A = *pA;
+	const size_t numColors = num_colors();
+
+	if(m_vColor.size() != c.size())
+		UG_THROW("MulticolorGaussSeidel: Coloring computed for " << m_vColor.size()
+				<< " rows, but vector has size " << c.size() << ".");
+
+#ifdef UG_OPENMP
+	const int numThreads = (int) AlgebraNumThreads(c.size());
+	if(numThreads > 1)
+	{
+	//	errors must not leave the parallel region, the first one is rethrown
+		bool bFailed = false;
+		UGError failure("");
+
+		#pragma omp parallel num_threads(numThreads)
+		for(size_t l = 0; l < numColors; ++l)
+		{
+			const size_t k = bForward ? l : numColors - 1 - l;
+			const long first = m_vColorStart[k], last = m_vColorStart[k+1];
+
+		//	implicit barrier at the end of each color
+			#pragma omp for schedule(static)
+			for(long r = first; r < last; ++r)
+			{
+				try{ update_row(A, c, d, relax, m_vRows[r], bForward); }
+				catch(UGError& err)
+				{
+					#pragma omp critical (MulticolorGaussSeidel_Error)
+					{
+						if(!bFailed) {bFailed = true; failure = err;}
+					}
+				}
+				catch(std::exception& ex)
+				{
+					#pragma omp critical (MulticolorGaussSeidel_Error)
+					{
+						if(!bFailed) {bFailed = true; failure = UGError("std::exception", ex, __FILE__, __LINE__);}
+					}
+				}
+			}
+		}
+
+		if(bFailed) throw failure;
+		return;
+	}
+#endif
+
+	for(size_t l = 0; l < numColors; ++l)
+	{
+		const size_t k = bForward ? l : numColors - 1 - l;
+		for(size_t r = m_vColorStart[k]; r < m_vColorStart[k+1]; ++r)
+			update_row(A, c, d, relax, m_vRows[r], bForward);
+	}
+}
+
+template <typename TBlock>
+template <typename TMatrix, typename TVector>
+void MulticolorGaussSeidel<TBlock>::
+sgs_step(const TMatrix& A, TVector& c, const TVector& d, const number relax) const
+{
+//	c1 = (D-L)^{-1} d
+	gs_step_LL(A, c, d, relax);
+
+//	c2 = D c1
+	typename TVector::value_type s;
+	for(size_t i = 0; i < c.size(); i++)
+	{
+		s = c[i];
+		MatMult(c[i], 1.0, A(i, i), s);
+	}
+
+//	c3 = (D-U)^{-1} c2
+	gs_step_UR(A, c, c, relax);
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MULTICOLOR_GAUSS_SEIDEL__ */
@@ -251,6 +251,8 @@ public:
 // 	Apply Operator, i.e. f = f - L*u;
 	virtual void apply_sub(Y& f, const X& u) {m_op->apply_sub(f,u);}
 
+	virtual bool accepts_additive_input() const {return false;}
+
 // 	Access to matrix
 	virtual M& get_matrix() {return *this;};
 };
@@ -125,6 +125,12 @@ class ParallelMatrix : public TMatrix
 		/////////////////////////
 
 	/// calculate res = A x
+	/**	If A is additive and x is only additive, x is made consistent during
+	 * the multiplication. The interface communication is then overlapped with
+	 * the multiplication of all rows not coupled to interface entries.
+	 * \note Although passed as const, x is modified in this case: its values
+	 * and storage type are consistent afterwards (the represented vector is
+	 * unchanged). x must thus not be accessed concurrently.*/
 		template<typename TPVector>
 		bool apply(TPVector &res, const TPVector &x) const;
 
@@ -140,6 +146,10 @@ class ParallelMatrix : public TMatrix
 		this_type &operator =(const this_type &M);
 
 	private:
+	///	res = A x, while x is converted from additive to consistent
+		template<typename TPVector>
+		void apply_overlapping_additive_to_consistent(TPVector &res, TPVector &x) const;
+
 	/// type of storage  (i.e. consistent, additiv, additiv unique)
 		uint m_type;
 
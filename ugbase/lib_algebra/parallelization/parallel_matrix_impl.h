@@ -91,6 +91,8 @@ apply(TPVector &res, const TPVector &x) const
 			&& x.has_storage_type(PST_ADDITIVE)) type = 1;
 	if(has_storage_type(PST_CONSISTENT)
 			&& x.has_storage_type(PST_CONSISTENT)) type = 2;
+	if(type == -1 && has_storage_type(PST_ADDITIVE)
+			&& x.has_storage_type(PST_ADDITIVE)) type = 3;
 
 //	if no admissible type is found, return error
 	if(type == -1)
@@ -99,11 +101,22 @@ apply(TPVector &res, const TPVector &x) const
 				"Wrong storage type of Matrix/Vector: Possibilities are:\n"
 				"    - A is PST_ADDITIVE and x is PST_CONSISTENT\n"
 				"    - A is PST_CONSISTENT and x is PST_ADDITIVE\n"
+				"    - A is PST_ADDITIVE and x is PST_ADDITIVE (x is made consistent)\n"
 				"    (storage type of A = " << get_storage_type() << ", x = " << x.get_storage_type() << ")");
 	}
 
 //	apply on single process vector
-	TMatrix::axpy(res, 0.0, res, 1.0, x);
+	if(type == 3){
+	//	x is made consistent in place (see ILinearOperator::accepts_additive_input).
+	//	This changes only the storage representation of x, not the vector it
+	//	represents, which is why x is passed as const.
+		TPVector& xConsistent = const_cast<TPVector&>(x);
+		apply_overlapping_additive_to_consistent(res, xConsistent);
+		UG_ASSERT(x.has_storage_type(PST_CONSISTENT),
+				  "ParallelMatrix::apply: x has not been made consistent.");
+	}
+	else
+		TMatrix::axpy(res, 0.0, res, 1.0, x);
 
 //	set outgoing vector to additive storage
 	switch(type)
@@ -111,12 +124,52 @@ apply(TPVector &res, const TPVector &x) const
 		case 0: res.set_storage_type(PST_ADDITIVE); break;
 		case 1: res.set_storage_type(PST_ADDITIVE); break;
 		case 2: res.set_storage_type(PST_CONSISTENT); break;
+		case 3: res.set_storage_type(PST_ADDITIVE); break;
 	}
 
 //	we're done.
 	return true;
 }
 
+template <typename TMatrix>
+template<typename TPVector>
+void
+ParallelMatrix<TMatrix>::
+apply_overlapping_additive_to_consistent(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+
+	UG_COND_THROW(x.layouts().invalid(), "ParallelMatrix::apply: No layouts "
+				  "given but trying to make x consistent.");
+	const AlgebraLayouts& layouts = *x.layouts();
+
+//	with overlap, values have to be copied after the conversion as well. This
+//	is left to the vector itself.
+	if(layouts.overlap_enabled()){
+		if(!x.change_storage_type(PST_CONSISTENT))
+			UG_THROW("ParallelMatrix::apply: Cannot convert x to consistent vector.");
+		TMatrix::axpy(res, 0.0, res, 1.0, x);
+		return;
+	}
+
+//	rows coupled to interface entries of x have to wait for the communication
+	std::vector<char> colMask(x.size(), 0);
+	MarkLayoutIndices(colMask, layouts.master());
+	MarkLayoutIndices(colMask, layouts.slave());
+
+	AdditiveToConsistentExchange<TPVector> exchange(&x, layouts.master(),
+													layouts.slave(), &layouts.comm());
+	exchange.start();
+
+	std::vector<size_t> borderRows;
+	TMatrix::apply_inner_rows(res, 1.0, x, colMask, borderRows);
+
+	exchange.finish();
+	x.set_storage_type(PST_CONSISTENT);
+
+	TMatrix::apply_rows(res, 1.0, x, borderRows);
+}
+
 // calculate res = A.T x
 template <typename TMatrix>
 template<typename TPVector>
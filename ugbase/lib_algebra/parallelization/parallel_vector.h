@@ -152,6 +152,23 @@ class ParallelVector : public TVector
 	 */
 		inline number dotprod(const this_type& v);
 
+	/// several dot products (this, w[k]) with a single global reduction
+	/**
+	 * The process-local dot products are computed in one sweep over this
+	 * vector using TVector::dotprods. Then, all results are summed up over the
+	 * processes in one allreduce. If the storage types of this vector and w[k]
+	 * do not match, w[k] is converted.
+	 */
+		void dotprods(std::vector<number>& res, const std::vector<const this_type*>& w);
+
+	/// two norms of several vectors with a single global reduction
+	/**
+	 * The vectors are made unique, the process-local squared norms are
+	 * computed using TVector::norms_squared and summed up over the processes
+	 * in one allreduce.
+	 */
+		static void norms(std::vector<number>& res, const std::vector<const this_type*>& v);
+
 	/// assign number to whole Vector
 		number operator = (number d);
 
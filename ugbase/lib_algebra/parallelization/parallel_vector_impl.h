@@ -378,6 +378,109 @@ number ParallelVector<TVector>::dotprod(const this_type& v)
 	return tSumGlobal;
 }
 
+template <typename TVector>
+void ParallelVector<TVector>::dotprods(std::vector<number>& res,
+                                       const std::vector<const this_type*>& w)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	res.clear();
+	if(w.empty()) return;
+
+	// 	step 0: check that storage type is given
+	if(this->has_storage_type(PST_UNDEFINED))
+		UG_THROW("ERROR in ParallelVector::dotprods(): No parallel "
+				"Storage type given.");
+
+	//	step 1: adjust storage types of w[k] such that the local products are
+	//			valid: additive <-> consistent or unique <-> unique. If this
+	//			vector itself is contained in w, it has to be unique.
+	for(size_t k = 0; k < w.size(); ++k)
+		if(w[k] == this && !this->has_storage_type(PST_UNIQUE))
+			if(!this->change_storage_type(PST_UNIQUE))
+				UG_THROW("ParallelVector::dotprods(): Cannot change"
+						" ParallelStorageType to unique.");
+
+	std::vector<const TVector*> vSeq(w.size());
+	for(size_t k = 0; k < w.size(); ++k)
+	{
+		this_type& wk = *const_cast<this_type*>(w[k]);
+		if(wk.has_storage_type(PST_UNDEFINED))
+			UG_THROW("ERROR in ParallelVector::dotprods(): No parallel "
+					"Storage type given.");
+
+		bool check = false;
+		if(this->has_storage_type(PST_ADDITIVE)
+				&& wk.has_storage_type(PST_CONSISTENT)) check = true;
+		if(this->has_storage_type(PST_CONSISTENT)
+				&& wk.has_storage_type(PST_ADDITIVE)) check = true;
+		if(this->has_storage_type(PST_UNIQUE)
+				&& wk.has_storage_type(PST_UNIQUE))     check = true;
+
+		if(!check)
+		{
+			if(this->has_storage_type(PST_ADDITIVE))
+				wk.change_storage_type(PST_CONSISTENT);
+			else
+				wk.change_storage_type(PST_UNIQUE);
+		}
+		vSeq[k] = &wk;
+	}
+
+	// 	step 2: compute local dot products
+	std::vector<double> vLocal;
+	TVector::dotprods(vLocal, vSeq);
+	std::vector<double> vGlobal(vLocal.size());
+
+	// 	step 3: sum global contributions
+	PARVEC_PROFILE_BEGIN(ParVec_dotprods_allreduce);
+	if(layouts()->proc_comm().empty())
+		vGlobal = vLocal;
+	else
+		layouts()->proc_comm().allreduce(&vLocal[0], &vGlobal[0], (int)vLocal.size(),
+		                                PCL_DT_DOUBLE, PCL_RO_SUM);
+	PARVEC_PROFILE_END();
+
+	res.assign(vGlobal.begin(), vGlobal.end());
+}
+
+template <typename TVector>
+void ParallelVector<TVector>::norms(std::vector<number>& res,
+                                    const std::vector<const this_type*>& v)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	res.clear();
+	if(v.empty()) return;
+
+	// 	step 1: make vectors additive unique
+	std::vector<const TVector*> vSeq(v.size());
+	for(size_t k = 0; k < v.size(); ++k)
+	{
+		if(!const_cast<this_type*>(v[k])->change_storage_type(PST_UNIQUE))
+			UG_THROW("ParallelVector::norms(): Cannot change"
+					" ParallelStorageType to unique.");
+		vSeq[k] = v[k];
+	}
+
+	// 	step 2: compute process-local squared norms
+	std::vector<double> vLocal;
+	TVector::norms_squared(vLocal, vSeq);
+	std::vector<double> vGlobal(vLocal.size());
+
+	// 	step 3: sum squared local norms
+	PARVEC_PROFILE_BEGIN(ParVec_norms_allreduce);
+	if(v[0]->layouts()->proc_comm().empty())
+		vGlobal = vLocal;
+	else
+		v[0]->layouts()->proc_comm().allreduce(&vLocal[0], &vGlobal[0], (int)vLocal.size(),
+		                                      PCL_DT_DOUBLE, PCL_RO_SUM);
+	PARVEC_PROFILE_END();
+
+	// 	step 4: return global norms
+	res.resize(vGlobal.size());
+	for(size_t k = 0; k < vGlobal.size(); ++k)
+		res[k] = sqrt((number)vGlobal[k]);
+}
+
 template <typename TVector>
 void ParallelVector<TVector>::check_storage_type() const
 {
@@ -941,5 +941,22 @@ SmartPtr<AlgebraLayouts> CreateLocalAlgebraLayouts()
 	return SmartPtr<AlgebraLayouts>(p);
 }
 
+void MarkLayoutIndices(std::vector<char>& mask, const IndexLayout& layout)
+{
+	for(IndexLayout::const_iterator iter = layout.begin();
+		iter != layout.end(); ++iter)
+	{
+		const IndexLayout::Interface& interface = layout.interface(iter);
+		for(IndexLayout::Interface::const_iterator iter = interface.begin();
+				iter != interface.end(); ++iter)
+		{
+			const size_t index = interface.get_element(iter);
+			UG_ASSERT(index < mask.size(), "Layout index " << index
+					  << " exceeds mask size " << mask.size());
+			mask[index] = 1;
+		}
+	}
+}
+
 
 }// end of namespace
@@ -190,6 +190,103 @@ void AdditiveToConsistent(	TVector* pVec,
 		PU_PROFILE_END(AdditiveToConsistent_step2);
 }
 
+/// split-phase version of AdditiveToConsistent
+/**
+ * Performs the same conversion as AdditiveToConsistent, but does not block
+ * until the communication is done. This allows to do work which does not
+ * access the interface entries of the vector while the communication is
+ * in progress:
+ *
+ * \code
+ * AdditiveToConsistentExchange<TVector> exchange(pVec, masterLayout, slaveLayout);
+ * exchange.start();	// sends slave values to masters
+ * // ... work on non-interface entries ...
+ * exchange.advance();	// receives master sums, sends them back to the slaves
+ * // ... more work on non-interface entries ...
+ * exchange.finish();	// pVec is consistent now
+ * \endcode
+ *
+ * The conversion consists of two communication steps (slaves to masters,
+ * masters to slaves). advance() waits for the running step and starts the
+ * next one. Calling advance() is optional, finish() completes all
+ * outstanding steps. The destructor calls finish().
+ *
+ * \note	No other communication may be performed through the given
+ * 			communicator until finish() was called.
+ */
+template <typename TVector>
+class AdditiveToConsistentExchange
+{
+	public:
+		AdditiveToConsistentExchange(	TVector* pVec,
+		                             	const IndexLayout& masterLayout,
+		                             	const IndexLayout& slaveLayout,
+		                             	pcl::InterfaceCommunicator<IndexLayout>* pCom = NULL)
+			:	m_masterLayout(masterLayout), m_slaveLayout(slaveLayout),
+				m_pCom(pCom ? pCom : &m_tCom),
+				m_cpVecAdd(pVec), m_cpVecCopy(pVec),
+				m_step(0)
+		{}
+
+		~AdditiveToConsistentExchange()	{finish();}
+
+	///	starts sending the slave values to the masters
+		void start()
+		{
+			UG_COND_THROW(m_step != 0, "AdditiveToConsistentExchange::start: "
+						  "Exchange has already been started.");
+			m_pCom->send_data(m_slaveLayout, m_cpVecAdd);
+			m_pCom->receive_data(m_masterLayout, m_cpVecAdd);
+			m_pCom->communicate_and_resume();
+			m_step = 1;
+		}
+
+	///	waits for the running step and starts the next one.
+	/**	Returns true if a communication step is still in progress afterwards.*/
+		bool advance()
+		{
+			if(m_step == 1){
+				m_pCom->wait();
+				m_pCom->send_data(m_masterLayout, m_cpVecCopy);
+				m_pCom->receive_data(m_slaveLayout, m_cpVecCopy);
+				m_pCom->communicate_and_resume();
+				m_step = 2;
+				return true;
+			}
+			else if(m_step == 2){
+				m_pCom->wait();
+				m_step = 3;
+			}
+			return false;
+		}
+
+	///	completes all outstanding communication. The vector is consistent afterwards.
+		void finish()
+		{
+			while(advance()) {}
+		}
+
+	///	returns true if start() was called and finish() was not called yet
+		bool in_progress() const	{return m_step == 1 || m_step == 2;}
+
+	private:
+		AdditiveToConsistentExchange(const AdditiveToConsistentExchange&);
+		AdditiveToConsistentExchange& operator=(const AdditiveToConsistentExchange&);
+
+		const IndexLayout& m_masterLayout;
+		const IndexLayout& m_slaveLayout;
+		pcl::InterfaceCommunicator<IndexLayout>		m_tCom;
+		pcl::InterfaceCommunicator<IndexLayout>*	m_pCom;
+		ComPol_VecAdd<TVector>	m_cpVecAdd;
+		ComPol_VecCopy<TVector>	m_cpVecCopy;
+		int m_step;
+};
+
+///	marks all indices contained in the given layout with 1 in mask
+/**	The mask has to be large enough to hold all layout indices. Entries
+ * which are not contained in the layout are not changed.*/
+void MarkLayoutIndices(std::vector<char>& mask, const IndexLayout& layout);
+
 /// changes parallel storage type from unique to consistent
 /**
  * This function changes the storage type of a parallel vector from unique
@@ -104,7 +104,13 @@ extern "C"
 	void sgetri_(lapack_int *n, lapack_float *pColMajorMatrix, lapack_int *lda, const lapack_int *ipiv, 
 				 lapack_float *pWork, lapack_int *worksize, lapack_int *info);
 	void dgetri_(lapack_int *n, lapack_double *pColMajorMatrix, lapack_int *lda, const lapack_int *ipiv,
-				 lapack_double *pWork, lapack_int *worksize, lapack_int *info);	
+				 lapack_double *pWork, lapack_int *worksize, lapack_int *info);
+
+	// matrix-matrix product (BLAS level 3)
+	void dgemm_(char *transA, char *transB, lapack_int *m, lapack_int *n, lapack_int *k,
+				lapack_double *alpha, const lapack_double *A, lapack_int *lda,
+				const lapack_double *B, lapack_int *ldb, lapack_double *beta,
+				lapack_double *C, lapack_int *ldc);
 }
 
 
@@ -39,6 +39,7 @@
 #include "common/common.h"
 #include "lib_algebra/small_algebra/small_algebra.h"  // for InvertNdyn
 #include <algorithm>
+#include <cmath>
 
 //
 namespace ug {
@@ -252,6 +253,57 @@ inline bool InverseMatMult(DenseVector< FixedArray1<double, 3> > &dest, double b
 {
 	return InverseMatMult3(dest, beta, mat, vec);
 }
+
+//////////////////////
+// 4x4
+
+//! solves mat * dest = beta * vec by gaussian elimination with partial pivoting
+template<typename vector_t, typename matrix_t>
+inline bool InverseMatMult4(DenseVector<vector_t> &dest, double beta,
+		const DenseMatrix<matrix_t> &mat, const DenseVector<vector_t> &vec)
+{
+	UG_ASSERT(&dest != &vec, "");
+	double a[4][5];
+	for(size_t r=0; r<4; r++)
+	{
+		for(size_t c=0; c<4; c++)
+			a[r][c] = mat(r,c);
+		a[r][4] = beta*vec[r];
+	}
+
+	for(size_t k=0; k<4; k++)
+	{
+		size_t p = k;
+		for(size_t r=k+1; r<4; r++)
+			if(fabs(a[r][k]) > fabs(a[p][k])) p = r;
+		if(a[p][k] == 0.0) return false;
+		if(p != k)
+			for(size_t c=k; c<5; c++)
+				std::swap(a[k][c], a[p][c]);
+
+		for(size_t r=k+1; r<4; r++)
+		{
+			const double l = a[r][k]/a[k][k];
+			for(size_t c=k+1; c<5; c++)
+				a[r][c] -= l*a[k][c];
+		}
+	}
+
+	for(size_t k=4; k-- > 0; )
+	{
+		double s = a[k][4];
+		for(size_t c=k+1; c<4; c++)
+			s -= a[k][c]*dest[c];
+		dest[k] = s/a[k][k];
+	}
+	return true;
+}
+
+inline bool InverseMatMult(DenseVector< FixedArray1<double, 4> > &dest, double beta,
+		const DenseMatrix< FixedArray2<double, 4, 4> > &mat, const DenseVector< FixedArray1<double, 4> > &vec)
+{
+	return InverseMatMult4(dest, beta, mat, vec);
+}
 //////////////////////
 
 
@@ -336,6 +388,7 @@ inline bool InverseMatMult(DenseVector<vector_t> &dest, double beta,
 		case 1: return InverseMatMult1(dest, beta, mat, vec);
 		case 2: return InverseMatMult2(dest, beta, mat, vec);
 		case 3: return InverseMatMult3(dest, beta, mat, vec);
+		case 4: return InverseMatMult4(dest, beta, mat, vec);
 		default: return InverseMatMultN(dest, beta, mat, vec);
 	}
 }
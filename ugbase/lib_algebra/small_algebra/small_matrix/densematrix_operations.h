@@ -98,4 +98,6 @@ inline void MatMultTransposedAdd(DenseVector<vector_t> &dest,
 
 }
 
+#include "densematrix_simd.h"
+
 #endif // __H__UG__COMMON__DENSEMATRIX_OPERATIONS_H__
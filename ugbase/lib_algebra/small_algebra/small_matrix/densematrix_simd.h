@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__SMALL_ALGEBRA__DENSEMATRIX_SIMD_H__
+#define __H__UG__SMALL_ALGEBRA__DENSEMATRIX_SIMD_H__
+
+#include "densematrix.h"
+#include "densevector.h"
+#include "../storage/fixed_array.h"
+
+// The block kernels are only compiled in if the compiler generates AVX2 and
+// FMA code (e.g. -march=native or -mavx2 -mfma). Otherwise the generic
+// MatMult/MatMultAdd of densematrix_operations.h are used.
+#if defined(__AVX2__) && defined(__FMA__)
+#define UG_SIMD_BLOCK_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace ug{
+
+/// \addtogroup small_algebra
+/// \{
+
+/**
+ * SIMD kernels for NxN column major blocks of doubles times a vector of
+ * length N, as used in the SpMV of CPUBlockAlgebra<N>. One column of the
+ * block is held in one register and is scaled by the entry of the vector.
+ * Specializations exist for N = 2, 3, 4 (a 4x4 column fills a 256 bit
+ * register, so AVX-512 has no benefit for these block sizes).
+ */
+template<size_t N>
+struct BlockKernelsSIMD;
+
+#ifdef UG_SIMD_BLOCK_KERNELS
+
+template<>
+struct BlockKernelsSIMD<2>
+{
+	//! dest = alpha1*v1 + beta1*A*w1
+	static inline void mat_mult_add(double *dest, double alpha1, const double *v1,
+			double beta1, const double *A, const double *w1)
+	{
+		__m128d d = _mm_mul_pd(_mm_set1_pd(alpha1), _mm_loadu_pd(v1));
+		d = _mm_fmadd_pd(_mm_loadu_pd(A), _mm_set1_pd(beta1*w1[0]), d);
+		d = _mm_fmadd_pd(_mm_loadu_pd(A+2), _mm_set1_pd(beta1*w1[1]), d);
+		_mm_storeu_pd(dest, d);
+	}
+
+	//! dest = beta1*A*w1
+	static inline void mat_mult(double *dest, double beta1, const double *A, const double *w1)
+	{
+		__m128d d = _mm_mul_pd(_mm_loadu_pd(A), _mm_set1_pd(beta1*w1[0]));
+		d = _mm_fmadd_pd(_mm_loadu_pd(A+2), _mm_set1_pd(beta1*w1[1]), d);
+		_mm_storeu_pd(dest, d);
+	}
+};
+
+template<>
+struct BlockKernelsSIMD<3>
+{
+	//	rows 0 and 1 are processed in a 128 bit register, row 2 scalar. Masked
+	//	256 bit loads/stores would avoid the split, but the masked store of dest
+	//	stalls the store forwarding to the next block of the same row.
+
+	//! dest = alpha1*v1 + beta1*A*w1
+	static inline void mat_mult_add(double *dest, double alpha1, const double *v1,
+			double beta1, const double *A, const double *w1)
+	{
+		const double bw0 = beta1*w1[0], bw1 = beta1*w1[1], bw2 = beta1*w1[2];
+		__m128d d = _mm_mul_pd(_mm_set1_pd(alpha1), _mm_loadu_pd(v1));
+		d = _mm_fmadd_pd(_mm_loadu_pd(A), _mm_set1_pd(bw0), d);
+		d = _mm_fmadd_pd(_mm_loadu_pd(A+3), _mm_set1_pd(bw1), d);
+		d = _mm_fmadd_pd(_mm_loadu_pd(A+6), _mm_set1_pd(bw2), d);
+		const double d2 = alpha1*v1[2] + A[2]*bw0 + A[5]*bw1 + A[8]*bw2;
+		_mm_storeu_pd(dest, d);
+		dest[2] = d2;
+	}
+
+	//! dest = beta1*A*w1
+	static inline void mat_mult(double *dest, double beta1, const double *A, const double *w1)
+	{
+		const double bw0 = beta1*w1[0], bw1 = beta1*w1[1], bw2 = beta1*w1[2];
+		__m128d d = _mm_mul_pd(_mm_loadu_pd(A), _mm_set1_pd(bw0));
+		d = _mm_fmadd_pd(_mm_loadu_pd(A+3), _mm_set1_pd(bw1), d);
+		d = _mm_fmadd_pd(_mm_loadu_pd(A+6), _mm_set1_pd(bw2), d);
+		dest[2] = A[2]*bw0 + A[5]*bw1 + A[8]*bw2;
+		_mm_storeu_pd(dest, d);
+	}
+};
+
+template<>
+struct BlockKernelsSIMD<4>
+{
+	//! dest = alpha1*v1 + beta1*A*w1
+	static inline void mat_mult_add(double *dest, double alpha1, const double *v1,
+			double beta1, const double *A, const double *w1)
+	{
+		__m256d d = _mm256_mul_pd(_mm256_set1_pd(alpha1), _mm256_loadu_pd(v1));
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A), _mm256_set1_pd(beta1*w1[0]), d);
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A+4), _mm256_set1_pd(beta1*w1[1]), d);
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A+8), _mm256_set1_pd(beta1*w1[2]), d);
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A+12), _mm256_set1_pd(beta1*w1[3]), d);
+		_mm256_storeu_pd(dest, d);
+	}
+
+	//! dest = beta1*A*w1
+	static inline void mat_mult(double *dest, double beta1, const double *A, const double *w1)
+	{
+		__m256d d = _mm256_mul_pd(_mm256_loadu_pd(A), _mm256_set1_pd(beta1*w1[0]));
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A+4), _mm256_set1_pd(beta1*w1[1]), d);
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A+8), _mm256_set1_pd(beta1*w1[2]), d);
+		d = _mm256_fmadd_pd(_mm256_loadu_pd(A+12), _mm256_set1_pd(beta1*w1[3]), d);
+		_mm256_storeu_pd(dest, d);
+	}
+};
+
+
+// overloads for the fixed block types of CPUBlockAlgebra<N>. Being non-templates,
+// they are preferred over the generic versions in densematrix_operations.h.
+
+//! calculates dest = beta1 * A1 * w1;
+inline void MatMult(DenseVector<FixedArray1<double, 2> > &dest,
+		const number &beta1, const DenseMatrix<FixedArray2<double, 2, 2> > &A1,
+		const DenseVector<FixedArray1<double, 2> > &w1)
+{
+	BlockKernelsSIMD<2>::mat_mult(&dest[0], beta1, &A1(0,0), &w1[0]);
+}
+
+//! calculates dest = alpha1*v1 + beta1 * A1 *w1;
+inline void MatMultAdd(DenseVector<FixedArray1<double, 2> > &dest,
+		const number &alpha1, const DenseVector<FixedArray1<double, 2> > &v1,
+		const number &beta1, const DenseMatrix<FixedArray2<double, 2, 2> > &A1,
+		const DenseVector<FixedArray1<double, 2> > &w1)
+{
+	BlockKernelsSIMD<2>::mat_mult_add(&dest[0], alpha1, &v1[0], beta1, &A1(0,0), &w1[0]);
+}
+
+//! calculates dest = beta1 * A1 * w1;
+inline void MatMult(DenseVector<FixedArray1<double, 3> > &dest,
+		const number &beta1, const DenseMatrix<FixedArray2<double, 3, 3> > &A1,
+		const DenseVector<FixedArray1<double, 3> > &w1)
+{
+	BlockKernelsSIMD<3>::mat_mult(&dest[0], beta1, &A1(0,0), &w1[0]);
+}
+
+//! calculates dest = alpha1*v1 + beta1 * A1 *w1;
+inline void MatMultAdd(DenseVector<FixedArray1<double, 3> > &dest,
+		const number &alpha1, const DenseVector<FixedArray1<double, 3> > &v1,
+		const number &beta1, const DenseMatrix<FixedArray2<double, 3, 3> > &A1,
+		const DenseVector<FixedArray1<double, 3> > &w1)
+{
+	BlockKernelsSIMD<3>::mat_mult_add(&dest[0], alpha1, &v1[0], beta1, &A1(0,0), &w1[0]);
+}
+
+//! calculates dest = beta1 * A1 * w1;
+inline void MatMult(DenseVector<FixedArray1<double, 4> > &dest,
+		const number &beta1, const DenseMatrix<FixedArray2<double, 4, 4> > &A1,
+		const DenseVector<FixedArray1<double, 4> > &w1)
+{
+	BlockKernelsSIMD<4>::mat_mult(&dest[0], beta1, &A1(0,0), &w1[0]);
+}
+
+//! calculates dest = alpha1*v1 + beta1 * A1 *w1;
+inline void MatMultAdd(DenseVector<FixedArray1<double, 4> > &dest,
+		const number &alpha1, const DenseVector<FixedArray1<double, 4> > &v1,
+		const number &beta1, const DenseMatrix<FixedArray2<double, 4, 4> > &A1,
+		const DenseVector<FixedArray1<double, 4> > &w1)
+{
+	BlockKernelsSIMD<4>::mat_mult_add(&dest[0], alpha1, &v1[0], beta1, &A1(0,0), &w1[0]);
+}
+
+#endif // UG_SIMD_BLOCK_KERNELS
+
+// end group small_algebra
+/// \}
+
+} // namespace ug
+
+#endif // __H__UG__SMALL_ALGEBRA__DENSEMATRIX_SIMD_H__
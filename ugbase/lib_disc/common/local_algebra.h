@@ -788,6 +788,49 @@ void AddLocalMatrixToGlobal(TMatrix& mat, const LocalMatrix& lmat)
 		}
 }
 
+///	adds the entries of a local matrix coupling a global index with itself
+template <typename TMatrix>
+void AddLocalMatrixDiagonalToGlobal(TMatrix& mat, const LocalMatrix& lmat)
+{
+	const LocalIndices& rowInd = lmat.get_row_indices();
+	const LocalIndices& colInd = lmat.get_col_indices();
+
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			const size_t rowIndex = rowInd.index(fct1,dof1);
+			const size_t rowComp = rowInd.comp(fct1,dof1);
+
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+				{
+				//	only the (block) diagonal is added
+					const size_t colIndex = colInd.index(fct2,dof2);
+					if(colIndex != rowIndex) continue;
+
+					const size_t colComp = colInd.comp(fct2,dof2);
+					BlockRef(mat(rowIndex, colIndex), rowComp, colComp)
+								+= lmat.value(fct1,dof1,fct2,dof2);
+				}
+		}
+}
+
+///	computes res += lmat * vec for local algebra objects
+inline
+void AddLocalMatVec(LocalVector& res, const LocalMatrix& lmat, const LocalVector& vec)
+{
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			number sum = 0.0;
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+					sum += lmat.value(fct1,dof1,fct2,dof2) * vec.value(fct2,dof2);
+
+			res.value(fct1,dof1) += sum;
+		}
+}
+
 } // end namespace ug
 
 #endif /* __H__UG__LIB_DISC__COMMON__LOCAL_ALGEBRA__ */
@@ -71,7 +71,14 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	  m_spSurfView(spSurfView),
 	  m_gridLevel(level),
 	  m_spDoFIndexStorage(spDoFIndexStorage),
-	  m_numIndex(0)
+	  m_numIndex(0),
+	  m_bElemIndexTables(false),
+	  m_bIncrementalReinit(false),
+	  m_defragThreshold(0.25),
+	  m_numIndexPerObj(0),
+	  m_numDisplacedIndex(0),
+	  m_bRecordAdaption(false),
+	  m_bRegionReinit(false)
 {
 	if(m_spDoFIndexStorage.invalid())
 		m_spDoFIndexStorage = SmartPtr<DoFIndexStorage>(new DoFIndexStorage(spMG, spDDInfo));
@@ -88,7 +95,11 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 
 
 DoFDistribution::
-~DoFDistribution() {}
+~DoFDistribution()
+{
+	stop_recording();
+	enable_elem_index_tables(false);
+}
 
 
 void DoFDistribution::check_subsets()
@@ -163,14 +174,25 @@ add(TBaseObject* obj, const ReferenceObjectID roid, const int si)
 	size_t numNewIndex = 1;
 	if(!m_bGrouped) numNewIndex = num_dofs(roid,si);
 
-// 	set first available index to the object. The first available index is the
-//	first managed index plus the size of the index set. (If holes are in the
-//	index set, this is not treated here, holes remain)
-	obj_index(obj) = m_numIndex;
+//	in an incremental reinit, keep the index if the object still owns it
+	if(!reuse_index(obj, si))
+	{
+	// 	set first available index to the object. The first available index is the
+	//	first managed index plus the size of the index set. (If holes are in the
+	//	index set, this is not treated here, holes remain)
+		obj_index(obj) = m_numIndex;
+
+	//	number of managed indices has changed. Thus, increase the counter.
+		m_numIndex += numNewIndex;
+
+	//	remember owner of the new slot
+		if(m_bIncrementalReinit){
+			m_vIndexOwner.push_back(obj);
+			m_vIndexSubset.push_back(si);
+		}
+	}
 
-//	number of managed indices and the number of managed indices on the subset has
-//	changed. Thus, increase the counters.
-	m_numIndex += numNewIndex;
+//	number of managed indices on the subset has changed
 	m_vNumIndexOnSubset[si] += numNewIndex;
 
 // 	if obj is a master, assign all its slaves
@@ -1120,6 +1142,25 @@ void DoFDistribution::_indices(TBaseElem* elem, LocalIndices& ind, bool bHang) c
 //	reference dimension
 	static const int dim = TBaseElem::dim;
 
+//	use the flat index table, if the element is contained
+	if(!bHang && m_bElemIndexTables && dim > VERTEX){
+		const size_t row = m_aaElemIndexRow[elem];
+		const ElemIndexTable& table = m_vElemIndexTable[dim];
+		if(table.contains(row, elem)){
+			table.local_indices(row, ind);
+			return;
+		}
+	}
+
+	grid_indices(elem, ind, bHang);
+}
+
+template<typename TBaseElem>
+void DoFDistribution::grid_indices(TBaseElem* elem, LocalIndices& ind, bool bHang) const
+{
+//	reference dimension
+	static const int dim = TBaseElem::dim;
+
 //	resize the number of functions
 	ind.resize_fct(num_fct());
 	for(size_t fct = 0; fct < num_fct(); ++fct) ind.clear_dof(fct);
@@ -1429,18 +1470,70 @@ void DoFDistribution::reinit()
 
 void DoFDistribution::reinit()
 {
-	m_numIndex = 0;
-	m_vNumIndexOnSubset.resize(0);
-	m_vNumIndexOnSubset.resize(num_subsets(), 0);
+	const size_t numOldIndex = m_numIndex;
+	m_vReinitIndexMap.clear();
+	m_vOldIndexOwner.clear();
+	m_bRegionReinit = false;
+
+//	after a recorded adaption, only the changed objects are visited
+	if(m_bRecordAdaption){
+		reinit_region(numOldIndex);
+		stop_recording();
+		m_bRegionReinit = true;
+	}
+	else{
+		m_vRegionObj.clear();
+
+	//	in incremental mode, the indices are appended to the old index set
+		if(m_bIncrementalReinit && !m_vIndexOwner.empty()){
+			m_vOldIndexOwner.swap(m_vIndexOwner);
+			m_vIndexOwner.assign(m_vOldIndexOwner.size(), NULL);
+			m_vIndexSubset.assign(m_vOldIndexOwner.size(), -1);
+		}
+		else{
+			m_vIndexOwner.clear();
+			m_vIndexSubset.clear();
+			m_numIndex = 0;
+			m_numDisplacedIndex = 0;
+		}
+
+		m_vNumIndexOnSubset.resize(0);
+		m_vNumIndexOnSubset.resize(num_subsets(), 0);
+
+		if(max_dofs(VERTEX)) reinit<Vertex>();
+		if(max_dofs(EDGE))   reinit<Edge>();
+		if(max_dofs(FACE))   reinit<Face>();
+		if(max_dofs(VOLUME)) reinit<Volume>();
 
-	if(max_dofs(VERTEX)) reinit<Vertex>();
-	if(max_dofs(EDGE))   reinit<Edge>();
-	if(max_dofs(FACE))   reinit<Face>();
-	if(max_dofs(VOLUME)) reinit<Volume>();
+		if(!m_vOldIndexOwner.empty()){
+			compact_indices(numOldIndex);
+			m_vOldIndexOwner.clear();
+		}
+	}
+
+//	too many displaced indices: renumber all
+	if(!m_vReinitIndexMap.empty()
+		&& m_numDisplacedIndex > m_defragThreshold * m_numIndex){
+		m_vIndexOwner.clear();
+		reinit();
+		return;
+	}
+
+//	move the values of the managed grid functions to the new indices
+	if(!m_vReinitIndexMap.empty()){
+		std::vector<std::pair<size_t, size_t> > vMoved;
+		for(size_t i = 0; i < m_vReinitIndexMap.size(); ++i)
+			if(m_vReinitIndexMap[i] != i && m_vReinitIndexMap[i] != (size_t)-1)
+				vMoved.push_back(std::make_pair(i, m_vReinitIndexMap[i]));
+		if(!vMoved.empty()) copy_values(vMoved, true);
+		resize_values(m_numIndex);
+	}
 
 #ifdef UG_PARALLEL
 	reinit_layouts_and_communicator();
 #endif
+
+	if(m_bElemIndexTables) update_elem_index_tables();
 }
 
 
@@ -1746,6 +1839,9 @@ void DoFDistribution::permute_indices(const std::vector<size_t>& vNewInd)
 	// 	get current (old) index
 		const size_t oldIndex = obj_index(elem);
 
+	//	elements without indices remain untouched
+		if(oldIndex >= vNewInd.size()) continue;
+
 	//	replace old index by new one
 		obj_index(elem) = vNewInd[oldIndex];
 	}
@@ -1758,12 +1854,637 @@ void DoFDistribution::permute_indices(const std::vector<size_t>& vNewInd)
 	if(max_dofs(FACE))   permute_indices<Face>(vNewInd);
 	if(max_dofs(VOLUME)) permute_indices<Volume>(vNewInd);
 
+//	move the slot owners along with their indices
+	if(!m_vIndexOwner.empty()){
+		std::vector<GridObject*> vOwner(m_vIndexOwner.size(), NULL);
+		std::vector<int> vSubset(m_vIndexSubset.size(), -1);
+		for(size_t slot = 0; slot < m_vIndexOwner.size(); ++slot){
+			const size_t newSlot = vNewInd[slot * m_numIndexPerObj] / m_numIndexPerObj;
+			vOwner[newSlot] = m_vIndexOwner[slot];
+			vSubset[newSlot] = m_vIndexSubset[slot];
+		}
+		m_vIndexOwner.swap(vOwner);
+		m_vIndexSubset.swap(vSubset);
+	}
+	m_vReinitIndexMap.clear();
+	m_bRegionReinit = false;
+	m_vRegionObj.clear();
+	m_numDisplacedIndex = 0;
+
 #ifdef UG_PARALLEL
 	reinit_layouts_and_communicator();
 #endif
 
+	if(m_bElemIndexTables) update_elem_index_tables();
+
 //	permute indices in associated vectors
 	permute_values(vNewInd);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Incremental reinit
+////////////////////////////////////////////////////////////////////////////////
+
+void DoFDistribution::enable_incremental_reinit(bool bEnable)
+{
+	if(bEnable == m_bIncrementalReinit) return;
+
+	stop_recording();
+	m_vIndexOwner.clear();
+	m_vIndexSubset.clear();
+	m_vReinitIndexMap.clear();
+	m_numDisplacedIndex = 0;
+	m_bIncrementalReinit = false;
+	if(!bEnable) return;
+
+//	the indices are moved in slots of equal size, thus each geometric object
+//	must carry the same number of indices
+	size_t numIndexPerObj = 0;
+	for(int si = 0; si < num_subsets(); ++si){
+		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid){
+			const size_t numDoF = num_dofs((ReferenceObjectID)roid, si);
+			if(numDoF == 0) continue;
+
+			const size_t numIndex = m_bGrouped ? 1 : numDoF;
+			if(numIndexPerObj != 0 && numIndexPerObj != numIndex)
+				UG_THROW("DoFDistribution::enable_incremental_reinit: "
+						"Only implemented iff the same number of indices is "
+						"located on all geometric objects, but found "
+						<<numIndexPerObj<<" and "<<numIndex<<" indices.");
+			numIndexPerObj = numIndex;
+		}
+	}
+
+	m_numIndexPerObj = std::max(numIndexPerObj, (size_t)1);
+	m_bIncrementalReinit = true;
+
+//	register the owners of the current indices
+	if(m_numIndex > 0){
+		m_vIndexOwner.assign(m_numIndex / m_numIndexPerObj, NULL);
+		m_vIndexSubset.assign(m_vIndexOwner.size(), -1);
+		if(max_dofs(VERTEX)) init_index_owners<Vertex>();
+		if(max_dofs(EDGE))   init_index_owners<Edge>();
+		if(max_dofs(FACE))   init_index_owners<Face>();
+		if(max_dofs(VOLUME)) init_index_owners<Volume>();
+
+	//	the region reinit requires an owner for every slot. Otherwise, the
+	//	next reinit renumbers all indices.
+		if(std::find(m_vIndexOwner.begin(), m_vIndexOwner.end(), (GridObject*)NULL)
+			!= m_vIndexOwner.end()){
+			m_vIndexOwner.clear();
+			m_vIndexSubset.clear();
+		}
+	}
+}
+
+void DoFDistribution::set_defragmentation_threshold(number threshold)
+{
+	UG_COND_THROW(threshold < 0, "DoFDistribution: Defragmentation threshold "
+					"must be non-negative, but is "<<threshold);
+	m_defragThreshold = threshold;
+}
+
+template <typename TBaseElem>
+void DoFDistribution::init_index_owners()
+{
+//	NOTE: Objects sharing an index (shadow copies, periodic slaves) are skipped.
+//		  Choosing a wrong owner would only prevent the reuse of its index.
+	const bool bPeriodic = m_spMG->has_periodic_boundaries();
+
+	typename traits<TBaseElem>::const_iterator iter = begin<TBaseElem>(SurfaceView::ALL);
+	typename traits<TBaseElem>::const_iterator iterEnd = end<TBaseElem>(SurfaceView::ALL);
+	for(; iter != iterEnd; ++iter)
+	{
+		TBaseElem* elem = *iter;
+		const size_t index = obj_index(elem);
+		if(index >= m_numIndex) continue;
+
+		if(grid_level().is_surface()
+			&& m_spSurfView->is_contained(elem, grid_level(), SurfaceView::SHADOW_RIM_COPY))
+			continue;
+		if(bPeriodic && m_spMG->periodic_boundary_manager()->is_slave(elem))
+			continue;
+
+		const size_t slot = index / m_numIndexPerObj;
+		if(m_vIndexOwner[slot] == NULL){
+			m_vIndexOwner[slot] = elem;
+			m_vIndexSubset[slot] = m_spMGSH->get_subset_index(elem);
+		}
+	}
+}
+
+bool DoFDistribution::reuse_index(GridObject* obj, int si)
+{
+	if(m_vOldIndexOwner.empty()) return false;
+
+//	new objects have the default index size_t(-1)
+	const size_t index = obj_index(obj);
+	if(index % m_numIndexPerObj != 0) return false;
+
+	const size_t slot = index / m_numIndexPerObj;
+	if(slot >= m_vOldIndexOwner.size()) return false;
+
+//	the index may be outdated, since the object was not
+//	contained in the index set in the meantime
+	if(m_vOldIndexOwner[slot] != obj || m_vIndexOwner[slot] != NULL)
+		return false;
+
+	m_vIndexOwner[slot] = obj;
+	m_vIndexSubset[slot] = si;
+	return true;
+}
+
+void DoFDistribution::compact_indices(size_t numOldIndex)
+{
+	PROFILE_FUNC();
+	const size_t numSlot = m_vIndexOwner.size();
+	const size_t numOldSlot = m_vOldIndexOwner.size();
+
+	size_t numUsedSlot = 0;
+	for(size_t slot = 0; slot < numSlot; ++slot)
+		if(m_vIndexOwner[slot] != NULL) ++numUsedSlot;
+
+//	fill the holes by the slots with the highest indices
+	std::vector<size_t> vNewSlot(numSlot);
+	for(size_t slot = 0; slot < numSlot; ++slot) vNewSlot[slot] = slot;
+
+	size_t tail = numSlot;
+	size_t numMoved = 0;
+	for(size_t hole = 0; hole < numUsedSlot; ++hole){
+		if(m_vIndexOwner[hole] != NULL) continue;
+
+		do{--tail;} while(m_vIndexOwner[tail] == NULL);
+		vNewSlot[tail] = hole;
+		if(tail < numOldSlot) ++numMoved;
+	}
+
+//	mapping old -> new index for all kept indices
+	m_vReinitIndexMap.assign(numOldIndex, (size_t)-1);
+	for(size_t slot = 0; slot < numOldSlot; ++slot){
+		if(m_vOldIndexOwner[slot] == NULL
+			|| m_vIndexOwner[slot] != m_vOldIndexOwner[slot]) continue;
+
+		for(size_t i = 0; i < m_numIndexPerObj; ++i)
+			m_vReinitIndexMap[slot * m_numIndexPerObj + i]
+			                  = vNewSlot[slot] * m_numIndexPerObj + i;
+	}
+
+//	appended and moved slots no longer follow the iteration order
+	m_numDisplacedIndex += (numSlot - numOldSlot + numMoved) * m_numIndexPerObj;
+
+//	move indices of all objects (including shadow copies and periodic slaves)
+	if(tail < numSlot){
+		std::vector<size_t> vNewInd(m_numIndex);
+		for(size_t i = 0; i < vNewInd.size(); ++i)
+			vNewInd[i] = vNewSlot[i / m_numIndexPerObj] * m_numIndexPerObj
+							+ i % m_numIndexPerObj;
+
+		if(max_dofs(VERTEX)) permute_indices<Vertex>(vNewInd);
+		if(max_dofs(EDGE))   permute_indices<Edge>(vNewInd);
+		if(max_dofs(FACE))   permute_indices<Face>(vNewInd);
+		if(max_dofs(VOLUME)) permute_indices<Volume>(vNewInd);
+
+		std::vector<GridObject*> vOwner(numUsedSlot, NULL);
+		std::vector<int> vSubset(numUsedSlot, -1);
+		for(size_t slot = 0; slot < numSlot; ++slot)
+			if(m_vIndexOwner[slot] != NULL){
+				vOwner[vNewSlot[slot]] = m_vIndexOwner[slot];
+				vSubset[vNewSlot[slot]] = m_vIndexSubset[slot];
+			}
+		m_vIndexOwner.swap(vOwner);
+		m_vIndexSubset.swap(vSubset);
+	}
+
+	m_vIndexOwner.resize(numUsedSlot);
+	m_vIndexSubset.resize(numUsedSlot);
+	m_numIndex = numUsedSlot * m_numIndexPerObj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Region reinit
+////////////////////////////////////////////////////////////////////////////////
+
+void DoFDistribution::adaption_begins()
+{
+	if(m_bRecordAdaption) return;
+
+	m_vRegionObj.clear();
+	m_vReleasedSlot.clear();
+
+//	the region reinit relies on an owner for each slot. Shared indices of
+//	periodic slaves and parallel layouts are only handled by a full loop.
+	if(!m_bIncrementalReinit || m_vIndexOwner.empty()) return;
+	if(m_spMG->has_periodic_boundaries()) return;
+#ifdef UG_PARALLEL
+	if(pcl::NumProcs() > 1) return;
+#endif
+
+	m_pMG->attach_to_dv<Vertex>(m_aRegionPos, (size_t)-1);
+	m_pMG->attach_to_dv<Edge>(m_aRegionPos, (size_t)-1);
+	m_pMG->attach_to_dv<Face>(m_aRegionPos, (size_t)-1);
+	m_pMG->attach_to_dv<Volume>(m_aRegionPos, (size_t)-1);
+	m_aaRegionPos.access(*m_pMG, m_aRegionPos, true, true, true, true);
+
+	m_pMG->register_observer(this, OT_VERTEX_OBSERVER | OT_EDGE_OBSERVER
+									| OT_FACE_OBSERVER | OT_VOLUME_OBSERVER);
+	m_bRecordAdaption = true;
+}
+
+void DoFDistribution::stop_recording()
+{
+	if(!m_bRecordAdaption) return;
+
+	m_pMG->unregister_observer(this);
+	m_aaRegionPos.invalidate();
+	m_pMG->detach_from<Vertex>(m_aRegionPos);
+	m_pMG->detach_from<Edge>(m_aRegionPos);
+	m_pMG->detach_from<Face>(m_aRegionPos);
+	m_pMG->detach_from<Volume>(m_aRegionPos);
+	m_bRecordAdaption = false;
+}
+
+void DoFDistribution::vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent, bool replacesParent)
+{
+	record(vrt);
+	if(pParent) record(pParent);
+}
+
+void DoFDistribution::edge_created(Grid* grid, Edge* e, GridObject* pParent, bool replacesParent)
+{
+	record(e);
+	if(pParent) record(pParent);
+}
+
+void DoFDistribution::face_created(Grid* grid, Face* f, GridObject* pParent, bool replacesParent)
+{
+	record(f);
+	if(pParent) record(pParent);
+}
+
+void DoFDistribution::volume_created(Grid* grid, Volume* vol, GridObject* pParent, bool replacesParent)
+{
+	record(vol);
+	if(pParent) record(pParent);
+}
+
+void DoFDistribution::vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy) {record_erased(vrt);}
+void DoFDistribution::edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy) {record_erased(e);}
+void DoFDistribution::face_to_be_erased(Grid* grid, Face* f, Face* replacedBy) {record_erased(f);}
+void DoFDistribution::volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy) {record_erased(vol);}
+
+template <typename TElem>
+void DoFDistribution::record(TElem* elem)
+{
+	size_t& pos = m_aaRegionPos[elem];
+	if(pos != (size_t)-1) return;
+
+	pos = m_vRegionObj.size();
+	m_vRegionObj.push_back(elem);
+}
+
+template <typename TElem>
+void DoFDistribution::record_sides(TElem* elem)
+{
+	static const int dim = TElem::dim;
+
+	if(dim > VERTEX && max_dofs(VERTEX)){
+		Grid::traits<Vertex>::secure_container vVrt;
+		m_pMG->associated_elements(vVrt, elem);
+		for(size_t i = 0; i < vVrt.size(); ++i) record(vVrt[i]);
+	}
+	if(dim > EDGE && max_dofs(EDGE)){
+		Grid::traits<Edge>::secure_container vEdge;
+		m_pMG->associated_elements(vEdge, elem);
+		for(size_t i = 0; i < vEdge.size(); ++i) record(vEdge[i]);
+	}
+	if(dim > FACE && max_dofs(FACE)){
+		Grid::traits<Face>::secure_container vFace;
+		m_pMG->associated_elements(vFace, elem);
+		for(size_t i = 0; i < vFace.size(); ++i) record(vFace[i]);
+	}
+}
+
+template <typename TElem>
+void DoFDistribution::record_erased(TElem* elem)
+{
+	const size_t pos = m_aaRegionPos[elem];
+	if(pos != (size_t)-1) m_vRegionObj[pos] = NULL;
+
+//	the subset of the object is already reset, thus the stored one is used
+	const size_t slot = owned_slot(elem);
+	if(slot != (size_t)-1) release_slot(slot);
+
+//	the parent may change its surface state
+	GridObject* pParent = m_pMG->get_parent(elem);
+	if(pParent) record(pParent);
+}
+
+size_t DoFDistribution::owned_slot(GridObject* obj)
+{
+	if(max_dofs(obj->base_object_id()) == 0) return (size_t)-1;
+
+	const size_t index = obj_index(obj);
+	if(index == (size_t)-1 || index % m_numIndexPerObj != 0) return (size_t)-1;
+
+	const size_t slot = index / m_numIndexPerObj;
+	if(slot >= m_vIndexOwner.size() || m_vIndexOwner[slot] != obj) return (size_t)-1;
+
+	return slot;
+}
+
+void DoFDistribution::release_slot(size_t slot)
+{
+	m_vNumIndexOnSubset[m_vIndexSubset[slot]] -= m_numIndexPerObj;
+	m_vIndexOwner[slot] = NULL;
+	m_vIndexSubset[slot] = -1;
+	m_vReleasedSlot.push_back(slot);
+}
+
+template <typename TBaseElem>
+bool DoFDistribution::requires_index(TBaseElem* elem) const
+{
+//	LEVEL: all elements of the level
+	if(grid_level().type() == GridLevel::LEVEL){
+		const int lvl = grid_level().top() ? (int)m_spMGSH->num_levels() - 1
+											: grid_level().level();
+		return m_pMG->get_level(elem) == lvl;
+	}
+
+//	SURFACE: same selection as in reinit<TBaseElem>()
+	const SurfaceView& sv = *m_spSurfView;
+	if(!sv.is_contained(elem, grid_level(), SurfaceView::ALL)) return false;
+
+	if(sv.is_contained(elem, grid_level(), SurfaceView::SHADOW_RIM_COPY)
+		&& m_pMG->num_children<TBaseElem>(elem) > 0){
+		TBaseElem* child = m_pMG->get_child<TBaseElem>(elem, 0);
+		if(sv.is_contained(child, grid_level(), SurfaceView::SURFACE_RIM))
+			return false;
+	}
+	return true;
+}
+
+template <typename TBaseElem>
+void DoFDistribution::reinit_region_obj(TBaseElem* elem)
+{
+	const int si = m_spMGSH->get_subset_index(elem);
+	const bool bRequired = (si >= 0) && (num_dofs(elem->reference_object_id(), si) > 0)
+							&& requires_index(elem);
+	const size_t slot = owned_slot(elem);
+
+	if(bRequired && slot == (size_t)-1){
+	//	new slots are appended, the holes are closed afterwards
+		obj_index(elem) = m_numIndex;
+		m_numIndex += m_numIndexPerObj;
+		m_vIndexOwner.push_back(elem);
+		m_vIndexSubset.push_back(si);
+		m_vNumIndexOnSubset[si] += m_numIndexPerObj;
+	}
+	else if(!bRequired && slot != (size_t)-1){
+		release_slot(slot);
+	}
+	else if(bRequired && m_vIndexSubset[slot] != si){
+		m_vNumIndexOnSubset[m_vIndexSubset[slot]] -= m_numIndexPerObj;
+		m_vNumIndexOnSubset[si] += m_numIndexPerObj;
+		m_vIndexSubset[slot] = si;
+	}
+}
+
+template <typename TBaseElem>
+void DoFDistribution::update_shadow_copies(TBaseElem* elem)
+{
+	if(owned_slot(elem) == (size_t)-1) return;
+
+	const SurfaceView& sv = *m_spSurfView;
+	const size_t index = obj_index(elem);
+	TBaseElem* p = dynamic_cast<TBaseElem*>(m_pMG->get_parent(elem));
+	while(p && sv.is_contained(p, grid_level(), SurfaceView::SHADOW_RIM_COPY)){
+		obj_index(p) = index;
+		p = dynamic_cast<TBaseElem*>(m_pMG->get_parent(p));
+	}
+}
+
+void DoFDistribution::reinit_region(size_t numOldIndex)
+{
+	PROFILE_BEGIN(DoFDistribution_ReinitRegion);
+
+//	the sides of changed objects may change their surface state
+	const size_t numRecorded = m_vRegionObj.size();
+	for(size_t i = 0; i < numRecorded; ++i){
+		GridObject* obj = m_vRegionObj[i];
+		if(obj == NULL) continue;
+		switch(obj->base_object_id()){
+			case EDGE:   record_sides(static_cast<Edge*>(obj)); break;
+			case FACE:   record_sides(static_cast<Face*>(obj)); break;
+			case VOLUME: record_sides(static_cast<Volume*>(obj)); break;
+			default: break;
+		}
+	}
+
+	for(size_t i = 0; i < m_vRegionObj.size(); ++i){
+		GridObject* obj = m_vRegionObj[i];
+		if(obj == NULL || max_dofs(obj->base_object_id()) == 0) continue;
+		switch(obj->base_object_id()){
+			case VERTEX: reinit_region_obj(static_cast<Vertex*>(obj)); break;
+			case EDGE:   reinit_region_obj(static_cast<Edge*>(obj)); break;
+			case FACE:   reinit_region_obj(static_cast<Face*>(obj)); break;
+			case VOLUME: reinit_region_obj(static_cast<Volume*>(obj)); break;
+			default: break;
+		}
+	}
+
+	compact_region(numOldIndex);
+
+//	copy the indices of new and moved objects to their shadow copies
+	if(grid_level().is_surface()){
+		for(size_t i = 0; i < m_vRegionObj.size(); ++i){
+			GridObject* obj = m_vRegionObj[i];
+			if(obj == NULL) continue;
+			switch(obj->base_object_id()){
+				case VERTEX: update_shadow_copies(static_cast<Vertex*>(obj)); break;
+				case EDGE:   update_shadow_copies(static_cast<Edge*>(obj)); break;
+				case FACE:   update_shadow_copies(static_cast<Face*>(obj)); break;
+				case VOLUME: update_shadow_copies(static_cast<Volume*>(obj)); break;
+				default: break;
+			}
+		}
+	}
+
+//	keep the objects owning an index
+	size_t numOwner = 0;
+	for(size_t i = 0; i < m_vRegionObj.size(); ++i){
+		GridObject* obj = m_vRegionObj[i];
+		if(obj != NULL && owned_slot(obj) != (size_t)-1)
+			m_vRegionObj[numOwner++] = obj;
+	}
+	m_vRegionObj.resize(numOwner);
+	PROFILE_END();
+}
+
+void DoFDistribution::compact_region(size_t numOldIndex)
+{
+	const size_t numOldSlot = numOldIndex / m_numIndexPerObj;
+	const size_t numSlot = m_vIndexOwner.size();
+
+//	mapping old -> new index, released indices are dropped
+	m_vReinitIndexMap.resize(numOldIndex);
+	for(size_t i = 0; i < numOldIndex; ++i) m_vReinitIndexMap[i] = i;
+	for(size_t i = 0; i < m_vReleasedSlot.size(); ++i){
+		const size_t slot = m_vReleasedSlot[i];
+		if(slot >= numOldSlot) continue;
+		for(size_t j = 0; j < m_numIndexPerObj; ++j)
+			m_vReinitIndexMap[slot * m_numIndexPerObj + j] = (size_t)-1;
+	}
+
+//	fill the holes by the slots with the highest indices
+	std::sort(m_vReleasedSlot.begin(), m_vReleasedSlot.end());
+	size_t tail = numSlot;
+	size_t numMoved = 0;
+	for(size_t i = 0; i < m_vReleasedSlot.size(); ++i){
+		const size_t hole = m_vReleasedSlot[i];
+		while(tail > 0 && m_vIndexOwner[tail-1] == NULL) --tail;
+		if(hole >= tail) break;
+
+		--tail;
+		GridObject* owner = m_vIndexOwner[tail];
+		m_vIndexOwner[hole] = owner;
+		m_vIndexSubset[hole] = m_vIndexSubset[tail];
+		m_vIndexOwner[tail] = NULL;
+		obj_index(owner) = hole * m_numIndexPerObj;
+
+	//	the shadow copies of the owner have to follow
+		record(owner);
+
+		if(tail < numOldSlot){
+			++numMoved;
+			for(size_t j = 0; j < m_numIndexPerObj; ++j)
+				m_vReinitIndexMap[tail * m_numIndexPerObj + j] = hole * m_numIndexPerObj + j;
+		}
+	}
+	while(tail > 0 && m_vIndexOwner[tail-1] == NULL) --tail;
+
+	m_vIndexOwner.resize(tail);
+	m_vIndexSubset.resize(tail);
+	m_numIndex = tail * m_numIndexPerObj;
+	m_vReleasedSlot.clear();
+
+//	appended and moved slots no longer follow the iteration order
+	m_numDisplacedIndex += (numSlot - std::min(numSlot, numOldSlot) + numMoved) * m_numIndexPerObj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Element index tables
+////////////////////////////////////////////////////////////////////////////////
+
+void DoFDistribution::enable_elem_index_tables(bool bEnable)
+{
+	if(bEnable == m_bElemIndexTables){
+		if(bEnable) update_elem_index_tables();
+		return;
+	}
+
+	if(bEnable){
+		m_pMG->attach_to_dv<Edge>(m_aElemIndexRow, (size_t)-1);
+		m_pMG->attach_to_dv<Face>(m_aElemIndexRow, (size_t)-1);
+		m_pMG->attach_to_dv<Volume>(m_aElemIndexRow, (size_t)-1);
+		m_aaElemIndexRow.access(*m_pMG, m_aElemIndexRow, false, true, true, true);
+		m_bElemIndexTables = true;
+		update_elem_index_tables();
+	}
+	else{
+		m_bElemIndexTables = false;
+		m_aaElemIndexRow.invalidate();
+		m_pMG->detach_from<Edge>(m_aElemIndexRow);
+		m_pMG->detach_from<Face>(m_aElemIndexRow);
+		m_pMG->detach_from<Volume>(m_aElemIndexRow);
+		for(int d = 0; d <= VOLUME; ++d)
+			m_vElemIndexTable[d].free_memory();
+	}
+}
+
+template <typename TBaseElem>
+void DoFDistribution::update_elem_index_table()
+{
+	static const int dim = TBaseElem::dim;
+	ElemIndexTable& table = m_vElemIndexTable[dim];
+
+//	NOTE: rows of elements no longer contained need not be reset, since a
+//		  lookup always checks that the row is still owned by the element
+	table.clear(num_fct());
+
+	LocalIndices ind;
+	for(int si = 0; si < num_subsets(); ++si)
+	{
+		if(dim_subset(si) != dim) continue;
+
+		typename traits<TBaseElem>::const_iterator iter = begin<TBaseElem>(si);
+		typename traits<TBaseElem>::const_iterator iterEnd = end<TBaseElem>(si);
+		for(; iter != iterEnd; ++iter)
+		{
+			TBaseElem* elem = *iter;
+			grid_indices<TBaseElem>(elem, ind, false);
+			m_aaElemIndexRow[elem] = table.add(elem, ind);
+		}
+	}
+}
+
+template <typename TBaseElem>
+bool DoFDistribution::check_elem_index_table() const
+{
+	static const int dim = TBaseElem::dim;
+	const ElemIndexTable& table = m_vElemIndexTable[dim];
+
+	bool bValid = true;
+	LocalIndices ind, gridInd;
+	for(int si = 0; si < num_subsets(); ++si)
+	{
+		if(dim_subset(si) != dim) continue;
+
+		typename traits<TBaseElem>::const_iterator iter = begin<TBaseElem>(si);
+		typename traits<TBaseElem>::const_iterator iterEnd = end<TBaseElem>(si);
+		for(; iter != iterEnd; ++iter)
+		{
+			TBaseElem* elem = *iter;
+			if(!table.contains(m_aaElemIndexRow[elem], elem)){
+				UG_LOG("DoFDistribution: Element of subset "<<si<<" missing in element index table.\n");
+				bValid = false;
+				continue;
+			}
+
+			_indices<TBaseElem>(elem, ind, false);
+			grid_indices<TBaseElem>(elem, gridInd, false);
+
+			bool bEqual = (ind.num_fct() == gridInd.num_fct());
+			for(size_t fct = 0; bEqual && fct < ind.num_fct(); ++fct){
+				bEqual = (ind.num_dof(fct) == gridInd.num_dof(fct));
+				for(size_t dof = 0; bEqual && dof < ind.num_dof(fct); ++dof)
+					bEqual = (ind.multi_index(fct, dof) == gridInd.multi_index(fct, dof));
+			}
+			if(!bEqual){
+				UG_LOG("DoFDistribution: Indices in element index table differ from"
+						" indices in grid for element of subset "<<si<<".\n");
+				bValid = false;
+			}
+		}
+	}
+	return bValid;
+}
+
+bool DoFDistribution::check_elem_index_tables() const
+{
+	if(!m_bElemIndexTables) return true;
+
+	bool bValid = check_elem_index_table<Edge>();
+	bValid = check_elem_index_table<Face>() && bValid;
+	bValid = check_elem_index_table<Volume>() && bValid;
+	return bValid;
+}
+
+void DoFDistribution::update_elem_index_tables()
+{
+	PROFILE_FUNC();
+	update_elem_index_table<Edge>();
+	update_elem_index_table<Face>();
+	update_elem_index_table<Volume>();
+}
+
 } // end namespace ug
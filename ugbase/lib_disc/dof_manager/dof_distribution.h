@@ -38,6 +38,8 @@
 #include "lib_disc/common/local_algebra.h"
 #include "dof_index_storage.h"
 #include "dof_count.h"
+#include "elem_index_table.h"
+#include "lib_grid/algorithms/attachment_util.h"
 
 #ifdef UG_PARALLEL
 #include "lib_algebra/parallelization/algebra_layouts.h"
@@ -47,7 +49,7 @@ namespace ug{
 
 class IGridFunction;
 
-class DoFDistribution : public DoFDistributionInfoProvider
+class DoFDistribution : public DoFDistributionInfoProvider, public GridObserver
 {
 	public:
 		///	constructor
@@ -354,6 +356,10 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		template <typename TBaseElem>
 		void _indices(TBaseElem* elem, LocalIndices& ind, bool bHang = false) const;
 
+		///	extracts the indices from the grid (i.e. not from an element index table)
+		template <typename TBaseElem>
+		void grid_indices(TBaseElem* elem, LocalIndices& ind, bool bHang = false) const;
+
 		template<typename TBaseElem>
 		size_t _dof_indices(TBaseElem* elem, size_t fct,
 		                     std::vector<DoFIndex>& ind,
@@ -485,6 +491,224 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// number of distributed indices on each subset
 		std::vector<size_t> m_vNumIndexOnSubset;
 
+	public:
+		///	enables flat element index tables
+		/**
+		 * If enabled, the (non-hanging) indices of all elements of full
+		 * dimension are stored in flat per-dimension tables, which are
+		 * rebuilt on every reinit and permutation of the indices. Calls to
+		 * indices() with bHang = false are then served by copying from those
+		 * tables instead of collecting the subelements from the grid.
+		 */
+		void enable_elem_index_tables(bool bEnable);
+
+		///	returns if flat element index tables are used
+		bool elem_index_tables_enabled() const {return m_bElemIndexTables;}
+
+		///	checks that the tables contain all elements with the indices in the grid
+		/**
+		 * Intended for debugging: Compares the indices of all elements of full
+		 * dimension with the indices extracted from the grid. Differences are
+		 * logged.
+		 *
+		 * \returns	true if the tables are valid or not enabled
+		 */
+		bool check_elem_index_tables() const;
+
+	protected:
+		///	rebuilds the element index tables
+		void update_elem_index_tables();
+
+		///	adds all elements of a base type to its element index table
+		template <typename TBaseElem>
+		void update_elem_index_table();
+
+		///	checks the element index table of a base type
+		template <typename TBaseElem>
+		bool check_elem_index_table() const;
+
+		///	flag if element index tables are used
+		bool m_bElemIndexTables;
+
+		///	element index tables per base object dimension
+		ElemIndexTable m_vElemIndexTable[VOLUME+1];
+
+		///	row of an element in its element index table
+		typedef Attachment<size_t> AElemIndexRow;
+		AElemIndexRow m_aElemIndexRow;
+		MultiElementAttachmentAccessor<AElemIndexRow> m_aaElemIndexRow;
+
+	public:
+		///	enables the incremental reinitialization of the indices
+		/**
+		 * If enabled, reinit() (e.g. after grid adaption) keeps the index of
+		 * every object which already had an index before and still requires
+		 * one. Objects without a valid index are appended at the end of the
+		 * index set and the holes left by removed objects are closed by
+		 * moving the objects with the highest indices into them. Thus, only
+		 * a few indices change and the mapping of old to new indices is
+		 * available through reinit_index_map().
+		 *
+		 * Since appended and moved indices do not follow the iteration order,
+		 * the ordering quality degrades with every reinit. If the fraction of
+		 * such displaced indices exceeds the defragmentation threshold, all
+		 * indices are renumbered (as done without incremental mode).
+		 *
+		 * The incremental mode requires the same number of indices on all
+		 * geometric objects carrying DoFs (e.g. grouped DoFs).
+		 *
+		 * On a single process and without periodic boundaries, the objects
+		 * changed by a grid adaption are recorded (see adaption_begins) and
+		 * the reinit after the adaption only visits these objects. In this
+		 * case, the values of the managed grid functions are moved to the new
+		 * indices and resized by the reinit, and the objects having indices
+		 * among the visited ones are available through reinit_region().
+		 */
+		void enable_incremental_reinit(bool bEnable);
+
+		///	returns if indices are reinitialized incrementally
+		bool incremental_reinit_enabled() const {return m_bIncrementalReinit;}
+
+		///	sets the fraction of displaced indices triggering a renumbering
+		void set_defragmentation_threshold(number threshold);
+
+		///	returns the fraction of displaced indices triggering a renumbering
+		number defragmentation_threshold() const {return m_defragThreshold;}
+
+		///	returns the mapping of old to new indices of the last reinit
+		/**
+		 * Entry i contains the new index of the old index i or size_t(-1) if
+		 * the index was removed. Indices not contained in the image are new.
+		 * The returned vector is empty if the last reinit renumbered all
+		 * indices or if the indices were permuted afterwards.
+		 */
+		const std::vector<size_t>& reinit_index_map() const {return m_vReinitIndexMap;}
+
+		///	starts to record the objects changed by a grid adaption
+		/**
+		 * In incremental mode, the created and erased objects, their parents
+		 * and the sides of those are recorded until the next reinit(). The
+		 * indices of the erased objects are released immediately. Nothing is
+		 * recorded in parallel or with periodic boundaries.
+		 */
+		void adaption_begins();
+
+		///	returns if the last reinit only visited the adapted region
+		bool region_reinit() const {return m_bRegionReinit;}
+
+		///	returns the objects owning indices among those visited by the last reinit
+		/**
+		 * The returned objects are only valid until the grid is changed again.
+		 * The vector is empty if region_reinit() is false.
+		 */
+		const std::vector<GridObject*>& reinit_region() const {return m_vRegionObj;}
+
+	protected:
+		///	tries to keep the index of an object in an incremental reinit
+		bool reuse_index(GridObject* obj, int si);
+
+		///	closes the holes in the index set after an incremental reinit
+		void compact_indices(size_t numOldIndex);
+
+		///	registers the current owners of all index slots
+		template <typename TBaseElem>
+		void init_index_owners();
+
+		///	reinitializes the indices of the recorded objects only
+		void reinit_region(size_t numOldIndex);
+
+		///	keeps, assigns or releases the index of a recorded object
+		template <typename TBaseElem>
+		void reinit_region_obj(TBaseElem* elem);
+
+		///	closes the holes in the index set after a region reinit
+		void compact_region(size_t numOldIndex);
+
+		///	copies the index of a recorded object to its shadow copies
+		template <typename TBaseElem>
+		void update_shadow_copies(TBaseElem* elem);
+
+		///	returns if an object requires its own index
+		template <typename TBaseElem>
+		bool requires_index(TBaseElem* elem) const;
+
+		///	returns the slot owned by an object or size_t(-1)
+		size_t owned_slot(GridObject* obj);
+
+		///	releases the slot of an object
+		void release_slot(size_t slot);
+
+		///	records an object for the region reinit
+		template <typename TElem>
+		void record(TElem* elem);
+
+		///	records the sides of an object
+		template <typename TElem>
+		void record_sides(TElem* elem);
+
+		///	records the parent of an erased object and releases its index
+		template <typename TElem>
+		void record_erased(TElem* elem);
+
+		///	stops recording the adaption
+		void stop_recording();
+
+	public:
+		///	grid observer callbacks (only registered while recording)
+		/// \{
+		virtual void vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent = NULL, bool replacesParent = false);
+		virtual void edge_created(Grid* grid, Edge* e, GridObject* pParent = NULL, bool replacesParent = false);
+		virtual void face_created(Grid* grid, Face* f, GridObject* pParent = NULL, bool replacesParent = false);
+		virtual void volume_created(Grid* grid, Volume* vol, GridObject* pParent = NULL, bool replacesParent = false);
+		virtual void vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy = NULL);
+		virtual void edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy = NULL);
+		virtual void face_to_be_erased(Grid* grid, Face* f, Face* replacedBy = NULL);
+		virtual void volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy = NULL);
+		/// \}
+
+	protected:
+
+		///	flag if indices are reinitialized incrementally
+		bool m_bIncrementalReinit;
+
+		///	fraction of displaced indices triggering a renumbering
+		number m_defragThreshold;
+
+		///	number of indices per object (incremental mode only)
+		size_t m_numIndexPerObj;
+
+		///	object owning each slot of m_numIndexPerObj indices
+		std::vector<GridObject*> m_vIndexOwner;
+
+		///	subset of the owner of each slot
+		std::vector<int> m_vIndexSubset;
+
+		///	slot owners before the current reinit
+		std::vector<GridObject*> m_vOldIndexOwner;
+
+		///	number of indices not placed in iteration order
+		size_t m_numDisplacedIndex;
+
+		///	mapping of old to new indices of the last reinit
+		std::vector<size_t> m_vReinitIndexMap;
+
+		///	flag if the objects changed by an adaption are recorded
+		bool m_bRecordAdaption;
+
+		///	recorded objects (NULL if erased after recording)
+		std::vector<GridObject*> m_vRegionObj;
+
+		///	slots released since the last reinit
+		std::vector<size_t> m_vReleasedSlot;
+
+		///	position of an object in m_vRegionObj
+		typedef Attachment<size_t> ARegionPos;
+		ARegionPos m_aRegionPos;
+		MultiElementAttachmentAccessor<ARegionPos> m_aaRegionPos;
+
+		///	flag if the last reinit only visited the adapted region
+		bool m_bRegionReinit;
+
 	public:
 		/// returns the connections
 		void get_connections(std::vector<std::vector<size_t> >& vvConnection) const;
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__DOF_MANAGER__ELEM_INDEX_TABLE__
+#define __H__UG__LIB_DISC__DOF_MANAGER__ELEM_INDEX_TABLE__
+
+#include <vector>
+#include "lib_grid/grid/grid_base_objects.h"
+#include "lib_disc/common/local_algebra.h"
+
+namespace ug{
+
+///	flat element to DoF index table
+/**
+ * Stores the (sorted, non-hanging) DoF indices of a set of elements in one
+ * contiguous array, row by row. The indices of row r and function fct are
+ * found in the range [offset(r,fct), offset(r,fct+1)). Copying the indices
+ * of an element from such a table into a LocalIndices structure avoids the
+ * collection of the subelements and the lookup in the index attachments
+ * that is needed when the indices are extracted from the grid.
+ *
+ * The table only holds a snapshot. It must be rebuilt whenever the indices
+ * of the underlying DoFDistribution change.
+ */
+class ElemIndexTable
+{
+	public:
+	///	Default constructor
+		ElemIndexTable() : m_numFct(0) {clear(0);}
+
+	///	removes all rows and sets the number of functions
+		void clear(size_t numFct)
+		{
+			m_numFct = numFct;
+			m_vElem.clear();
+			m_vIndex.clear();
+			m_vOffset.clear();
+			m_vOffset.push_back(0);
+		}
+
+	///	appends the indices of an element, returns the row
+		size_t add(GridObject* elem, const LocalIndices& ind)
+		{
+			UG_ASSERT(ind.num_fct() == m_numFct, "Number of functions mismatch.");
+
+			for(size_t fct = 0; fct < m_numFct; ++fct){
+				for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+					m_vIndex.push_back(ind.multi_index(fct, dof));
+				m_vOffset.push_back(m_vIndex.size());
+			}
+
+			m_vElem.push_back(elem);
+			return m_vElem.size() - 1;
+		}
+
+	///	number of rows
+		size_t num_elem() const {return m_vElem.size();}
+
+	///	element stored in a row
+		GridObject* elem(size_t row) const {return m_vElem[row];}
+
+	///	number of functions
+		size_t num_fct() const {return m_numFct;}
+
+	///	returns if the row exists and belongs to the element
+		bool contains(size_t row, const GridObject* elem) const
+		{
+			return row < m_vElem.size() && m_vElem[row] == elem;
+		}
+
+	///	copies the indices of a row into a LocalIndices structure
+		void local_indices(size_t row, LocalIndices& ind) const
+		{
+			UG_ASSERT(row < num_elem(), "Row "<<row<<" not in table.");
+
+			ind.resize_fct(m_numFct);
+			const size_t* pOffset = &m_vOffset[row * m_numFct];
+			for(size_t fct = 0; fct < m_numFct; ++fct){
+				const size_t first = pOffset[fct];
+				const size_t numDoF = pOffset[fct+1] - first;
+				ind.resize_dof(fct, numDoF);
+				for(size_t dof = 0; dof < numDoF; ++dof){
+					const DoFIndex& dofIndex = m_vIndex[first + dof];
+					ind.index(fct, dof) = dofIndex[0];
+					ind.comp(fct, dof) = dofIndex[1];
+				}
+			}
+		}
+
+	///	releases the memory
+		void free_memory()
+		{
+			std::vector<GridObject*>().swap(m_vElem);
+			std::vector<size_t>().swap(m_vOffset);
+			std::vector<DoFIndex>().swap(m_vIndex);
+			clear(m_numFct);
+		}
+
+	protected:
+	///	number of functions
+		size_t m_numFct;
+
+	///	element of each row
+		std::vector<GridObject*> m_vElem;
+
+	///	offsets into the index array (numElem * numFct + 1 entries)
+		std::vector<size_t> m_vOffset;
+
+	///	indices of all rows
+		std::vector<DoFIndex> m_vIndex;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__DOF_MANAGER__ELEM_INDEX_TABLE__ */
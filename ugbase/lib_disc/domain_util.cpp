@@ -36,10 +36,15 @@
 #include "common/util/file_util.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/file_io/file_io_ugx.h"
+#include "lib_grid/file_io/file_io_ugb.h"
 #include "lib_grid/algorithms/geom_obj_util/misc_util.h"
 #include "lib_grid/refinement/projectors/projection_handler.h"
 #include "common/profiler/profiler.h"
 
+#ifdef UG_PARALLEL
+	#include "lib_grid/parallelization/partitioned_grid_io.h"
+#endif
+
 using namespace std;
 
 namespace ug{
@@ -94,11 +99,71 @@ void SaveDomain(TDomain& domain, const char* filename)
 			UG_THROW("Couldn't save domain to the specified file: " << filename);
 		}
 	}
+	else if(GetFilenameExtension(string(filename)) == string("ugb")){
+		vector<ISubsetHandler*> shs(1, domain.subset_handler().get());
+		vector<const char*> shNames(1, "defSH");
+
+		vector<string> additionalSHNames = domain.additional_subset_handler_names();
+		for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name){
+			shs.push_back(domain.additional_subset_handler(additionalSHNames[i_name]).get());
+			shNames.push_back(additionalSHNames[i_name].c_str());
+		}
+
+		if(!SaveGridToUGB(*domain.grid(), filename, &shs.front(), &shNames.front(),
+						  (int)shs.size(), NULL, 0, domain.position_attachment()))
+		{
+			UG_THROW("Couldn't save domain to the specified file: " << filename);
+		}
+	}
 	else if(!SaveGridToFile(*domain.grid(), *domain.subset_handler(),
 						  filename, domain.position_attachment()))
 		UG_THROW("SaveDomain: Could not save to file: "<<filename);
 }
 
+#ifdef UG_PARALLEL
+///	adds serializers for the positions and all subset handlers of the domain
+template <typename TDomain>
+static void AddDomainSerializers(GridDataSerializationHandler& serializer,
+								 TDomain& domain)
+{
+	serializer.add(
+		GeomObjAttachmentSerializer<Vertex, typename TDomain::position_attachment_type>::
+						create(*domain.grid(), domain.position_attachment()));
+
+	serializer.add(SubsetHandlerSerializer::create(*domain.subset_handler()));
+
+	vector<string> additionalSHNames = domain.additional_subset_handler_names();
+	for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name){
+		SmartPtr<ISubsetHandler> sh =
+				domain.additional_subset_handler(additionalSHNames[i_name]);
+		if(sh.valid())
+			serializer.add(SubsetHandlerSerializer::create(*sh));
+	}
+}
+
+template <typename TDomain>
+void SavePartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	GridDataSerializationHandler serializer;
+	AddDomainSerializers(serializer, domain);
+
+	if(!SavePartitionedGrid(*domain.grid(), filename, serializer))
+		UG_THROW("SavePartitionedDomain: Could not save to file: "<<filename);
+}
+
+template <typename TDomain>
+void LoadPartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	GridDataSerializationHandler serializer;
+	AddDomainSerializers(serializer, domain);
+
+	if(!LoadPartitionedGrid(*domain.grid(), filename, serializer))
+		UG_THROW("LoadPartitionedDomain: Could not load file: "<<filename);
+}
+#endif
+
 
 template <typename TDomain>
 number MaxElementDiameter(TDomain& domain, int level)
@@ -130,6 +195,16 @@ template void SaveDomain<Domain1d>(Domain1d& domain, const char* filename);
 template void SaveDomain<Domain2d>(Domain2d& domain, const char* filename);
 template void SaveDomain<Domain3d>(Domain3d& domain, const char* filename);
 
+#ifdef UG_PARALLEL
+template void SavePartitionedDomain<Domain1d>(Domain1d& domain, const char* filename);
+template void SavePartitionedDomain<Domain2d>(Domain2d& domain, const char* filename);
+template void SavePartitionedDomain<Domain3d>(Domain3d& domain, const char* filename);
+
+template void LoadPartitionedDomain<Domain1d>(Domain1d& domain, const char* filename);
+template void LoadPartitionedDomain<Domain2d>(Domain2d& domain, const char* filename);
+template void LoadPartitionedDomain<Domain3d>(Domain3d& domain, const char* filename);
+#endif
+
 template number MaxElementDiameter<Domain1d>(Domain1d& domain, int level);
 template number MaxElementDiameter<Domain2d>(Domain2d& domain, int level);
 template number MaxElementDiameter<Domain3d>(Domain3d& domain, int level);
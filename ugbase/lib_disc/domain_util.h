@@ -58,6 +58,26 @@ void LoadDomain(TDomain& domain, const char* filename, int procId);
 template <typename TDomain>
 void SaveDomain(TDomain& domain, const char* filename);
 
+#ifdef UG_PARALLEL
+///	Saves the local part of a distributed domain to a combined parallel file.
+/**	Besides the grid and its interfaces, the position attachment, the subset
+ * handler and all additional subset handlers are written.
+ * Has to be called on all processes.
+ * \sa SavePartitionedGrid
+ */
+template <typename TDomain>
+void SavePartitionedDomain(TDomain& domain, const char* filename);
+
+///	Loads a distributed domain from a file written by SavePartitionedDomain.
+/**	Each process only reads its own partition. The domain has to provide the
+ * same additional subset handlers as the one that was saved, and the file has
+ * to be read with the same number of processes that was used to write it.
+ * \sa LoadPartitionedGrid
+ */
+template <typename TDomain>
+void LoadPartitionedDomain(TDomain& domain, const char* filename);
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////
 ///	returns the corner coordinates of a geometric object
@@ -56,6 +56,11 @@ class AdaptionSurfaceGridFunction : public GridObserver
 		template <typename TAlgebra>
 		void copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct);
 
+	///	copies the values of the passed objects only (see DoFDistribution::reinit_region)
+		template <typename TAlgebra>
+		void copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct,
+		                     const std::vector<GridObject*>& vObj);
+
 		AValues value_attachment()	{return m_aValue;}
 
 	protected:
@@ -110,15 +115,18 @@ class AdaptionSurfaceGridFunction : public GridObserver
 
 	public:
 		///	creates storage when object created
+		/**	If the new object replaces pParent (e.g. on Grid::relocate), the
+		 * values of pParent are taken over.*/
 		template <typename TBaseElem>
-		inline void obj_created(TBaseElem* elem);
+		inline void obj_created(TBaseElem* elem, GridObject* pParent = NULL,
+		                        bool replacesParent = false);
 
 		/// grid observer callbacks
 		/// \{
-		virtual void vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent = NULL, bool replacesParent = false){obj_created(vrt);}
-		virtual void edge_created(Grid* grid, Edge* e, GridObject* pParent = NULL, bool replacesParent = false){obj_created(e);}
-		virtual void face_created(Grid* grid, Face* f, GridObject* pParent = NULL, bool replacesParent = false){obj_created(f);}
-		virtual void volume_created(Grid* grid, Volume* vol, GridObject* pParent = NULL, bool replacesParent = false){obj_created(vol);}
+		virtual void vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent = NULL, bool replacesParent = false){obj_created(vrt, pParent, replacesParent);}
+		virtual void edge_created(Grid* grid, Edge* e, GridObject* pParent = NULL, bool replacesParent = false){obj_created(e, pParent, replacesParent);}
+		virtual void face_created(Grid* grid, Face* f, GridObject* pParent = NULL, bool replacesParent = false){obj_created(f, pParent, replacesParent);}
+		virtual void volume_created(Grid* grid, Volume* vol, GridObject* pParent = NULL, bool replacesParent = false){obj_created(vol, pParent, replacesParent);}
 		/// \}
 
 	protected:
@@ -175,14 +175,45 @@ copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct)
 	detach_entries();
 }
 
+template <typename TDomain>
+template <typename TAlgebra>
+void AdaptionSurfaceGridFunction<TDomain>::
+copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct,
+                const std::vector<GridObject*>& vObj)
+{
+	GFUNCADAPT_PROFILE_FUNC();
+	for(size_t i = 0; i < vObj.size(); ++i)
+	{
+		GridObject* obj = vObj[i];
+		switch(obj->base_object_id()){
+			case VERTEX: copy_to_surface<Vertex,TAlgebra>(rSurfaceFct, static_cast<Vertex*>(obj)); break;
+			case EDGE:   copy_to_surface<Edge,TAlgebra>(rSurfaceFct, static_cast<Edge*>(obj)); break;
+			case FACE:   copy_to_surface<Face,TAlgebra>(rSurfaceFct, static_cast<Face*>(obj)); break;
+			case VOLUME: copy_to_surface<Volume,TAlgebra>(rSurfaceFct, static_cast<Volume*>(obj)); break;
+			default: UG_THROW("AdaptionSurfaceGridFunction: Unknown base object type.");
+		}
+	}
+
+	#ifdef UG_PARALLEL
+	rSurfaceFct.set_storage_type(m_ParallelStorageType);
+	#endif
+
+	detach_entries();
+}
+
 
 template <typename TDomain>
 template <typename TBaseElem>
-inline void AdaptionSurfaceGridFunction<TDomain>::obj_created(TBaseElem* elem){
+inline void AdaptionSurfaceGridFunction<TDomain>::
+obj_created(TBaseElem* elem, GridObject* pParent, bool replacesParent){
 
 //	 get value attachment
 	std::vector<std::vector<number> >& vvVal = m_aaValue[elem];
 
+//	a replacing object represents the same geometric object
+	if(replacesParent && pParent)
+		vvVal = m_aaValue[static_cast<TBaseElem*>(pParent)];
+
 //	resize to number of functions
 	vvVal.resize(m_spDDInfo->num_fct());
 
@@ -83,6 +83,9 @@ init(SmartPtr<subset_handler_type> spMGSH,
 	m_spDoFDistributionInfo = SmartPtr<DoFDistributionInfo>(new DoFDistributionInfo(spMGSH));
 	m_algebraType = algebraType;
 	m_bAdaptionIsActive = false;
+	m_bElemIndexTables = false;
+	m_bIncrementalReinit = false;
+	m_defragThreshold = 0.25;
 	m_RevCnt = RevisionCounter(this);
 
 	this->set_dof_distribution_info(m_spDoFDistributionInfo);
@@ -343,11 +346,47 @@ void IApproximationSpace::create_dof_distribution(const GridLevel& gl)
 		DoFDistribution(m_spMG, m_spMGSH, m_spDoFDistributionInfo,
 						m_spSurfaceView, gl, m_bGrouped, spIndexStrg));
 
+	if(m_bElemIndexTables)
+		spDD->enable_elem_index_tables(true);
+
+	spDD->set_defragmentation_threshold(m_defragThreshold);
+	if(m_bIncrementalReinit)
+		spDD->enable_incremental_reinit(true);
+
 //	add to list and sort
 	m_vDD.push_back(spDD);
 	std::sort(m_vDD.begin(), m_vDD.end(), SortDD);
 }
 
+void IApproximationSpace::enable_elem_index_tables(bool bEnable)
+{
+	m_bElemIndexTables = bEnable;
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		m_vDD[i]->enable_elem_index_tables(bEnable);
+}
+
+bool IApproximationSpace::check_elem_index_tables() const
+{
+	bool bValid = true;
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		bValid = m_vDD[i]->check_elem_index_tables() && bValid;
+	return bValid;
+}
+
+void IApproximationSpace::enable_incremental_reinit(bool bEnable)
+{
+	m_bIncrementalReinit = bEnable;
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		m_vDD[i]->enable_incremental_reinit(bEnable);
+}
+
+void IApproximationSpace::set_defragmentation_threshold(number threshold)
+{
+	m_defragThreshold = threshold;
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		m_vDD[i]->set_defragmentation_threshold(threshold);
+}
+
 void IApproximationSpace::surface_view_required()
 {
 //	allocate surface view if needed
@@ -434,9 +473,14 @@ void IApproximationSpace::register_at_adaption_msg_hub()
 void IApproximationSpace::
 grid_changed_callback(const GridMessage_Adaption& msg)
 {
-	if(msg.adaption_begins())
+	if(msg.adaption_begins()){
 		m_bAdaptionIsActive = true;
 
+	//	record the changed objects for an incremental reinit
+		for(size_t i = 0; i < m_vDD.size(); ++i)
+			m_vDD[i]->adaption_begins();
+	}
+
 	else if(m_bAdaptionIsActive){
 			if(msg.adaption_ends())
 			{
@@ -210,6 +210,26 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	returns the current revision
 		const RevisionCounter& revision() const {return m_RevCnt;}
 
+	///	enables flat element index tables in all dof distributions
+		void enable_elem_index_tables(bool bEnable);
+
+	///	returns if flat element index tables are used
+		bool elem_index_tables_enabled() const {return m_bElemIndexTables;}
+
+	///	checks the element index tables of all dof distributions
+	///	(see DoFDistribution::check_elem_index_tables)
+		bool check_elem_index_tables() const;
+
+	///	enables the incremental reinit of the indices in all dof distributions
+	/// (see DoFDistribution::enable_incremental_reinit)
+		void enable_incremental_reinit(bool bEnable);
+
+	///	returns if the indices are reinitialized incrementally
+		bool incremental_reinit_enabled() const {return m_bIncrementalReinit;}
+
+	///	sets the fraction of displaced indices triggering a renumbering
+		void set_defragmentation_threshold(number threshold);
+
 	protected:
 	///	creates a dof distribution
 		void create_dof_distribution(const GridLevel& gl);
@@ -256,6 +276,15 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	flag if DoFs should be grouped
 		bool m_bGrouped;
 
+	///	flag if dof distributions use element index tables
+		bool m_bElemIndexTables;
+
+	///	flag if dof distributions reinitialize their indices incrementally
+		bool m_bIncrementalReinit;
+
+	///	fraction of displaced indices triggering a renumbering
+		number m_defragThreshold;
+
 	///	DofDistributionInfo
 		SmartPtr<DoFDistributionInfo> m_spDoFDistributionInfo;
 
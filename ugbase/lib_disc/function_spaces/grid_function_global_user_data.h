@@ -44,7 +44,7 @@
 #include "lib_disc/local_finite_element/local_finite_element_provider.h"
 #include "lib_disc/spatial_disc/user_data/std_glob_pos_data.h"
 #include "lib_disc/reference_element/reference_mapping_provider.h"
-#include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+#include "lib_disc/function_spaces/grid_function_point_locator.h"
 
 #include <math.h>       /* fabs */
 
@@ -71,63 +71,36 @@ class GlobalGridFunctionNumberData
 	///	local finite element id
 		LFEID m_lfeID;
 
-		typedef lg_ntree<dim, dim, element_t>	tree_t;
-		tree_t	m_tree;
+		typedef GridFunctionPointLocator<TGridFunction, elemDim>	locator_t;
+		SmartPtr<locator_t>	m_spLocator;
 
 	public:
 	/// constructor
+	/**	Creates an own locator indexing the subsets in which the function is
+	 * defined. Its trees are built on the first evaluation.*/
 		GlobalGridFunctionNumberData(SmartPtr<TGridFunction> spGridFct, const char* cmp)
-		: m_spGridFct(spGridFct),
-		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment())
+		: m_spGridFct(spGridFct)
 		{
-			//this->set_functions(cmp);
-
-			//	get function id of name
-			m_fct = spGridFct->fct_id_by_name(cmp);
-
-			//	check that function exists
-			if(m_fct >= spGridFct->num_fct())
-				UG_THROW("GridFunctionNumberData: Function space does not contain"
-						" a function with name " << cmp << ".");
-
-			//	local finite element id
-			m_lfeID = spGridFct->local_finite_element_id(m_fct);
-
-
-
-//			const MGSubsetHandler& ssh = *m_spGridFct->domain()->subset_handler();
+			init(cmp);
 
 			SubsetGroup ssGrp(m_spGridFct->domain()->subset_handler());
-			ssGrp.add_all();
-
-			std::vector<size_t> subsetsOfGridFunction;
-			std::vector<element_t*> elemsWithGridFunctions;
-
-			typename TGridFunction::template dim_traits<elemDim>::const_iterator iterEnd, iter;
-
-
-			for(size_t si = 0; si < ssGrp.size(); si++){
+			for(int si = 0; si < ssGrp.subset_handler()->num_subsets(); si++){
 				if( spGridFct->is_def_in_subset(m_fct, si) )
-					subsetsOfGridFunction.push_back(si);
-			}
-
-
-			for(size_t i = 0; i<subsetsOfGridFunction.size(); i++){
-				size_t si = subsetsOfGridFunction[i];
-				iter = spGridFct->template begin<element_t>(si);
-				iterEnd = spGridFct->template end<element_t>(si);
-
-				for(;iter!=iterEnd; ++iter){
-					element_t *elem = *iter;
-					elemsWithGridFunctions.push_back(elem);
-				}
+					ssGrp.add(si);
 			}
+			m_spLocator = make_sp(new locator_t(spGridFct, ssGrp));
+		};
 
-//			m_tree.create_tree(spGridFct->template begin<element_t>(si),
-//														spGridFct->template end<element_t>(si));
-
-			m_tree.create_tree(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
-
+	/// constructor sharing a point locator
+	/**	Several data objects (e.g. for several components or time steps) may
+	 * share a single locator, so that its trees are built only once.*/
+		GlobalGridFunctionNumberData(SmartPtr<TGridFunction> spGridFct, const char* cmp,
+									 SmartPtr<locator_t> spLocator)
+		: m_spGridFct(spGridFct), m_spLocator(spLocator)
+		{
+			UG_COND_THROW(spLocator.invalid(), "GlobalGridFunctionNumberData: "
+						  "Invalid locator passed.");
+			init(cmp);
 		};
 
 		virtual ~GlobalGridFunctionNumberData() {}
@@ -155,51 +128,7 @@ class GlobalGridFunctionNumberData
 		///	evaluates the data at a given point, returns false if point not found
 		inline bool evaluate(number& value, const MathVector<dim>& x) const
 		{
-			element_t* elem = NULL;
-			//try{
-
-				if(!FindContainingElement(elem, m_tree, x)){
-					return false;
-				}
-
-			//	get corners of element
-				std::vector<MathVector<dim> > vCornerCoords;
-				CollectCornerCoordinates(vCornerCoords, *elem, *m_spGridFct->domain());
-
-			//	reference object id
-				const ReferenceObjectID roid = elem->reference_object_id();
-
-			//	get local position of DoF
-				DimReferenceMapping<elemDim, dim>& map
-					= ReferenceMappingProvider::get<elemDim, dim>(roid, vCornerCoords);
-				MathVector<elemDim> locPos;
-				VecSet(locPos, 0.5);
-				map.global_to_local(locPos, x);
-
-			//	evaluate at shapes at ip
-				const LocalShapeFunctionSet<elemDim>& rTrialSpace =
-						LocalFiniteElementProvider::get<elemDim>(roid, m_lfeID);
-				std::vector<number> vShape;
-				rTrialSpace.shapes(vShape, locPos);
-
-			//	get multiindices of element
-				std::vector<DoFIndex> ind;
-				m_spGridFct->dof_indices(elem, m_fct, ind);
-
-			// 	compute solution at integration point
-				value = 0.0;
-				for(size_t sh = 0; sh < vShape.size(); ++sh)
-				{
-					const number valSH = DoFRef(*m_spGridFct, ind[sh]);
-					value += valSH * vShape[sh];
-				}
-
-			//	point is found
-				return true;
-			//}
-			//UG_CATCH_THROW("GlobalGridFunctionNumberData: Evaluation failed."
-			//			   << "Point: " << x << ", Element: "
-			//			   << ElementDebugInfo(*m_spGridFct->domain()->grid(), elem));
+			return m_spLocator->evaluate(value, x, *m_spGridFct, m_fct);
 		}
 		/// evaluate value on all procs, throws when no containing element is found
 		inline void evaluate_global(number& value, const MathVector<dim>& x) const
@@ -268,6 +197,21 @@ class GlobalGridFunctionNumberData
 
 			return value;
 		}
+
+	protected:
+		void init(const char* cmp)
+		{
+			//	get function id of name
+			m_fct = m_spGridFct->fct_id_by_name(cmp);
+
+			//	check that function exists
+			if(m_fct >= m_spGridFct->num_fct())
+				UG_THROW("GridFunctionNumberData: Function space does not contain"
+						" a function with name " << cmp << ".");
+
+			//	local finite element id
+			m_lfeID = m_spGridFct->local_finite_element_id(m_fct);
+		}
 };
 
 
@@ -291,63 +235,32 @@ class GlobalGridFunctionGradientData
 	///	local finite element id
 		LFEID m_lfeID;
 
-		typedef lg_ntree<dim, dim, element_t>	tree_t;
-		tree_t	m_tree;
+		typedef GridFunctionPointLocator<TGridFunction>	locator_t;
+		SmartPtr<locator_t>	m_spLocator;
 
 	public:
 	/// constructor
 		GlobalGridFunctionGradientData(SmartPtr<TGridFunction> spGridFct, const char* cmp)
-		: m_spGridFct(spGridFct),
-		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment())
+		: m_spGridFct(spGridFct)
 		{
-			//this->set_functions(cmp);
-
-			//	get function id of name
-			m_fct = spGridFct->fct_id_by_name(cmp);
-
-			//	check that function exists
-			if(m_fct >= spGridFct->num_fct())
-				UG_THROW("GridFunctionNumberData: Function space does not contain"
-						" a function with name " << cmp << ".");
-
-			//	local finite element id
-			m_lfeID = spGridFct->local_finite_element_id(m_fct);
-
-
-
-//			const MGSubsetHandler& ssh = *m_spGridFct->domain()->subset_handler();
+			init(cmp);
 
 			SubsetGroup ssGrp(m_spGridFct->domain()->subset_handler());
-			ssGrp.add_all();
-
-			std::vector<size_t> subsetsOfGridFunction;
-			std::vector<element_t*> elemsWithGridFunctions;
-
-			typename TGridFunction::const_element_iterator iterEnd, iter;
-
-
-			for(size_t si = 0; si < ssGrp.size(); si++){
+			for(int si = 0; si < ssGrp.subset_handler()->num_subsets(); si++){
 				if( spGridFct->is_def_in_subset(m_fct, si) )
-					subsetsOfGridFunction.push_back(si);
-			}
-
-
-			for(size_t i = 0; i<subsetsOfGridFunction.size(); i++){
-				size_t si = subsetsOfGridFunction[i];
-				iter = spGridFct->template begin<element_t>(si);
-				iterEnd = spGridFct->template end<element_t>(si);
-
-				for(;iter!=iterEnd; ++iter){
-					element_t *elem = *iter;
-					elemsWithGridFunctions.push_back(elem);
-				}
+					ssGrp.add(si);
 			}
+			m_spLocator = make_sp(new locator_t(spGridFct, ssGrp));
+		};
 
-//			m_tree.create_tree(spGridFct->template begin<element_t>(si),
-//														spGridFct->template end<element_t>(si));
-
-			m_tree.create_tree(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
-
+	/// constructor sharing a point locator
+		GlobalGridFunctionGradientData(SmartPtr<TGridFunction> spGridFct, const char* cmp,
+									   SmartPtr<locator_t> spLocator)
+		: m_spGridFct(spGridFct), m_spLocator(spLocator)
+		{
+			UG_COND_THROW(spLocator.invalid(), "GlobalGridFunctionGradientData: "
+						  "Invalid locator passed.");
+			init(cmp);
 		};
 
 		virtual ~GlobalGridFunctionGradientData() {}
@@ -372,7 +285,9 @@ class GlobalGridFunctionGradientData
 			element_t* elem = NULL;
 			try{
 
-				if(!FindContainingElement(elem, m_tree, x)){
+			//	find element and local position of x
+				MathVector<dim> locPos;
+				if(!m_spLocator->locate(elem, locPos, x)){
 					return false;
 				}
 
@@ -383,13 +298,6 @@ class GlobalGridFunctionGradientData
 			//	reference object id
 				const ReferenceObjectID roid = elem->reference_object_id();
 
-			//	get local position of DoF
-				DimReferenceMapping<dim, dim>& map
-					= ReferenceMappingProvider::get<dim, dim>(roid, vCornerCoords);
-				MathVector<dim> locPos;
-				VecSet(locPos, 0.5);
-				map.global_to_local(locPos, x);
-
 				
 				MathMatrix<refDim, dim> JT;
 				try{
@@ -465,6 +373,21 @@ class GlobalGridFunctionGradientData
 			for(int i = 0; i < dim; i++) vPos[i] = value[i];
 			return vPos;
 		}
+
+	protected:
+		void init(const char* cmp)
+		{
+			//	get function id of name
+			m_fct = m_spGridFct->fct_id_by_name(cmp);
+
+			//	check that function exists
+			if(m_fct >= m_spGridFct->num_fct())
+				UG_THROW("GridFunctionGradientData: Function space does not contain"
+						" a function with name " << cmp << ".");
+
+			//	local finite element id
+			m_lfeID = m_spGridFct->local_finite_element_id(m_fct);
+		}
 };
 
 } // end namespace ug
@@ -378,8 +378,11 @@ grid_changed_callback(const GridMessage_Adaption& msg)
 		this->set_layouts(m_spDD->layouts());
 		#endif
 
-
-		m_spAdaptGridFct->copy_to_surface(*this);
+	//	after a region reinit, the unchanged values have already been moved
+		if(m_spDD->region_reinit())
+			m_spAdaptGridFct->copy_to_surface(*this, m_spDD->reinit_region());
+		else
+			m_spAdaptGridFct->copy_to_surface(*this);
 		m_spAdaptGridFct = SPNULL;
 	}
 }
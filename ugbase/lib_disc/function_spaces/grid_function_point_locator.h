@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__FUNCTION_SPACE__GRID_FUNCTION_POINT_LOCATOR__
+#define __H__UG__LIB_DISC__FUNCTION_SPACE__GRID_FUNCTION_POINT_LOCATOR__
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "common/common.h"
+#include "common/util/smart_pointer.h"
+#include "lib_grid/tools/subset_group.h"
+#include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+#include "lib_disc/common/revision_counter.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/local_finite_element/local_finite_element_provider.h"
+#include "lib_disc/reference_element/reference_mapping_provider.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_process_communicator.h"
+	#include "lib_grid/parallelization/distributed_grid.h"
+#endif
+
+namespace ug{
+
+///	Persistent spatial index for point location and point evaluation of grid functions
+/**
+ * The locator holds two lg_ntrees: one containing the surface elements of
+ * dimension elemDim and one containing the surface vertices of the grid
+ * function in the subsets passed to the constructor. The trees are created on
+ * the first query and reused afterwards, until the revision of the
+ * approximation space changes (i.e. after grid adaption or redistribution) or
+ * a grid function with a different dof distribution is set. Thus a single
+ * locator can be kept alive over a whole time-stepping loop and answers each
+ * query in logarithmic instead of linear time.
+ *
+ * Changes of vertex positions (e.g. moving meshes) are not tracked. Call
+ * rebuild() in that case.
+ *
+ * All queries are available for single points and for batches of points.
+ * The batched versions additionally reuse the element found for the previous
+ * point as a first guess, which makes them considerably cheaper for clustered
+ * probe points.
+ *
+ * \note	The trees are created lazily from const methods, thus a single
+ * 			locator must not be queried concurrently from several threads.
+ */
+template <typename TGridFunction, int elemDim = TGridFunction::dim>
+class GridFunctionPointLocator
+{
+	public:
+	///	world dimension
+		static const int dim = TGridFunction::dim;
+
+	///	type of located elements
+		typedef typename TGridFunction::template dim_traits<elemDim>::grid_base_object element_t;
+
+	///	tree types
+		typedef lg_ntree<dim, dim, element_t>	elem_tree_t;
+		typedef lg_ntree<dim, dim, Vertex>		vertex_tree_t;
+
+	public:
+	///	creates a locator for all subsets of the grid function
+		GridFunctionPointLocator(SmartPtr<TGridFunction> spGridFct)
+		{
+			init(spGridFct, NULL);
+		}
+
+	///	creates a locator restricted to the given subsets (comma separated)
+		GridFunctionPointLocator(SmartPtr<TGridFunction> spGridFct, const char* subsets)
+		{
+			init(spGridFct, subsets);
+		}
+
+	///	creates a locator restricted to the given subset group
+		GridFunctionPointLocator(SmartPtr<TGridFunction> spGridFct, const SubsetGroup& ssGrp)
+		{
+			init(spGridFct, NULL);
+			m_ssGrp = ssGrp;
+		}
+
+	///	sets the grid function used for evaluation
+	/**	The trees are kept if the new function shares dof distribution and
+	 * revision with the previous one, e.g. for grid functions of successive
+	 * time steps.*/
+		void set_grid_function(SmartPtr<TGridFunction> spGridFct)
+		{
+			UG_COND_THROW(spGridFct.invalid(), "GridFunctionPointLocator: "
+						  "Invalid grid function passed.");
+			UG_COND_THROW(spGridFct->domain() != m_spGridFct->domain(),
+						  "GridFunctionPointLocator: Grid function of a "
+						  "different domain passed.");
+			m_spGridFct = spGridFct;
+		}
+
+	///	returns the grid function used for evaluation
+		SmartPtr<TGridFunction> grid_function() const	{return m_spGridFct;}
+
+	///	returns the subsets whose elements are indexed
+		const SubsetGroup& subset_group() const	{return m_ssGrp;}
+
+	///	discards the trees. They are recreated on the next query.
+		void rebuild()
+		{
+			m_elemRevision.invalidate();
+			m_vrtRevision.invalidate();
+		}
+
+	///	finds the element containing x and the local coordinates of x in it
+	/**	Returns false if no indexed element contains the point.*/
+		bool locate(element_t*& elemOut, MathVector<elemDim>& locPosOut,
+					const MathVector<dim>& x) const
+		{
+			update_elem_tree();
+			if(!FindContainingElement(elemOut, m_elemTree, x))
+				return false;
+			global_to_local(locPosOut, elemOut, x);
+			return true;
+		}
+
+	///	locates a batch of points
+	/**	Entries of vElemOut are NULL for points which could not be located.
+	 * Returns the number of located points.*/
+		size_t locate(std::vector<element_t*>& vElemOut,
+					  std::vector<MathVector<elemDim> >& vLocPosOut,
+					  const std::vector<MathVector<dim> >& vPos) const
+		{
+			update_elem_tree();
+
+			vElemOut.resize(vPos.size());
+			vLocPosOut.resize(vPos.size());
+
+			const typename TGridFunction::domain_type::position_accessor_type&
+				aaPos = m_spGridFct->domain()->position_accessor();
+
+			size_t numFound = 0;
+			element_t* lastElem = NULL;
+			for(size_t i = 0; i < vPos.size(); ++i){
+				element_t* elem = NULL;
+				if(lastElem && ContainsPoint(lastElem, vPos[i], aaPos))
+					elem = lastElem;
+				else if(!FindContainingElement(elem, m_elemTree, vPos[i]))
+					elem = NULL;
+
+				vElemOut[i] = elem;
+				if(elem){
+					global_to_local(vLocPosOut[i], elem, vPos[i]);
+					lastElem = elem;
+					++numFound;
+				}
+			}
+			return numFound;
+		}
+
+	///	returns the closest indexed vertex carrying dofs of the given function
+	/**	Vertices with children and, in parallel, ghosts and horizontal slaves
+	 * are not indexed. Returns NULL if no such vertex exists.
+	 * If distSqOut is given, it is filled with the squared distance.*/
+		Vertex* closest_vertex(const MathVector<dim>& x, size_t fct,
+							   number* distSqOut = NULL) const
+		{
+			update_vertex_tree();
+
+			Vertex* vrt = NULL;
+			number distSq = std::numeric_limits<number>::max();
+			if(!FindClosestElement(vrt, distSq, m_vrtTree, x,
+								   FunctionDefinedOnVertex(*m_spGridFct, fct)))
+				vrt = NULL;
+
+			if(distSqOut) *distSqOut = distSq;
+			return vrt;
+		}
+
+	///	evaluates a component of a grid function in an element at local coordinates
+		number evaluate_in_element(element_t* elem, const MathVector<elemDim>& locPos,
+								   const TGridFunction& u, size_t fct) const
+		{
+			const ReferenceObjectID roid = elem->reference_object_id();
+			const LocalShapeFunctionSet<elemDim>& rTrialSpace =
+				LocalFiniteElementProvider::get<elemDim>
+					(roid, u.local_finite_element_id(fct));
+
+			rTrialSpace.shapes(m_vShape, locPos);
+			u.dof_indices(elem, fct, m_vInd);
+
+			number value = 0.0;
+			for(size_t sh = 0; sh < m_vShape.size(); ++sh)
+				value += DoFRef(u, m_vInd[sh]) * m_vShape[sh];
+			return value;
+		}
+
+	///	evaluates a component of a grid function at x
+	/**	Returns false if x is not contained in an indexed element in which
+	 * the function is defined. u has to live on the same surface as the
+	 * grid function of the locator, e.g. a solution of another time step.*/
+		bool evaluate(number& valueOut, const MathVector<dim>& x,
+					  const TGridFunction& u, size_t fct) const
+		{
+			element_t* elem;
+			MathVector<elemDim> locPos;
+			if(!locate(elem, locPos, x) || !is_def_in_elem(elem, fct))
+				return false;
+			valueOut = evaluate_in_element(elem, locPos, u, fct);
+			return true;
+		}
+
+	///	evaluates a component of the grid function of the locator at x
+		bool evaluate(number& valueOut, const MathVector<dim>& x, size_t fct) const
+		{
+			return evaluate(valueOut, x, *m_spGridFct, fct);
+		}
+
+	///	evaluates a component of the grid function at a batch of points
+	/**	vFoundOut[i] is false for points which could not be located.
+	 * The corresponding values are set to 0. Returns the number of located
+	 * points.*/
+		size_t evaluate(std::vector<number>& vValueOut, std::vector<bool>& vFoundOut,
+						const std::vector<MathVector<dim> >& vPos, size_t fct) const
+		{
+			locate(m_vElem, m_vLocPos, vPos);
+
+			vValueOut.assign(vPos.size(), 0.0);
+			vFoundOut.assign(vPos.size(), false);
+			size_t numFound = 0;
+			for(size_t i = 0; i < vPos.size(); ++i){
+				element_t* elem = m_vElem[i];
+				if(!elem || !is_def_in_elem(elem, fct)) continue;
+				vValueOut[i] = evaluate_in_element(elem, m_vLocPos[i], *m_spGridFct, fct);
+				vFoundOut[i] = true;
+				++numFound;
+			}
+			return numFound;
+		}
+
+	///	evaluates a component at the closest vertex of each point of a batch
+	/**	vDistSqOut receives the squared distances to the chosen vertices
+	 * (max number if none was found, then the value is 0).
+	 * Returns the number of points for which a vertex was found.*/
+		size_t evaluate_at_closest_vertex(std::vector<number>& vValueOut,
+										  std::vector<number>& vDistSqOut,
+										  const std::vector<MathVector<dim> >& vPos,
+										  size_t fct) const
+		{
+			vValueOut.assign(vPos.size(), 0.0);
+			vDistSqOut.resize(vPos.size());
+			size_t numFound = 0;
+			for(size_t i = 0; i < vPos.size(); ++i){
+				Vertex* vrt = closest_vertex(vPos[i], fct, &vDistSqOut[i]);
+				if(!vrt) continue;
+				m_spGridFct->inner_dof_indices(vrt, fct, m_vInd);
+				vValueOut[i] = DoFRef(*m_spGridFct, m_vInd[0]);
+				++numFound;
+			}
+			return numFound;
+		}
+
+	///	evaluates at a batch of points on all processes
+	/**	Values of points found on several processes are averaged. vFoundOut
+	 * is identical on all processes.*/
+		size_t evaluate_global(std::vector<number>& vValueOut, std::vector<bool>& vFoundOut,
+							   const std::vector<MathVector<dim> >& vPos, size_t fct) const
+		{
+			size_t numFound = evaluate(vValueOut, vFoundOut, vPos, fct);
+
+		#ifdef UG_PARALLEL
+			std::vector<number> vCnt(vPos.size());
+			for(size_t i = 0; i < vPos.size(); ++i)
+				vCnt[i] = vFoundOut[i] ? 1 : 0;
+
+			pcl::ProcessCommunicator com;
+			std::vector<number> vGlobCnt, vGlobVal;
+			com.allreduce(vCnt, vGlobCnt, PCL_RO_SUM);
+			com.allreduce(vValueOut, vGlobVal, PCL_RO_SUM);
+
+			numFound = 0;
+			for(size_t i = 0; i < vPos.size(); ++i){
+				vFoundOut[i] = (vGlobCnt[i] > 0);
+				vValueOut[i] = vFoundOut[i] ? vGlobVal[i] / vGlobCnt[i] : 0.0;
+				if(vFoundOut[i]) ++numFound;
+			}
+		#endif
+
+			return numFound;
+		}
+
+	///	evaluates at the closest vertex over all processes for a batch of points
+	/**	If several processes share the minimal distance, their values are averaged.
+	 * Returns the number of points for which a vertex was found on some process.*/
+		size_t evaluate_at_closest_vertex_global(std::vector<number>& vValueOut,
+												 std::vector<number>& vDistSqOut,
+												 const std::vector<MathVector<dim> >& vPos,
+												 size_t fct) const
+		{
+			size_t numFound = evaluate_at_closest_vertex(vValueOut, vDistSqOut, vPos, fct);
+
+		#ifdef UG_PARALLEL
+			pcl::ProcessCommunicator com;
+			std::vector<number> vMinDistSq;
+			com.allreduce(vDistSqOut, vMinDistSq, PCL_RO_MIN);
+
+			std::vector<number> vCnt(vPos.size(), 0.0);
+			for(size_t i = 0; i < vPos.size(); ++i){
+				if(vDistSqOut[i] == vMinDistSq[i]
+				   && vMinDistSq[i] != std::numeric_limits<number>::max())
+					vCnt[i] = 1;
+				else
+					vValueOut[i] = 0.0;
+			}
+
+			std::vector<number> vGlobCnt, vGlobVal;
+			com.allreduce(vCnt, vGlobCnt, PCL_RO_SUM);
+			com.allreduce(vValueOut, vGlobVal, PCL_RO_SUM);
+
+			numFound = 0;
+			for(size_t i = 0; i < vPos.size(); ++i){
+				vDistSqOut[i] = vMinDistSq[i];
+				vValueOut[i] = (vGlobCnt[i] > 0) ? vGlobVal[i] / vGlobCnt[i] : 0.0;
+				if(vGlobCnt[i] > 0) ++numFound;
+			}
+		#endif
+
+			return numFound;
+		}
+
+	////////////////////////////////
+	//	script interface
+	////////////////////////////////
+
+	///	evaluates a component at points given as flat coordinate array (x0,y0,x1,y1,...)
+	/**	Points which can not be located on this process yield NaN.*/
+		std::vector<number> evaluate_lua(const std::vector<number>& vCoords,
+										 const char* cmp) const
+		{
+			std::vector<number> vValue;
+			std::vector<bool> vFound;
+			evaluate(vValue, vFound, coords_to_positions(vCoords), fct_id(cmp));
+			mark_missing(vValue, vFound);
+			return vValue;
+		}
+
+	///	evaluates a component at points given as flat coordinate array on all processes
+	/**	Points which can not be located on any process yield NaN.*/
+		std::vector<number> evaluate_global_lua(const std::vector<number>& vCoords,
+												const char* cmp) const
+		{
+			std::vector<number> vValue;
+			std::vector<bool> vFound;
+			evaluate_global(vValue, vFound, coords_to_positions(vCoords), fct_id(cmp));
+			mark_missing(vValue, vFound);
+			return vValue;
+		}
+
+	///	evaluates a component at the closest vertices of points given as flat coordinate array
+		std::vector<number> evaluate_at_closest_vertex_lua(const std::vector<number>& vCoords,
+														   const char* cmp) const
+		{
+			std::vector<number> vValue, vDistSq;
+			evaluate_at_closest_vertex(vValue, vDistSq, coords_to_positions(vCoords), fct_id(cmp));
+			mark_missing(vValue, vDistSq);
+			return vValue;
+		}
+
+	///	like evaluate_at_closest_vertex_lua, but minimizes the distance over all processes
+		std::vector<number> evaluate_at_closest_vertex_global_lua(const std::vector<number>& vCoords,
+																  const char* cmp) const
+		{
+			std::vector<number> vValue, vDistSq;
+			evaluate_at_closest_vertex_global(vValue, vDistSq, coords_to_positions(vCoords), fct_id(cmp));
+			mark_missing(vValue, vDistSq);
+			return vValue;
+		}
+
+	///	returns the distances of the given points to their closest vertices
+	/**	Only vertices carrying dofs of the given component are considered.
+	 * Points without such a vertex yield the max number.*/
+		std::vector<number> closest_vertex_distances(const std::vector<number>& vCoords,
+													 const char* cmp) const
+		{
+			const std::vector<MathVector<dim> > vPos = coords_to_positions(vCoords);
+			const size_t fct = fct_id(cmp);
+			std::vector<number> vDist(vPos.size());
+			for(size_t i = 0; i < vPos.size(); ++i){
+				number distSq;
+				if(closest_vertex(vPos[i], fct, &distSq))
+					vDist[i] = std::sqrt(distSq);
+				else
+					vDist[i] = std::numeric_limits<number>::max();
+			}
+			return vDist;
+		}
+
+	protected:
+	///	predicate accepting vertices in subsets where the function is defined
+		struct FunctionDefinedOnVertex
+		{
+			FunctionDefinedOnVertex(const TGridFunction& gridFct, size_t fct) :
+				m_pGridFct(&gridFct), m_fct(fct)	{}
+
+			bool operator()(Vertex* vrt) const
+			{
+				return m_pGridFct->is_def_in_subset
+						(m_fct, m_pGridFct->domain()->subset_handler()->get_subset_index(vrt));
+			}
+
+			const TGridFunction*	m_pGridFct;
+			size_t					m_fct;
+		};
+
+		void init(SmartPtr<TGridFunction> spGridFct, const char* subsets)
+		{
+			UG_COND_THROW(spGridFct.invalid(), "GridFunctionPointLocator: "
+						  "Invalid grid function passed.");
+			m_spGridFct = spGridFct;
+			m_pElemDD = NULL;
+			m_pVrtDD = NULL;
+
+			typename TGridFunction::domain_type& dom = *spGridFct->domain();
+			m_elemTree.set_grid(*dom.grid(), dom.position_attachment());
+			m_vrtTree.set_grid(*dom.grid(), dom.position_attachment());
+
+			m_ssGrp = SubsetGroup(dom.subset_handler());
+			if(subsets != NULL)
+				m_ssGrp.add(TokenizeString(subsets));
+			else
+				m_ssGrp.add_all();
+		}
+
+	///	returns whether the trees built for the dof distribution dd are outdated
+		bool outdated(const RevisionCounter& rev, const DoFDistribution* dd) const
+		{
+			return rev != m_spGridFct->approx_space()->revision()
+					|| dd != m_spGridFct->dd().get();
+		}
+
+		void update_elem_tree() const
+		{
+			if(!outdated(m_elemRevision, m_pElemDD)) return;
+
+			std::vector<element_t*> vElem;
+			for(size_t i = 0; i < m_ssGrp.size(); ++i){
+				const int si = m_ssGrp[i];
+				typename TGridFunction::template dim_traits<elemDim>::const_iterator
+					iter = m_spGridFct->template begin<element_t>(si),
+					iterEnd = m_spGridFct->template end<element_t>(si);
+				for(; iter != iterEnd; ++iter)
+					vElem.push_back(*iter);
+			}
+
+			m_elemTree.create_tree(vElem.begin(), vElem.end());
+			m_elemRevision = m_spGridFct->approx_space()->revision();
+			m_pElemDD = m_spGridFct->dd().get();
+		}
+
+		void update_vertex_tree() const
+		{
+			if(!outdated(m_vrtRevision, m_pVrtDD)) return;
+
+			const typename TGridFunction::domain_type::grid_type& grid
+				= *m_spGridFct->domain()->grid();
+		#ifdef UG_PARALLEL
+			const DistributedGridManager* dgm = grid.distributed_grid_manager();
+		#endif
+
+			std::vector<Vertex*> vVrt;
+			for(size_t i = 0; i < m_ssGrp.size(); ++i){
+				const int si = m_ssGrp[i];
+				typename TGridFunction::template dim_traits<0>::const_iterator
+					iter = m_spGridFct->template begin<Vertex>(si),
+					iterEnd = m_spGridFct->template end<Vertex>(si);
+				for(; iter != iterEnd; ++iter){
+					Vertex* vrt = *iter;
+					if(grid.has_children(vrt)) continue;
+				#ifdef UG_PARALLEL
+					if(dgm && (dgm->is_ghost(vrt)
+							   || dgm->contains_status(vrt, INT_H_SLAVE)))
+						continue;
+				#endif
+					vVrt.push_back(vrt);
+				}
+			}
+
+			m_vrtTree.create_tree(vVrt.begin(), vVrt.end());
+			m_vrtRevision = m_spGridFct->approx_space()->revision();
+			m_pVrtDD = m_spGridFct->dd().get();
+		}
+
+		void global_to_local(MathVector<elemDim>& locPosOut, element_t* elem,
+							 const MathVector<dim>& x) const
+		{
+			CollectCornerCoordinates(m_vCornerCoords, *elem, *m_spGridFct->domain());
+			DimReferenceMapping<elemDim, dim>& map
+				= ReferenceMappingProvider::get<elemDim, dim>
+					(elem->reference_object_id(), m_vCornerCoords);
+			VecSet(locPosOut, 0.5);
+			map.global_to_local(locPosOut, x);
+		}
+
+		bool is_def_in_elem(element_t* elem, size_t fct) const
+		{
+			return m_spGridFct->is_def_in_subset
+					(fct, m_spGridFct->domain()->subset_handler()->get_subset_index(elem));
+		}
+
+		size_t fct_id(const char* cmp) const
+		{
+			const size_t fct = m_spGridFct->fct_id_by_name(cmp);
+			UG_COND_THROW(fct >= m_spGridFct->num_fct(), "GridFunctionPointLocator: "
+						  "Function space does not contain a function with name "
+						  << cmp << ".");
+			return fct;
+		}
+
+		std::vector<MathVector<dim> > coords_to_positions(const std::vector<number>& vCoords) const
+		{
+			UG_COND_THROW(vCoords.size() % dim != 0, "GridFunctionPointLocator: "
+						  "Expected a multiple of " << dim << " coordinates, but "
+						  "given " << vCoords.size() << ".");
+
+			std::vector<MathVector<dim> > vPos(vCoords.size() / dim);
+			for(size_t i = 0; i < vPos.size(); ++i)
+				for(int d = 0; d < dim; ++d)
+					vPos[i][d] = vCoords[i * dim + d];
+			return vPos;
+		}
+
+		static void mark_missing(std::vector<number>& vValue, const std::vector<bool>& vFound)
+		{
+			for(size_t i = 0; i < vValue.size(); ++i)
+				if(!vFound[i]) vValue[i] = std::numeric_limits<number>::quiet_NaN();
+		}
+
+		static void mark_missing(std::vector<number>& vValue, const std::vector<number>& vDistSq)
+		{
+			for(size_t i = 0; i < vValue.size(); ++i)
+				if(vDistSq[i] == std::numeric_limits<number>::max())
+					vValue[i] = std::numeric_limits<number>::quiet_NaN();
+		}
+
+	protected:
+		SmartPtr<TGridFunction>	m_spGridFct;
+		SubsetGroup				m_ssGrp;
+
+	///	trees and the state they were created for
+		mutable elem_tree_t				m_elemTree;
+		mutable RevisionCounter			m_elemRevision;
+		mutable const DoFDistribution*	m_pElemDD;
+		mutable vertex_tree_t			m_vrtTree;
+		mutable RevisionCounter			m_vrtRevision;
+		mutable const DoFDistribution*	m_pVrtDD;
+
+	///	buffers reused between queries
+		mutable std::vector<MathVector<dim> >		m_vCornerCoords;
+		mutable std::vector<number>					m_vShape;
+		mutable std::vector<DoFIndex>				m_vInd;
+		mutable std::vector<element_t*>				m_vElem;
+		mutable std::vector<MathVector<elemDim> >	m_vLocPos;
+};
+
+}// end of namespace
+
+#endif
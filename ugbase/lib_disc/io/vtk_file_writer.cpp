@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <cstring>
+#include <algorithm>
+#include <climits>
+#include <stdint.h>
+
+#include "vtk_file_writer.h"
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+
+#ifdef UG_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef UG_PARALLEL
+#include "pcl/pcl_comm_world.h"
+#endif
+
+namespace ug{
+
+///	size of the blocks compressed independently (the vtk default)
+static const size_t VTK_ZLIB_BLOCK_SIZE = 32768;
+
+static const char* VTK_APPENDED_BEGIN = "  <AppendedData encoding=\"raw\">\n   _";
+static const char* VTK_APPENDED_END = "\n  </AppendedData>\n";
+
+////////////////////////////////////////////////////////////////////////////////
+//	VTKFileGroup
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef UG_PARALLEL
+VTKFileGroup::VTKFileGroup(int groupSize) :
+	m_comm(MPI_COMM_NULL), m_rank(0), m_size(1), m_leader(0), m_groupSize(groupSize)
+{
+	UG_COND_THROW(groupSize < 0, "VTKFileGroup: Group size must not be negative.");
+
+	int worldRank, worldSize;
+	MPI_Comm_rank(PCL_COMM_WORLD, &worldRank);
+	MPI_Comm_size(PCL_COMM_WORLD, &worldSize);
+
+//	split the processes into the groups
+	if(groupSize == 0)
+		MPI_Comm_split_type(PCL_COMM_WORLD, MPI_COMM_TYPE_SHARED, worldRank,
+		                    MPI_INFO_NULL, &m_comm);
+	else
+		MPI_Comm_split(PCL_COMM_WORLD, worldRank / groupSize, worldRank, &m_comm);
+
+	MPI_Comm_rank(m_comm, &m_rank);
+	MPI_Comm_size(m_comm, &m_size);
+
+//	the leader is the lowest world rank of the group
+	m_leader = worldRank;
+	MPI_Bcast(&m_leader, 1, MPI_INT, 0, m_comm);
+
+//	collect the leaders of all groups
+	std::vector<int> vLeader(worldSize);
+	int myLeader = is_leader() ? worldRank : -1;
+	MPI_Allgather(&myLeader, 1, MPI_INT, &vLeader[0], 1, MPI_INT, PCL_COMM_WORLD);
+	for(size_t i = 0; i < vLeader.size(); ++i)
+		if(vLeader[i] >= 0) m_vLeader.push_back(vLeader[i]);
+}
+
+VTKFileGroup::~VTKFileGroup()
+{
+	if(m_comm != MPI_COMM_NULL)
+		MPI_Comm_free(&m_comm);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//	VTKFileWriter
+////////////////////////////////////////////////////////////////////////////////
+
+VTKFileWriter::VTKFileWriter(const char* filename, DataMode mode) :
+	m_mode(mode)
+{
+	init(filename);
+}
+
+#ifdef UG_PARALLEL
+VTKFileWriter::VTKFileWriter(const char* filename, DataMode mode,
+                             ConstSmartPtr<VTKFileGroup> spGroup) :
+	m_mode(mode), m_spGroup(spGroup)
+{
+	UG_COND_THROW(m_spGroup.valid() && (mode == INLINE_BASE64 || mode == BUFFERED_RAW),
+	              "VTKFileWriter: Writing a file of a group requires an appended data mode.");
+	init(filename);
+}
+#endif
+
+void VTKFileWriter::init(const char* filename)
+{
+#ifndef UG_ZLIB
+	UG_COND_THROW(m_mode == APPENDED_ZLIB, "VTKFileWriter: Compressed output "
+	              "requires zlib. Please reconfigure with 'cmake -DUSE_ZLIB=ON'.");
+#endif
+
+	m_currFormat = base64_ascii;
+	m_filename = filename;
+	m_bClosed = false;
+	m_bBlockOpen = false;
+	m_bBlockExpected = false;
+	m_piecesBegin = m_piecesEnd = m_appendedPos = std::string::npos;
+	m_bRecording = false;
+	m_recXml = m_recPlaceholder = m_recBlock = 0;
+
+	if(m_mode == INLINE_BASE64){
+		m_inline.open(filename);
+		return;
+	}
+
+//	buffered files are kept in memory only
+	if(m_mode == BUFFERED_RAW) return;
+
+#ifdef UG_PARALLEL
+//	the file of a group is opened collectively on close
+	if(m_spGroup.valid()) return;
+#endif
+
+	m_out.open(filename, std::ios_base::out | std::ios_base::binary);
+	if(!m_out.is_open())
+		UG_THROW("Could not open output file: " << filename);
+}
+
+VTKFileWriter::~VTKFileWriter()
+{
+#ifdef UG_PARALLEL
+//	closing is collective for groups and can not be done implicitly
+	if(m_spGroup.valid()) return;
+#endif
+	if(!m_bClosed){
+		try{close();}
+		catch(...) {}
+	}
+}
+
+const char* VTKFileWriter::header_attributes() const
+{
+	if(m_mode == APPENDED_ZLIB)
+		return " compressor=\"vtkZLibDataCompressor\"";
+	return "";
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const fmtflag format)
+{
+	if(m_mode == INLINE_BASE64){
+		m_inline << (Base64FileWriter::fmtflag) format;
+		m_currFormat = format;
+		return *this;
+	}
+
+	if(format == m_currFormat) return *this;
+
+	if(m_currFormat == base64_binary)
+		finish_block();
+
+	if(format == base64_binary){
+		UG_COND_THROW(!m_bBlockExpected, "VTKFileWriter: Binary data written "
+		              "without announcing its data array by data_format(true).");
+		m_vCurBlock.clear();
+		m_bBlockOpen = true;
+		m_bBlockExpected = false;
+	}
+
+	m_currFormat = format;
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const DataFormat& format)
+{
+	if(!format.binary)
+		return *this << "\"ascii\"";
+
+	if(m_mode == INLINE_BASE64)
+		return *this << "\"binary\"";
+
+	UG_COND_THROW(m_currFormat == base64_binary,
+	              "VTKFileWriter: Data format requested inside of binary data.");
+	UG_COND_THROW(m_bBlockExpected,
+	              "VTKFileWriter: Binary data missing for previous data array.");
+
+//	the offset is inserted when the size of all previous blocks is known
+	m_xml << "\"appended\" offset=\"";
+	m_vPlaceholder.push_back(std::make_pair((size_t)m_xml.tellp(), m_vBlock.size()));
+	m_xml << "\"";
+	m_bBlockExpected = true;
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const char* value)
+{
+	if(m_mode == INLINE_BASE64) {m_inline << value; return *this;}
+	if(m_currFormat == base64_binary)
+		m_vCurBlock.insert(m_vCurBlock.end(), value, value + strlen(value));
+	else
+		m_xml << value;
+	return *this;
+}
+
+void VTKFileWriter::finish_block()
+{
+	if(!m_bBlockOpen) return;
+	m_vBlock.push_back(std::vector<char>());
+	m_vBlock.back().swap(m_vCurBlock);
+	m_vEncoded.push_back(false);
+	m_bBlockOpen = false;
+}
+
+void VTKFileWriter::encode_blocks(size_t from)
+{
+	PROFILE_FUNC();
+
+	for(size_t b = from; b < m_vBlock.size(); ++b)
+	{
+		if(m_vEncoded[b]) continue;
+		std::vector<char>& block = m_vBlock[b];
+
+	//	every block starts with the byte count of its data, which is
+	//	recomputed here from the actual size
+		UG_COND_THROW(block.size() < sizeof(uint32_t),
+		              "VTKFileWriter: Binary block without byte count.");
+		const size_t len = block.size() - sizeof(uint32_t);
+		UG_COND_THROW(len > UINT_MAX, "VTKFileWriter: Binary block too large.");
+
+		if(m_mode != APPENDED_ZLIB){
+			uint32_t n = (uint32_t)len;
+			memcpy(&block[0], &n, sizeof(n));
+		}
+		else{
+#ifdef UG_ZLIB
+		//	header: #blocks, block size, size of last block, compressed sizes
+			const size_t numBlocks = (len + VTK_ZLIB_BLOCK_SIZE - 1) / VTK_ZLIB_BLOCK_SIZE;
+			std::vector<uint32_t> vHeader(3 + numBlocks);
+			vHeader[0] = (uint32_t)numBlocks;
+			vHeader[1] = (uint32_t)VTK_ZLIB_BLOCK_SIZE;
+			vHeader[2] = (uint32_t)(len - (numBlocks > 0 ? (numBlocks-1) * VTK_ZLIB_BLOCK_SIZE : 0));
+
+			std::vector<char> vData;
+			vData.reserve(compressBound(len) + numBlocks * 16);
+			std::vector<Bytef> vBuf(compressBound(VTK_ZLIB_BLOCK_SIZE));
+			const Bytef* src = reinterpret_cast<const Bytef*>(&block[0]) + sizeof(uint32_t);
+			for(size_t i = 0; i < numBlocks; ++i)
+			{
+				const size_t srcLen = (i+1 < numBlocks) ? VTK_ZLIB_BLOCK_SIZE : vHeader[2];
+				uLongf dstLen = vBuf.size();
+			//	fast compression: the output is written once and read rarely
+				if(compress2(&vBuf[0], &dstLen, src + i*VTK_ZLIB_BLOCK_SIZE,
+				             srcLen, Z_BEST_SPEED) != Z_OK)
+					UG_THROW("VTKFileWriter: zlib compression failed.");
+				vHeader[3+i] = (uint32_t)dstLen;
+				vData.insert(vData.end(), (const char*)&vBuf[0], (const char*)&vBuf[0] + dstLen);
+			}
+
+			block.assign(reinterpret_cast<const char*>(&vHeader[0]),
+			             reinterpret_cast<const char*>(&vHeader[0]) + vHeader.size()*sizeof(uint32_t));
+			block.insert(block.end(), vData.begin(), vData.end());
+#endif
+		}
+		m_vEncoded[b] = true;
+	}
+}
+
+size_t VTKFileWriter::appended_size() const
+{
+	size_t size = 0;
+	for(size_t b = 0; b < m_vBlock.size(); ++b)
+		size += m_vBlock[b].size();
+	return size;
+}
+
+void VTKFileWriter::materialize(std::string& out, size_t begin, size_t end,
+                                size_t baseOffset) const
+{
+	const std::string xml = m_xml.str();
+	out.clear();
+
+//	offsets of the blocks
+	std::vector<size_t> vOffset(m_vBlock.size() + 1, baseOffset);
+	for(size_t b = 0; b < m_vBlock.size(); ++b)
+		vOffset[b+1] = vOffset[b] + m_vBlock[b].size();
+
+	size_t pos = begin;
+	for(size_t i = 0; i < m_vPlaceholder.size(); ++i)
+	{
+		const size_t at = m_vPlaceholder[i].first;
+		if(at < begin || at >= end) continue;
+		out.append(xml, pos, at - pos);
+		std::ostringstream ss; ss << vOffset[m_vPlaceholder[i].second];
+		out.append(ss.str());
+		pos = at;
+	}
+	out.append(xml, pos, end - pos);
+}
+
+void VTKFileWriter::begin_pieces()
+{
+	if(m_mode == INLINE_BASE64) return;
+	m_piecesBegin = m_xml.tellp();
+}
+
+void VTKFileWriter::end_pieces()
+{
+	if(m_mode == INLINE_BASE64) return;
+	UG_COND_THROW(m_currFormat == base64_binary || m_bBlockExpected,
+	              "VTKFileWriter: Pieces ended inside of a data array.");
+	m_piecesEnd = m_xml.tellp();
+}
+
+void VTKFileWriter::write_appended_data()
+{
+	if(m_mode == INLINE_BASE64) return;
+	UG_COND_THROW(m_currFormat == base64_binary || m_bBlockExpected,
+	              "VTKFileWriter: Appended data requested inside of a data array.");
+	m_appendedPos = m_xml.tellp();
+}
+
+void VTKFileWriter::begin_record()
+{
+	UG_COND_THROW(m_mode == INLINE_BASE64,
+	              "VTKFileWriter: Recording is only supported in appended modes.");
+	UG_COND_THROW(m_currFormat == base64_binary || m_bBlockExpected,
+	              "VTKFileWriter: Recording started inside of a data array.");
+	m_bRecording = true;
+	m_recXml = m_xml.tellp();
+	m_recPlaceholder = m_vPlaceholder.size();
+	m_recBlock = m_vBlock.size();
+}
+
+void VTKFileWriter::end_record(Record& rec)
+{
+	UG_COND_THROW(!m_bRecording, "VTKFileWriter: Recording has not been started.");
+	UG_COND_THROW(m_currFormat == base64_binary || m_bBlockExpected,
+	              "VTKFileWriter: Recording ended inside of a data array.");
+	m_bRecording = false;
+
+//	the record keeps the encoded blocks
+	encode_blocks(m_recBlock);
+
+	rec.clear();
+	rec.xml = m_xml.str().substr(m_recXml);
+	for(size_t i = m_recPlaceholder; i < m_vPlaceholder.size(); ++i)
+		rec.vPlaceholder.push_back(std::make_pair(m_vPlaceholder[i].first - m_recXml,
+		                                          m_vPlaceholder[i].second - m_recBlock));
+	rec.vBlock.assign(m_vBlock.begin() + m_recBlock, m_vBlock.end());
+}
+
+void VTKFileWriter::replay(const Record& rec)
+{
+	UG_COND_THROW(m_mode == INLINE_BASE64,
+	              "VTKFileWriter: Replay is only supported in appended modes.");
+	UG_COND_THROW(m_currFormat == base64_binary || m_bBlockExpected,
+	              "VTKFileWriter: Replay inside of a data array.");
+
+	const size_t xmlBase = m_xml.tellp();
+	const size_t blockBase = m_vBlock.size();
+
+	m_xml << rec.xml;
+	for(size_t i = 0; i < rec.vPlaceholder.size(); ++i)
+		m_vPlaceholder.push_back(std::make_pair(rec.vPlaceholder[i].first + xmlBase,
+		                                        rec.vPlaceholder[i].second + blockBase));
+	m_vBlock.insert(m_vBlock.end(), rec.vBlock.begin(), rec.vBlock.end());
+	m_vEncoded.resize(m_vBlock.size(), true);
+}
+
+void VTKFileWriter::close()
+{
+	PROFILE_FUNC();
+
+	if(m_bClosed) return;
+	m_bClosed = true;
+
+	if(m_mode == INLINE_BASE64){
+		m_inline.close();
+		return;
+	}
+
+	if(m_currFormat == base64_binary)
+		finish_block();
+	UG_COND_THROW(m_bBlockExpected, "VTKFileWriter: Binary data missing for last data array.");
+
+	encode_blocks(0);
+
+	if(m_mode == BUFFERED_RAW) {collect_data_arrays(); return;}
+
+#ifdef UG_PARALLEL
+	if(m_spGroup.valid()) {write_group(); return;}
+#endif
+	write_serial();
+}
+
+void VTKFileWriter::collect_data_arrays()
+{
+	const std::string xml = m_xml.str();
+	static const char* vSection[] = {"<Points>", "<Cells>", "<PointData>", "<CellData>"};
+
+	m_vDataArray.clear();
+	for(size_t i = 0; i < m_vPlaceholder.size(); ++i)
+	{
+		const size_t at = m_vPlaceholder[i].first;
+		const std::vector<char>& block = m_vBlock[m_vPlaceholder[i].second];
+
+		DataArray arr;
+		const size_t tagBegin = xml.rfind('<', at);
+		arr.tag = xml.substr(tagBegin, xml.find('>', at) + 1 - tagBegin);
+
+	//	the data array belongs to the section opened last
+		size_t sectionPos = 0;
+		for(size_t s = 0; s < sizeof(vSection) / sizeof(vSection[0]); ++s){
+			const size_t pos = xml.rfind(vSection[s], at);
+			if(pos != std::string::npos && pos >= sectionPos){
+				sectionPos = pos;
+				arr.section = std::string(vSection[s] + 1, strlen(vSection[s]) - 2);
+			}
+		}
+
+		arr.data = &block[0] + sizeof(uint32_t);
+		arr.size = block.size() - sizeof(uint32_t);
+		m_vDataArray.push_back(arr);
+	}
+}
+
+void VTKFileWriter::write_serial()
+{
+	const size_t xmlSize = m_xml.tellp();
+	const size_t split = (m_appendedPos == std::string::npos) ? xmlSize : m_appendedPos;
+	const bool bAppended = !m_vBlock.empty() && (m_appendedPos != std::string::npos);
+
+	std::string out;
+	materialize(out, 0, split, 0);
+	m_out.write(out.data(), out.size());
+
+	if(bAppended){
+		m_out << VTK_APPENDED_BEGIN;
+		for(size_t b = 0; b < m_vBlock.size(); ++b)
+			if(!m_vBlock[b].empty())
+				m_out.write(&m_vBlock[b][0], m_vBlock[b].size());
+		m_out << VTK_APPENDED_END;
+	}
+
+	materialize(out, split, xmlSize, 0);
+	m_out.write(out.data(), out.size());
+
+	m_out.close();
+	UG_COND_THROW(m_out.fail(), "VTKFileWriter: Could not write file: " << m_filename);
+}
+
+#ifdef UG_PARALLEL
+///	writes a buffer of arbitrary size at a given offset
+static void WriteAt(MPI_File fh, MPI_Offset offset, const char* buf, size_t size)
+{
+	while(size > 0)
+	{
+		const int chunk = (int)std::min(size, (size_t)INT_MAX);
+		MPI_Status status;
+		if(MPI_File_write_at(fh, offset, const_cast<char*>(buf), chunk, MPI_BYTE, &status))
+			UG_THROW("VTKFileWriter: MPI_File_write_at failed.");
+		offset += chunk; buf += chunk; size -= chunk;
+	}
+}
+
+void VTKFileWriter::write_group()
+{
+	PROFILE_FUNC();
+
+	const VTKFileGroup& group = *m_spGroup;
+	MPI_Comm comm = group.communicator();
+	const size_t xmlSize = m_xml.tellp();
+
+	UG_COND_THROW(m_piecesBegin == std::string::npos || m_piecesEnd == std::string::npos,
+	              "VTKFileWriter: Pieces must be marked when writing a file of a group.");
+	UG_COND_THROW(m_appendedPos == std::string::npos,
+	              "VTKFileWriter: write_appended_data() missing for a file of a group.");
+
+//	offset of the appended data of this process in the appended section
+	unsigned long long appSize = appended_size(), appBase = 0;
+	MPI_Exscan(&appSize, &appBase, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+	if(group.rank() == 0) appBase = 0;
+
+//	offset of the pieces of this process in the pieces section
+	std::string pieces;
+	materialize(pieces, m_piecesBegin, m_piecesEnd, appBase);
+	unsigned long long xmlPiece = pieces.size(), xmlBase = 0;
+	MPI_Exscan(&xmlPiece, &xmlBase, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+	if(group.rank() == 0) xmlBase = 0;
+
+	unsigned long long local[2] = {xmlPiece, appSize}, total[2];
+	MPI_Allreduce(local, total, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+	const bool bAppended = (total[1] > 0);
+
+//	head and tail are taken from the leader
+	std::string head, tailBegin, tailEnd;
+	unsigned long long sizes[2] = {0, 0};
+	if(group.is_leader()){
+		materialize(head, 0, m_piecesBegin, 0);
+		materialize(tailBegin, m_piecesEnd, m_appendedPos, 0);
+		if(bAppended) tailBegin.append(VTK_APPENDED_BEGIN);
+		materialize(tailEnd, m_appendedPos, xmlSize, 0);
+		if(bAppended) tailEnd.insert(0, VTK_APPENDED_END);
+		sizes[0] = head.size(); sizes[1] = tailBegin.size();
+	}
+	MPI_Bcast(sizes, 2, MPI_UNSIGNED_LONG_LONG, 0, comm);
+
+	const MPI_Offset piecesOffset = sizes[0];
+	const MPI_Offset appendedOffset = sizes[0] + total[0] + sizes[1];
+
+//	open the file collectively and truncate it
+	MPI_File fh;
+	if(MPI_File_open(comm, const_cast<char*>(m_filename.c_str()),
+	                 MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh))
+		UG_THROW("VTKFileWriter: Could not open output file: " << m_filename);
+	MPI_File_set_size(fh, 0);
+
+	WriteAt(fh, piecesOffset + xmlBase, pieces.data(), pieces.size());
+
+	MPI_Offset offset = appendedOffset + appBase;
+	for(size_t b = 0; b < m_vBlock.size(); ++b){
+		if(m_vBlock[b].empty()) continue;
+		WriteAt(fh, offset, &m_vBlock[b][0], m_vBlock[b].size());
+		offset += m_vBlock[b].size();
+	}
+
+	if(group.is_leader()){
+		WriteAt(fh, 0, head.data(), head.size());
+		WriteAt(fh, sizes[0] + total[0], tailBegin.data(), tailBegin.size());
+		WriteAt(fh, appendedOffset + total[1], tailEnd.data(), tailEnd.size());
+	}
+
+	MPI_File_close(&fh);
+}
+#endif
+
+} // end namespace ug
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+#define __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <utility>
+
+#include "common/util/base64_file_writer.h"
+#include "common/util/smart_pointer.h"
+
+#ifdef UG_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace ug{
+
+#ifdef UG_PARALLEL
+///	group of processes sharing one vtu file
+/**
+ * The processes of a group write their pieces into one common vtu file using
+ * MPI-IO. The file is named after the lowest rank of the group (the leader).
+ * A group size of 0 groups all processes of a shared-memory node, a group size
+ * n > 0 groups n consecutive ranks.
+ *
+ * Creating a group is a collective operation on all processes.
+ */
+class VTKFileGroup
+{
+	public:
+		explicit VTKFileGroup(int groupSize);
+		~VTKFileGroup();
+
+	///	communicator of the group
+		MPI_Comm communicator() const	{return m_comm;}
+
+	///	rank in the group and size of the group
+		int rank() const				{return m_rank;}
+		int size() const				{return m_size;}
+
+	///	world rank of the group leader
+		int leader() const				{return m_leader;}
+		bool is_leader() const			{return m_rank == 0;}
+
+	///	world ranks of all group leaders (i.e. of all written files)
+		const std::vector<int>& leaders() const	{return m_vLeader;}
+
+	///	requested group size this group has been created for
+		int group_size() const			{return m_groupSize;}
+
+	private:
+		VTKFileGroup(const VTKFileGroup&);
+		VTKFileGroup& operator=(const VTKFileGroup&);
+
+		MPI_Comm m_comm;
+		int m_rank, m_size, m_leader, m_groupSize;
+		std::vector<int> m_vLeader;
+};
+#endif
+
+///	file writer for the vtk xml formats with inline or appended binary data
+/**
+ * The writer has the same stream interface as the Base64FileWriter: text is
+ * written in 'normal' mode, binary data in 'base64_binary' mode. Every binary
+ * data array has to be written as one binary block, starting with the UInt32
+ * byte count of the data, and it has to be announced by streaming
+ * data_format(true) as value of its 'format' attribute.
+ *
+ * Depending on the data mode the binary blocks are
+ * <ul>
+ * <li> INLINE_BASE64: base64 encoded into the xml (default, as before),
+ * <li> APPENDED_RAW: written unencoded into the \<AppendedData\> section,
+ * <li> APPENDED_ZLIB: compressed by zlib and written into \<AppendedData\>,
+ * <li> BUFFERED_RAW: kept unencoded in memory, no file is written. The data
+ *      arrays can be accessed by data_arrays() after close(). This is used to
+ *      compose other file formats from the vtk output (e.g. xdmf).
+ * </ul>
+ * In the appended modes the xml is buffered and the file is written on
+ * close(). The caller has to stream header_attributes() into the \<VTKFile\>
+ * tag and to call write_appended_data() right before its closing tag.
+ *
+ * In the appended modes, a part of the output (e.g. the grid) can be recorded
+ * and replayed into later files, so that unchanged data is neither traversed
+ * nor encoded again.
+ *
+ * In parallel, the writer may be created for a VTKFileGroup. Then the pieces
+ * of all group members are collected into one file written via MPI-IO, and the
+ * xml outside of begin_pieces() / end_pieces() is taken from the leader only.
+ * close() is then collective on the group.
+ */
+class VTKFileWriter
+{
+	public:
+	///	format flags, as in Base64FileWriter
+		enum fmtflag {base64_ascii, base64_binary, normal};
+
+	///	storage of binary data arrays
+		enum DataMode {INLINE_BASE64, APPENDED_RAW, APPENDED_ZLIB, BUFFERED_RAW};
+
+	///	value of a 'format' attribute, created by data_format()
+		struct DataFormat {bool binary;};
+
+	///	recorded output of the appended modes, see begin_record()
+		struct Record
+		{
+			std::string xml;
+			std::vector<std::pair<size_t, size_t> > vPlaceholder;
+			std::vector<std::vector<char> > vBlock;
+			bool empty() const {return xml.empty() && vBlock.empty();}
+			void clear() {xml.clear(); vPlaceholder.clear(); vBlock.clear();}
+		};
+
+	///	binary data array of a buffered file, see data_arrays()
+		struct DataArray
+		{
+			std::string section;	///< enclosing xml element (e.g. "Points", "PointData")
+			std::string tag;		///< opening xml tag of the data array
+			const char* data;		///< binary data (without byte count)
+			size_t size;			///< size of the binary data in bytes
+		};
+
+	public:
+		explicit VTKFileWriter(const char* filename, DataMode mode = INLINE_BASE64);
+#ifdef UG_PARALLEL
+		VTKFileWriter(const char* filename, DataMode mode, ConstSmartPtr<VTKFileGroup> spGroup);
+#endif
+		~VTKFileWriter();
+
+	///	returns the data mode
+		DataMode data_mode() const {return m_mode;}
+
+	///	returns if binary data is appended
+		bool appended() const {return m_mode != INLINE_BASE64;}
+
+	///	returns the current format
+		fmtflag format() const {return m_currFormat;}
+
+	///	returns the value of the 'format' attribute of the next data array
+		DataFormat data_format(bool binary) const {DataFormat f; f.binary = binary; return f;}
+
+	///	returns additional attributes of the \<VTKFile\> tag (e.g. the compressor)
+		const char* header_attributes() const;
+
+		VTKFileWriter& operator<<(const fmtflag format);
+		VTKFileWriter& operator<<(const DataFormat& format);
+		VTKFileWriter& operator<<(int value)				{dispatch(value); return *this;}
+		VTKFileWriter& operator<<(char value)				{dispatch(value); return *this;}
+		VTKFileWriter& operator<<(const char* value);
+		VTKFileWriter& operator<<(const std::string& value)	{return *this << value.c_str();}
+		VTKFileWriter& operator<<(float value)				{dispatch(value); return *this;}
+		VTKFileWriter& operator<<(double value)				{dispatch(value); return *this;}
+		VTKFileWriter& operator<<(long value)				{dispatch(value); return *this;}
+		VTKFileWriter& operator<<(size_t value)				{dispatch(value); return *this;}
+
+	///	marks the begin/end of the pieces of this process (relevant for groups)
+	/// \{
+		void begin_pieces();
+		void end_pieces();
+	/// \}
+
+	///	writes the \<AppendedData\> section (no-op in inline mode)
+		void write_appended_data();
+
+	///	records all output until end_record() (appended modes only)
+	/// \{
+		void begin_record();
+		void end_record(Record& rec);
+	/// \}
+
+	///	writes recorded output again
+		void replay(const Record& rec);
+
+	///	writes the file and closes it
+		void close();
+
+	///	returns the binary data arrays in order of writing (BUFFERED_RAW, after close)
+		const std::vector<DataArray>& data_arrays() const {return m_vDataArray;}
+
+	private:
+		VTKFileWriter(const VTKFileWriter&);
+		VTKFileWriter& operator=(const VTKFileWriter&);
+
+		void init(const char* filename);
+
+		template <typename T>
+		inline void dispatch(const T& value)
+		{
+			if(m_mode == INLINE_BASE64) {m_inline << value; return;}
+			if(m_currFormat == base64_binary)
+				m_vCurBlock.insert(m_vCurBlock.end(), reinterpret_cast<const char*>(&value),
+				                   reinterpret_cast<const char*>(&value) + sizeof(T));
+			else
+				m_xml << value;
+		}
+
+	///	finishes the current binary block
+		void finish_block();
+
+	///	encodes (compresses) all binary blocks from the given index on
+		void encode_blocks(size_t from);
+
+	///	returns the encoded size of all blocks
+		size_t appended_size() const;
+
+	///	composes the xml in [begin, end) with the offsets of the blocks
+		void materialize(std::string& out, size_t begin, size_t end, size_t baseOffset) const;
+
+		void write_serial();
+		void collect_data_arrays();
+#ifdef UG_PARALLEL
+		void write_group();
+#endif
+
+	private:
+		DataMode m_mode;
+		fmtflag m_currFormat;
+		std::string m_filename;
+		bool m_bClosed;
+
+	//	inline mode
+		Base64FileWriter m_inline;
+
+	//	appended modes: output file in serial
+		std::ofstream m_out;
+
+	//	appended modes: buffered xml and placeholders (xml position, block index)
+		std::ostringstream m_xml;
+		std::vector<std::pair<size_t, size_t> > m_vPlaceholder;
+		std::vector<std::vector<char> > m_vBlock;
+		std::vector<bool> m_vEncoded;
+		std::vector<char> m_vCurBlock;
+		bool m_bBlockOpen;
+		bool m_bBlockExpected;
+
+	//	positions in the xml
+		size_t m_piecesBegin, m_piecesEnd, m_appendedPos;
+
+	//	recording
+		bool m_bRecording;
+		size_t m_recXml, m_recPlaceholder, m_recBlock;
+
+	//	buffered mode: data arrays after close
+		std::vector<DataArray> m_vDataArray;
+
+#ifdef UG_PARALLEL
+		ConstSmartPtr<VTKFileGroup> m_spGroup;
+#endif
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__ */
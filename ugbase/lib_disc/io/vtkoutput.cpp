@@ -35,6 +35,13 @@
 #include "common/util/os_info.h"  // for GetPathSeparator
 
 #include <sstream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef UG_PARALLEL
+#include "pcl/pcl_process_communicator.h"
+#endif
 
 namespace ug{
 
@@ -56,11 +63,8 @@ print(const char* filename, Domain<TDim>& domain)
 	grid.attach_to_vertices(aVrtIndex);
 	aaVrtIndex.access(grid, aVrtIndex);
 
-//	get rank of process
-	int rank = 0;
-#ifdef UG_PARALLEL
-	rank = pcl::ProcRank();
-#endif
+//	get rank naming the file of this process
+	int rank = vtu_file_rank();
 
 	SubsetGroup ssg (domain.subset_handler());
 	ssg.add_all ();
@@ -76,7 +80,11 @@ print(const char* filename, Domain<TDim>& domain)
 //	open the file
 	try
 	{
-		VTKFileWriter File(name.c_str());
+#ifdef UG_PARALLEL
+		VTKFileWriter File(name.c_str(), m_dataMode, m_spFileGroup);
+#else
+		VTKFileWriter File(name.c_str(), m_dataMode);
+#endif
 
 	//	header
 		File << VTKFileWriter::normal;
@@ -87,10 +95,11 @@ print(const char* filename, Domain<TDim>& domain)
 		File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 		if(IsLittleEndian()) File << "LittleEndian";
 		else File << "BigEndian";
-		File << "\">\n";
+		File << "\"" << File.header_attributes() << ">\n";
 
 	//	opening the grid
 		File << "  <UnstructuredGrid>\n";
+		File.begin_pieces();
 
 	// 	get dimension of grid-piece
 		int dim = DimensionOfSubsets(sh);
@@ -117,8 +126,11 @@ print(const char* filename, Domain<TDim>& domain)
 		}
 
 	//	write closing xml tags
+		File.end_pieces();
 		File << "  </UnstructuredGrid>\n";
+		File.write_appended_data();
 		File << "</VTKFile>\n";
+		File.close();
 
 	// 	detach help indices
 		grid.detach_from_vertices(aVrtIndex);
@@ -140,7 +152,7 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "    <Piece NumberOfPoints=\"0\" NumberOfCells=\"0\">\n";
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.data_format(binary) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
@@ -149,18 +161,21 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "      </Points>\n";
 	File << "      <Cells>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.data_format(binary) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
 		File << n;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
-	File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
+		 <<	File.data_format(binary) << ">\n";
+	if(binary)
+		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
+	else
+		File << n;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.data_format(binary) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
@@ -201,6 +216,89 @@ write_comment_printf(FILE* File)
 	fprintf(File, "-->\n");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Output format
+////////////////////////////////////////////////////////////////////////////////
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_appended(bool b)
+{
+	if(b){
+		if(m_dataMode == VTKFileWriter::INLINE_BASE64)
+			m_dataMode = VTKFileWriter::APPENDED_RAW;
+	}
+	else{
+		m_dataMode = VTKFileWriter::INLINE_BASE64;
+		m_ioGroupSize = 1;
+	}
+	m_mGridCache.clear();
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_compressed(bool b)
+{
+#ifndef UG_ZLIB
+	if(b)
+		UG_THROW("VTKOutput::set_compressed: Compressed output requires zlib. "
+				"Please reconfigure with 'cmake -DUSE_ZLIB=ON'.");
+#endif
+	if(b)
+		m_dataMode = VTKFileWriter::APPENDED_ZLIB;
+	else if(m_dataMode == VTKFileWriter::APPENDED_ZLIB)
+		m_dataMode = VTKFileWriter::APPENDED_RAW;
+	m_mGridCache.clear();
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_io_group_size(int n)
+{
+	if(n < 0)
+		UG_THROW("VTKOutput::set_io_group_size: Group size must not be negative.");
+	m_ioGroupSize = n;
+	if(n != 1 && m_dataMode == VTKFileWriter::INLINE_BASE64)
+		m_dataMode = VTKFileWriter::APPENDED_RAW;
+}
+
+template <int TDim>
+int VTKOutput<TDim>::
+vtu_file_rank()
+{
+#ifdef UG_PARALLEL
+	if(m_ioGroupSize == 1 || pcl::NumProcs() == 1){
+		m_spFileGroup = SPNULL;
+		return pcl::ProcRank();
+	}
+
+//	(re-)creating the group is collective
+	if(m_spFileGroup.invalid() || m_spFileGroup->group_size() != m_ioGroupSize)
+		m_spFileGroup = make_sp(new VTKFileGroup(m_ioGroupSize));
+
+	return m_spFileGroup->leader();
+#else
+	return 0;
+#endif
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+vtu_file_ranks(std::vector<int>& vRank) const
+{
+	vRank.clear();
+#ifdef UG_PARALLEL
+	if(m_spFileGroup.valid()){
+		vRank = m_spFileGroup->leaders();
+		return;
+	}
+	for(int i = 0; i < pcl::NumProcs(); ++i)
+		vRank.push_back(i);
+#else
+	vRank.push_back(0);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // FileNames
 ////////////////////////////////////////////////////////////////////////////////
@@ -302,6 +400,27 @@ pvd_time_filename(std::string& nameOut, std::string nameIn, int step)
 	nameOut.append(".pvd");
 }
 
+template <int TDim>
+void VTKOutput<TDim>::
+xdmf_filename(std::string& nameOut, std::string nameIn, int rank,
+              const char* indicator, int counter)
+{
+// remove extension of file if necessary
+	baseName(nameOut, nameIn);
+
+#ifdef UG_PARALLEL
+// 	process index
+	if(pcl::NumProcs() > 1)
+		AppendCounterToString(nameOut, "_p", rank, pcl::NumProcs() - 1);
+#endif
+
+// 	grid or time index
+	AppendCounterToString(nameOut, indicator, counter);
+
+// 	add file extension
+	nameOut.append(".bin");
+}
+
 template <int TDim>
 void VTKOutput<TDim>::
 write_subset_pvd(int numSubset, const std::string& filename, int step, number time)
@@ -405,6 +524,279 @@ write_subset_pvd(int numSubset, const std::string& filename, int step, number ti
 	#endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// XDMF time series
+////////////////////////////////////////////////////////////////////////////////
+
+///	returns the value of an attribute of a xml tag (or "" if not present)
+static std::string XMLAttribute(const std::string& tag, const char* attr)
+{
+	const std::string key = std::string(" ") + attr + "=\"";
+	const size_t begin = tag.find(key);
+	if(begin == std::string::npos) return "";
+	const size_t valBegin = begin + key.size();
+	return tag.substr(valBegin, tag.find('"', valBegin) - valBegin);
+}
+
+///	returns the xdmf cell type for a vtk cell type (0 if not supported)
+static int XDMFCellType(int vtkType)
+{
+	switch(vtkType)
+	{
+		case 1: return 1;	// vertex -> polyvertex
+		case 3: return 2;	// line -> polyline
+		case 5: return 4;	// triangle
+		case 9: return 5;	// quadrilateral
+		case 10: return 6;	// tetrahedron
+		case 14: return 7;	// pyramid
+		case 13: return 8;	// prism -> wedge
+		case 12: return 9;	// hexahedron
+		default: return 0;
+	}
+}
+
+///	returns the buffered data array with the given section and name
+static const VTKFileWriter::DataArray*
+FindDataArray(const VTKFileWriter& File, const char* section, const char* name)
+{
+	const std::vector<VTKFileWriter::DataArray>& vArr = File.data_arrays();
+	for(size_t i = 0; i < vArr.size(); ++i)
+		if(vArr[i].section == section && XMLAttribute(vArr[i].tag, "Name") == name)
+			return &vArr[i];
+	return NULL;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+write_xdmf_mesh(const char* filename, const VTKFileWriter& File)
+{
+	PROFILE_FUNC();
+
+	int rank = 0, numProcs = 1;
+#ifdef UG_PARALLEL
+	rank = pcl::ProcRank();
+	numProcs = pcl::NumProcs();
+#endif
+
+//	get the buffered grid
+	const VTKFileWriter::DataArray* pPoints = FindDataArray(File, "Points", "");
+	const VTKFileWriter::DataArray* pConn = FindDataArray(File, "Cells", "connectivity");
+	const VTKFileWriter::DataArray* pOffset = FindDataArray(File, "Cells", "offsets");
+	const VTKFileWriter::DataArray* pType = FindDataArray(File, "Cells", "types");
+	if(!pPoints || !pConn || !pOffset || !pType)
+		UG_THROW("VTK::write_xdmf_mesh: Grid not found in buffered output.");
+
+	const int numVert = (int)(pPoints->size / (3*sizeof(float)));
+	const int numElem = (int)pType->size;
+
+	std::vector<int> vConn(pConn->size / sizeof(int)), vOffset(numElem);
+	if(!vConn.empty()) memcpy(&vConn[0], pConn->data, pConn->size);
+	if(!vOffset.empty()) memcpy(&vOffset[0], pOffset->data, pOffset->size);
+
+//	convert the cells to a xdmf mixed topology: the xdmf cell type followed by
+//	the number of corners for poly cells and by the corners
+	std::vector<int> vTopo;
+	vTopo.reserve(vConn.size() + 2*numElem);
+	int begin = 0;
+	for(int c = 0; c < numElem; ++c)
+	{
+		const int type = XDMFCellType(pType->data[c]);
+		if(type == 0)
+			UG_THROW("VTK::write_xdmf_mesh: Cell type "<<(int)pType->data[c]<<
+					" not supported by xdmf output.");
+
+		const int end = vOffset[c];
+		vTopo.push_back(type);
+		if(type == 1 || type == 2) vTopo.push_back(end - begin);
+		vTopo.insert(vTopo.end(), vConn.begin() + begin, vConn.begin() + end);
+		begin = end;
+	}
+
+//	write points and topology
+	XDMFSeries& series = m_mXDMF[filename];
+	std::string name;
+	xdmf_filename(name, filename, rank, "_mesh", (int)series.vMesh.size());
+
+	std::ofstream out(name.c_str(), std::ios_base::out | std::ios_base::binary);
+	if(!out.is_open())
+		UG_THROW("VTK::write_xdmf_mesh: Could not open output file: " << name);
+	out.write(pPoints->data, pPoints->size);
+	if(!vTopo.empty())
+		out.write(reinterpret_cast<const char*>(&vTopo[0]), vTopo.size() * sizeof(int));
+	out.close();
+	if(out.fail())
+		UG_THROW("VTK::write_xdmf_mesh: Could not write file: " << name);
+
+//	collect the sizes of the pieces of all processes
+	int vLocal[3] = {numVert, numElem, (int)vTopo.size()};
+	std::vector<int> vAll(3*numProcs);
+#ifdef UG_PARALLEL
+	pcl::ProcessCommunicator().allgather(vLocal, 3, PCL_DT_INT, &vAll[0], 3, PCL_DT_INT);
+#else
+	std::copy(vLocal, vLocal + 3, vAll.begin());
+#endif
+
+	XDMFMesh mesh;
+	for(int p = 0; p < numProcs; ++p){
+		mesh.vNumVert.push_back(vAll[3*p]);
+		mesh.vNumElem.push_back(vAll[3*p+1]);
+		mesh.vTopoSize.push_back(vAll[3*p+2]);
+	}
+	series.vMesh.push_back(mesh);
+	series.numVert = numVert;
+	series.numElem = numElem;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+write_xdmf_data(const char* filename, int step, number time, const VTKFileWriter& File)
+{
+	PROFILE_FUNC();
+
+	int rank = 0;
+#ifdef UG_PARALLEL
+	rank = pcl::ProcRank();
+#endif
+
+	XDMFSeries& series = m_mXDMF[filename];
+	if((int)series.vStep.size() <= step) series.vStep.resize(step+1);
+	XDMFStep& xdmfStep = series.vStep[step];
+	xdmfStep.time = time;
+	xdmfStep.mesh = (int)series.vMesh.size() - 1;
+	xdmfStep.vArray.clear();
+
+//	write all data arrays one after another
+	std::string name;
+	xdmf_filename(name, filename, rank, "_t", step);
+
+	std::ofstream out(name.c_str(), std::ios_base::out | std::ios_base::binary);
+	if(!out.is_open())
+		UG_THROW("VTK::write_xdmf_data: Could not open output file: " << name);
+
+	const std::vector<VTKFileWriter::DataArray>& vArr = File.data_arrays();
+	for(size_t i = 0; i < vArr.size(); ++i)
+	{
+		XDMFArray arr;
+		arr.name = XMLAttribute(vArr[i].tag, "Name");
+		arr.center = (vArr[i].section == "PointData") ? "Node" : "Cell";
+		arr.numCmp = 1;
+		const std::string numCmp = XMLAttribute(vArr[i].tag, "NumberOfComponents");
+		if(!numCmp.empty()) arr.numCmp = atoi(numCmp.c_str());
+
+		const std::string type = XMLAttribute(vArr[i].tag, "type");
+		if(type == "Float32") {arr.numberType = "Float"; arr.precision = 4;}
+		else if(type == "Float64") {arr.numberType = "Float"; arr.precision = 8;}
+		else if(type == "Int32") {arr.numberType = "Int"; arr.precision = 4;}
+		else if(type == "Int8") {arr.numberType = "Char"; arr.precision = 1;}
+		else if(type == "UInt8") {arr.numberType = "UChar"; arr.precision = 1;}
+		else UG_THROW("VTK::write_xdmf_data: Type '"<<type<<"' not supported.");
+
+		xdmfStep.vArray.push_back(arr);
+		out.write(vArr[i].data, vArr[i].size);
+	}
+
+	out.close();
+	if(out.fail())
+		UG_THROW("VTK::write_xdmf_data: Could not write file: " << name);
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+write_xdmf(const char* filename)
+{
+	if(!GetLogAssistant().is_output_process()) return;
+
+	const XDMFSeries& series = m_mXDMF[filename];
+	const char* endian = IsLittleEndian() ? "Little" : "Big";
+
+//	change locale to ensure decimal . is really a .
+	char* oldLocale = setlocale (LC_ALL, NULL);
+	setlocale(LC_NUMERIC, "C");
+
+	std::string name;
+	baseName(name, filename);
+	name.append(".xmf");
+
+	FILE* file = fopen(name.c_str(), "w");
+	if (file == NULL)
+		UG_THROW("VTKOutput: Cannot print to file.");
+
+	fprintf(file, "<?xml version=\"1.0\"?>\n");
+	write_comment_printf(file);
+	fprintf(file, "<Xdmf Version=\"2.0\">\n");
+	fprintf(file, "  <Domain>\n");
+	fprintf(file, "    <Grid Name=\"TimeSeries\" GridType=\"Collection\" CollectionType=\"Temporal\">\n");
+
+	for(size_t step = 0; step < series.vStep.size(); ++step)
+	{
+		const XDMFStep& xdmfStep = series.vStep[step];
+		if(xdmfStep.mesh < 0) continue;
+		const XDMFMesh& mesh = series.vMesh[xdmfStep.mesh];
+
+		fprintf(file, "      <Grid Name=\"t%d\" GridType=\"Collection\" CollectionType=\"Spatial\">\n", (int)step);
+		fprintf(file, "        <Time Value=\"%.17g\"/>\n", xdmfStep.time);
+
+	//	one grid for the piece of every process
+		for(size_t p = 0; p < mesh.vNumVert.size(); ++p)
+		{
+			const int numVert = mesh.vNumVert[p];
+			const int numElem = mesh.vNumElem[p];
+			if(numVert == 0) continue;
+
+			std::string meshName, dataName;
+			xdmf_filename(meshName, filename, (int)p, "_mesh", xdmfStep.mesh);
+			xdmf_filename(dataName, filename, (int)p, "_t", (int)step);
+			meshName = FilenameWithoutPath(meshName);
+			dataName = FilenameWithoutPath(dataName);
+
+			fprintf(file, "        <Grid Name=\"p%d\" GridType=\"Uniform\">\n", (int)p);
+			fprintf(file, "          <Topology TopologyType=\"Mixed\" NumberOfElements=\"%d\">\n", numElem);
+			fprintf(file, "            <DataItem Dimensions=\"%d\" NumberType=\"Int\" Precision=\"4\" "
+					"Format=\"Binary\" Endian=\"%s\" Seek=\"%lu\">%s</DataItem>\n",
+					mesh.vTopoSize[p], endian, (unsigned long)(3*sizeof(float)*numVert), meshName.c_str());
+			fprintf(file, "          </Topology>\n");
+			fprintf(file, "          <Geometry GeometryType=\"XYZ\">\n");
+			fprintf(file, "            <DataItem Dimensions=\"%d 3\" NumberType=\"Float\" Precision=\"4\" "
+					"Format=\"Binary\" Endian=\"%s\">%s</DataItem>\n",
+					numVert, endian, meshName.c_str());
+			fprintf(file, "          </Geometry>\n");
+
+		//	the data arrays are stored one after another
+			unsigned long seek = 0;
+			for(size_t i = 0; i < xdmfStep.vArray.size(); ++i)
+			{
+				const XDMFArray& arr = xdmfStep.vArray[i];
+				const int n = (arr.center == "Node") ? numVert : numElem;
+				const char* attrType = "Matrix";
+				if(arr.numCmp == 1) attrType = "Scalar";
+				else if(arr.numCmp == 3) attrType = "Vector";
+				else if(arr.numCmp == 9) attrType = "Tensor";
+
+				fprintf(file, "          <Attribute Name=\"%s\" AttributeType=\"%s\" Center=\"%s\">\n",
+						arr.name.c_str(), attrType, arr.center.c_str());
+				fprintf(file, "            <DataItem Dimensions=\"%d %d\" NumberType=\"%s\" Precision=\"%d\" "
+						"Format=\"Binary\" Endian=\"%s\" Seek=\"%lu\">%s</DataItem>\n",
+						n, arr.numCmp, arr.numberType.c_str(), arr.precision, endian, seek, dataName.c_str());
+				fprintf(file, "          </Attribute>\n");
+
+				seek += (unsigned long)n * arr.numCmp * arr.precision;
+			}
+
+			fprintf(file, "        </Grid>\n");
+		}
+
+		fprintf(file, "      </Grid>\n");
+	}
+
+	fprintf(file, "    </Grid>\n");
+	fprintf(file, "  </Domain>\n");
+	fprintf(file, "</Xdmf>\n");
+	fclose(file);
+
+// restore old locale
+	setlocale(LC_NUMERIC, oldLocale);
+}
+
 template <int TDim>
 void VTKOutput<TDim>::
 select(const std::vector<std::string>& vFct, const char* name)
@@ -42,14 +42,13 @@
 
 // other ug modules
 #include "common/util/string_util.h"
-#include "common/util/base64_file_writer.h"
 #include "lib_disc/common/function_group.h"
+#include "lib_disc/common/revision_counter.h"
 #include "lib_disc/domain.h"
 #include "lib_disc/spatial_disc/user_data/user_data.h"
+#include "vtk_file_writer.h"
 
 namespace ug{
-// todo this should avoid refactoring all the signatures of VTKOutput, remove it later
-typedef Base64FileWriter VTKFileWriter;
 
 template <typename T>
 struct IteratorProvider
@@ -140,6 +139,12 @@ struct IteratorProvider<MGSubsetHandler>
  * with only one process), the *.pvtu are not written and the *.vtu file
  * contains all information.
  *
+ * 3)) TIME SERIES IN XDMF FORMAT (see set_xdmf_time_series)
+ * In case that all functions are defined globally
+ * - filename_p0000_mesh0000.bin	(grid for proc, written once per grid revision)
+ * - filename_p0000_t0000.bin		(data for proc, timestep)
+ * - filename.xmf					(group of timeseries, by write_time_pvd)
+ *
  * ATTENTION: This class uses heavily the mark-function of the grid.
  * 			  Do not use any member function while having called begin_mark()
  *
@@ -700,6 +705,38 @@ protected:
 								  Grid& grid, TFunction& u, number time,
 								  const SubsetGroup& ssGrp, const int dim);
 
+	/**
+	 * This method writes the opening tag of a piece together with its points
+	 * and cells. In the appended modes, this part is recorded and reused for
+	 * later outputs of the same subsets, if the grid is unchanged.
+	 *
+	 * \param[in,out]	File		file to write the points
+	 * \param[in]		u			discrete function
+	 * \param[in]		ssGrp		subsets
+	 * \param[in]		dim			dimension of subset
+	 * \param[out]		numVert		number of vertices of the piece
+	 * \param[out]		numElem		number of elements of the piece
+	 */
+		template <typename TFunction>
+		void
+		write_piece_grid(VTKFileWriter& File,
+		                 Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
+		                 Grid& grid, TFunction& u,
+		                 const SubsetGroup& ssGrp, const int dim,
+		                 int& numVert, int& numElem);
+
+	///	selects all components of the function if 'selectAll' is chosen
+		template <typename TFunction>
+		void select_all_functions(TFunction& u);
+
+	///	writes the grid (if changed) and the data of a time step of a xdmf time series
+		template <typename TFunction>
+		void print_xdmf_step(const char* filename, TFunction& u, int step, number time);
+
+	///	returns a checksum of all vertex positions of a domain
+		template <typename TDomain>
+		static size_t position_checksum(TDomain& dom);
+
 	///////////////////////////////////////////////////////////////////////////
 	// nodal data
 
@@ -855,6 +892,26 @@ protected:
 		static void write_subset_pvd(int numSubset, const std::string&  filename,
 		                             int step = -1, number time = 0.0);
 
+	///	writes the grid file of a xdmf time series from a buffered grid piece
+		void write_xdmf_mesh(const char* filename, const VTKFileWriter& File);
+
+	///	writes the data file of a xdmf time series from a buffered data piece
+		void write_xdmf_data(const char* filename, int step, number time,
+		                     const VTKFileWriter& File);
+
+	///	writes the grouping *.xmf file of a xdmf time series
+		void write_xdmf(const char* filename);
+
+	///	creates the needed file name of the binary data of a xdmf time series
+		static void xdmf_filename(std::string& nameOut, std::string nameIn,
+		                          int rank, const char* indicator, int counter);
+
+	///	returns the rank naming the vtu file of this process (creates the io group)
+		int vtu_file_rank();
+
+	///	returns the ranks naming the vtu files of all processes
+		void vtu_file_ranks(std::vector<int>& vRank) const;
+
 	///	creates the needed vtu file name
 		static void vtu_filename(std::string& nameOut, std::string nameIn,
 		                         int rank, int si, int maxSi, int step);
@@ -872,7 +929,8 @@ protected:
 
 	public:
 	///	default constructor
-		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false) {} //TODO: maybe true?
+		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false),
+					  m_dataMode(VTKFileWriter::INLINE_BASE64), m_ioGroupSize(1), m_bCacheGrid(true), m_bXDMF(false) {} //TODO: maybe true?
 
 	/// should values be printed in binary (base64 encoded way ) or plain ascii
 		void set_binary(bool b) {m_bBinary = b;};
@@ -883,6 +941,44 @@ protected:
 
 		void set_write_proc_ranks(bool b) {m_bWriteProcRanks = b;};
 
+	///	should binary data be appended raw to the file instead of inline base64
+	/**
+	 * Appended raw data is about 25% smaller than base64 and needs no encoding.
+	 * Switching this off also resets the io group size to 1.
+	 */
+		void set_appended(bool b);
+
+	///	should appended binary data be compressed by zlib (implies appended)
+		void set_compressed(bool b);
+
+	///	sets the number of processes writing their pieces into one common file
+	/**
+	 * 1 (default) writes one file per process, 0 one file per shared-memory
+	 * node and n > 1 one file for each n consecutive processes. Files of
+	 * groups are written by MPI-IO and require appended data, which is enabled
+	 * if necessary. Without UG_PARALLEL this option has no effect.
+	 */
+		void set_io_group_size(int n);
+
+	///	should time series be written in the xdmf format
+	/**
+	 * If enabled, print() with a time step writes the grid only once per grid
+	 * revision into a raw binary file per process and for every time step only
+	 * the data. write_time_pvd() then writes the grouping *.xmf file (XDMF 2,
+	 * readable e.g. by ParaView) instead of the *.pvd file. Stationary output
+	 * and functions not defined everywhere are still written as *.vtu files.
+	 * Binary output is required.
+	 */
+		void set_xdmf_time_series(bool b) {m_bXDMF = b; m_mXDMF.clear();}
+
+	///	should the grid of a piece be reused if unchanged (appended modes only)
+	/**
+	 * If enabled, points and cells of a piece are encoded only once and reused
+	 * for later outputs, as long as the revision of the approximation space,
+	 * the dof distribution and the vertex positions are unchanged.
+	 */
+		void set_cache_grid(bool b) {m_bCacheGrid = b; if(!b) m_mGridCache.clear();}
+
 	protected:
 	///	returns true if name for vtk-component is already used
 		bool vtk_name_used(const char* name) const;
@@ -950,6 +1046,63 @@ protected:
 
 		bool m_bWriteSubsetIndices;
 		bool m_bWriteProcRanks;
+
+	///	storage of binary data
+		VTKFileWriter::DataMode m_dataMode;
+
+	///	number of processes writing one file (0: all processes of a node)
+		int m_ioGroupSize;
+#ifdef UG_PARALLEL
+		SmartPtr<VTKFileGroup> m_spFileGroup;
+#endif
+
+	///	cached grid (points and cells) of a piece
+		struct GridCache
+		{
+			RevisionCounter revision;
+			size_t posChecksum;
+			int numVert, numElem;
+			VTKFileWriter::Record record;
+		};
+		bool m_bCacheGrid;
+		std::map<std::string, GridCache> m_mGridCache;
+
+	///	data array of a time step of a xdmf time series
+		struct XDMFArray
+		{
+			std::string name;
+			std::string center;
+			std::string numberType;
+			int precision;
+			int numCmp;
+		};
+
+	///	grid of a xdmf time series with the sizes of the pieces of all processes
+		struct XDMFMesh
+		{
+			std::vector<int> vNumVert, vNumElem, vTopoSize;
+		};
+
+	///	time step of a xdmf time series
+		struct XDMFStep
+		{
+			XDMFStep() : time(0.0), mesh(-1) {}
+			number time;
+			int mesh;
+			std::vector<XDMFArray> vArray;
+		};
+
+	///	xdmf time series
+		struct XDMFSeries
+		{
+			RevisionCounter revision;
+			size_t posChecksum;
+			int numVert, numElem;
+			std::vector<XDMFMesh> vMesh;
+			std::vector<XDMFStep> vStep;
+		};
+		bool m_bXDMF;
+		std::map<std::string, XDMFSeries> m_mXDMF;
 };
 
 } // namespace ug
@@ -36,6 +36,8 @@
 #include <cstring>
 #include <string>
 #include <algorithm>
+#include <sstream>
+#include <stdint.h>
 
 // ug4 libraries
 #include "common/log.h"
@@ -204,6 +206,16 @@ print(const char* filename, TFunction& u, int step, number time, bool makeConsis
 //	later using a *.pvd file.
 	if(bEverywhere)
 	{
+	//	write time step of a xdmf time series, grid only if changed
+		if(m_bXDMF && step >= 0)
+		{
+			try{
+				print_xdmf_step(filename, u, step, time);
+			}
+			UG_CATCH_THROW("VTK::print: Failed to write xdmf time step.");
+			return;
+		}
+
 	//	write whole grid to a single file
 		try
 		{
@@ -266,11 +278,8 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	grid.attach_to_vertices(aVrtIndex);
 	aaVrtIndex.access(grid, aVrtIndex);
 
-//	get rank of process
-	int rank = 0;
-#ifdef UG_PARALLEL
-	rank = pcl::ProcRank();
-#endif
+//	get rank naming the file of this process
+	int rank = vtu_file_rank();
 
 //	get name for *.vtu file
 	std::string name;
@@ -283,7 +292,11 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 //	open the file
 	try
 	{
-		VTKFileWriter File(name.c_str());
+#ifdef UG_PARALLEL
+		VTKFileWriter File(name.c_str(), m_dataMode, m_spFileGroup);
+#else
+		VTKFileWriter File(name.c_str(), m_dataMode);
+#endif
 
 	//	bool if time point should be written to *.vtu file
 	//	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -301,7 +314,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 		File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 		if(IsLittleEndian()) File << "LittleEndian";
 		else File << "BigEndian";
-		File << "\">\n";
+		File << "\"" << File.header_attributes() << ">\n";
 
 	//	writing time point
 		if(bTimeDep)
@@ -311,6 +324,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 
 	//	opening the grid
 		File << "  <UnstructuredGrid>\n";
+		File.begin_pieces();
 
 	// 	get dimension of grid-piece
 		int dim = DimensionOfSubset(*u.domain()->subset_handler(), si);
@@ -337,8 +351,11 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 
 	//	write closing xml tags
 		File << VTKFileWriter::normal;
+		File.end_pieces();
 		File << "  </UnstructuredGrid>\n";
+		File.write_appended_data();
 		File << "</VTKFile>\n";
+		File.close();
 
 	// 	detach help indices
 		grid.detach_from_vertices(aVrtIndex);
@@ -399,11 +416,8 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 	grid.attach_to_vertices(aVrtIndex);
 	aaVrtIndex.access(grid, aVrtIndex);
 
-//	get rank of process
-	int rank = 0;
-#ifdef UG_PARALLEL
-	rank = pcl::ProcRank();
-#endif
+//	get rank naming the file of this process
+	int rank = vtu_file_rank();
 
 //	get name for *.vtu file
 	std::string name;
@@ -416,7 +430,11 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 //	open the file
 	try
 	{
-		VTKFileWriter File(name.c_str());
+#ifdef UG_PARALLEL
+		VTKFileWriter File(name.c_str(), m_dataMode, m_spFileGroup);
+#else
+		VTKFileWriter File(name.c_str(), m_dataMode);
+#endif
 
 	//	bool if time point should be written to *.vtu file
 	//	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -434,7 +452,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 		File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 		if(IsLittleEndian()) File << "LittleEndian";
 		else File << "BigEndian";
-		File << "\">\n";
+		File << "\"" << File.header_attributes() << ">\n";
 
 	//	writing time point
 		if(bTimeDep)
@@ -444,6 +462,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 
 	//	opening the grid
 		File << "  <UnstructuredGrid>\n";
+		File.begin_pieces();
 
 	// 	get dimension of grid-piece: the highest dimension of the specified subsets
 		int dim = -1;
@@ -470,8 +489,11 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 
 	//	write closing xml tags
 		File << VTKFileWriter::normal;
+		File.end_pieces();
 		File << "  </UnstructuredGrid>\n";
+		File.write_appended_data();
 		File << "</VTKFile>\n";
+		File.close();
 
 	// 	detach help indices
 		grid.detach_from_vertices(aVrtIndex);
@@ -602,8 +624,79 @@ write_grid_solution_piece(VTKFileWriter& File,
                           Grid& grid, TFunction& u, number time,
                           const SubsetGroup& ssGrp, const int dim)
 {
+//	write the beginning of the piece and the grid
+	int numVert = 0, numElem = 0;
+	write_piece_grid(File, aaVrtIndex, grid, u, ssGrp, dim, numVert, numElem);
+
+//	add all components if 'selectAll' chosen
+	select_all_functions(u);
+
+//	write nodal data
+	write_nodal_values_piece(File, u, time, grid, ssGrp, dim, numVert);
+
+//	write cell data
+	write_cell_values_piece(File, u, time, grid, ssGrp, dim, numElem);
+
+//	write closing tag
+	File << VTKFileWriter::normal;
+	File << "    </Piece>\n";
+}
+
+template <int TDim>
+template <typename TFunction>
+void VTKOutput<TDim>::
+select_all_functions(TFunction& u)
+{
+	if(!m_bSelectAll) return;
+
+	for(size_t fct = 0; fct < u.num_fct(); ++fct){
+		if(!vtk_name_used(u.name(fct).c_str())){
+			if(LocalFiniteElementProvider::continuous(u.local_finite_element_id(fct))){
+				select_nodal(u.name(fct).c_str(), u.name(fct).c_str());
+			}else{
+				select_element(u.name(fct).c_str(), u.name(fct).c_str());
+			}
+		}
+	}
+}
+
+template <int TDim>
+template <typename TFunction>
+void VTKOutput<TDim>::
+write_piece_grid(VTKFileWriter& File,
+                 Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
+                 Grid& grid, TFunction& u, const SubsetGroup& ssGrp, const int dim,
+                 int& numVert, int& numElem)
+{
+//	look for a cached version of the grid of this piece
+	GridCache* pCache = NULL;
+	size_t posChecksum = 0;
+	if(m_bCacheGrid && File.appended())
+	{
+		std::stringstream key;
+		key << u.dd().get() << ':' << dim << ':' << m_bWriteGrid << ':' << m_bBinary;
+		for(size_t i = 0; i < ssGrp.size(); ++i) key << ':' << ssGrp[i];
+
+		pCache = &m_mGridCache[key.str()];
+		posChecksum = position_checksum(*u.domain());
+
+		if(!pCache->record.empty()
+			&& pCache->revision == u.approx_space()->revision()
+			&& pCache->posChecksum == posChecksum)
+		{
+			File.replay(pCache->record);
+			numVert = pCache->numVert;
+			numElem = pCache->numElem;
+			return;
+		}
+
+		File << VTKFileWriter::normal;
+		File.begin_record();
+	}
+
 //	counters
-	int numVert = 0, numElem = 0, numConn = 0;
+	int numConn = 0;
+	numVert = 0; numElem = 0;
 
 // 	Count needed sizes for vertices, elements and connections
 	try{
@@ -621,28 +714,127 @@ write_grid_solution_piece(VTKFileWriter& File,
 	write_points_cells_piece<TFunction>
 	(File, aaVrtIndex, u.domain()->position_accessor(), grid, u, ssGrp, dim, numVert, numElem, numConn);
 
-//	add all components if 'selectAll' chosen
-	if(m_bSelectAll){
-		for(size_t fct = 0; fct < u.num_fct(); ++fct){
-			if(!vtk_name_used(u.name(fct).c_str())){
-				if(LocalFiniteElementProvider::continuous(u.local_finite_element_id(fct))){
-					select_nodal(u.name(fct).c_str(), u.name(fct).c_str());
-				}else{
-					select_element(u.name(fct).c_str(), u.name(fct).c_str());
-				}
-			}
+//	remember the grid of this piece
+	if(pCache)
+	{
+		File << VTKFileWriter::normal;
+		File.end_record(pCache->record);
+		pCache->revision = u.approx_space()->revision();
+		pCache->posChecksum = posChecksum;
+		pCache->numVert = numVert;
+		pCache->numElem = numElem;
+	}
+}
+
+template <int TDim>
+template <typename TDomain>
+size_t VTKOutput<TDim>::
+position_checksum(TDomain& dom)
+{
+	typedef typename TDomain::position_type position_type;
+	const typename TDomain::position_accessor_type& aaPos = dom.position_accessor();
+	Grid& grid = *dom.grid();
+
+//	hash combine of the bit patterns of all coordinates
+	uint64_t hash = grid.num<Vertex>();
+	for(VertexIterator iter = grid.begin<Vertex>(); iter != grid.end<Vertex>(); ++iter)
+	{
+		const position_type& pos = aaPos[*iter];
+		for(size_t d = 0; d < (size_t) position_type::Size; ++d)
+		{
+			uint64_t bits;
+			const double x = pos[d];
+			memcpy(&bits, &x, sizeof(bits));
+			hash ^= bits + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
 		}
 	}
+	return (size_t) hash;
+}
 
-//	write nodal data
-	write_nodal_values_piece(File, u, time, grid, ssGrp, dim, numVert);
+/**
+ * Writes a time step of a xdmf time series. The grid is written by the usual
+ * vtk methods into a buffer and converted to a binary grid file only if the
+ * approximation space or the vertex positions have changed since the last
+ * step. Otherwise only the point and cell data are evaluated and written.
+ */
+template <int TDim>
+template <typename TFunction>
+void VTKOutput<TDim>::
+print_xdmf_step(const char* filename, TFunction& u, int step, number time)
+{
+	PROFILE_FUNC();
 
-//	write cell data
-	write_cell_values_piece(File, u, time, grid, ssGrp, dim, numElem);
+	if(!m_bBinary || !m_bWriteGrid)
+		UG_THROW("VTK::print_xdmf_step: The xdmf time series requires binary "
+				"output including the grid.");
 
-//	write closing tag
-	File << VTKFileWriter::normal;
-	File << "    </Piece>\n";
+	Grid& grid = *u.domain()->grid();
+	SubsetGroup ssGrp(u.domain()->subset_handler());
+	ssGrp.add_all();
+
+// 	get dimension of grid-piece: the highest dimension of the subsets
+	int dim = -1;
+	for(size_t i = 0; i < ssGrp.size(); i++)
+	{
+		int ssDim = DimensionOfSubset(*u.domain()->subset_handler(), ssGrp[i]);
+		if(dim < ssDim)
+			dim = ssDim;
+	}
+	if(dim < 0)
+		UG_THROW("VTK::print_xdmf_step: Dimension of grid/subset not"
+				" detected correctly although grid objects present.");
+
+//	check if the grid has changed since the last time step (on any process)
+	XDMFSeries& series = m_mXDMF[filename];
+	const size_t posChecksum = position_checksum(*u.domain());
+	bool bNewMesh = series.vMesh.empty()
+					|| series.revision != u.approx_space()->revision()
+					|| series.posChecksum != posChecksum;
+#ifdef UG_PARALLEL
+	bNewMesh = pcl::OneProcTrue(bNewMesh);
+#endif
+
+//	write grid
+	if(bNewMesh)
+	{
+		typedef ug::Attachment<int> AVrtIndex;
+		AVrtIndex aVrtIndex;
+		Grid::VertexAttachmentAccessor<AVrtIndex> aaVrtIndex;
+		grid.attach_to_vertices(aVrtIndex);
+		aaVrtIndex.access(grid, aVrtIndex);
+
+		VTKFileWriter File(filename, VTKFileWriter::BUFFERED_RAW);
+		try{
+			write_grid_piece(File, aaVrtIndex, u.domain()->position_accessor(),
+			                 grid, u, ssGrp, dim);
+		}
+		UG_CATCH_THROW("VTK::print_xdmf_step: Can not write the grid.");
+		File.close();
+
+		grid.detach_from_vertices(aVrtIndex);
+
+		write_xdmf_mesh(filename, File);
+		series.revision = u.approx_space()->revision();
+		series.posChecksum = posChecksum;
+	}
+
+//	add all components if 'selectAll' chosen
+	select_all_functions(u);
+
+//	write data
+	VTKFileWriter File(filename, VTKFileWriter::BUFFERED_RAW);
+	try{
+		write_nodal_values_piece(File, u, time, grid, ssGrp, dim, series.numVert);
+		write_cell_values_piece(File, u, time, grid, ssGrp, dim, series.numElem);
+	}
+	UG_CATCH_THROW("VTK::print_xdmf_step: Can not write the data.");
+	File.close();
+
+	write_xdmf_data(filename, step, time, File);
+
+	#ifdef UG_PARALLEL
+		PCL_DEBUG_BARRIER_ALL();
+	#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -822,7 +1014,7 @@ write_points(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(m_bBinary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 	int n = 3*sizeof(float) * numVert;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1016,7 +1208,7 @@ write_cell_connectivity(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that connections will be written
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 	int n = sizeof(int) * numConn;
 
 	if(m_bBinary)
@@ -1119,7 +1311,7 @@ write_cell_offsets(VTKFileWriter& File, const T& iterContainer, const SubsetGrou
 	File << VTKFileWriter::normal;
 //	write opening tag indicating that offsets are going to be written
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 	int n = sizeof(int) * numElem;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1234,7 +1426,7 @@ write_cell_types(VTKFileWriter& File, const T& iterContainer, const SubsetGroup&
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1316,7 +1508,7 @@ write_cell_subsets(VTKFileWriter& File, const T& iterContainer, const SubsetGrou
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"regions\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1399,7 +1591,7 @@ write_cell_proc_ranks(VTKFileWriter& File, const T& iterContainer, const SubsetG
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"proc_ranks\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1550,7 +1742,7 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numVert * numCmp;
 	if(m_bBinary)
@@ -1667,7 +1859,7 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 //	write opening tag
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numVert * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -1936,7 +2128,7 @@ write_cell_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numElem * numCmp;
 	if(m_bBinary)
@@ -2074,7 +2266,7 @@ write_cell_values(VTKFileWriter& File, TFunction& u,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.data_format(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numElem * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -2443,9 +2635,11 @@ write_pvtu(TFunction& u, const std::string& filename,
 			fprintf(file, "    </PCellData>\n");
 		}
 
-	// 	include files from all procs
-		for (int i = 0; i < numProcs; i++) {
-			vtu_filename(name, filename, i, si, maxSi, step);
+	// 	include files from all procs (or process groups)
+		std::vector<int> vFileRank;
+		vtu_file_ranks(vFileRank);
+		for (size_t i = 0; i < vFileRank.size(); i++) {
+			vtu_filename(name, filename, vFileRank[i], si, maxSi, step);
 			name = FilenameWithoutPath(name);
 			fprintf(file, "    <Piece Source=\"%s\"/>\n", name.c_str());
 		}
@@ -2466,6 +2660,13 @@ template <typename TFunction>
 void VTKOutput<TDim>::
 write_time_pvd(const char* filename, TFunction& u)
 {
+//	time series in xdmf format are grouped by a *.xmf file
+	if(m_bXDMF && m_mXDMF.find(filename) != m_mXDMF.end())
+	{
+		write_xdmf(filename);
+		return;
+	}
+
 //	File
 	FILE* file;
 
@@ -104,7 +104,8 @@ void
 AssembledLinearOperator<TAlgebra>::apply(vector_type& d, const vector_type& c)
 {
 #ifdef UG_PARALLEL
-	if(!c.has_storage_type(PST_CONSISTENT))
+//	additive vectors are made consistent by the matrix while multiplying
+	if(!c.has_storage_type(PST_CONSISTENT) && !c.has_storage_type(PST_ADDITIVE))
 		UG_THROW("Inadequate storage format of Vector c.");
 #endif
 
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_JACOBIAN_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_JACOBIAN_OPERATOR__
+
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_disc/spatial_disc/domain_disc.h"
+
+namespace ug{
+
+///	Jacobian operator applied element by element without assembling the matrix
+/**
+ * This operator computes d = J(u)*c by calling the element discretizations of
+ * a DomainDiscretization for every application, i.e. the global Jacobian is
+ * never assembled. The operator is not a matrix. Only the (block) diagonal of
+ * J(u) is assembled on init and returned by diagonal(), so that preconditioners
+ * using nothing but the diagonal (e.g. Jacobi) can be used. A geometric
+ * multigrid retrieves the discretization, assembles only its level operators
+ * and applies this operator for the surface defect. The surface matrix is
+ * assembled (see assemble_jacobian) only if RAP or the coarse grid couplings
+ * of an adaptive grid need it. Other matrix based preconditioners reject the
+ * operator.
+ *
+ * Only Dirichlet constraints are supported.
+ *
+ * \tparam	TDomain				domain type
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TDomain, typename TAlgebra>
+class MatrixFreeJacobianOperator
+	: public IMatrixFreeLinearOperator<typename TAlgebra::matrix_type,
+	                                   typename TAlgebra::vector_type>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Type of the diagonal matrix operator
+		typedef MatrixOperator<matrix_type, vector_type> matrix_operator_type;
+
+	///	Type of domain discretization
+		typedef DomainDiscretization<TDomain, TAlgebra> domain_disc_type;
+
+	public:
+	///	Constructor
+		MatrixFreeJacobianOperator(SmartPtr<domain_disc_type> spDomDisc)
+			: m_spDomDisc(spDomDisc) {};
+
+	///	Constructor
+		MatrixFreeJacobianOperator(SmartPtr<domain_disc_type> spDomDisc, const GridLevel& gl)
+			: m_spDomDisc(spDomDisc), m_gridLevel(gl) {};
+
+	///	returns the domain discretization
+		SmartPtr<domain_disc_type> discretization() {return m_spDomDisc;}
+
+	///	sets the level used for assembling
+		void set_level(const GridLevel& gl) {m_gridLevel = gl;}
+
+	///	returns the level
+		const GridLevel& level() const {return m_gridLevel;}
+
+	///	stores the linearization point u and assembles the diagonal of J(u)
+		virtual void init(const vector_type& u);
+
+	///	initializes the operator for a linear problem (linearized at u = 0)
+		virtual void init();
+
+	///	compute d = J(u)*c element by element
+		virtual void apply(vector_type& d, const vector_type& c);
+
+	///	compute d := d - J(u)*c element by element
+		virtual void apply_sub(vector_type& d, const vector_type& c);
+
+	///	c must be passed consistent, the elements are applied to it directly
+		virtual bool accepts_additive_input() const {return false;}
+
+	///	returns the (block) diagonal of J(u) (valid after init)
+		virtual SmartPtr<matrix_operator_type> diagonal() {return m_spDiag;}
+
+	///	returns the linearization point (valid after init)
+		ConstSmartPtr<vector_type> linearization_point() const {return m_spU;}
+
+	///	assembles the complete matrix J(u) at the linearization point
+	/**
+	 * Needed by solvers that can not work without the matrix (e.g. for the
+	 * coarse grid couplings of the geometric multigrid).
+	 */
+		void assemble_jacobian(matrix_type& J);
+
+	///	Destructor
+		virtual ~MatrixFreeJacobianOperator() {};
+
+	protected:
+	///	domain discretization used for the element-wise application
+		SmartPtr<domain_disc_type> m_spDomDisc;
+
+	///	grid level
+		GridLevel m_gridLevel;
+
+	///	linearization point
+		SmartPtr<vector_type> m_spU;
+
+	///	(block) diagonal of J(u)
+		SmartPtr<matrix_operator_type> m_spDiag;
+};
+
+} // namespace ug
+
+// include implementation
+#include "matrix_free_jacobian_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_JACOBIAN_OPERATOR__ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_JACOBIAN_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_JACOBIAN_OPERATOR_IMPL__
+
+#include "matrix_free_jacobian_operator.h"
+#include "lib_algebra/common/operations_vec.h"
+
+namespace ug{
+
+template <typename TDomain, typename TAlgebra>
+void
+MatrixFreeJacobianOperator<TDomain, TAlgebra>::init(const vector_type& u)
+{
+	if(m_spDomDisc.invalid())
+		UG_THROW("MatrixFreeJacobianOperator: Domain discretization not set.");
+
+//	remember linearization point
+	m_spU = u.clone();
+
+//	assemble diagonal of J(u), used by preconditioners
+	if(m_spDiag.invalid())
+		m_spDiag = make_sp(new matrix_operator_type);
+	try{
+		m_spDomDisc->assemble_jacobian_diagonal(*m_spDiag, u, m_gridLevel);
+	}
+	UG_CATCH_THROW("MatrixFreeJacobianOperator: Cannot assemble diagonal.");
+}
+
+template <typename TDomain, typename TAlgebra>
+void
+MatrixFreeJacobianOperator<TDomain, TAlgebra>::assemble_jacobian(matrix_type& J)
+{
+	if(m_spU.invalid())
+		UG_THROW("MatrixFreeJacobianOperator::assemble_jacobian: Operator not initialized.");
+
+	try{
+		m_spDomDisc->assemble_jacobian(J, *m_spU, m_gridLevel);
+	}
+	UG_CATCH_THROW("MatrixFreeJacobianOperator: Cannot assemble Jacobian.");
+}
+
+template <typename TDomain, typename TAlgebra>
+void
+MatrixFreeJacobianOperator<TDomain, TAlgebra>::init()
+{
+	if(m_spDomDisc.invalid())
+		UG_THROW("MatrixFreeJacobianOperator: Domain discretization not set.");
+
+	ConstSmartPtr<DoFDistribution> dd =
+			m_spDomDisc->approximation_space()->dof_distribution(m_gridLevel);
+
+//	linear problem: linearize at zero
+	vector_type u;
+	u.resize(dd->num_indices());
+	u.set(0.0);
+#ifdef UG_PARALLEL
+	u.set_layouts(dd->layouts());
+	u.set_storage_type(PST_CONSISTENT);
+#endif
+
+	init(u);
+}
+
+template <typename TDomain, typename TAlgebra>
+void
+MatrixFreeJacobianOperator<TDomain, TAlgebra>::apply(vector_type& d, const vector_type& c)
+{
+#ifdef UG_PARALLEL
+	if(!c.has_storage_type(PST_CONSISTENT))
+		UG_THROW("Inadequate storage format of Vector c.");
+#endif
+
+	if(m_spU.invalid())
+		UG_THROW("MatrixFreeJacobianOperator::apply: Operator not initialized.");
+
+//	perform check of sizes
+	if(c.size() != m_spU->size() || d.size() != m_spU->size())
+		UG_THROW("MatrixFreeJacobianOperator::apply: Size of operator ["<<
+		        m_spU->size() << "] must match the sizes of vectors x ["
+		        <<c.size()<<"], b ["<<d.size()<<"] for the operation b = A*x.");
+
+	try{
+		m_spDomDisc->apply_jacobian(d, *m_spU, c, m_gridLevel);
+	}
+	UG_CATCH_THROW("MatrixFreeJacobianOperator::apply: Cannot apply Jacobian.");
+}
+
+template <typename TDomain, typename TAlgebra>
+void
+MatrixFreeJacobianOperator<TDomain, TAlgebra>::apply_sub(vector_type& d, const vector_type& c)
+{
+#ifdef UG_PARALLEL
+	if(!d.has_storage_type(PST_ADDITIVE))
+		UG_THROW("Inadequate storage format of Vector d.");
+#endif
+
+	SmartPtr<vector_type> spJc = d.clone_without_values();
+	apply(*spJc, c);
+	VecScaleAdd(d, 1.0, d, -1.0, *spJc);
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_JACOBIAN_OPERATOR_IMPL__ */
@@ -56,6 +56,7 @@
 // library intern headers
 #include "lib_disc/function_spaces/grid_function_util.h"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/matrix_free_jacobian_operator.h"
 
 #include "mg_stats.h"
 
@@ -313,10 +314,31 @@ class AssembledMultiGridCycle :
 		void assemble_rim_cpl(const vector_type* u);
 		void init_rap_rim_cpl();
 
+	///	extracts the assembling and the surface matrix from the operator
+		void init_surface_operator(SmartPtr<ILinearOperator<vector_type> > L);
+
+	///	assembles the surface matrix of a matrix-free surface operator
+	/**
+	 * Only the RAP operators and the coarse grid couplings of adaptive grids
+	 * need the surface matrix. For a matrix-free surface operator it is
+	 * assembled here on demand, otherwise the operator is applied matrix-free
+	 * and only the level matrices are assembled.
+	 */
+		void assemble_surface_matrix();
+
 	protected:
 	/// operator to invert (surface grid)
+		SmartPtr<ILinearOperator<vector_type> > m_spSurfaceOp;
+
+	/// surface matrix (invalid for matrix-free operators unless needed)
 		ConstSmartPtr<matrix_type> m_spSurfaceMat;
 
+	///	matrix-free surface operator
+		SmartPtr<MatrixFreeJacobianOperator<TDomain, TAlgebra> > m_spMatrixFreeOp;
+
+	///	surface matrix assembled for matrix-free operators
+		SmartPtr<matrix_type> m_spAssembledSurfaceMat;
+
 	///	Solution on surface grid
 		const vector_type* m_pSurfaceSol;
 
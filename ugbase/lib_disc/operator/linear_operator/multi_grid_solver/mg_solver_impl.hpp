@@ -77,7 +77,7 @@ namespace ug{
 template <typename TDomain, typename TAlgebra>
 AssembledMultiGridCycle<TDomain, TAlgebra>::
 AssembledMultiGridCycle() :
-	m_spSurfaceMat(NULL), m_pSurfaceSol(nullptr), m_spAss(NULL), m_spApproxSpace(SPNULL),
+	m_spSurfaceOp(SPNULL), m_spSurfaceMat(NULL), m_pSurfaceSol(nullptr), m_spAss(NULL), m_spApproxSpace(SPNULL),
 	m_topLev(GridLevel::TOP), m_surfaceLev(GridLevel::TOP),
 	m_baseLev(0), m_cycleType(_V_),
 	m_numPreSmooth(2), m_numPostSmooth(2),
@@ -102,7 +102,7 @@ AssembledMultiGridCycle() :
 template <typename TDomain, typename TAlgebra>
 AssembledMultiGridCycle<TDomain, TAlgebra>::
 AssembledMultiGridCycle(SmartPtr<ApproximationSpace<TDomain> > approxSpace) :
-	m_spSurfaceMat(NULL), m_pSurfaceSol(nullptr), m_spAss(NULL), m_spApproxSpace(approxSpace),
+	m_spSurfaceOp(SPNULL), m_spSurfaceMat(NULL), m_pSurfaceSol(nullptr), m_spAss(NULL), m_spApproxSpace(approxSpace),
 	m_topLev(GridLevel::TOP), m_surfaceLev(GridLevel::TOP),
 	m_baseLev(0), m_cycleType(_V_),
 	m_numPreSmooth(2), m_numPostSmooth(2),
@@ -197,7 +197,8 @@ apply(vector_type& rC, const vector_type& rD)
 
 //	debug output
 	write_debug(d, "Defect_In");
-	write_debug(*m_spSurfaceMat, "SurfaceStiffness", c, c);
+	if(m_spSurfaceMat.valid())
+		write_debug(*m_spSurfaceMat, "SurfaceStiffness", c, c);
 	for(int lev = m_baseLev; lev <= m_topLev; ++lev)
 	{
 		LevData& ld = *m_vLevData[lev];
@@ -256,7 +257,7 @@ apply(vector_type& rC, const vector_type& rD)
 //	apply scaling
 	GMG_PROFILE_BEGIN(GMG_Apply_Scaling);
 	try{
-		const number kappa = this->damping()->damping(c, d, m_spSurfaceMat.template cast_dynamic<ILinearOperator<vector_type> >());
+		const number kappa = this->damping()->damping(c, d, m_spSurfaceOp);
 		if(kappa != 1.0) c *= kappa;
 	}
 	UG_CATCH_THROW("GMG: Damping failed.")
@@ -307,8 +308,8 @@ apply_update_defect(vector_type &c, vector_type& rD)
 //	compute correction
 	if(!apply(c, rD)) return false;
 
-//	update defect: d = d - A*c
-	m_spSurfaceMat->matmul_minus(rD, c);
+//	update defect: d = d - A*c (matrix-free for matrix-free operators)
+	m_spSurfaceOp->apply_sub(rD, c);
 
 //	write for debugging
 	const GF* pD = dynamic_cast<const GF*>(&rD);
@@ -326,15 +327,8 @@ init(SmartPtr<ILinearOperator<vector_type> > J, const vector_type& u)
 	GMG_PROFILE_FUNC();
 	UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-start - init(J, u)\n");
 
-	// try to extract assembling routine
-	SmartPtr<AssembledLinearOperator<TAlgebra> > spALO =
-			J.template cast_dynamic<AssembledLinearOperator<TAlgebra> >();
-	if(spALO.valid()){
-		m_spAss = spALO->discretization();
-	}
-
-	// Store Surface Matrix
-	m_spSurfaceMat = J.template cast_dynamic<matrix_type>();
+	// extract assembling routine and surface matrix
+	init_surface_operator(J);
 
 	// Store Surface Solution
 	m_pSurfaceSol = &u;
@@ -353,15 +347,8 @@ init(SmartPtr<ILinearOperator<vector_type> > L)
 	GMG_PROFILE_FUNC();
 	UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-start - init(L)\n");
 
-	// try to extract assembling routine
-	SmartPtr<AssembledLinearOperator<TAlgebra> > spALO =
-			L.template cast_dynamic<AssembledLinearOperator<TAlgebra> >();
-	if(spALO.valid()){
-		m_spAss = spALO->discretization();
-	}
-
-	// Store Surface Matrix
-	m_spSurfaceMat = L.template cast_dynamic<matrix_type>();
+	// extract assembling routine and surface matrix
+	init_surface_operator(L);
 
 	// Store Surface Solution
 	m_pSurfaceSol = NULL;
@@ -375,6 +362,46 @@ init(SmartPtr<ILinearOperator<vector_type> > L)
 
 
 
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+init_surface_operator(SmartPtr<ILinearOperator<vector_type> > L)
+{
+	// try to extract assembling routine
+	SmartPtr<AssembledLinearOperator<TAlgebra> > spALO =
+			L.template cast_dynamic<AssembledLinearOperator<TAlgebra> >();
+	if(spALO.valid()){
+		m_spAss = spALO->discretization();
+	}
+
+	// Store Surface Operator and Matrix
+	m_spSurfaceOp = L;
+	m_spSurfaceMat = L.template cast_dynamic<matrix_type>();
+
+	// matrix-free operator: the surface matrix is not assembled, the level
+	// matrices are assembled by the discretization of the operator
+	m_spMatrixFreeOp =
+			L.template cast_dynamic<MatrixFreeJacobianOperator<TDomain, TAlgebra> >();
+	if(m_spMatrixFreeOp.valid())
+		m_spAss = m_spMatrixFreeOp->discretization();
+}
+
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+assemble_surface_matrix()
+{
+	if(m_spMatrixFreeOp.invalid()) return;
+
+	GMG_PROFILE_BEGIN(GMG_Init_AssembleSurfaceMatrix);
+	if(m_spAssembledSurfaceMat.invalid())
+		m_spAssembledSurfaceMat = make_sp(new matrix_type);
+	try{
+		m_spMatrixFreeOp->assemble_jacobian(*m_spAssembledSurfaceMat);
+	}
+	UG_CATCH_THROW("GMG::init: Cannot assemble surface matrix of matrix-free operator.");
+	m_spSurfaceMat = m_spAssembledSurfaceMat;
+	GMG_PROFILE_END();
+}
+
 template <typename TDomain, typename TAlgebra>
 void AssembledMultiGridCycle<TDomain, TAlgebra>::
 init()
@@ -385,7 +412,7 @@ init()
 	try{
 
 // 	Cast Operator
-	if(m_spSurfaceMat.invalid())
+	if(m_spSurfaceMat.invalid() && m_spMatrixFreeOp.invalid())
 		UG_THROW("GMG:init: Can not cast Operator to Matrix.");
 
 //	Check Approx Space
@@ -464,6 +491,11 @@ init()
 //	Assemble coarse grid operators
 	GMG_PROFILE_BEGIN(GMG_Init_CreateLevelMatrices);
 	try{
+	//	the surface matrix of a matrix-free operator is only needed for RAP and
+	//	for the coarse grid couplings of adaptive grids
+		if(m_bUseRAP || m_topLev > m_LocalFullRefLevel)
+			assemble_surface_matrix();
+
 		if(m_bUseRAP){
 			init_rap_operator();
 		} else {
@@ -603,7 +635,8 @@ assemble_level_operator()
 		#endif
 
 	//	In Full-Ref case we can copy the Matrix from the surface
-		bool bCpyFromSurface = ((lev == m_topLev) && (lev <= m_LocalFullRefLevel));
+		bool bCpyFromSurface = ((lev == m_topLev) && (lev <= m_LocalFullRefLevel)
+								&& m_spSurfaceMat.valid());
 		if(!bCpyFromSurface)
 		{
 			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: assemble on lev "<<lev<<"\n");
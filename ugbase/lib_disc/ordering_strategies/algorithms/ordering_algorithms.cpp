@@ -1,4 +1,5 @@
 #include "lexorder.h"
+#include "space_filling_curve_order.h"
 #include "riverorder.h"
 #include "directional_ordering.cpp"
 
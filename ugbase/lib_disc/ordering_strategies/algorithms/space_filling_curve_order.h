@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#ifndef __H__UG__LIB_DISC__ORDERING_STRATEGIES_ALGORITHMS__SPACE_FILLING_CURVE_ORDER__
+#define __H__UG__LIB_DISC__ORDERING_STRATEGIES_ALGORITHMS__SPACE_FILLING_CURVE_ORDER__
+
+#include <vector>
+#include <string>
+
+#include "lib_disc/domain.h"
+#include "lib_disc/function_spaces/grid_function.h"
+
+#include "lib_algebra/ordering_strategies/algorithms/IOrderingAlgorithm.h"
+#include "lib_algebra/ordering_strategies/algorithms/util.h"
+#include "lib_disc/function_spaces/dof_position_util.h"
+#include "lib_grid/algorithms/space_filling_curve_util.h"
+
+#include "common/error.h"
+
+namespace ug{
+
+///	computes the order of the positions along a space filling curve
+/**	vNewIndex[i] is the new index of the position vPos[i]. Positions with
+ * the same key (e.g. several DoFs on the same geometric object) keep their
+ * relative order.
+ */
+template<int dim>
+void ComputeSpaceFillingCurveOrder(std::vector<size_t>& vNewIndex,
+                                   const std::vector<MathVector<dim> >& vPos,
+                                   SpaceFillingCurveType type = SFC_HILBERT);
+
+/// orders the dof distribution along a space filling curve
+template <typename TDomain>
+void OrderSpaceFillingCurveForDofDist(SmartPtr<DoFDistribution> dd,
+                                      ConstSmartPtr<TDomain> domain,
+                                      SpaceFillingCurveType type = SFC_HILBERT);
+
+/// orders all DofDistributions of the ApproximationSpace along a space filling curve
+/**	type is either "hilbert" or "morton".*/
+template <typename TDomain>
+void OrderSpaceFillingCurve(ApproximationSpace<TDomain>& approxSpace, const char* type);
+
+
+///	orders the indices of a grid function along a space filling curve
+template <typename TAlgebra, typename TDomain, typename O_t>
+class SpaceFillingCurveOrdering : public IOrderingAlgorithm<TAlgebra, O_t>
+{
+public:
+	typedef typename TAlgebra::matrix_type M_t;
+	typedef typename TAlgebra::vector_type V_t;
+	typedef IOrderingAlgorithm<TAlgebra, O_t> baseclass;
+
+	/// Grid function type for the solution
+	typedef GridFunction<TDomain, TAlgebra> GridFunc_t;
+
+	SpaceFillingCurveOrdering() : m_type(SFC_HILBERT) {}
+
+	/// clone constructor
+	SpaceFillingCurveOrdering( const SpaceFillingCurveOrdering<TAlgebra, TDomain, O_t> &parent )
+			: baseclass(), m_type(parent.m_type){}
+
+	SmartPtr<IOrderingAlgorithm<TAlgebra, O_t> > clone()
+	{
+		return make_sp(new SpaceFillingCurveOrdering<TAlgebra, TDomain, O_t>(*this));
+	}
+
+	void compute(){
+		ComputeSpaceFillingCurveOrder<TDomain::dim>(o, m_vPositions, m_type);
+		m_vPositions.clear();
+	}
+
+	void check(){
+		if(!is_permutation(o)){
+			UG_THROW(name() << "::check: Not a permutation!");
+		}
+	}
+
+	O_t& ordering(){
+		return o;
+	}
+
+	void init(M_t* A, const V_t& V){
+		const GridFunc_t* pGridF;
+		if((pGridF = dynamic_cast<const GridFunc_t*>(&V)) == 0){
+			UG_THROW(name() << "::init: No DoFDistribution specified.");
+		}
+
+		SmartPtr<DoFDistribution> dd = ((GridFunc_t*) pGridF)->dof_distribution();
+
+		if(dd->num_indices() != A->num_rows()){
+			UG_THROW(name() << "::init: #indices != #rows");
+		}
+
+		o.resize(dd->num_indices());
+		ExtractPositions(pGridF->domain(), dd, m_vPositions);
+	}
+
+	void init(M_t*){
+		UG_THROW(name() << "::init: Cannot initialize smoother without a geometry. Specify the 2nd argument for init!");
+	}
+
+	void init(M_t*, const V_t&, const O_t&){
+		UG_THROW(name() << "::init: induced subgraph version not implemented yet!");
+	}
+
+	void init(M_t*, const O_t&){
+		UG_THROW(name() << "::init: induced subgraph version not implemented yet!");
+	}
+
+	virtual const char* name() const {return "SpaceFillingCurveOrdering";}
+
+	///	sets the type of the curve, either "hilbert" (default) or "morton"
+	void set_curve(const char* type){
+		m_type = SpaceFillingCurveTypeFromString(type);
+	}
+
+private:
+	O_t o;
+
+	SpaceFillingCurveType m_type;
+	std::vector<MathVector<TDomain::dim> > m_vPositions;
+};
+
+} // end namespace ug
+
+#endif
@@ -221,6 +221,35 @@ QuadratureRuleProvider<TDim>::get_quad_rule(ReferenceObjectID roid,
                                             size_t order,
                                             QuadType type)
 {
+#ifdef UG_OPENMP
+	//	the rules are shared between all threads, but the lookup is done in a
+	//	per-thread cache, such that the common storage is only accessed
+	//	(in a critical section) when a rule is requested the first time by a thread
+	static thread_local std::vector<const QuadratureRule<TDim>*>
+		vCachedRule[NUM_QUADRATURE_TYPES][NUM_REFERENCE_OBJECTS];
+
+	std::vector<const QuadratureRule<TDim>*>& vCache = vCachedRule[type][roid];
+	if(order < vCache.size() && vCache[order] != NULL)
+		return *vCache[order];
+
+	const QuadratureRule<TDim>* pRule = NULL;
+	UGError failure("");
+	#pragma omp critical (QuadratureRuleProvider_create_rule)
+	{
+		try{
+			if(order >= m_vRule[type][roid].size() ||
+					m_vRule[type][roid][order] == NULL)
+				create_rule(roid, order, type);
+			pRule = m_vRule[type][roid][order];
+		}
+		catch(UGError& err) {failure = err;}
+	}
+	if(pRule == NULL) throw failure;
+
+	if(vCache.size() <= order) vCache.resize(order+1, NULL);
+	vCache[order] = pRule;
+	return *pRule;
+#else
 	//	check if order present, else resize and create
 	if(order >= m_vRule[type][roid].size() ||
 			m_vRule[type][roid][order] == NULL)
@@ -228,6 +257,7 @@ QuadratureRuleProvider<TDim>::get_quad_rule(ReferenceObjectID roid,
 
 	//	return correct order
 	return *m_vRule[type][roid][order];
+#endif
 }
 
 template <int TDim>
@@ -36,6 +36,7 @@
 
 #include "common/common.h"
 #include "common/math/ugmath.h"
+#include "common/util/provider.h"
 #include "lib_grid/grid/grid_base_objects.h"
 
 namespace ug{
@@ -164,6 +165,9 @@ class DimReferenceMapping
 /// class to provide reference mappings
 /**
  *	This class provides references mappings. It is implemented as a Singleton.
+ *	Since the mappings are updated with the corners of an element, one set of
+ *	mappings is provided per thread if ug4 is compiled with thread support
+ *	(see UG_THREAD_LOCAL).
  */
 class ReferenceMappingProvider {
 	private:
@@ -177,10 +181,10 @@ class ReferenceMappingProvider {
 	// 	private destructor
 		~ReferenceMappingProvider(){};
 
-	// 	Singleton provider
+	// 	Singleton provider (one per thread)
 		static ReferenceMappingProvider& inst()
 		{
-			static ReferenceMappingProvider myInst;
+			static UG_THREAD_LOCAL ReferenceMappingProvider myInst;
 			return myInst;
 		};
 
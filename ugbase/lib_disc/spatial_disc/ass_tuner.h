@@ -33,9 +33,13 @@
 #ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ASS_TUNER__
 #define __H__UG__LIB_DISC__SPATIAL_DISC__ASS_TUNER__
 
+#include <map>
+
 #include "lib_grid/tools/bool_marker.h"
 #include "lib_grid/tools/selector_grid.h"
 #include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
+#include "lib_disc/spatial_disc/local_to_global/matrix_pattern_cache.h"
+#include "lib_disc/common/revision_counter.h"
 #include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
 
 namespace ug{
@@ -107,7 +111,11 @@ class AssemblingTuner
 		m_bSingleAssIndex(false), m_SingleAssIndex(0),
 		m_bForceRegGrid(false), m_bModifySolutionImplemented(false),
 		m_ConstraintTypesEnabled(CT_ALL), m_ElemTypesEnabled(EDT_ALL),
-		m_bMatrixIsConst(false), m_bMatrixStructureIsConst(false), m_bClearOnResize(true) {}
+		m_bMatrixIsConst(false), m_bMatrixStructureIsConst(false), m_bClearOnResize(true),
+		m_numThreads(1), m_threadChunkSize(64), m_numThreadedElemLoops(0),
+		m_elemBatchSize(64), m_numBatchedElemLoops(0),
+		m_bPatternCaching(false), m_pCurrPatternMat(NULL), m_pCurrPatternCache(NULL),
+		m_bMatrixFreezing(false) {}
 
 	/// destructor
 		virtual ~AssemblingTuner() {}
@@ -133,6 +141,8 @@ class AssemblingTuner
 		{
 			if (m_pMapper)
 				m_pMapper->add_local_mat_to_global(mat, lmat, dd);
+			else if (m_pCurrPatternCache && m_pCurrPatternMat == &mat)
+				m_pCurrPatternCache->add_local_mat_to_global(mat, lmat);
 			else
 				m_defaultMapper.add_local_mat_to_global(mat, lmat);
 		}
@@ -221,6 +231,9 @@ class AssemblingTuner
 		void resize(ConstSmartPtr<DoFDistribution> dd, vector_type& vec) const;
 		void resize(ConstSmartPtr<DoFDistribution> dd, matrix_type& mat) const;
 
+	///	finishes an assembled matrix (freezes it, if enabled)
+		void finish(matrix_type& mat) const;
+
 	///	gets the element iterator from the Selector
 		template <typename TElem>
 		void collect_selected_elements(std::vector<TElem*>& vElem, ConstSmartPtr<DoFDistribution> dd, int si) const;
@@ -259,6 +272,129 @@ class AssemblingTuner
 	 */
 		bool matrix_is_const() const {return m_bMatrixIsConst;}
 
+	///	sets the number of threads used in the element loops
+	/**
+	 * If more than one thread is requested (and ug4 has been compiled with
+	 * OpenMP), the element loops for the (stationary) stiffness matrix, jacobian
+	 * and defect are processed in chunks: The local indices and local solutions
+	 * of a chunk of elements are gathered sequentially, the local contributions
+	 * are computed concurrently (each thread using an own DataEvaluator and own
+	 * local algebra) and are finally added to the global matrix/vector
+	 * sequentially in the original element order. Thus, the result does not
+	 * depend on the number of threads.
+	 *
+	 * Threads are only used if all element discretizations involved in the loop
+	 * allow concurrent assembling (see IElemDiscBase::set_thread_safe_assembling)
+	 * and can be copied for the additional threads (see IElemDisc::thread_copy).
+	 * Otherwise, the sequential loop is used (see num_threaded_elem_loops).
+	 *
+	 * \param[in]	numThreads	number of threads (0 or 1: sequential)
+	 */
+		void set_num_threads(size_t numThreads) {m_numThreads = numThreads;}
+
+	///	returns the number of threads used in the element loops
+		size_t num_threads() const {return m_numThreads;}
+
+	///	sets the number of elements processed by one thread in one chunk
+		void set_thread_chunk_size(size_t chunkSize)
+		{
+			if(chunkSize == 0) UG_THROW("AssemblingTuner: Chunk size must be positive.");
+			m_threadChunkSize = chunkSize;
+		}
+
+	///	returns the number of elements processed by one thread in one chunk
+		size_t thread_chunk_size() const {return m_threadChunkSize;}
+
+	///	returns the number of element loops that have been assembled by threads
+		size_t num_threaded_elem_loops() const {return m_numThreadedElemLoops;}
+
+	///	counts an element loop assembled by threads
+		void threaded_elem_loop_done() const {++m_numThreadedElemLoops;}
+
+	///	sets the number of elements assembled at once in batched element loops
+	/**
+	 * If all element discretizations of a (sequential) element loop provide a
+	 * batched assembling for the element type (see LocalElemBatch), blocks of
+	 * this many elements are assembled at once. A size of 0 disables the
+	 * batched assembling.
+	 */
+		void set_elem_batch_size(size_t batchSize) {m_elemBatchSize = batchSize;}
+
+	///	returns the number of elements assembled at once in batched element loops
+		size_t elem_batch_size() const {return m_elemBatchSize;}
+
+	///	returns the number of element loops that have been assembled in batches
+		size_t num_batched_elem_loops() const {return m_numBatchedElemLoops;}
+
+	///	counts an element loop assembled in batches
+		void batched_elem_loop_done() const {++m_numBatchedElemLoops;}
+
+	///	enables the reuse of the matrix sparsity pattern in repeated assemblings
+	/**
+	 * If enabled, the first assembling of a matrix records the global positions
+	 * of all local matrix entries. In the following assemblings of the same
+	 * matrix (e.g. in every Newton step and time step), the matrix structure is
+	 * kept and the local entries are added directly at the cached storage
+	 * positions (see MatrixPatternCache). The cached patterns are discarded
+	 * whenever the revision of the approximation space changes (see
+	 * set_pattern_revision), e.g. after grid refinement or redistribution.
+	 *
+	 * The caching is not used for single index assembling, for user-defined
+	 * LocalToGlobalMappers and if clearing on resize is disabled.
+	 */
+		void enable_pattern_caching(bool bEnable)
+		{
+			m_bPatternCaching = bEnable;
+			clear_pattern_cache();
+		}
+
+	///	returns if the reuse of the matrix sparsity pattern is enabled
+		bool pattern_caching_enabled() const {return m_bPatternCaching;}
+
+	///	sets the revision the cached patterns are valid for
+	/**
+	 * If the revision differs from the one passed before, all cached patterns
+	 * are discarded.
+	 */
+		void set_pattern_revision(const RevisionCounter& rev)
+		{
+			if(rev == m_patternRevision) return;
+			m_patternRevision = rev;
+			clear_pattern_cache();
+		}
+
+	///	discards all cached patterns
+		void clear_pattern_cache()
+		{
+			m_mPatternCache.clear();
+			m_pCurrPatternMat = NULL;
+			m_pCurrPatternCache = NULL;
+		}
+
+	///	enables the frozen CRS mode for assembled matrices
+	/**
+	 * If enabled, the assembled matrices are frozen at the end of the
+	 * assembling (see SparseMatrix::freeze), such that the following
+	 * matrix-vector products use the contiguous CRS storage. Structural
+	 * changes of the matrix leave the frozen mode automatically.
+	 *
+	 * Freezing copies a matrix assembled into a fresh pattern once more, hence
+	 * it is disabled by default. Together with the pattern caching, replayed
+	 * patterns are contiguous already and are frozen without a copy.
+	 */
+		void enable_matrix_freezing(bool bEnable) {m_bMatrixFreezing = bEnable;}
+
+	///	returns if the assembled matrices are frozen
+		bool matrix_freezing_enabled() const {return m_bMatrixFreezing;}
+
+	protected:
+	///	freezes sparse matrices
+		template <typename TBlock>
+		static void freeze(SparseMatrix<TBlock>* pMat) {pMat->freeze();}
+
+	///	no frozen mode for other matrix types
+		static void freeze(const void*) {}
+
 	protected:
 	///	default LocalToGlobalMapper
 		LocalToGlobalMapper<TAlgebra> m_defaultMapper;
@@ -297,6 +433,37 @@ class AssemblingTuner
 
 	/// disables clearing of vector/matrix on resize
 		bool m_bClearOnResize;
+
+	///	number of threads used in the element loops
+		size_t m_numThreads;
+
+	///	number of elements per thread and chunk in threaded element loops
+		size_t m_threadChunkSize;
+
+	///	number of element loops assembled by threads
+		mutable size_t m_numThreadedElemLoops;
+
+	///	number of elements per batch in batched element loops (0: disabled)
+		size_t m_elemBatchSize;
+
+	///	number of element loops assembled in batches
+		mutable size_t m_numBatchedElemLoops;
+
+	///	enables the reuse of the matrix sparsity pattern
+		bool m_bPatternCaching;
+
+	///	revision the cached patterns are valid for
+		RevisionCounter m_patternRevision;
+
+	///	cached patterns (per matrix)
+		mutable std::map<const void*, MatrixPatternCache> m_mPatternCache;
+
+	///	matrix currently assembled using a cached pattern
+		mutable const void* m_pCurrPatternMat;
+		mutable MatrixPatternCache* m_pCurrPatternCache;
+
+	///	enables the freezing of assembled matrices
+		bool m_bMatrixFreezing;
 };
 
 } // end namespace ug
@@ -57,12 +57,28 @@ void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
 {
 	if (single_index_assembling_enabled())
 	{
+		m_pCurrPatternMat = NULL;
+		m_pCurrPatternCache = NULL;
 		if (m_bClearOnResize) mat.resize_and_clear(1, 1);
 		else mat.resize_and_keep_values(1,1);
 	}
 	else
 	{
 		const size_t numIndex = dd->num_indices();
+		if (m_bPatternCaching && m_bClearOnResize && !m_pMapper)
+		{
+			UG_COND_THROW(m_bMatrixStructureIsConst &&
+				(mat.num_rows() != numIndex || mat.num_cols() != numIndex),
+				"The assembling tuner is set to use a constant matrix structure, "
+				"but the number of indices in the new matrix is different from that in the old one.");
+			m_pCurrPatternMat = &mat;
+			m_pCurrPatternCache = &m_mPatternCache[m_pCurrPatternMat];
+			m_pCurrPatternCache->resize_and_clear(mat, numIndex, m_bMatrixStructureIsConst);
+			return;
+		}
+
+		m_pCurrPatternMat = NULL;
+		m_pCurrPatternCache = NULL;
 		if (m_bClearOnResize)
 		{
 			if (m_bMatrixStructureIsConst)
@@ -80,6 +96,13 @@ void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
 	}
 }
 
+template <typename TAlgebra>
+void AssemblingTuner<TAlgebra>::finish(matrix_type& mat) const
+{
+	if (m_bMatrixFreezing && !single_index_assembling_enabled())
+		freeze(&mat);
+}
+
 template <typename TAlgebra>
 template <typename TElem>
 bool AssemblingTuner<TAlgebra>::element_used(TElem* elem) const
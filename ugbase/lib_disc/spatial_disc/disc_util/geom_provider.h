@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__SPATIAL_DISC__DISC_UTIL__GEOM_PROVIDER__
 
 #include <map>
+#include "common/util/provider.h"
 #include "lib_disc/local_finite_element/local_finite_element_id.h"
 
 namespace ug{
@@ -46,6 +47,15 @@ namespace ug{
  *
  * In addition, the object can be shared between unrelated code parts, if the
  * same object is intended to be used, but no passing is possible or wanted.
+ *
+ * Since the geometries are updated for every element, the instances are
+ * provided per thread if ug4 is compiled with thread support (see
+ * UG_THREAD_LOCAL). Thus, several threads can update their geometries
+ * concurrently without any locking. Note, that the returned reference must
+ * therefore not be cached in a static variable, but requested in the
+ * function using it. Settings made in prep_elem_loop (e.g. requested
+ * boundary subsets) only apply to the instance of the calling thread, thus
+ * the threaded element loops prepare the elem discs on each thread.
  */
 template <typename TGeom>
 class GeomProvider
@@ -67,9 +77,9 @@ class GeomProvider
 		/// destructor
 		~GeomProvider() {clear_geoms();}
 
-		/// singleton provider
+		/// singleton provider (one per thread)
 		static GeomProvider<TGeom>& inst() {
-			static GeomProvider<TGeom> inst;
+			static UG_THREAD_LOCAL GeomProvider<TGeom> inst;
 			return inst;
 		}
 
@@ -91,10 +101,10 @@ class GeomProvider
 
 		/// vector holding instances
 		typedef std::map<LFEIDandQuadOrder, TGeom*> MapType;
-		static MapType m_mLFEIDandOrder;
+		MapType m_mLFEIDandOrder;
 
 		/// returns class based on identifier
-		static TGeom& get_class(const LFEID lfeID, const int quadOrder) {
+		TGeom& get_class(const LFEID lfeID, const int quadOrder) {
 
 			LFEIDandQuadOrder key(lfeID, quadOrder);
 
@@ -115,7 +125,7 @@ class GeomProvider
 		}
 
 		/// clears all instances
-		static void clear_geoms(){
+		void clear_geoms(){
 			typedef typename std::map<LFEIDandQuadOrder, TGeom*>::iterator MapIter;
 			for(MapIter iter = m_mLFEIDandOrder.begin(); iter != m_mLFEIDandOrder.end(); ++iter)
 				if(iter->second)
@@ -139,23 +149,19 @@ class GeomProvider
 
 		///	returns a singleton based on the identifier
 		static inline TGeom& get(){
-			static TGeom inst;
+			static UG_THREAD_LOCAL TGeom inst;
 			if(!staticLocalData)
 				UG_THROW("GeomProvider: accessing geometry without keys, but"
 						 " geometry may change local data. Use access by keys instead.");
 			return inst;
 		}
 
-		///	clears all singletons
+		///	clears all singletons (of the calling thread)
 		static inline void clear(){
 			inst().clear_geoms();
 		}
 };
 
-template <typename TGeom>
-std::map<typename GeomProvider<TGeom>::LFEIDandQuadOrder, TGeom*> GeomProvider<TGeom>::m_mLFEIDandOrder
-						= std::map<typename GeomProvider<TGeom>::LFEIDandQuadOrder, TGeom*>();
-
 
 } // end namespace ug
 
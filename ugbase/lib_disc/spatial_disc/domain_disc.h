@@ -123,6 +123,30 @@ class DomainDiscretizationBase
 		virtual void assemble_jacobian(matrix_type& J, const vector_type& u, const GridLevel& gl)
 		{assemble_jacobian(J, u, dd(gl));}
 
+	///	computes d = J(u)*c element by element without assembling J(u)
+	/**
+	 * The Jacobian of the (stationary) problem is applied element-wise via the
+	 * element discretizations. Dirichlet rows act as identity, as in the
+	 * assembled Jacobian. Other constraint types are not supported.
+	 *
+	 * \param[out]	d		result (additive)
+	 * \param[in]	u		solution the Jacobian is linearized at
+	 * \param[in]	c		vector the Jacobian is applied to (consistent)
+	 * \param[in]	dd		DoF Distribution
+	 */
+		void apply_jacobian(vector_type& d, const vector_type& u, const vector_type& c,
+		                    ConstSmartPtr<DoFDistribution> dd);
+		void apply_jacobian(vector_type& d, const vector_type& u, const vector_type& c,
+		                    const GridLevel& gl)
+		{apply_jacobian(d, u, c, dd(gl));}
+
+	///	assembles only the (block) diagonal of the (stationary) Jacobian J(u)
+		void assemble_jacobian_diagonal(matrix_type& D, const vector_type& u,
+		                                ConstSmartPtr<DoFDistribution> dd);
+		void assemble_jacobian_diagonal(matrix_type& D, const vector_type& u,
+		                                const GridLevel& gl)
+		{assemble_jacobian_diagonal(D, u, dd(gl));}
+
 	/// \copydoc IAssemble::assemble_defect()
 		virtual void assemble_defect(vector_type& d, const vector_type& u, ConstSmartPtr<DoFDistribution> dd);
 		virtual void assemble_defect(vector_type& d, const vector_type& u, const GridLevel& gl)
@@ -554,6 +578,19 @@ public:
 									matrix_type& J,
 									const vector_type& u);
 	template <typename TElem>
+	void ApplyJacobianElemwise(		const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+									ConstSmartPtr<DoFDistribution> dd,
+									int si, bool bNonRegularGrid,
+									vector_type* pD,
+									matrix_type* pDiag,
+									const vector_type& u,
+									const vector_type* pC);
+	void apply_jacobian_elemwise(	vector_type* pD,
+									matrix_type* pDiag,
+									const vector_type& u,
+									const vector_type* pC,
+									ConstSmartPtr<DoFDistribution> dd);
+	template <typename TElem>
 	void AssembleDefect( 			const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 									ConstSmartPtr<DoFDistribution> dd,
 									int si, bool bNonRegularGrid,
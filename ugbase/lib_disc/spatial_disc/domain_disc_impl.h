@@ -128,6 +128,9 @@ void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::update_disc_it
 {
 	update_elem_discs();
 	update_constraints();
+
+//	cached matrix patterns are only valid for the current approximation space
+	m_spAssTuner->set_pattern_revision(m_spApproxSpace->revision());
 }
 
 template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
@@ -247,6 +250,9 @@ assemble_mass_matrix(matrix_type& M, const vector_type& u,
 	}UG_CATCH_THROW("DomainDiscretization::assemble_mass_matrix:"
 					" Cannot execute post process.");
 
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(M);
+
 //	Remember parallel storage type
 #ifdef UG_PARALLEL
 	M.set_storage_type(PST_ADDITIVE);
@@ -407,6 +413,9 @@ assemble_stiffness_matrix(matrix_type& A, const vector_type& u,
 	}UG_CATCH_THROW("DomainDiscretization::assemble_stiffness_matrix:"
 					" Cannot execute post process.");
 
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(A);
+
 //	Remember parallel storage type
 #ifdef UG_PARALLEL
 	A.set_storage_type(PST_ADDITIVE);
@@ -592,6 +601,9 @@ assemble_jacobian(matrix_type& J,
 	}UG_CATCH_THROW("DomainDiscretization::assemble_jacobian:"
 					" Cannot execute post process.");
 
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(J);
+
 //	Remember parallel storage type
 #ifdef UG_PARALLEL
 	J.set_storage_type(PST_ADDITIVE);
@@ -640,6 +652,234 @@ AssembleJacobian(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Matrix-free Jacobian (stationary)
+///////////////////////////////////////////////////////////////////////////////
+template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
+void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::
+apply_jacobian(vector_type& d,
+               const vector_type& u,
+               const vector_type& c,
+               ConstSmartPtr<DoFDistribution> dd)
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+//	reset result to zero and resize
+	m_spAssTuner->resize(dd, d);
+	if(c.size() != d.size())
+		UG_THROW("DomainDiscretization::apply_jacobian: Size of vector c ("
+				<< c.size() << ") does not match the number of indices ("
+				<< d.size() << ").");
+
+//	add J(u)*c element by element
+	apply_jacobian_elemwise(&d, NULL, u, &c, dd);
+
+//	Dirichlet rows of the Jacobian are identity rows: mark the constrained
+//	components by adjusting a vector of ones as a correction
+	if(!m_vConstraint.empty())
+	{
+		SmartPtr<vector_type> spMask = c.clone_without_values();
+		spMask->set(1.0);
+
+		try{
+		for(int type = 1; type < CT_ALL; type = type << 1){
+			if(!(m_spAssTuner->constraint_type_enabled(type))) continue;
+			for(size_t i = 0; i < m_vConstraint.size(); ++i)
+				if(m_vConstraint[i]->type() & type)
+					m_vConstraint[i]->adjust_correction(*spMask, dd, type);
+		}
+		}UG_CATCH_THROW("DomainDiscretization::apply_jacobian:"
+						" Cannot adjust constraints.");
+
+		const vector_type& mask = *spMask;
+		for(size_t i = 0; i < d.size(); ++i)
+			for(size_t alpha = 0; alpha < GetSize(d[i]); ++alpha)
+				if(BlockRef(mask[i], alpha) == 0.0)
+					BlockRef(d[i], alpha) = BlockRef(c[i], alpha);
+	}
+
+//	Remember parallel storage type
+#ifdef UG_PARALLEL
+	d.set_storage_type(PST_ADDITIVE);
+#endif
+}
+
+template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
+void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::
+assemble_jacobian_diagonal(matrix_type& D,
+                           const vector_type& u,
+                           ConstSmartPtr<DoFDistribution> dd)
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+//	reset matrix to zero and resize
+	m_spAssTuner->resize(dd, D);
+
+//	add diag(J(u)) element by element
+	apply_jacobian_elemwise(NULL, &D, u, NULL, dd);
+
+//	set Dirichlet rows
+	try{
+	for(int type = 1; type < CT_ALL; type = type << 1){
+		if(!(m_spAssTuner->constraint_type_enabled(type))) continue;
+		for(size_t i = 0; i < m_vConstraint.size(); ++i)
+			if(m_vConstraint[i]->type() & type)
+			{
+				m_vConstraint[i]->set_ass_tuner(m_spAssTuner);
+				m_vConstraint[i]->adjust_jacobian(D, u, dd, type);
+			}
+	}
+	}UG_CATCH_THROW("DomainDiscretization::assemble_jacobian_diagonal:"
+					" Cannot adjust constraints.");
+
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(D);
+
+//	Remember parallel storage type
+#ifdef UG_PARALLEL
+	D.set_storage_type(PST_ADDITIVE);
+	D.set_layouts(dd->layouts());
+#endif
+}
+
+template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
+void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::
+apply_jacobian_elemwise(vector_type* pD,
+                        matrix_type* pDiag,
+                        const vector_type& u,
+                        const vector_type* pC,
+                        ConstSmartPtr<DoFDistribution> dd)
+{
+//	only Dirichlet constraints can be applied without the matrix
+	for(size_t i = 0; i < m_vConstraint.size(); ++i)
+		if(m_spAssTuner->constraint_type_enabled(m_vConstraint[i]->type())
+			&& m_vConstraint[i]->type() != CT_DIRICHLET)
+			UG_THROW("DomainDiscretization: Matrix-free application of the "
+					"Jacobian only supports Dirichlet constraints.");
+
+	if(m_spAssTuner->single_index_assembling_enabled()
+		|| m_spAssTuner->modify_solution_enabled())
+		UG_THROW("DomainDiscretization: Matrix-free application of the "
+				"Jacobian does not support single index assembling or "
+				"modification of the solution.");
+
+//	update the elem discs
+	update_disc_items();
+	prep_assemble_loop(m_vElemDisc);
+
+//	Union of Subsets
+	SubsetGroup unionSubsets;
+	std::vector<SubsetGroup> vSSGrp;
+
+//	create list of all subsets
+	try{
+		CreateSubsetGroups(vSSGrp, unionSubsets, m_vElemDisc, dd->subset_handler());
+	}UG_CATCH_THROW("'DomainDiscretization': Can not create Subset Groups and Union.");
+
+//	loop subsets
+	for(size_t i = 0; i < unionSubsets.size(); ++i)
+	{
+	//	get subset
+		const int si = unionSubsets[i];
+
+	//	get dimension of the subset
+		const int dim = DimensionOfSubset(*dd->subset_handler(), si);
+
+	//	request if subset is regular grid
+		bool bNonRegularGrid = !unionSubsets.regular_grid(i);
+
+	//	overrule by regular grid if required
+		if(m_spAssTuner->regular_grid_forced()) bNonRegularGrid = false;
+
+	//	Elem Disc on the subset
+		std::vector<IElemDisc<TDomain>*> vSubsetElemDisc;
+
+	//	get all element discretizations that work on the subset
+		GetElemDiscOnSubset(vSubsetElemDisc, m_vElemDisc, vSSGrp, si);
+
+	//	apply on suitable elements
+		try
+		{
+		switch(dim)
+		{
+		case 0:
+			this->template ApplyJacobianElemwise<RegularVertex>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			break;
+		case 1:
+			this->template ApplyJacobianElemwise<RegularEdge>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<ConstrainingEdge>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			break;
+		case 2:
+			this->template ApplyJacobianElemwise<Triangle>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<Quadrilateral>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<ConstrainingTriangle>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<ConstrainingQuadrilateral>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			break;
+		case 3:
+			this->template ApplyJacobianElemwise<Tetrahedron>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<Pyramid>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<Prism>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<Hexahedron>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			this->template ApplyJacobianElemwise<Octahedron>
+				(vSubsetElemDisc, dd, si, bNonRegularGrid, pD, pDiag, u, pC);
+			break;
+		default:
+			UG_THROW("DomainDiscretization::apply_jacobian_elemwise:"
+							"Dimension "<<dim<<"(subset="<<si<<") not supported");
+		}
+		}
+		UG_CATCH_THROW("DomainDiscretization::apply_jacobian_elemwise:"
+						" Processing of elements of Dimension " << dim << " in "
+						" subset "<<si<< " failed.");
+	}
+
+	try{
+		post_assemble_loop(m_vElemDisc);
+	}UG_CATCH_THROW("DomainDiscretization::apply_jacobian_elemwise:"
+					" Cannot execute post process.");
+}
+
+template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
+template <typename TElem>
+void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::
+ApplyJacobianElemwise(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+						ConstSmartPtr<DoFDistribution> dd,
+						int si, bool bNonRegularGrid,
+						vector_type* pD,
+						matrix_type* pDiag,
+						const vector_type& u,
+						const vector_type* pC)
+{
+	//	check if only some elements are selected
+	if(m_spAssTuner->selected_elements_used())
+	{
+		std::vector<TElem*> vElem;
+		m_spAssTuner->collect_selected_elements(vElem, dd, si);
+
+		gass_type::template ApplyJacobianElemwise<TElem>
+			(vElemDisc, m_spApproxSpace->domain(), dd, vElem.begin(), vElem.end(), si,
+			 bNonRegularGrid, pD, pDiag, u, pC, m_spAssTuner);
+	}
+	else
+	{
+		gass_type::template ApplyJacobianElemwise<TElem>
+			(vElemDisc, m_spApproxSpace->domain(), dd,
+				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
+					bNonRegularGrid, pD, pDiag, u, pC, m_spAssTuner);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Defect (stationary)
 ///////////////////////////////////////////////////////////////////////////////
@@ -939,6 +1179,9 @@ assemble_linear(matrix_type& mat, vector_type& rhs,
 	post_assemble_loop(m_vElemDisc);
 	}UG_CATCH_THROW("DomainDiscretization::assemble_linear: Cannot post process.");
 
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(mat);
+
 //	Remember parallel storage type
 #ifdef UG_PARALLEL
 	mat.set_storage_type(PST_ADDITIVE);
@@ -1501,6 +1744,9 @@ assemble_jacobian(matrix_type& J,
 	post_assemble_loop(m_vElemDisc);
 	}UG_CATCH_THROW("Cannot adjust jacobian.");
 
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(J);
+
 //	Remember parallel storage type
 #ifdef UG_PARALLEL
 	J.set_storage_type(PST_ADDITIVE);
@@ -1844,6 +2090,9 @@ assemble_linear(matrix_type& mat, vector_type& rhs,
 	}
 	} UG_CATCH_THROW("Cannot adjust linear.");
 
+//	finish matrix (e.g. freeze it for fast matrix-vector products)
+	m_spAssTuner->finish(mat);
+
 //	Remember parallel storage type
 #ifdef UG_PARALLEL
 	mat.set_storage_type(PST_ADDITIVE);
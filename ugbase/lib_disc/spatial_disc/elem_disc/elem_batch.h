@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_BATCH__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_BATCH__
+
+// extern headers
+#include <vector>
+#include <algorithm>
+
+// intern headers
+#include "common/math/ugmath.h"
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/reference_element/reference_element_traits.h"
+#include "lib_grid/grid/grid_base_objects.h"
+
+namespace ug{
+
+/// \ingroup lib_disc_elem_disc
+/// @{
+
+///	local data of a block of elements of the same reference object type
+/**
+ * This class holds the input and output of the batched element assembling
+ * (see IElemAssembleFuncs::set_add_jac_A_elem_batch_fct). A batch consists of
+ * up to capacity() elements of the same reference object type and with the
+ * same local index layout (same number of functions and DoFs per function).
+ *
+ * All data is stored in a structure-of-arrays layout: For every corner
+ * coordinate component and every local DoF (or pair of DoFs) the values of
+ * all elements of the batch are stored consecutively. Thus, loops over the
+ * elements of a batch have unit stride and can be vectorized, e.g.
+ *
+ * \code
+ * const number* x0 = batch.corner_ptr(0, 0);
+ * const number* x1 = batch.corner_ptr(1, 0);
+ * number* J = batch.jac_ptr(0, 0, 0, 0);
+ * for(size_t e = 0; e < batch.num_elem(); ++e)
+ * 	J[e] += x1[e] - x0[e];
+ * \endcode
+ *
+ * As for the LocalVector and LocalMatrix, the functions are accessed through
+ * a FunctionIndexMapping of the element discretization, if one has been set
+ * by access_by_map.
+ */
+template <int dim>
+class LocalElemBatch
+{
+	public:
+	///	constructor
+		LocalElemBatch()
+			: m_roid(ROID_UNKNOWN), m_numElem(0), m_capacity(0),
+			  m_numCorner(0), m_numDoF(0), m_pFuncMap(NULL) {}
+
+	///	sets the layout of the batch
+	/**
+	 * The layout of the local indices (number of functions and DoFs) is taken
+	 * from the passed indices. All values are undefined after this call and
+	 * the batch contains no elements.
+	 *
+	 * \param[in]	roid		reference object id of the elements
+	 * \param[in]	numCorner	number of corners of the elements
+	 * \param[in]	ind			local indices of one element of the batch
+	 * \param[in]	capacity	maximal number of elements
+	 */
+		void resize(ReferenceObjectID roid, size_t numCorner,
+		            const LocalIndices& ind, size_t capacity)
+		{
+			m_roid = roid;
+			m_numCorner = numCorner;
+			m_capacity = capacity;
+			m_numElem = 0;
+
+			m_vOffset.resize(ind.num_fct() + 1);
+			m_vOffset[0] = 0;
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				m_vOffset[fct+1] = m_vOffset[fct] + ind.num_dof(fct);
+			m_numDoF = m_vOffset.back();
+
+			m_vElem.resize(m_capacity);
+			m_vCorner.resize(m_numCorner * dim * m_capacity);
+			m_vU.resize(m_numDoF * m_capacity);
+			m_vDef.resize(m_numDoF * m_capacity);
+			m_vRhs.resize(m_numDoF * m_capacity);
+			m_vJac.resize(m_numDoF * m_numDoF * m_capacity);
+			access_all();
+		}
+
+	///	returns if the local indices of an element fit into the layout
+		bool layout_matches(const LocalIndices& ind) const
+		{
+			if(ind.num_fct() + 1 != m_vOffset.size()) return false;
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				if(m_vOffset[fct+1] - m_vOffset[fct] != ind.num_dof(fct))
+					return false;
+			return true;
+		}
+
+	///	removes all elements from the batch
+		void clear() {m_numElem = 0;}
+
+	///	adds an element with its corner coordinates and local solution
+	/**
+	 * \returns	the position of the element in the batch
+	 */
+		size_t push_back(GridObject* elem, const MathVector<dim> vCornerCoords[],
+		                 const LocalVector& u)
+		{
+			UG_ASSERT(m_numElem < m_capacity, "LocalElemBatch: capacity exceeded.");
+			const size_t e = m_numElem++;
+			m_vElem[e] = elem;
+			for(size_t co = 0; co < m_numCorner; ++co)
+				for(int d = 0; d < dim; ++d)
+					m_vCorner[(co*dim + d)*m_capacity + e] = vCornerCoords[co][d];
+			for(size_t fct = 0; fct < u.num_all_fct(); ++fct)
+				for(size_t dof = 0; dof < u.num_all_dof(fct); ++dof)
+					m_vU[(m_vOffset[fct] + dof)*m_capacity + e] = u.value(fct, dof);
+			return e;
+		}
+
+	///	sets the local jacobian, defect and rhs of all elements to zero
+		void clear_results()
+		{
+			std::fill(m_vJac.begin(), m_vJac.end(), 0.0);
+			std::fill(m_vDef.begin(), m_vDef.end(), 0.0);
+			std::fill(m_vRhs.begin(), m_vRhs.end(), 0.0);
+		}
+
+	///	adds the local jacobian of an element to a local matrix
+		void add_jac_to(LocalMatrix& J, size_t e) const
+		{
+			for(size_t fct1 = 0; fct1 < J.num_all_row_fct(); ++fct1)
+				for(size_t dof1 = 0; dof1 < J.num_all_row_dof(fct1); ++dof1)
+					for(size_t fct2 = 0; fct2 < J.num_all_col_fct(); ++fct2)
+						for(size_t dof2 = 0; dof2 < J.num_all_col_dof(fct2); ++dof2)
+							J.value(fct1, dof1, fct2, dof2)
+								+= m_vJac[((m_vOffset[fct1] + dof1)*m_numDoF
+								          + m_vOffset[fct2] + dof2)*m_capacity + e];
+		}
+
+	///	adds the local defect (minus the local rhs) of an element to a local vector
+		void add_def_to(LocalVector& d, size_t e) const
+		{
+			for(size_t fct = 0; fct < d.num_all_fct(); ++fct)
+				for(size_t dof = 0; dof < d.num_all_dof(fct); ++dof)
+				{
+					const size_t k = (m_vOffset[fct] + dof)*m_capacity + e;
+					d.value(fct, dof) += m_vDef[k] - m_vRhs[k];
+				}
+		}
+
+	///	access only the functions of a mapping
+		void access_by_map(const FunctionIndexMapping& funcMap) {m_pFuncMap = &funcMap;}
+
+	///	access all functions
+		void access_all() {m_pFuncMap = NULL;}
+
+	///	returns the reference object id of the elements
+		ReferenceObjectID roid() const {return m_roid;}
+
+	///	returns the number of elements in the batch
+		size_t num_elem() const {return m_numElem;}
+
+	///	returns the maximal number of elements (and the stride of the values)
+		size_t capacity() const {return m_capacity;}
+
+	///	returns the number of corners of the elements
+		size_t num_corners() const {return m_numCorner;}
+
+	///	returns the number of (accessible) functions
+		size_t num_fct() const
+		{
+			if(m_pFuncMap == NULL) return m_vOffset.size() - 1;
+			return m_pFuncMap->num_fct();
+		}
+
+	///	returns the number of DoFs of a function per element
+		size_t num_dof(size_t fct) const
+		{
+			const size_t f = all_fct(fct);
+			return m_vOffset[f+1] - m_vOffset[f];
+		}
+
+	///	returns the e'th element
+		GridObject* elem(size_t e) const {return m_vElem[e];}
+
+	///	returns the component d of a corner coordinate for all elements
+		const number* corner_ptr(size_t co, int d) const
+			{return &m_vCorner[(co*dim + d)*m_capacity];}
+
+	///	returns the local solution of a DoF for all elements
+		const number* u_ptr(size_t fct, size_t dof) const
+			{return &m_vU[index(fct, dof)*m_capacity];}
+
+	///	returns the local defect (stiffness part) of a DoF for all elements
+		number* def_ptr(size_t fct, size_t dof)
+			{return &m_vDef[index(fct, dof)*m_capacity];}
+
+	///	returns the local rhs of a DoF for all elements
+		number* rhs_ptr(size_t fct, size_t dof)
+			{return &m_vRhs[index(fct, dof)*m_capacity];}
+
+	///	returns the local jacobian entry of a pair of DoFs for all elements
+		number* jac_ptr(size_t fct1, size_t dof1, size_t fct2, size_t dof2)
+			{return &m_vJac[(index(fct1, dof1)*m_numDoF + index(fct2, dof2))*m_capacity];}
+
+	protected:
+	///	returns the function index w.r.t. all functions
+		size_t all_fct(size_t fct) const
+		{
+			if(m_pFuncMap == NULL) return fct;
+			return (*m_pFuncMap)[fct];
+		}
+
+	///	returns the position of a DoF in the flattened local layout
+		size_t index(size_t fct, size_t dof) const
+		{
+			const size_t f = all_fct(fct);
+			UG_ASSERT(dof < m_vOffset[f+1] - m_vOffset[f], "LocalElemBatch: Wrong index.");
+			return m_vOffset[f] + dof;
+		}
+
+	protected:
+		ReferenceObjectID m_roid;	///< reference object id of the elements
+		size_t m_numElem;			///< number of elements in the batch
+		size_t m_capacity;			///< maximal number of elements (stride)
+		size_t m_numCorner;			///< number of corners per element
+		size_t m_numDoF;			///< number of local DoFs per element
+
+	///	offsets of the functions in the flattened local DoF layout
+		std::vector<size_t> m_vOffset;
+
+	///	elements of the batch
+		std::vector<GridObject*> m_vElem;
+
+	///	corner coordinates, local solution and results (element index fastest)
+	/// \{
+		std::vector<number> m_vCorner;
+		std::vector<number> m_vU;
+		std::vector<number> m_vDef;
+		std::vector<number> m_vRhs;
+		std::vector<number> m_vJac;
+	/// \}
+
+	///	current function mapping
+		const FunctionIndexMapping* m_pFuncMap;
+};
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_BATCH__ */
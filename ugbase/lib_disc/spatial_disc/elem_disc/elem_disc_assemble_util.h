@@ -43,11 +43,16 @@
 // intern headers
 #include "../../reference_element/reference_element.h"
 #include "./elem_disc_interface.h"
+#include "./elem_batch.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/common/local_algebra.h"
 #include "lib_disc/spatial_disc/user_data/data_evaluator.h"
 #include "bridge/util_algebra_dependent.h"
 
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
 #define PROFILE_ELEM_LOOP
 #ifdef PROFILE_ELEM_LOOP
 	#define EL_PROFILE_FUNC()		PROFILE_FUNC()
@@ -124,6 +129,18 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the threaded element loop if requested and possible
+		const int numThreads = NumElemLoopThreads(vElemDisc, spAssTuner);
+		if(numThreads > 1)
+			if(AssembleStiffnessMatrixThreaded<TElem>(numThreads, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, A, u, spAssTuner))
+				return;
+
+	//	use the batched element loop if provided by all elem discs
+		if(AssembleJacobianBatched<TElem>(STIFF, vElemDisc, spDomain, dd,
+				iterBegin, iterEnd, si, bNonRegularGrid, A, u, spAssTuner))
+			return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -338,6 +355,18 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the threaded element loop if requested and possible
+		const int numThreads = NumElemLoopThreads(vElemDisc, spAssTuner);
+		if(numThreads > 1)
+			if(AssembleJacobianThreaded<TElem>(numThreads, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, J, u, spAssTuner))
+				return;
+
+	//	use the batched element loop if provided by all elem discs
+		if(AssembleJacobianBatched<TElem>(STIFF | RHS, vElemDisc, spDomain, dd,
+				iterBegin, iterEnd, si, bNonRegularGrid, J, u, spAssTuner))
+			return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -412,6 +441,133 @@ public:
 		UG_CATCH_THROW("(stationary) AssembleJacobian: Cannot create Data Evaluator.");
 	}
 
+////////////////////////////////////////////////////////////////////////////////
+// Apply (stationary) Jacobian element-wise
+////////////////////////////////////////////////////////////////////////////////
+
+public:
+	/**
+	 * This function applies the Jacobian of all passed element discretizations
+	 * on one given subset element by element without assembling the global
+	 * matrix, i.e. it adds J(u)*c to d. Optionally, the (block) diagonal of
+	 * the Jacobian is assembled in the same loop.
+	 * (This version processes elements in a given interval.)
+	 *
+	 * \param[in]		vElemDisc		element discretizations
+	 * \param[in]		spDomain		domain
+	 * \param[in]		dd				DoF Distribution
+	 * \param[in]		iterBegin		element iterator
+	 * \param[in]		iterEnd			element iterator
+	 * \param[in]		si				subset index
+	 * \param[in]		bNonRegularGrid flag to indicate if non regular grid is used
+	 * \param[in,out]	pD				result vector (J(u)*c is added), may be NULL
+	 * \param[in,out]	pDiag			diagonal matrix (diag(J(u)) is added), may be NULL
+	 * \param[in]		u				solution
+	 * \param[in]		pC				vector the Jacobian is applied to (if pD != NULL)
+	 * \param[in]		spAssTuner		assemble adapter
+	 */
+	template <typename TElem, typename TIterator>
+	static void
+	ApplyJacobianElemwise(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+							ConstSmartPtr<domain_type> spDomain,
+							ConstSmartPtr<DoFDistribution> dd,
+							TIterator iterBegin,
+							TIterator iterEnd,
+							int si, bool bNonRegularGrid,
+							vector_type* pD,
+							matrix_type* pDiag,
+							const vector_type& u,
+							const vector_type* pC,
+							ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+	//	check if there are any elements at all, otherwise return immediately
+		if(iterBegin == iterEnd) return;
+
+		if(pD != NULL && pC == NULL)
+			UG_THROW("ApplyJacobianElemwise: No vector to apply the Jacobian to.");
+
+	//	reference object id
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+	//	storage for corner coordinates
+		MathVector<domain_type::dim> vCornerCoords[TElem::NUM_VERTICES];
+
+	//	prepare for given elem discs
+		try
+		{
+		DataEvaluator<domain_type> Eval(STIFF | RHS,
+						   vElemDisc, dd->function_pattern(), bNonRegularGrid);
+
+	//	prepare element loop
+		Eval.prepare_elem_loop(id, si);
+
+	//	local indices and local algebra
+		LocalIndices ind; LocalVector locU, locC, locD; LocalMatrix locJ;
+
+	//	Loop over all elements
+		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
+		{
+		//	get Element
+			TElem* elem = *iter;
+
+		//	get corner coordinates
+			FillCornerCoordinates(vCornerCoords, *elem, *spDomain);
+
+		//	check if elem is skipped from assembling
+			if(!spAssTuner->element_used(elem)) continue;
+
+		//	get global indices
+			dd->indices(elem, ind, Eval.use_hanging());
+
+		//	adapt local algebra
+			locU.resize(ind); locJ.resize(ind);
+
+		//	read local values of u
+			GetLocalVector(locU, u);
+
+		//	prepare element
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, ind, true);
+			}
+			UG_CATCH_THROW("ApplyJacobianElemwise: Cannot prepare element.");
+
+		//	reset local algebra
+			locJ = 0.0;
+
+		//	compute local JA
+			try
+			{
+				Eval.add_jac_A_elem(locJ, locU, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("ApplyJacobianElemwise: Cannot compute Jacobian (A).");
+
+		//	add local J*c to global vector
+			if(pD != NULL)
+			{
+				locC.resize(ind); locD.resize(ind);
+				GetLocalVector(locC, *pC);
+				locD = 0.0;
+				AddLocalMatVec(locD, locJ, locC);
+				AddLocalVector(*pD, locD);
+			}
+
+		//	add local diagonal to global matrix
+			if(pDiag != NULL)
+				AddLocalMatrixDiagonalToGlobal(*pDiag, locJ);
+		}
+
+	//	finish element loop
+		try
+		{
+			Eval.finish_elem_loop();
+		}
+		UG_CATCH_THROW("ApplyJacobianElemwise: Cannot finish element loop.");
+
+		}
+		UG_CATCH_THROW("ApplyJacobianElemwise: Cannot create Data Evaluator.");
+	}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Assemble (instationary) Jacobian
 ////////////////////////////////////////////////////////////////////////////////
@@ -589,6 +745,20 @@ public:
 	//	check if at least one element exists, else return
 		if(iterBegin == iterEnd) return;
 
+	//	use the threaded element loop if requested and possible
+	//	(the modification of the local solution is only done sequentially)
+		const int numThreads = NumElemLoopThreads(vElemDisc, spAssTuner);
+		if(numThreads > 1 && !spAssTuner->modify_solution_enabled())
+			if(AssembleDefectThreaded<TElem>(numThreads, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, d, u, spAssTuner))
+				return;
+
+	//	use the batched element loop if provided by all elem discs
+		if(!spAssTuner->modify_solution_enabled())
+			if(AssembleDefectBatched<TElem>(vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, d, u, spAssTuner))
+				return;
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -2129,6 +2299,557 @@ public:
 		UG_CATCH_THROW("AssembleErrorEstimator: Cannot create Data Evaluator.");
 	}
 
+////////////////////////////////////////////////////////////////////////////////
+// Threaded element loops
+////////////////////////////////////////////////////////////////////////////////
+
+protected:
+///	local data of one element in a threaded or batched element loop
+	template <typename TElem>
+	struct ThreadedElemData
+	{
+		TElem* elem;
+		MathVector<domain_type::dim> vCornerCoords[TElem::NUM_VERTICES];
+		LocalIndices ind;
+		LocalVector locU, locD, tmpLocD;
+		LocalMatrix locJ;
+	};
+
+///	returns the number of threads to use for an element loop (1 if sequential)
+	static int
+	NumElemLoopThreads(const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                   ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+#ifdef UG_OPENMP
+		if(spAssTuner->num_threads() <= 1) return 1;
+
+	//	all elem discs must allow concurrent calls of their element functions
+		for(size_t i = 0; i < vElemDisc.size(); ++i)
+			if(!vElemDisc[i]->thread_safe_assembling()) return 1;
+
+		return (int)spAssTuner->num_threads();
+#else
+		return 1;
+#endif
+	}
+
+///	returns the number of the calling thread in a threaded element loop
+	static int ElemLoopThreadNum()
+	{
+#ifdef UG_OPENMP
+		return omp_get_thread_num();
+#else
+		return 0;
+#endif
+	}
+
+///	sequentially gathers the local data of the next chunk of used elements
+/**
+ * Fills at most vData.size() entries with the corner coordinates, the
+ * local indices and the local solution of the elements starting at iter.
+ *
+ * \returns		iterator to the first element not processed
+ */
+	template <typename TElem, typename TIterator>
+	static TIterator
+	GatherElemChunk(std::vector<ThreadedElemData<TElem> >& vData, size_t& numData,
+	                ConstSmartPtr<domain_type> spDomain,
+	                ConstSmartPtr<DoFDistribution> dd,
+	                TIterator iter, TIterator iterEnd, bool bUseHanging,
+	                const vector_type& u,
+	                ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		numData = 0;
+		for(; iter != iterEnd && numData < vData.size(); ++iter)
+		{
+			TElem* elem = *iter;
+
+		//	check if elem is skipped from assembling
+			if(!spAssTuner->element_used(elem)) continue;
+
+			ThreadedElemData<TElem>& data = vData[numData++];
+			data.elem = elem;
+			FillCornerCoordinates(data.vCornerCoords, *elem, *spDomain);
+			dd->indices(elem, data.ind, bUseHanging);
+			data.locU.resize(data.ind);
+			GetLocalVector(data.locU, u);
+		}
+		return iter;
+	}
+
+///	remembers the first error thrown inside of a parallel region
+	static void
+	StoreThreadError(bool& bFailed, UGError& failure, const UGError& err)
+	{
+#ifdef UG_OPENMP
+		#pragma omp critical (StdGlobAssembler_ThreadError)
+#endif
+		{
+			if(!bFailed) {bFailed = true; failure = err;}
+		}
+	}
+
+///	threaded element loop for the (stationary) jacobian or defect
+/**
+ * All threads of one parallel region process the whole loop. Each thread
+ * prepares an own DataEvaluator, since the elem discs set up the geometries
+ * in prep_elem_loop and those are provided per thread (see GeomProvider).
+ * The first thread uses the elem discs, all other threads use own copies of
+ * the elem discs (see IElemDisc::thread_copy), since the discs store their
+ * imports and the evaluated user data. The preparation is serialized
+ * nonetheless, since the copies may share other objects (e.g. the
+ * approximation space).
+ *
+ * The elements are processed in chunks: the local data is gathered by one
+ * thread, the local contributions are computed concurrently and added to
+ * the global matrix (if pJ is given) or defect (else) by one thread in
+ * element order.
+ *
+ * If an elem disc can not be copied, nothing is assembled and false is
+ * returned, such that the sequential loop can be used.
+ *
+ * \returns		true if the elements have been assembled
+ */
+	template <typename TElem, typename TIterator>
+	static bool
+	AssembleThreaded(int numThreads, int discPart,
+	                 const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                 ConstSmartPtr<domain_type> spDomain,
+	                 ConstSmartPtr<DoFDistribution> dd,
+	                 TIterator iterBegin,
+	                 TIterator iterEnd,
+	                 int si, bool bNonRegularGrid,
+	                 matrix_type* pJ, vector_type* pD,
+	                 const vector_type& u,
+	                 ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+	//	copy the elem discs for all but the first thread
+		std::vector<std::vector<IElemDisc<domain_type>*> > vvThreadDisc(numThreads, vElemDisc);
+		std::vector<SmartPtr<IElemDisc<domain_type> > > vspCopy;
+		for(int t = 1; t < numThreads; ++t)
+			for(size_t i = 0; i < vElemDisc.size(); ++i)
+			{
+				SmartPtr<IElemDisc<domain_type> > spCopy = vElemDisc[i]->thread_copy();
+				if(spCopy.invalid()) return false;
+				vspCopy.push_back(spCopy);
+				vvThreadDisc[t][i] = spCopy.get();
+			}
+
+		std::vector<SmartPtr<DataEvaluator<domain_type> > > vEval(numThreads);
+		std::vector<ThreadedElemData<TElem> > vData(numThreads * spAssTuner->thread_chunk_size());
+
+		TIterator iter = iterBegin;
+		size_t numData = 0;
+		bool bUseHanging = false;
+		bool bFailed = false; UGError failure("");
+
+#ifdef UG_OPENMP
+		#pragma omp parallel num_threads(numThreads)
+#endif
+		{
+			const int t = ElemLoopThreadNum();
+
+		//	prepare the element loop on this thread
+#ifdef UG_OPENMP
+			#pragma omp critical (StdGlobAssembler_PrepareElemLoop)
+#endif
+			{
+				try
+				{
+					vEval[t] = make_sp(new DataEvaluator<domain_type>(discPart,
+					                   vvThreadDisc[t], dd->function_pattern(), bNonRegularGrid));
+					vEval[t]->prepare_elem_loop(id, si);
+				}
+				catch(UGError& err)
+					{StoreThreadError(bFailed, failure, err);}
+				catch(std::exception& ex)
+					{StoreThreadError(bFailed, failure, UGError("std::exception", ex, __FILE__, __LINE__));}
+			}
+#ifdef UG_OPENMP
+			#pragma omp barrier
+			#pragma omp single
+#endif
+			if(!bFailed) bUseHanging = vEval[0]->use_hanging();
+
+			while(!bFailed)
+			{
+			//	gather local data sequentially
+#ifdef UG_OPENMP
+				#pragma omp single
+#endif
+				{
+					try
+					{
+						iter = GatherElemChunk<TElem>(vData, numData, spDomain, dd, iter, iterEnd,
+						                              bUseHanging, u, spAssTuner);
+					}
+					catch(UGError& err)
+						{StoreThreadError(bFailed, failure, err);}
+				}
+				if(bFailed || numData == 0) break;
+
+			//	compute local contributions concurrently
+#ifdef UG_OPENMP
+				#pragma omp for schedule(static)
+#endif
+				for(int i = 0; i < (int)numData; ++i)
+				{
+					ThreadedElemData<TElem>& data = vData[i];
+					DataEvaluator<domain_type>& Eval = *vEval[t];
+					try
+					{
+						if(pJ)
+						{
+							data.locJ.resize(data.ind);
+							Eval.prepare_elem(data.locU, data.elem, id, data.vCornerCoords, data.ind, true);
+							data.locJ = 0.0;
+							Eval.add_jac_A_elem(data.locJ, data.locU, data.elem, data.vCornerCoords);
+						}
+						else
+						{
+							data.locD.resize(data.ind); data.tmpLocD.resize(data.ind);
+							Eval.prepare_elem(data.locU, data.elem, id, data.vCornerCoords, data.ind);
+
+							data.locD = 0.0;
+							Eval.add_def_A_elem(data.locD, data.locU, data.elem, data.vCornerCoords);
+
+							data.tmpLocD = 0.0;
+							Eval.add_rhs_elem(data.tmpLocD, data.elem, data.vCornerCoords);
+							data.locD.scale_append(-1, data.tmpLocD);
+						}
+					}
+					catch(UGError& err)
+						{StoreThreadError(bFailed, failure, err);}
+					catch(std::exception& ex)
+						{StoreThreadError(bFailed, failure, UGError("std::exception", ex, __FILE__, __LINE__));}
+				}
+
+			//	send local to global matrix/defect in element order
+#ifdef UG_OPENMP
+				#pragma omp single
+#endif
+				if(!bFailed)
+				{
+					try
+					{
+						for(size_t i = 0; i < numData; ++i)
+						{
+							if(pJ) spAssTuner->add_local_mat_to_global(*pJ, vData[i].locJ, dd);
+							else spAssTuner->add_local_vec_to_global(*pD, vData[i].locD, dd);
+						}
+					}
+					catch(UGError& err)
+						{StoreThreadError(bFailed, failure, err);}
+				}
+			}
+
+		//	finish the element loop on this thread
+#ifdef UG_OPENMP
+			#pragma omp critical (StdGlobAssembler_PrepareElemLoop)
+#endif
+			{
+				try
+				{
+					if(vEval[t].valid()) vEval[t]->finish_elem_loop();
+				}
+				catch(UGError& err)
+					{StoreThreadError(bFailed, failure, err);}
+			}
+		}
+
+		if(bFailed) throw failure;
+		spAssTuner->threaded_elem_loop_done();
+		return true;
+	}
+
+///	threaded version of AssembleStiffnessMatrix (see AssembleThreaded)
+	template <typename TElem, typename TIterator>
+	static bool
+	AssembleStiffnessMatrixThreaded(int numThreads,
+	                                const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                                ConstSmartPtr<domain_type> spDomain,
+	                                ConstSmartPtr<DoFDistribution> dd,
+	                                TIterator iterBegin,
+	                                TIterator iterEnd,
+	                                int si, bool bNonRegularGrid,
+	                                matrix_type& A,
+	                                const vector_type& u,
+	                                ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		EL_PROFILE_BEGIN(Elem_AssembleStiffnessMatrixThreaded);
+		bool bDone = false;
+		try
+		{
+			bDone = AssembleThreaded<TElem>(numThreads, STIFF, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &A, NULL, u, spAssTuner);
+		}
+		UG_CATCH_THROW("AssembleStiffnessMatrix (threaded): Cannot assemble elements.");
+		return bDone;
+	}
+
+///	threaded version of AssembleJacobian (stationary, see AssembleThreaded)
+	template <typename TElem, typename TIterator>
+	static bool
+	AssembleJacobianThreaded(int numThreads,
+	                         const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                         ConstSmartPtr<domain_type> spDomain,
+	                         ConstSmartPtr<DoFDistribution> dd,
+	                         TIterator iterBegin,
+	                         TIterator iterEnd,
+	                         int si, bool bNonRegularGrid,
+	                         matrix_type& J,
+	                         const vector_type& u,
+	                         ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		EL_PROFILE_BEGIN(Elem_AssembleJacobianThreaded);
+		bool bDone = false;
+		try
+		{
+			bDone = AssembleThreaded<TElem>(numThreads, STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &J, NULL, u, spAssTuner);
+		}
+		UG_CATCH_THROW("(stationary) AssembleJacobian (threaded): Cannot assemble elements.");
+		return bDone;
+	}
+
+///	threaded version of AssembleDefect (stationary, see AssembleThreaded)
+	template <typename TElem, typename TIterator>
+	static bool
+	AssembleDefectThreaded(int numThreads,
+	                       const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                       ConstSmartPtr<domain_type> spDomain,
+	                       ConstSmartPtr<DoFDistribution> dd,
+	                       TIterator iterBegin,
+	                       TIterator iterEnd,
+	                       int si, bool bNonRegularGrid,
+	                       vector_type& d,
+	                       const vector_type& u,
+	                       ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		EL_PROFILE_BEGIN(Elem_AssembleDefectThreaded);
+		bool bDone = false;
+		try
+		{
+			bDone = AssembleThreaded<TElem>(numThreads, STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, NULL, &d, u, spAssTuner);
+		}
+		UG_CATCH_THROW("(stationary) AssembleDefect (threaded): Cannot assemble elements.");
+		return bDone;
+	}
+
+////////////////////////////////////////////////////////////////////////////////
+// Batched element loops
+////////////////////////////////////////////////////////////////////////////////
+
+protected:
+///	returns if the elements of a prepared loop can be assembled in batches
+/**
+ * This is the case if all elem discs have registered the batched assembling
+ * for the element type, no elem modifiers are used and the local indices do
+ * not include hanging DoFs (see LocalElemBatch). Since the elem discs may
+ * adapt the registration to the data of the subset in prep_elem_loop, this
+ * is checked after the preparation of the loop.
+ *
+ * \param[in]	bDefect		if true, checks the batched defect assembling,
+ * 							else the batched jacobian assembling
+ */
+	template <typename TElem>
+	static bool
+	ElemLoopBatchable(const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                  bool bDefect, bool bNonRegularGrid)
+	{
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+		if(vElemDisc.empty()) return false;
+
+		for(size_t i = 0; i < vElemDisc.size(); ++i)
+		{
+			IElemDisc<domain_type>& disc = *vElemDisc[i];
+
+			if(bDefect && !disc.add_def_A_elem_batch_registered(id)) return false;
+			if(!bDefect && !disc.add_jac_A_elem_batch_registered(id)) return false;
+			if(!disc.get_elem_modifier().empty()) return false;
+			if(bNonRegularGrid && disc.use_hanging()) return false;
+		}
+		return true;
+	}
+
+///	fills a batch with gathered element data
+/**
+ * Adds the elements starting at position 'first' to the batch, as long as
+ * their local index layout matches the one of the first element.
+ *
+ * \returns		position of the first element not added
+ */
+	template <typename TElem>
+	static size_t
+	FillElemBatch(LocalElemBatch<domain_type::dim>& batch,
+	              const std::vector<ThreadedElemData<TElem> >& vData,
+	              size_t first, size_t numData)
+	{
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+		batch.resize(id, TElem::NUM_VERTICES, vData[first].ind, vData.size());
+
+		size_t i = first;
+		for(; i < numData && batch.layout_matches(vData[i].ind); ++i)
+			batch.push_back(vData[i].elem, vData[i].vCornerCoords, vData[i].locU);
+		return i;
+	}
+
+///	batched version of AssembleStiffnessMatrix and AssembleJacobian (stationary)
+/**
+ * \returns		true if the elements have been assembled, false if the loop
+ * 				can not be batched (see ElemLoopBatchable)
+ */
+	template <typename TElem, typename TIterator>
+	static bool
+	AssembleJacobianBatched(int discPart,
+	                        const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                        ConstSmartPtr<domain_type> spDomain,
+	                        ConstSmartPtr<DoFDistribution> dd,
+	                        TIterator iterBegin,
+	                        TIterator iterEnd,
+	                        int si, bool bNonRegularGrid,
+	                        matrix_type& J,
+	                        const vector_type& u,
+	                        ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+		if(spAssTuner->elem_batch_size() == 0) return false;
+
+		try
+		{
+		DataEvaluator<domain_type> Eval(discPart,
+						   vElemDisc, dd->function_pattern(), bNonRegularGrid);
+		Eval.prepare_elem_loop(id, si);
+
+		if(!ElemLoopBatchable<TElem>(vElemDisc, false, bNonRegularGrid))
+		{
+			Eval.finish_elem_loop();
+			return false;
+		}
+
+		std::vector<ThreadedElemData<TElem> > vData(spAssTuner->elem_batch_size());
+		LocalElemBatch<domain_type::dim> batch;
+
+		EL_PROFILE_BEGIN(Elem_AssembleJacobianBatched);
+		for(TIterator iter = iterBegin; iter != iterEnd; )
+		{
+		//	gather local data
+			size_t numData;
+			iter = GatherElemChunk<TElem>(vData, numData, spDomain, dd, iter, iterEnd,
+			                              Eval.use_hanging(), u, spAssTuner);
+
+			for(size_t first = 0; first < numData; )
+			{
+			//	compute local jacobians of a batch
+				const size_t last = FillElemBatch<TElem>(batch, vData, first, numData);
+				batch.clear_results();
+				for(size_t i = 0; i < vElemDisc.size(); ++i)
+					vElemDisc[i]->do_add_jac_A_elem_batch(batch);
+
+			//	send local to global matrix in element order
+				for(size_t e = first; e < last; ++e)
+				{
+					LocalMatrix& locJ = vData[e].locJ;
+					locJ.resize(vData[e].ind);
+					locJ = 0.0;
+					batch.add_jac_to(locJ, e - first);
+					spAssTuner->add_local_mat_to_global(J, locJ, dd);
+				}
+				first = last;
+			}
+		}
+		EL_PROFILE_END();
+
+		Eval.finish_elem_loop();
+		}
+		UG_CATCH_THROW("AssembleJacobian (batched): Cannot assemble elements.");
+
+		spAssTuner->batched_elem_loop_done();
+		return true;
+	}
+
+///	batched version of AssembleDefect (stationary)
+/**
+ * \returns		true if the elements have been assembled, false if the loop
+ * 				can not be batched (see ElemLoopBatchable)
+ */
+	template <typename TElem, typename TIterator>
+	static bool
+	AssembleDefectBatched(const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                      ConstSmartPtr<domain_type> spDomain,
+	                      ConstSmartPtr<DoFDistribution> dd,
+	                      TIterator iterBegin,
+	                      TIterator iterEnd,
+	                      int si, bool bNonRegularGrid,
+	                      vector_type& d,
+	                      const vector_type& u,
+	                      ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+		if(spAssTuner->elem_batch_size() == 0) return false;
+
+		try
+		{
+		DataEvaluator<domain_type> Eval(STIFF | RHS,
+						   vElemDisc, dd->function_pattern(), bNonRegularGrid);
+		Eval.prepare_elem_loop(id, si);
+
+		if(!ElemLoopBatchable<TElem>(vElemDisc, true, bNonRegularGrid))
+		{
+			Eval.finish_elem_loop();
+			return false;
+		}
+
+		std::vector<ThreadedElemData<TElem> > vData(spAssTuner->elem_batch_size());
+		LocalElemBatch<domain_type::dim> batch;
+
+		EL_PROFILE_BEGIN(Elem_AssembleDefectBatched);
+		for(TIterator iter = iterBegin; iter != iterEnd; )
+		{
+		//	gather local data
+			size_t numData;
+			iter = GatherElemChunk<TElem>(vData, numData, spDomain, dd, iter, iterEnd,
+			                              Eval.use_hanging(), u, spAssTuner);
+
+			for(size_t first = 0; first < numData; )
+			{
+			//	compute local defects and rhs of a batch
+				const size_t last = FillElemBatch<TElem>(batch, vData, first, numData);
+				batch.clear_results();
+				for(size_t i = 0; i < vElemDisc.size(); ++i)
+					vElemDisc[i]->do_add_def_A_elem_batch(batch);
+				for(size_t i = 0; i < vElemDisc.size(); ++i)
+					vElemDisc[i]->do_add_rhs_elem_batch(batch);
+
+			//	send local to global defect in element order
+				for(size_t e = first; e < last; ++e)
+				{
+					LocalVector& locD = vData[e].locD;
+					locD.resize(vData[e].ind);
+					locD = 0.0;
+					batch.add_def_to(locD, e - first);
+					spAssTuner->add_local_vec_to_global(d, locD, dd);
+				}
+				first = last;
+			}
+		}
+		EL_PROFILE_END();
+
+		Eval.finish_elem_loop();
+		}
+		UG_CATCH_THROW("(stationary) AssembleDefect (batched): Cannot assemble elements.");
+
+		spAssTuner->batched_elem_loop_done();
+		return true;
+	}
+
 }; // class StdGlobAssembler
 
 } // end namespace ug
@@ -38,7 +38,8 @@ namespace ug{
 template <typename TDomain>
 IElemDiscBase<TDomain>::IElemDiscBase(const char* functions, const char* subsets)
 	:	m_spApproxSpace(NULL), m_spFctPattern(0),
-	  	m_timePoint(0), m_pLocalVectorTimeSeries(NULL), m_bStationaryForced(false)
+	  	m_timePoint(0), m_pLocalVectorTimeSeries(NULL), m_bStationaryForced(false),
+		m_bThreadSafeAssembling(false)
 		//,m_id(ROID_UNKNOWN)
 {
 	if(functions == NULL) functions = "";
@@ -54,7 +55,8 @@ IElemDiscBase<TDomain>::
 IElemDiscBase(const std::vector<std::string>& vFct,
                               const std::vector<std::string>& vSubset)
 	: 	m_spApproxSpace(NULL), m_spFctPattern(0),
-		m_timePoint(0), m_pLocalVectorTimeSeries(NULL), m_bStationaryForced(false)
+		m_timePoint(0), m_pLocalVectorTimeSeries(NULL), m_bStationaryForced(false),
+		m_bThreadSafeAssembling(false)
 		//,m_id(ROID_UNKNOWN)
 {
 	set_functions(vFct);
@@ -99,6 +101,10 @@ void IElemAssembleFuncs<TLeaf, TDomain>::clear_add_fct(ReferenceObjectID id)
 	m_vElemdMFct[id] = NULL;
 
 	m_vElemRHSFct[id] = NULL;
+
+	m_vElemJABatchFct[id] = NULL;
+	m_vElemdABatchFct[id] = NULL;
+	m_vElemRHSBatchFct[id] = NULL;
 }
 
 
@@ -198,6 +204,11 @@ set_default_add_fct()
 		m_vElemdMFct[i] = &T::add_def_M_elem;
 
 		m_vElemRHSFct[i] = &T::add_rhs_elem;
+
+	//	there is no default batched assembling
+		m_vElemJABatchFct[i] = NULL;
+		m_vElemdABatchFct[i] = NULL;
+		m_vElemRHSBatchFct[i] = NULL;
 	}
 
 	for (size_t i = 0; i < bridge::NUM_ALGEBRA_TYPES; ++i)
@@ -657,6 +668,42 @@ do_add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCorne
 	(this->*m_vElemRHSFct[m_roid])(rhs, elem, vCornerCoords);
 }
 
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_add_jac_A_elem_batch(LocalElemBatch<dim>& batch)
+{
+	//	access by map
+	batch.access_by_map(asLeaf().map());
+
+	//	call assembling routine
+	UG_ASSERT(m_vElemJABatchFct[m_roid]!=NULL, "ElemDisc method add_jac_A_elem_batch missing.");
+	(this->*m_vElemJABatchFct[m_roid])(batch);
+}
+
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_add_def_A_elem_batch(LocalElemBatch<dim>& batch)
+{
+	//	access by map
+	batch.access_by_map(asLeaf().map());
+
+	//	call assembling routine
+	UG_ASSERT(m_vElemdABatchFct[m_roid]!=NULL, "ElemDisc method add_def_A_elem_batch missing.");
+	(this->*m_vElemdABatchFct[m_roid])(batch);
+}
+
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_add_rhs_elem_batch(LocalElemBatch<dim>& batch)
+{
+	//	access by map
+	batch.access_by_map(asLeaf().map());
+
+	//	call assembling routine
+	UG_ASSERT(m_vElemRHSBatchFct[m_roid]!=NULL, "ElemDisc method add_rhs_elem_batch missing.");
+	(this->*m_vElemRHSBatchFct[m_roid])(batch);
+}
+
 template <typename TLeaf, typename TDomain>
 void IElemEstimatorFuncs<TLeaf, TDomain>::
 do_prep_err_est_elem_loop(const ReferenceObjectID roid, const int si)
@@ -48,6 +48,7 @@
 #include "lib_disc/domain_util.h"
 #include "lib_disc/domain_traits.h"
 #include "elem_modifier.h"
+#include "elem_batch.h"
 #include "lib_disc/spatial_disc/elem_disc/err_est_data.h"
 #include "bridge/util_algebra_dependent.h"
 #include "lib_disc/common/multi_index.h"
@@ -192,8 +193,22 @@ public:
 	void do_add_def_A_expl_elem(LocalVector& d, LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 	void do_add_def_M_elem(LocalVector& d, LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 	void do_add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[]);
+	/// \}
+
+	///	returns if the batched assembling of the Jacobian (Stiffness part) is registered
+	bool add_jac_A_elem_batch_registered(ReferenceObjectID id) const
+	{ return m_vElemJABatchFct[id] != NULL; }
 
+	///	returns if the batched assembling of the Defect (Stiffness part and Rhs) is registered
+	bool add_def_A_elem_batch_registered(ReferenceObjectID id) const
+	{ return m_vElemdABatchFct[id] != NULL && m_vElemRHSBatchFct[id] != NULL; }
 
+	///	function dispatching batched call to implementation
+	/// \{
+	void do_add_jac_A_elem_batch(LocalElemBatch<dim>& batch);
+	void do_add_def_A_elem_batch(LocalElemBatch<dim>& batch);
+	void do_add_rhs_elem_batch(LocalElemBatch<dim>& batch);
+	/// \}
 
 
 protected:
@@ -214,6 +229,26 @@ protected:
 	template <typename TAssFunc> void set_add_def_M_elem_fct(ReferenceObjectID id, TAssFunc func);
 	template <typename TAssFunc> void set_add_rhs_elem_fct(ReferenceObjectID id, TAssFunc func);
 
+	/**
+	 * Optionally, an element discretization can register functions that
+	 * assemble a whole block of elements of one reference object type at once
+	 * (see LocalElemBatch). The batched functions receive the corner
+	 * coordinates and the local solutions of the elements and add the local
+	 * Jacobians, defects (stiffness part) or right-hand sides of all elements
+	 * of the block. Note, that 'prep_elem' is NOT called for the elements of
+	 * a batch. Therefore, a discretization should only register the batched
+	 * functions, if its element contributions can be computed from this data
+	 * alone (e.g. no data imports with non-constant data). The registration
+	 * is checked after 'prep_elem_loop', thus it may be adapted to the data
+	 * used on the subset there. The per-element functions remain required and
+	 * are used whenever batching is not possible.
+	 */
+	/// \{
+	template <typename TAssFunc> void set_add_jac_A_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+	template <typename TAssFunc> void set_add_def_A_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+	template <typename TAssFunc> void set_add_rhs_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+	/// \}
+
 
 
 	//	unregister functions
@@ -233,6 +268,10 @@ protected:
 	void remove_add_def_M_elem_fct(ReferenceObjectID id);
 	void remove_add_rhs_elem_fct(ReferenceObjectID id);
 
+	void remove_add_jac_A_elem_batch_fct(ReferenceObjectID id);
+	void remove_add_def_A_elem_batch_fct(ReferenceObjectID id);
+	void remove_add_rhs_elem_batch_fct(ReferenceObjectID id);
+
 protected:
 	///	sets all assemble functions to the corresponding virtual ones
 	void set_default_add_fct();
@@ -269,6 +308,11 @@ private:
 // 	types of right hand side assemble functions
 	typedef void (T::*ElemRHSFct)(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 
+// 	types of batched assemble functions
+	typedef void (T::*ElemJABatchFct)(LocalElemBatch<dim>& batch);
+	typedef void (T::*ElemdABatchFct)(LocalElemBatch<dim>& batch);
+	typedef void (T::*ElemRHSBatchFct)(LocalElemBatch<dim>& batch);
+
 
 private:
 // 	timestep function pointers
@@ -294,6 +338,11 @@ private:
 // 	Rhs function pointers
 	ElemRHSFct 	m_vElemRHSFct[NUM_REFERENCE_OBJECTS];
 
+// 	batched function pointers
+	ElemJABatchFct 	m_vElemJABatchFct[NUM_REFERENCE_OBJECTS];
+	ElemdABatchFct 	m_vElemdABatchFct[NUM_REFERENCE_OBJECTS];
+	ElemRHSBatchFct m_vElemRHSBatchFct[NUM_REFERENCE_OBJECTS];
+
 public:
 /// sets the geometric object type
 /**
@@ -750,6 +799,26 @@ class IElemDiscBase
 	 * element assemblings but is needed for finite volumes
 	 */
 		virtual bool use_hanging() const {return false;}
+
+	///	sets if the element-wise assembling may be called concurrently
+	/**
+	 * If set to true, the assembling routines may call the element loop
+	 * functions concurrently from several threads (see
+	 * AssemblingTuner::set_num_threads). The first thread uses the elem disc
+	 * itself, every further thread an own copy created by
+	 * IElemDisc::thread_copy, such that the imports and user data (that store
+	 * the evaluated values) are not shared. If a disc can not be copied, e.g.
+	 * since it uses user data that can not be evaluated concurrently (like
+	 * lua callbacks), the sequential loop is used.
+	 */
+		void set_thread_safe_assembling(bool bThreadSafe) {m_bThreadSafeAssembling = bThreadSafe;}
+
+	///	returns if the element-wise assembling may be called concurrently
+		bool thread_safe_assembling() const {return m_bThreadSafeAssembling;}
+
+	protected:
+	///	flag if the element-wise assembling may be called concurrently
+		bool m_bThreadSafeAssembling;
 };
 
 
@@ -842,6 +911,17 @@ protected:
 
 
 public:
+	///	returns a copy of the disc for the assembling on another thread
+	/**
+	 * The copy must have the same setting as this disc, but must use own
+	 * imports and own copies of the user data (see CplUserData::thread_copy).
+	 * It is only used for the element loops of a threaded assembling (see
+	 * set_thread_safe_assembling).
+	 *
+	 * \returns	the copy, or SPNULL if the disc can not be copied (default)
+	 */
+		virtual SmartPtr<IElemDisc<TDomain> > thread_copy() {return SPNULL;}
+
 	void add_elem_modifier(SmartPtr<IElemDiscModifier<TDomain> > elemModifier )
 	{
 			m_spElemModifier.push_back(elemModifier);
@@ -852,6 +932,22 @@ public:
 	{ return m_spElemModifier;}
 
 protected:
+	///	copies the setting of the elem disc base to a thread copy (see thread_copy)
+	/**
+	 * \returns	false if the disc can not be copied, since it uses elem modifiers
+	 */
+		bool init_thread_copy(IElemDisc<TDomain>& copy) const
+		{
+			if(!m_spElemModifier.empty()) return false;
+
+			copy.set_subsets(this->m_vSubset);
+			copy.set_approximation_space(this->m_spApproxSpace);
+			copy.set_stationary(this->m_bStationaryForced);
+			copy.set_time_point(this->m_timePoint);
+			copy.set_thread_safe_assembling(this->m_bThreadSafeAssembling);
+			return true;
+		}
+
 	///	Approximation Space
 	std::vector<SmartPtr<IElemDiscModifier<TDomain> > > m_spElemModifier;
 
@@ -175,6 +175,42 @@ void IElemAssembleFuncs<TLeaf, TDomain>::remove_add_rhs_elem_fct(ReferenceObject
 	m_vElemRHSFct[id] = NULL;
 };
 
+template <typename TLeaf, typename TDomain>
+template<typename TAssFunc>
+void IElemAssembleFuncs<TLeaf, TDomain>::set_add_jac_A_elem_batch_fct(ReferenceObjectID id, TAssFunc func)
+{
+	m_vElemJABatchFct[id] = static_cast<ElemJABatchFct>(func);
+};
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::remove_add_jac_A_elem_batch_fct(ReferenceObjectID id)
+{
+	m_vElemJABatchFct[id] = NULL;
+};
+
+template <typename TLeaf, typename TDomain>
+template<typename TAssFunc>
+void IElemAssembleFuncs<TLeaf, TDomain>::set_add_def_A_elem_batch_fct(ReferenceObjectID id, TAssFunc func)
+{
+	m_vElemdABatchFct[id] = static_cast<ElemdABatchFct>(func);
+};
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::remove_add_def_A_elem_batch_fct(ReferenceObjectID id)
+{
+	m_vElemdABatchFct[id] = NULL;
+};
+
+template <typename TLeaf, typename TDomain>
+template<typename TAssFunc>
+void IElemAssembleFuncs<TLeaf, TDomain>::set_add_rhs_elem_batch_fct(ReferenceObjectID id, TAssFunc func)
+{
+	m_vElemRHSBatchFct[id] = static_cast<ElemRHSBatchFct>(func);
+};
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::remove_add_rhs_elem_batch_fct(ReferenceObjectID id)
+{
+	m_vElemRHSBatchFct[id] = NULL;
+};
+
 template <typename TLeaf, typename TDomain>
 template<typename TAssFunc>
 void IElemAssembleFuncs<TLeaf, TDomain>::set_fsh_timestep_fct(size_t algebra_id, TAssFunc func)
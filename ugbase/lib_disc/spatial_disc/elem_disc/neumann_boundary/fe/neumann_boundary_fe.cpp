@@ -92,6 +92,32 @@ add(SmartPtr<CplUserData<MathVector<dim>, dim> > user, const char* BndSubsets, c
 	this->add_inner_subsets(InnerSubsets);
 }
 
+template<typename TDomain>
+SmartPtr<IElemDisc<TDomain> > NeumannBoundaryFE<TDomain>::thread_copy()
+{
+	SmartPtr<this_type> spCopy = make_sp(new this_type(this->symb_fcts()[0].c_str()));
+
+//	the copy needs own user data, since the evaluated values are stored there
+	for(size_t i = 0; i < m_vNumberData.size(); ++i){
+		SmartPtr<CplUserData<number, dim> > spData = m_vNumberData[i].import.user_data()->thread_copy();
+		if(spData.invalid()) return SPNULL;
+		spCopy->add(spData, m_vNumberData[i].BndSubsetNames.c_str(), m_vNumberData[i].InnerSubsetNames.c_str());
+	}
+	for(size_t i = 0; i < m_vBNDNumberData.size(); ++i){
+		SmartPtr<CplUserData<number, dim, bool> > spData = m_vBNDNumberData[i].functor->thread_copy();
+		if(spData.invalid()) return SPNULL;
+		spCopy->add(spData, m_vBNDNumberData[i].BndSubsetNames.c_str(), m_vBNDNumberData[i].InnerSubsetNames.c_str());
+	}
+	for(size_t i = 0; i < m_vVectorData.size(); ++i){
+		SmartPtr<CplUserData<MathVector<dim>, dim> > spData = m_vVectorData[i].functor->thread_copy();
+		if(spData.invalid()) return SPNULL;
+		spCopy->add(spData, m_vVectorData[i].BndSubsetNames.c_str(), m_vVectorData[i].InnerSubsetNames.c_str());
+	}
+
+	if(!this->init_thread_copy(*spCopy)) return SPNULL;
+	return spCopy;
+}
+
 template<typename TDomain>
 void NeumannBoundaryFE<TDomain>::update_subset_groups()
 {
@@ -67,6 +67,9 @@ class NeumannBoundaryFV
 		void add(SmartPtr<CplUserData<MathVector<dim>, dim> > user, 	const char* BndSubsets, const char* InnerSubsets);
 	/// \}
 
+	///	returns a copy of the disc for the assembling on another thread
+		virtual SmartPtr<IElemDisc<TDomain> > thread_copy();
+
 	protected:
 		using typename base_type::Data;
 
@@ -86,6 +86,32 @@ add(SmartPtr<CplUserData<MathVector<dim>, dim> > user, const char* BndSubsets, c
 	this->add_inner_subsets(InnerSubsets);
 }
 
+template<typename TDomain>
+SmartPtr<IElemDisc<TDomain> > NeumannBoundaryFV1<TDomain>::thread_copy()
+{
+	SmartPtr<this_type> spCopy = make_sp(new this_type(this->symb_fcts()[0].c_str()));
+
+//	the copy needs own user data, since the evaluated values are stored there
+	for(size_t i = 0; i < m_vNumberData.size(); ++i){
+		SmartPtr<CplUserData<number, dim> > spData = m_vNumberData[i].import.user_data()->thread_copy();
+		if(spData.invalid()) return SPNULL;
+		spCopy->add(spData, m_vNumberData[i].BndSubsetNames.c_str(), m_vNumberData[i].InnerSubsetNames.c_str());
+	}
+	for(size_t i = 0; i < m_vBNDNumberData.size(); ++i){
+		SmartPtr<CplUserData<number, dim, bool> > spData = m_vBNDNumberData[i].functor->thread_copy();
+		if(spData.invalid()) return SPNULL;
+		spCopy->add(spData, m_vBNDNumberData[i].BndSubsetNames.c_str(), m_vBNDNumberData[i].InnerSubsetNames.c_str());
+	}
+	for(size_t i = 0; i < m_vVectorData.size(); ++i){
+		SmartPtr<CplUserData<MathVector<dim>, dim> > spData = m_vVectorData[i].functor->thread_copy();
+		if(spData.invalid()) return SPNULL;
+		spCopy->add(spData, m_vVectorData[i].BndSubsetNames.c_str(), m_vVectorData[i].InnerSubsetNames.c_str());
+	}
+
+	if(!this->init_thread_copy(*spCopy)) return SPNULL;
+	return spCopy;
+}
+
 template<typename TDomain>
 void NeumannBoundaryFV1<TDomain>::update_subset_groups()
 {
@@ -110,7 +136,7 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 	m_si = si;
 
 //	register subsetIndex at Geometry
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = GeomProvider<TFVGeom >::get();
 
 //	request subset indices as boundary subset. This will force the
 //	creation of boundary subsets when calling geo.update
@@ -153,6 +179,19 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 		this->register_import(m_vNumberData[data].import);
 		m_vNumberData[data].import.set_rhs_part();
 	}
+
+//	assemble full-dimensional simplices in batches, if no data must be
+//	evaluated at the integration points
+	if(TElem::dim == dim && (dim == 2 || id == ROID_TETRAHEDRON) && constant_data_only()){
+		this->set_add_jac_A_elem_batch_fct(id, &this_type::add_jac_A_elem_batch);
+		this->set_add_def_A_elem_batch_fct(id, &this_type::add_def_A_elem_batch);
+		this->set_add_rhs_elem_batch_fct(id, &this_type::template add_rhs_elem_batch<TElem>);
+	}
+	else{
+		this->remove_add_jac_A_elem_batch_fct(id);
+		this->remove_add_def_A_elem_batch_fct(id);
+		this->remove_add_rhs_elem_batch_fct(id);
+	}
 }
 
 template<typename TDomain>
@@ -161,7 +200,7 @@ void NeumannBoundaryFV1<TDomain>::
 prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
 {
 //  update Geometry for this element
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = GeomProvider<TFVGeom >::get();
 	try{
 		geo.update(elem, vCornerCoords, &(this->subset_handler()));
 	}
@@ -178,7 +217,7 @@ template<typename TElem, typename TFVGeom>
 void NeumannBoundaryFV1<TDomain>::
 add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoords[])
 {
-	const static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	const TFVGeom& geo = GeomProvider<TFVGeom >::get();
 	typedef typename TFVGeom::BF BF;
 
 //	Number Data
@@ -233,13 +272,134 @@ add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoor
 	}
 }
 
+template<typename TDomain>
+bool NeumannBoundaryFV1<TDomain>::
+constant_data_only() const
+{
+	for(size_t i = 0; i < m_vNumberData.size(); ++i)
+		if(m_vNumberData[i].InnerSSGrp.contains(m_si) && !m_vNumberData[i].import.constant())
+			return false;
+	for(size_t i = 0; i < m_vBNDNumberData.size(); ++i)
+		if(m_vBNDNumberData[i].InnerSSGrp.contains(m_si) && !m_vBNDNumberData[i].functor->constant())
+			return false;
+	for(size_t i = 0; i < m_vVectorData.size(); ++i)
+		if(m_vVectorData[i].InnerSSGrp.contains(m_si) && !m_vVectorData[i].functor->constant())
+			return false;
+	return true;
+}
+
+template<typename TDomain>
+template<typename TElem>
+void NeumannBoundaryFV1<TDomain>::
+add_rhs_elem_batch(LocalElemBatch<dim>& batch)
+{
+	static const int refDim = TElem::dim;
+	static const size_t numCo = TElem::NUM_VERTICES;
+	const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+	const ReferenceElement& rRefElem = ReferenceElementProvider::get(id);
+	const ISubsetHandler& sh = this->subset_handler();
+	Grid& grid = *sh.grid();
+
+//	constant flux density (scalar and vector) per boundary subset
+	std::vector<int> vBndSI;
+	std::vector<number> vFlux;
+	std::vector<MathVector<dim> > vFluxVec;
+	const MathVector<dim> zero(0.0);
+
+	for(size_t data = 0; data < m_vNumberData.size(); ++data){
+		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
+			const int si = m_vNumberData[data].BndSSGrp[s];
+			number val;
+			(*m_vNumberData[data].import.user_data())(val, zero, this->time(), si);
+			vBndSI.push_back(si); vFlux.push_back(val); vFluxVec.push_back(zero);
+		}
+	}
+	for(size_t data = 0; data < m_vBNDNumberData.size(); ++data){
+		if(!m_vBNDNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		for(size_t s = 0; s < m_vBNDNumberData[data].BndSSGrp.size(); ++s){
+			const int si = m_vBNDNumberData[data].BndSSGrp[s];
+			number val = 0.0;
+			if(!(*m_vBNDNumberData[data].functor)(val, zero, this->time(), si))
+				continue;
+			vBndSI.push_back(si); vFlux.push_back(val); vFluxVec.push_back(zero);
+		}
+	}
+	for(size_t data = 0; data < m_vVectorData.size(); ++data){
+		if(!m_vVectorData[data].InnerSSGrp.contains(m_si)) continue;
+		for(size_t s = 0; s < m_vVectorData[data].BndSSGrp.size(); ++s){
+			const int si = m_vVectorData[data].BndSSGrp[s];
+			MathVector<dim> val;
+			(*m_vVectorData[data].functor)(val, zero, this->time(), si);
+			vBndSI.push_back(si); vFlux.push_back(0.0); vFluxVec.push_back(val);
+		}
+	}
+	if(vBndSI.empty()) return;
+
+	number* vRhs[numCo];
+	for(size_t co = 0; co < numCo; ++co)
+		vRhs[co] = batch.rhs_ptr(_C_, co);
+
+	for(size_t e = 0; e < batch.num_elem(); ++e)
+	{
+		TElem* elem = static_cast<TElem*>(batch.elem(e));
+
+	//	corner coordinates and center of the element
+		MathVector<dim> vCorner[numCo], center(0.0);
+		for(size_t co = 0; co < numCo; ++co){
+			for(int d = 0; d < dim; ++d)
+				vCorner[co][d] = batch.corner_ptr(co, d)[e];
+			center += vCorner[co];
+		}
+		center /= numCo;
+
+		for(size_t side = 0; side < rRefElem.num(refDim-1); ++side)
+		{
+			const int sideSI = sh.get_subset_index(grid.get_side(elem, side));
+
+		//	outward area normal of the side
+			const size_t numSideCo = rRefElem.num(refDim-1, side, 0);
+			MathVector<dim> normal;
+			bool bNormal = false;
+			for(size_t i = 0; i < vBndSI.size(); ++i){
+				if(vBndSI[i] != sideSI) continue;
+				if(!bNormal){
+					const MathVector<dim>& x0 = vCorner[rRefElem.id(refDim-1, side, 0, 0)];
+					const MathVector<dim>& x1 = vCorner[rRefElem.id(refDim-1, side, 0, 1)];
+					if(dim == 2){
+						normal[0] = x1[1] - x0[1];
+						normal[1] = x0[0] - x1[0];
+					}
+					else{
+						const MathVector<dim>& x2 = vCorner[rRefElem.id(refDim-1, side, 0, 2)];
+						MathVector<dim> a, b;
+						VecSubtract(a, x1, x0);
+						VecSubtract(b, x2, x0);
+						GenVecCross(normal, a, b);
+						normal *= 0.5;
+					}
+					MathVector<dim> toCenter;
+					VecSubtract(toCenter, center, x0);
+					if(VecDot(normal, toCenter) > 0) normal *= -1.0;
+					bNormal = true;
+				}
+
+				const number flux = (vFlux[i] * VecTwoNorm(normal)
+									+ VecDot(vFluxVec[i], normal)) / numSideCo;
+				for(size_t k = 0; k < numSideCo; ++k)
+					vRhs[rRefElem.id(refDim-1, side, 0, k)][e] -= flux;
+			}
+		}
+	}
+}
+
 template<typename TDomain>
 template<typename TElem, typename TGeom>
 void NeumannBoundaryFV1<TDomain>::
 fsh_elem_loop()
 {
 //	remove subsetIndex from Geometry
-	static TGeom& geo = GeomProvider<TGeom >::get();
+	TGeom& geo = GeomProvider<TGeom >::get();
 
 
 //	unrequest subset indices as boundary subset. This will force the
@@ -510,7 +670,7 @@ lin_def(const LocalVector& u,
             const size_t nip)
 {
 //  get finite volume geometry
-	const static TFVGeom& geo = GeomProvider<TFVGeom>::get();
+	const TFVGeom& geo = GeomProvider<TFVGeom>::get();
 	typedef typename TFVGeom::BF BF;
 
 	for(size_t s = 0; s < this->BndSSGrp.size(); ++s)
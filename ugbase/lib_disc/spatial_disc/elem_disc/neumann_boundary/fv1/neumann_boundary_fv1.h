@@ -70,6 +70,9 @@ class NeumannBoundaryFV1
 		void add(SmartPtr<CplUserData<MathVector<dim>, dim> > user, 	const char* BndSubsets, const char* InnerSubsets);
 	/// \}
 
+	///	returns a copy of the disc for the assembling on another thread
+		virtual SmartPtr<IElemDisc<TDomain> > thread_copy();
+
 	protected:
 		using typename base_type::Data;
 
@@ -154,6 +157,24 @@ class NeumannBoundaryFV1
 		template<typename TElem, typename TFVGeom>
 		void add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 
+	///	batched assembling functions for constant data
+	/**
+	 * If only constant data is used on the current subset, the boundary
+	 * fluxes of a block of elements are computed directly from the corner
+	 * coordinates (see LocalElemBatch). Each corner of a boundary side gets
+	 * the same part of the side flux, as the finite volume boundary faces do
+	 * for simplices.
+	 */
+	///	\{
+		void add_jac_A_elem_batch(LocalElemBatch<dim>& batch) {}
+		void add_def_A_elem_batch(LocalElemBatch<dim>& batch) {}
+		template<typename TElem>
+		void add_rhs_elem_batch(LocalElemBatch<dim>& batch);
+	///	\}
+
+	///	returns if the data used on the current subset allows batched assembling
+		bool constant_data_only() const;
+
 	///	prepares the loop over all elements of one type for the computation of the error estimator
 		template <typename TElem, typename TFVGeom>
 		void prep_err_est_elem_loop(const ReferenceObjectID roid, const int si);
@@ -49,6 +49,10 @@ NeumannBoundaryBase<TDomain>::NeumannBoundaryBase(const char* function)
 {
 	if(this->num_fct() != 1)
 		UG_THROW("NeumannBoundaryBase: needed exactly one function.");
+
+//	the element functions only write to the disc and its imports, that are
+//	copied for every thread (see thread_copy)
+	this->set_thread_safe_assembling(true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
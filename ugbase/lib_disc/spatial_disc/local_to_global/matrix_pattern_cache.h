@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__MATRIX_PATTERN_CACHE__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__MATRIX_PATTERN_CACHE__
+
+// extern headers
+#include <vector>
+#include <utility>
+
+// intern headers
+#include "lib_disc/common/local_algebra.h"
+#include "lib_algebra/cpu_algebra/sparsematrix.h"
+
+namespace ug{
+
+/// caches the storage positions of local matrix entries in a global matrix
+/**
+ * When the same matrix is assembled repeatedly on an unchanged grid (e.g. in
+ * every Newton step or time step), all local matrices are added at the same
+ * global positions in the same order. This class exploits this: In a first
+ * assembling pass the global (row, col) pairs of all local entries are
+ * recorded. At the beginning of the next pass the matrix is defragmented, the
+ * pairs are translated into storage positions (slots) of the sparse matrix and
+ * the matrix is cleared retaining its structure. From then on, local entries
+ * are added directly to the values at the cached slots, avoiding the search
+ * for (and insertion of) the entries.
+ *
+ * Each slot is checked against the row range and the column index of the
+ * entry to add, so that a modified assembling sequence or matrix structure
+ * is detected. In this case, the entries are added in the usual way for the
+ * rest of the pass and the pattern is recorded again in the next pass.
+ *
+ * The caching is only available for matrices derived from SparseMatrix. For
+ * other matrix types, the usual resize and add functions are used.
+ */
+class MatrixPatternCache
+{
+	public:
+	///	constructor
+		MatrixPatternCache() : m_state(RECORD), m_pos(0), m_numRows(0) {}
+
+	///	resizes and clears the matrix for a new assembling pass
+	/**
+	 * \param[in]	mat					matrix to be assembled
+	 * \param[in]	numIndex			number of rows and columns
+	 * \param[in]	bRetainStructure	if true, a newly recorded pass keeps the
+	 * 									existing structure of the matrix
+	 */
+		template <typename TMatrix>
+		void resize_and_clear(TMatrix& mat, size_t numIndex, bool bRetainStructure)
+		{
+			if(!resize_and_clear_x(&mat, numIndex, bRetainStructure))
+			{
+				if(bRetainStructure) mat.clear_retain_structure();
+				else mat.resize_and_clear(numIndex, numIndex);
+			}
+		}
+
+	///	adds a local matrix to the global one
+		template <typename TMatrix>
+		void add_local_mat_to_global(TMatrix& mat, const LocalMatrix& lmat)
+		{
+			if(!add_local_mat_to_global_x(&mat, lmat))
+				AddLocalMatrixToGlobal(mat, lmat);
+		}
+
+	///	forgets the cached pattern
+		void clear()
+		{
+			m_state = RECORD; m_pos = 0; m_numRows = 0;
+			std::vector<std::pair<size_t,size_t> >().swap(m_vRowCol);
+			std::vector<int>().swap(m_vSlot);
+		}
+
+	///	returns if the entries are currently added at cached slots
+		bool replaying() const {return m_state == REPLAY;}
+
+	protected:
+	///	resize for sparse matrices
+		template <typename TBlock>
+		bool resize_and_clear_x(SparseMatrix<TBlock>* pMat, size_t numIndex,
+		                        bool bRetainStructure);
+
+	///	no caching for other matrix types
+		bool resize_and_clear_x(const void*, size_t, bool) {return false;}
+
+	///	adding for sparse matrices
+		template <typename TBlock>
+		bool add_local_mat_to_global_x(SparseMatrix<TBlock>* pMat, const LocalMatrix& lmat);
+
+	///	no caching for other matrix types
+		bool add_local_mat_to_global_x(const void*, const LocalMatrix&) {return false;}
+
+	///	returns the slot of (r,c) in a defragmented matrix, -1 if not present
+		template <typename TBlock>
+		static int find_slot(const SparseMatrix<TBlock>& mat, size_t r, size_t c);
+
+	protected:
+	///	states of the current assembling pass
+		enum State
+		{
+			RECORD,		///< (row, col) pairs are recorded
+			REPLAY,		///< entries are added at the cached slots
+			FAILED		///< cached slots not usable, entries are added as usual
+		};
+		State m_state;
+
+	///	recorded (row, col) pairs (in RECORD state)
+		std::vector<std::pair<size_t,size_t> > m_vRowCol;
+
+	///	cached slots in the order of assembling
+		std::vector<int> m_vSlot;
+
+	///	current position in m_vSlot
+		size_t m_pos;
+
+	///	number of rows of the matrix the pattern has been recorded for
+		size_t m_numRows;
+};
+
+template <typename TBlock>
+int MatrixPatternCache::find_slot(const SparseMatrix<TBlock>& mat, size_t r, size_t c)
+{
+	int first = mat.row_start(r);
+	int last = mat.row_end(r);
+	if(first < 0) return -1;
+
+//	columns of a row are sorted
+	while(first < last)
+	{
+		const int mid = (first + last) / 2;
+		if(mat.col_index(mid) < c) first = mid + 1;
+		else last = mid;
+	}
+	if(first < mat.row_end(r) && mat.col_index(first) == c) return first;
+	return -1;
+}
+
+template <typename TBlock>
+bool MatrixPatternCache::resize_and_clear_x(SparseMatrix<TBlock>* pMat,
+                                            size_t numIndex, bool bRetainStructure)
+{
+	SparseMatrix<TBlock>& mat = *pMat;
+	const bool bSameSize = (mat.num_rows() == numIndex && mat.num_cols() == numIndex
+							&& m_numRows == numIndex);
+
+//	a completely recorded pass: translate the pairs into slots
+	if(bSameSize && m_state == RECORD && !m_vRowCol.empty())
+	{
+		mat.defragment();
+		m_vSlot.resize(m_vRowCol.size());
+		bool bValid = true;
+		for(size_t i = 0; i < m_vRowCol.size(); ++i)
+		{
+			m_vSlot[i] = find_slot(mat, m_vRowCol[i].first, m_vRowCol[i].second);
+			if(m_vSlot[i] < 0) {bValid = false; break;}
+		}
+		std::vector<std::pair<size_t,size_t> >().swap(m_vRowCol);
+
+		if(bValid) m_state = REPLAY;
+		else {m_vSlot.clear(); m_state = FAILED;}
+	}
+//	a completely replayed pass: reuse the slots
+	else if(!(bSameSize && m_state == REPLAY && m_pos == m_vSlot.size()))
+		m_state = FAILED;
+
+	if(m_state == REPLAY)
+	{
+		m_pos = 0;
+		mat.clear_retain_structure();
+		return true;
+	}
+
+//	(re-)record the pattern in this pass
+	clear();
+	m_numRows = numIndex;
+	if(bRetainStructure) mat.clear_retain_structure();
+	else mat.resize_and_clear(numIndex, numIndex);
+	return true;
+}
+
+template <typename TBlock>
+bool MatrixPatternCache::add_local_mat_to_global_x(SparseMatrix<TBlock>* pMat,
+                                                   const LocalMatrix& lmat)
+{
+	SparseMatrix<TBlock>& mat = *pMat;
+	const LocalIndices& rowInd = lmat.get_row_indices();
+	const LocalIndices& colInd = lmat.get_col_indices();
+
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			const size_t rowIndex = rowInd.index(fct1,dof1);
+			const size_t rowComp = rowInd.comp(fct1,dof1);
+
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+				{
+					const size_t colIndex = colInd.index(fct2,dof2);
+					const size_t colComp = colInd.comp(fct2,dof2);
+
+					if(m_state == REPLAY)
+					{
+					//	check that the cached slot still holds this entry
+						if(m_pos < m_vSlot.size())
+						{
+							const int slot = m_vSlot[m_pos];
+							if(slot >= mat.row_start(rowIndex) && slot < mat.row_end(rowIndex)
+								&& mat.col_index(slot) == colIndex)
+							{
+								++m_pos;
+								BlockRef(mat.value_at(slot), rowComp, colComp)
+											+= lmat.value(fct1,dof1,fct2,dof2);
+								continue;
+							}
+						}
+						m_state = FAILED;
+					}
+					else if(m_state == RECORD)
+						m_vRowCol.push_back(std::make_pair(rowIndex, colIndex));
+
+					BlockRef(mat(rowIndex, colIndex), rowComp, colComp)
+								+= lmat.value(fct1,dof1,fct2,dof2);
+				}
+		}
+	return true;
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__MATRIX_PATTERN_CACHE__ */
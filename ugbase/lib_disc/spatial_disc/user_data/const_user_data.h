@@ -113,6 +113,12 @@ class StdConstData
 				getImpl().evaluate(this->value(seriesID,ip));
 		}
 
+	///	returns a copy of the data to be evaluated on another thread
+		virtual SmartPtr<CplUserData<TData, dim> > thread_copy() const
+		{
+			return make_sp(new TImpl(getImpl()));
+		}
+
 	///	returns if data is constant
 		virtual bool constant() const {return true;}
 
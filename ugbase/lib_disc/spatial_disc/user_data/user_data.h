@@ -263,6 +263,9 @@ class ICplUserData : virtual public UserDataInfo
 	///	default constructor
 		ICplUserData();
 
+	///	copy constructor, copying only the settings (subset, times), not the ip series
+		ICplUserData(const ICplUserData& other);
+
 	///	clear all data
 		void clear();
 
@@ -542,6 +545,17 @@ class CplUserData : public ICplUserData<dim>, public UserData<TData,dim,TRet>
 	///	destructor
 		~CplUserData() {local_ip_series_to_be_cleared();}
 
+	///	returns a copy of the data to be evaluated on another thread
+	/**
+	 * The threaded element loops give each thread own copies of the elem discs
+	 * (see IElemDisc::thread_copy), that must use own user data, since the
+	 * evaluated values are stored in the user data. The copy has the same
+	 * setting, but no ip series and no registered imports.
+	 *
+	 * \returns	the copy, or SPNULL if the data can not be copied (default)
+	 */
+		virtual SmartPtr<CplUserData<TData,dim,TRet> > thread_copy() const {return SPNULL;}
+
 	///	register external callback, invoked when data storage changed
 		void register_storage_callback(DataImport<TData,dim>* obj, void (DataImport<TData,dim>::*func)());
 
@@ -549,6 +563,13 @@ class CplUserData : public ICplUserData<dim>, public UserData<TData,dim,TRet>
 		void unregister_storage_callback(DataImport<TData,dim>* obj);
 
 	protected:
+	///	default constructor
+		CplUserData() {}
+
+	///	copy constructor, copying neither the values nor the registered callbacks
+		CplUserData(const CplUserData& other)
+			: UserDataInfo(other), base_type(other), UserData<TData,dim,TRet>(other) {}
+
 	///	checks in debug mode the correct index
 		inline void check_series(size_t s) const;
 
@@ -53,6 +53,13 @@ ICplUserData<dim>::ICplUserData()
 	m_vTime.clear(); m_vTime.push_back(0.0);
 }
 
+template <int dim>
+ICplUserData<dim>::ICplUserData(const ICplUserData& other)
+:	UserDataInfo(other),
+ 	m_locPosDim(-1), m_vTime(other.m_vTime), m_timePoint(other.m_timePoint),
+ 	m_defaultTimePoint(other.m_defaultTimePoint), m_si(other.m_si)
+{}
+
 template <int dim>
 void ICplUserData<dim>::clear()
 {
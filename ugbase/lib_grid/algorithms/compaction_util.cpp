@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <vector>
+#include "compaction_util.h"
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/grid/grid_object_pool.h"
+#include "lib_grid/lib_grid_messages.h"
+
+using namespace std;
+
+namespace ug
+{
+
+template <class TElem, class TIterator>
+static size_t RelocateElements(Grid& g, TIterator iterBegin, TIterator iterEnd)
+{
+//	the relocated elements are appended to the section containers, which is
+//	why the current order has to be stored first
+	vector<TElem*> vElem;
+	for(TIterator iter = iterBegin; iter != iterEnd; ++iter){
+		TElem* e = *iter;
+		if(!(e->is_constrained() || e->is_constraining()))
+			vElem.push_back(e);
+	}
+
+	size_t numRelocated = 0;
+	for(size_t i = 0; i < vElem.size(); ++i){
+		if(g.relocate(vElem[i]))
+			++numRelocated;
+	}
+	return numRelocated;
+}
+
+template <class TElem>
+static size_t RelocateElements(Grid& g)
+{
+	if(MultiGrid* pmg = dynamic_cast<MultiGrid*>(&g)){
+		size_t numRelocated = 0;
+		for(size_t lvl = 0; lvl < pmg->num_levels(); ++lvl){
+			numRelocated += RelocateElements<TElem>(g, pmg->begin<TElem>(lvl),
+													pmg->end<TElem>(lvl));
+		}
+		return numRelocated;
+	}
+
+	return RelocateElements<TElem>(g, g.begin<TElem>(), g.end<TElem>());
+}
+
+size_t CompactGridObjectStorage(Grid& g)
+{
+//	all objects are replaced. Listeners like approximation spaces and grid
+//	functions treat this like a grid adaption, i.e. they reassign their indices,
+//	transfer their values and invalidate cached search trees.
+	SPMessageHub msgHub = g.message_hub();
+	msgHub->post_message(GridMessage_Adaption(GMAT_GLOBAL_ADAPTION_BEGINS));
+
+	const bool poolWasEnabled = GridObjectPool::enabled();
+	GridObjectPool::enable(true);
+	GridObjectPool::set_sequential(true);
+
+	size_t numRelocated = 0;
+	try{
+		numRelocated += RelocateElements<Vertex>(g);
+		numRelocated += RelocateElements<Edge>(g);
+		numRelocated += RelocateElements<Face>(g);
+		numRelocated += RelocateElements<Volume>(g);
+	}
+	catch(...){
+		GridObjectPool::set_sequential(false);
+		GridObjectPool::enable(poolWasEnabled);
+		msgHub->post_message(GridMessage_Adaption(GMAT_GLOBAL_ADAPTION_ENDS));
+		throw;
+	}
+
+	GridObjectPool::set_sequential(false);
+	GridObjectPool::enable(poolWasEnabled);
+	msgHub->post_message(GridMessage_Adaption(GMAT_GLOBAL_ADAPTION_ENDS));
+	return numRelocated;
+}
+
+}//	end of namespace
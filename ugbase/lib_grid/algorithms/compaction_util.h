@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_GRID__COMPACTION_UTIL__
+#define __H__UG__LIB_GRID__COMPACTION_UTIL__
+
+#include "lib_grid/grid/grid.h"
+
+namespace ug
+{
+
+///	reallocates the objects of a grid in the order in which they are iterated
+/**	All vertices, edges, faces and volumes are replaced by new instances of
+ * the same type (see Grid::relocate), which are allocated consecutively from
+ * fresh chunks of the GridObjectPool. Afterwards iterating the elements of a
+ * SectionContainer touches memory in increasing address order, and the old,
+ * fragmented chunks are released. For a MultiGrid the elements are relocated
+ * level by level.
+ *
+ * The relocated objects are always allocated from the GridObjectPool, even if
+ * pool allocation is currently disabled.
+ *
+ * Constrained and constraining objects (hanging nodes) store links to each
+ * other, which are not transferred on replacement. Those objects are thus
+ * left at their old position.
+ *
+ * Since all objects are replaced, pointers to grid objects which are not
+ * managed by GridObservers (e.g. in vectors of the caller) become invalid.
+ * Attachments are only passed on if passOnValues was set on attaching.
+ * The relocation is enclosed by GMAT_GLOBAL_ADAPTION_BEGINS and
+ * GMAT_GLOBAL_ADAPTION_ENDS messages on the grid's message hub, so that
+ * approximation spaces and grid functions are updated as after a grid
+ * adaption (this also invalidates search trees cached on them). Still, this
+ * method is cheapest if called after the grid has been loaded and refined and
+ * before discretization objects are created.
+ *
+ * The GridObjectPool is not thread-safe. This method must not run while other
+ * threads create or erase grid objects.
+ *
+ * \returns the number of relocated objects.
+ */
+UG_API size_t CompactGridObjectStorage(Grid& g);
+
+}//	end of namespace
+
+#endif
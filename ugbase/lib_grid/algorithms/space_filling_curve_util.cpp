@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#include "space_filling_curve_util.h"
+#include "common/error.h"
+
+using namespace std;
+
+namespace ug
+{
+
+SpaceFillingCurveType SpaceFillingCurveTypeFromString(const std::string& name)
+{
+	if(name == "morton")
+		return SFC_MORTON;
+	if(name == "hilbert")
+		return SFC_HILBERT;
+	UG_THROW("Unknown space filling curve '" << name
+			 << "'. Valid types are 'morton' and 'hilbert'.");
+}
+
+///	transforms the coordinates to the 'transposed' Hilbert index
+/**	See J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+ * (2004). Afterwards interleaving the bits of the coordinates gives the
+ * position along the Hilbert curve.
+ */
+static void HilbertAxesToTranspose(uint32* X, int n, int b)
+{
+	const uint32 M = uint32(1) << (b - 1);
+
+//	inverse undo
+	for(uint32 Q = M; Q > 1; Q >>= 1){
+		const uint32 P = Q - 1;
+		for(int i = 0; i < n; ++i){
+			if(X[i] & Q)
+				X[0] ^= P;
+			else{
+				const uint32 t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+//	gray encode
+	for(int i = 1; i < n; ++i)
+		X[i] ^= X[i-1];
+
+	uint32 t = 0;
+	for(uint32 Q = M; Q > 1; Q >>= 1){
+		if(X[n-1] & Q)
+			t ^= Q - 1;
+	}
+	for(int i = 0; i < n; ++i)
+		X[i] ^= t;
+}
+
+uint64 SpaceFillingCurveIndex(uint32* coords, int numCoords, int numBits,
+							  SpaceFillingCurveType type)
+{
+	UG_COND_THROW(numBits < 1 || numBits > 32 || numCoords * numBits > 64,
+				  "SpaceFillingCurveIndex: Unsupported number of bits ("
+				  << numBits << ") for " << numCoords << " coordinates.");
+
+	if(type == SFC_HILBERT && numCoords > 1)
+		HilbertAxesToTranspose(coords, numCoords, numBits);
+
+//	interleave bits, starting with the most significant one
+	uint64 index = 0;
+	for(int bit = numBits - 1; bit >= 0; --bit){
+		for(int i = 0; i < numCoords; ++i)
+			index = (index << 1) | ((coords[i] >> bit) & 1);
+	}
+	return index;
+}
+
+}//	end of namespace
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#ifndef __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL__
+#define __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL__
+
+#include <string>
+#include "common/types.h"
+#include "common/math/ugmath_types.h"
+#include "lib_grid/grid/grid.h"
+
+namespace ug
+{
+
+///	types of space filling curves which can be used to order grid objects
+enum SpaceFillingCurveType
+{
+	SFC_MORTON,		///< Z-order curve (bit interleaving)
+	SFC_HILBERT		///< Hilbert curve (better locality, no jumps)
+};
+
+///	returns the curve type for "morton" or "hilbert". Throws otherwise.
+UG_API SpaceFillingCurveType
+SpaceFillingCurveTypeFromString(const std::string& name);
+
+///	computes the position of a quantized point along a space filling curve
+/**	coords contains numCoords integer coordinates, each with numBits
+ * significant bits (numCoords * numBits <= 64, numBits <= 32).
+ * The array is modified by the Hilbert transform.
+ */
+UG_API uint64
+SpaceFillingCurveIndex(uint32* coords, int numCoords, int numBits,
+					   SpaceFillingCurveType type);
+
+
+///	Computes keys along a space filling curve for points in a bounding box.
+/**	The bounding box is mapped to a cube of 2^NUM_BITS cells per direction
+ * (the aspect ratio of the box is preserved). Sorting points by their key
+ * results in an ordering in which points that are close in the sequence are
+ * also close in space.
+ */
+template <int dim>
+class SpaceFillingCurveKey
+{
+	public:
+		static const int NUM_BITS = (64 / dim > 32) ? 32 : 64 / dim;
+
+		SpaceFillingCurveKey(const MathVector<dim>& boxMin,
+							 const MathVector<dim>& boxMax,
+							 SpaceFillingCurveType type = SFC_HILBERT);
+
+		uint64 operator()(const MathVector<dim>& pos) const;
+
+	private:
+		MathVector<dim>			m_min;
+		number					m_scale;
+		SpaceFillingCurveType	m_type;
+};
+
+
+///	reorders the grid objects along a space filling curve
+/**	The elements of each base type (vertices, edges, faces, volumes) are
+ * sorted by the position of their centers along the given space filling curve
+ * and are then relocated in this order (see Grid::relocate). Since relocated
+ * elements are appended to the sections of all SectionContainers of the grid
+ * and its observers (levels of a MultiGrid, subsets of subset handlers, ...),
+ * each section is afterwards iterated along the curve. The new objects are
+ * allocated consecutively from the GridObjectPool, so that the memory layout
+ * follows the same order (cf. CompactGridObjectStorage).
+ *
+ * For a MultiGrid the elements of each level are sorted separately.
+ *
+ * Constrained objects (hanging nodes) are sorted by the center of their
+ * constraining object, so that they follow the curve together with it. The
+ * links between constrained and constraining objects are transferred to the
+ * relocated instances.
+ *
+ * DoFDistributions number indices in the order in which the elements are
+ * iterated. Call this method before approximation spaces are created (or
+ * before they are reinitialized) to obtain a DoF numbering along the curve.
+ * Since all objects are replaced, pointers to grid objects which are not
+ * managed by GridObservers become invalid. Only attachments which were
+ * attached with passOnValues = true keep their values.
+ *
+ * \returns the number of relocated objects.
+ */
+template <class TAAPos>
+size_t SortGridObjectsAlongSpaceFillingCurve(Grid& g, TAAPos aaPos,
+								SpaceFillingCurveType type = SFC_HILBERT);
+
+}//	end of namespace
+
+
+////////////////////////////////
+//	include implementation
+#include "space_filling_curve_util_impl.hpp"
+
+#endif
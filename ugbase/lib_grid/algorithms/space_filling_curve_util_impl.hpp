@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#ifndef __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL_IMPL__
+#define __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL_IMPL__
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "common/error.h"
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/grid/grid_object_pool.h"
+#include "lib_grid/grid_objects/constraint_traits.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+namespace ug
+{
+
+template <int dim>
+SpaceFillingCurveKey<dim>::
+SpaceFillingCurveKey(const MathVector<dim>& boxMin,
+					 const MathVector<dim>& boxMax,
+					 SpaceFillingCurveType type) :
+	m_min(boxMin),
+	m_scale(0),
+	m_type(type)
+{
+	number maxExtent = 0;
+	for(int i = 0; i < dim; ++i)
+		maxExtent = std::max(maxExtent, boxMax[i] - boxMin[i]);
+
+	if(maxExtent > 0){
+	//	the largest representable cell index is 2^NUM_BITS - 1
+		const number maxCell = (number)((uint64(1) << NUM_BITS) - 1);
+		m_scale = maxCell / maxExtent;
+	}
+}
+
+template <int dim>
+uint64 SpaceFillingCurveKey<dim>::
+operator()(const MathVector<dim>& pos) const
+{
+	const number maxCell = (number)((uint64(1) << NUM_BITS) - 1);
+	uint32 coords[dim];
+	for(int i = 0; i < dim; ++i){
+		number c = (pos[i] - m_min[i]) * m_scale;
+		c = std::min(std::max(c, (number)0), maxCell);
+		coords[i] = (uint32)c;
+	}
+	return SpaceFillingCurveIndex(coords, dim, NUM_BITS, m_type);
+}
+
+
+namespace detail{
+namespace sfc{
+
+///	compares pairs of keys and element indices by their keys only
+struct CompareKeys
+{
+	bool operator()(const std::pair<uint64, size_t>& p1,
+					const std::pair<uint64, size_t>& p2) const
+	{
+		return p1.first < p2.first;
+	}
+};
+
+///	returns the constraining object of a constrained element (or NULL)
+template <class TElem>
+GridObject* ConstrainingObject(TElem* e)
+{
+	typedef typename constraint_traits<TElem>::constrained_t constrained_t;
+	if(constrained_t* c = dynamic_cast<constrained_t*>(e))
+		return c->get_constraining_object();
+	return NULL;
+}
+
+inline GridObject* ConstrainingObject(Volume*)	{return NULL;}
+
+template <class TAAPos>
+typename TAAPos::ValueType ObjectCenter(GridObject* o, TAAPos& aaPos)
+{
+	switch(o->base_object_id()){
+		case VERTEX:	return CalculateCenter(static_cast<Vertex*>(o), aaPos);
+		case EDGE:		return CalculateCenter(static_cast<Edge*>(o), aaPos);
+		case FACE:		return CalculateCenter(static_cast<Face*>(o), aaPos);
+		case VOLUME:	return CalculateCenter(static_cast<Volume*>(o), aaPos);
+	}
+	UG_THROW("Unknown base object id: " << o->base_object_id());
+}
+
+template <class TChild, class TConstraining>
+void CollectConstrainedObjects(std::vector<TChild*>& vChildrenOut, TConstraining* c)
+{
+	vChildrenOut.clear();
+	for(size_t i = 0; i < c->template num_constrained<TChild>(); ++i)
+		vChildrenOut.push_back(c->template constrained<TChild>(i));
+}
+
+template <class TChild, class TConstraining>
+void LinkConstrainedObjects(const std::vector<TChild*>& vChildren, TConstraining* c)
+{
+	typedef typename constraint_traits<TChild>::constrained_t constrained_t;
+	for(size_t i = 0; i < vChildren.size(); ++i){
+		c->add_constrained_object(vChildren[i]);
+		if(constrained_t* child = dynamic_cast<constrained_t*>(vChildren[i]))
+			child->set_constraining_object(c);
+	}
+}
+
+template <class TChild>
+void ReplaceInList(std::vector<TChild*>& vChildren, GridObject* oldChild,
+				   GridObject* newChild)
+{
+	for(size_t i = 0; i < vChildren.size(); ++i){
+		if(vChildren[i] == oldChild)
+			vChildren[i] = static_cast<TChild*>(newChild);
+	}
+}
+
+///	the constrained objects of a constraining edge or face
+/**	The lists are cleared and relinked to (possibly other) constraining
+ * objects, which keeps the order of the constrained objects.*/
+struct ConstrainedObjects
+{
+	std::vector<Vertex*>	vVrts;
+	std::vector<Edge*>		vEdges;
+	std::vector<Face*>		vFaces;
+
+	void collect_and_clear(ConstrainingEdge* e)
+	{
+		CollectConstrainedObjects(vVrts, e);
+		CollectConstrainedObjects(vEdges, e);
+		vFaces.clear();
+		e->clear_constrained_objects();
+	}
+
+	void collect_and_clear(ConstrainingFace* f)
+	{
+		CollectConstrainedObjects(vVrts, f);
+		CollectConstrainedObjects(vEdges, f);
+		CollectConstrainedObjects(vFaces, f);
+		f->clear_constrained_objects();
+	}
+
+	void replace(GridObject* oldChild, GridObject* newChild)
+	{
+		ReplaceInList(vVrts, oldChild, newChild);
+		ReplaceInList(vEdges, oldChild, newChild);
+		ReplaceInList(vFaces, oldChild, newChild);
+	}
+
+	void link(ConstrainingEdge* e)
+	{
+		LinkConstrainedObjects(vVrts, e);
+		LinkConstrainedObjects(vEdges, e);
+	}
+
+	void link(ConstrainingFace* f)
+	{
+		LinkConstrainedObjects(vVrts, f);
+		LinkConstrainedObjects(vEdges, f);
+		LinkConstrainedObjects(vFaces, f);
+	}
+};
+
+///	replaces a constrained object in the lists of its constraining object
+inline void ReplaceConstrainedObject(GridObject* constrObj, GridObject* oldChild,
+									 GridObject* newChild)
+{
+	ConstrainedObjects children;
+	if(ConstrainingEdge* ce = dynamic_cast<ConstrainingEdge*>(constrObj)){
+		children.collect_and_clear(ce);
+		children.replace(oldChild, newChild);
+		children.link(ce);
+	}
+	else if(ConstrainingFace* cf = dynamic_cast<ConstrainingFace*>(constrObj)){
+		children.collect_and_clear(cf);
+		children.replace(oldChild, newChild);
+		children.link(cf);
+	}
+}
+
+///	relocates a constrained element and links the new instance to the constraining object
+template <class TConstrained, class TElem>
+TElem* RelocateConstrained(Grid& g, TElem* e)
+{
+	TConstrained* c = static_cast<TConstrained*>(e);
+	GridObject* constrObj = c->get_constraining_object();
+	const int parentBaseObjectId = c->get_parent_base_object_id();
+
+//	unlinked, the replaced instance doesn't remove itself from the
+//	constraining object on deletion
+	c->set_constraining_object(NULL);
+	TElem* eNew = g.relocate(e);
+	if(!eNew){
+		c->set_constraining_object(constrObj);
+		return NULL;
+	}
+
+	TConstrained* cNew = static_cast<TConstrained*>(eNew);
+	if(constrObj){
+		cNew->set_constraining_object(constrObj);
+		ReplaceConstrainedObject(constrObj, e, eNew);
+	}
+	else if(parentBaseObjectId != -1)
+		cNew->set_parent_base_object_id(parentBaseObjectId);
+	return eNew;
+}
+
+///	relocates a constraining element and links its constrained objects to the new instance
+template <class TConstraining, class TElem>
+TElem* RelocateConstraining(Grid& g, TElem* e)
+{
+	TConstraining* c = static_cast<TConstraining*>(e);
+
+//	the replaced instance would unlink the constrained objects on deletion
+	ConstrainedObjects children;
+	children.collect_and_clear(c);
+	TElem* eNew = g.relocate(e);
+
+	children.link(eNew ? static_cast<TConstraining*>(eNew) : c);
+	return eNew;
+}
+
+///	relocates an element (see Grid::relocate) and keeps its constraint links
+inline Vertex* Relocate(Grid& g, Vertex* v)
+{
+	if(ConstrainedVertex* cv = dynamic_cast<ConstrainedVertex*>(v)){
+		const vector2 localCoords = cv->get_local_coordinates();
+		Vertex* vNew = RelocateConstrained<ConstrainedVertex>(g, v);
+		if(vNew)
+			static_cast<ConstrainedVertex*>(vNew)->set_local_coordinates(localCoords);
+		return vNew;
+	}
+	return g.relocate(v);
+}
+
+inline Edge* Relocate(Grid& g, Edge* e)
+{
+	if(dynamic_cast<ConstrainingEdge*>(e))
+		return RelocateConstraining<ConstrainingEdge>(g, e);
+	if(dynamic_cast<ConstrainedEdge*>(e))
+		return RelocateConstrained<ConstrainedEdge>(g, e);
+	return g.relocate(e);
+}
+
+inline Face* Relocate(Grid& g, Face* f)
+{
+	if(dynamic_cast<ConstrainingFace*>(f))
+		return RelocateConstraining<ConstrainingFace>(g, f);
+	if(dynamic_cast<ConstrainedFace*>(f))
+		return RelocateConstrained<ConstrainedFace>(g, f);
+	return g.relocate(f);
+}
+
+inline Volume* Relocate(Grid& g, Volume* v)
+{
+	return g.relocate(v);
+}
+
+template <class TElem, class TIterator, class TKey, class TAAPos>
+size_t RelocateAlongCurve(Grid& g, TIterator iterBegin, TIterator iterEnd,
+						  const TKey& key, TAAPos& aaPos)
+{
+//	the relocated elements are appended to the section containers, which is
+//	why the elements have to be collected first
+	std::vector<TElem*> vElem;
+	std::vector<std::pair<uint64, size_t> > vKeys;
+	for(TIterator iter = iterBegin; iter != iterEnd; ++iter){
+		TElem* e = *iter;
+	//	constrained elements are sorted together with their constraining object
+		GridObject* constrObj = ConstrainingObject(e);
+		if(constrObj)
+			vKeys.push_back(std::make_pair(key(ObjectCenter(constrObj, aaPos)),
+										   vElem.size()));
+		else
+			vKeys.push_back(std::make_pair(key(CalculateCenter(e, aaPos)),
+										   vElem.size()));
+		vElem.push_back(e);
+	}
+
+	std::stable_sort(vKeys.begin(), vKeys.end(), CompareKeys());
+
+	size_t numRelocated = 0;
+	for(size_t i = 0; i < vKeys.size(); ++i){
+		if(Relocate(g, vElem[vKeys[i].second]))
+			++numRelocated;
+	}
+	return numRelocated;
+}
+
+template <class TElem, class TKey, class TAAPos>
+size_t RelocateAlongCurve(Grid& g, const TKey& key, TAAPos& aaPos)
+{
+	if(MultiGrid* pmg = dynamic_cast<MultiGrid*>(&g)){
+		size_t numRelocated = 0;
+		for(size_t lvl = 0; lvl < pmg->num_levels(); ++lvl){
+			numRelocated += RelocateAlongCurve<TElem>(g, pmg->begin<TElem>(lvl),
+													  pmg->end<TElem>(lvl),
+													  key, aaPos);
+		}
+		return numRelocated;
+	}
+
+	return RelocateAlongCurve<TElem>(g, g.begin<TElem>(), g.end<TElem>(),
+									 key, aaPos);
+}
+
+}//	end of namespace sfc
+}//	end of namespace detail
+
+
+template <class TAAPos>
+size_t SortGridObjectsAlongSpaceFillingCurve(Grid& g, TAAPos aaPos,
+											 SpaceFillingCurveType type)
+{
+	typedef typename TAAPos::ValueType vector_t;
+	static const int dim = (int)vector_t::Size;
+
+	if(g.num_vertices() == 0)
+		return 0;
+
+	vector_t boxMin = aaPos[*g.vertices_begin()];
+	vector_t boxMax = boxMin;
+	for(VertexIterator iter = g.vertices_begin(); iter != g.vertices_end(); ++iter){
+		const vector_t& p = aaPos[*iter];
+		for(int i = 0; i < dim; ++i){
+			boxMin[i] = std::min(boxMin[i], p[i]);
+			boxMax[i] = std::max(boxMax[i], p[i]);
+		}
+	}
+
+	SpaceFillingCurveKey<dim> key(boxMin, boxMax, type);
+	const bool poolWasEnabled = GridObjectPool::enabled();
+	GridObjectPool::enable(true);
+	GridObjectPool::set_sequential(true);
+
+	size_t numRelocated = 0;
+	try{
+		numRelocated += detail::sfc::RelocateAlongCurve<Vertex>(g, key, aaPos);
+		numRelocated += detail::sfc::RelocateAlongCurve<Edge>(g, key, aaPos);
+		numRelocated += detail::sfc::RelocateAlongCurve<Face>(g, key, aaPos);
+		numRelocated += detail::sfc::RelocateAlongCurve<Volume>(g, key, aaPos);
+	}
+	catch(...){
+		GridObjectPool::set_sequential(false);
+		GridObjectPool::enable(poolWasEnabled);
+		throw;
+	}
+
+	GridObjectPool::set_sequential(false);
+	GridObjectPool::enable(poolWasEnabled);
+	return numRelocated;
+}
+
+}//	end of namespace
+
+#endif
@@ -131,6 +131,18 @@ struct lg_ntree_traits_base
 		return box.contains_point(point);
 	}
 
+	static real_t box_point_distance_sq(const box_t& box, const vector_t& point)
+	{
+		real_t distSq = 0;
+		for(int i = 0; i < world_dim; ++i){
+			if(point[i] < box.min[i])
+				distSq += sq(box.min[i] - point[i]);
+			else if(point[i] > box.max[i])
+				distSq += sq(point[i] - box.max[i]);
+		}
+		return distSq;
+	}
+
 ///	returns true if the given boxes intersect
 	static bool box_box_intersection(const box_t& box1, const box_t& box2)
 	{
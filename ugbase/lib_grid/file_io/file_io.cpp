@@ -53,6 +53,7 @@
 #include "file_io_dump.h"
 #include "file_io_ncdf.h"
 #include "file_io_ugx.h"
+#include "file_io_ugb.h"
 #include "file_io_msh.h"
 #include "file_io_stl.h"
 #include "file_io_tikz.h"
@@ -208,6 +209,15 @@ static bool LoadGrid(Grid& grid, ISubsetHandler* psh,
 					retVal = LoadGridFromUGX(grid, shTmp, tfile.c_str(), aPos);
 				}
 			}
+			else if(tfile.find(".ugb") != string::npos){
+				if(psh)
+					retVal = LoadGridFromUGB(grid, *psh, tfile.c_str(), aPos);
+				else{
+				//	we have to create a temporary subset handler
+					SubsetHandler shTmp(grid);
+					retVal = LoadGridFromUGB(grid, shTmp, tfile.c_str(), aPos);
+				}
+			}
 			else if(tfile.find(".vtu") != string::npos){
 				if(psh)
 					retVal = LoadGridFromVTU(grid, *psh, tfile.c_str(), aPos);
@@ -274,6 +284,20 @@ static bool LoadGrid(Grid& grid, SPProjectionHandler* ph, size_t& num_ph, ISubse
 					retVal = LoadGridFromUGX(grid, *ph, num_ph, shTmp, additionalSHNames, ash, tfile.c_str(), aPos);
 				}
 			}
+			else if(tfile.find(".ugb") != string::npos){
+			//	subset handlers are matched by name. Projectors are not
+			//	supported by the binary format.
+				SubsetHandler shTmp(grid);
+				vector<ISubsetHandler*> shs(1, psh ? psh : &shTmp);
+				vector<const char*> shNames(1, "defSH");
+				for(size_t i = 0; i < ash.size(); ++i){
+					shs.push_back(ash[i].get());
+					shNames.push_back(additionalSHNames[i].c_str());
+				}
+				retVal = LoadGridFromUGB(grid, tfile.c_str(), &shs.front(),
+										 &shNames.front(), (int)shs.size(),
+										 NULL, 0, aPos);
+			}
 
 			else if(tfile.find(".vtu") != string::npos){
 				if(psh)
@@ -448,6 +472,12 @@ static bool SaveGrid(Grid& grid, ISubsetHandler* psh,
 			return SaveGridToUGX(grid, shTmp, strName.c_str(), aPos);
 		}
 	}
+	else if(strName.find(".ugb") != string::npos){
+		if(psh)
+			return SaveGridToUGB(grid, *psh, filename, aPos);
+		else
+			return SaveGridToUGB(grid, filename, NULL, NULL, 0, NULL, 0, aPos);
+	}
 	else if(strName.find(".vtu") != string::npos){
 		#if (defined UG_PARALLEL && defined UG_DEBUG)
                  std::size_t found=strName.find(".vtu");
@@ -0,0 +1,891 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <fstream>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "file_io_ugb.h"
+#include "common/util/file_util.h"
+#include "common/util/binary_buffer.h"
+#include "common/profiler/profiler.h"
+#include "lib_grid/grid_objects/grid_objects.h"
+#include "lib_grid/global_attachments.h"
+#include "lib_grid/algorithms/serialization.h"
+
+using namespace std;
+
+namespace ug
+{
+
+/*	File layout of ugb files. All values are stored in native byte order,
+ *	which is checked on load through UGB_ENDIANESS.
+ *
+ *	header:		char[8] magic, uint32 version, uint32 endianess,
+ *				uint32 position dimension, uint32 sizeof(int)
+ *	sections:	uint32 type, uint32 (unused), uint64 payload size, payload
+ *
+ *	The last section is of type UGB_END. Payloads are padded to multiples of
+ *	8 bytes and strings are stored as uint64 length followed by the padded
+ *	characters. This way every array in the file starts at an 8 byte boundary
+ *	and can be accessed in place in the mapped file.
+ *
+ *	Elements are indexed separately for each base object type in the order
+ *	in which they appear in the file (for faces and volumes grouped by their
+ *	reference object type). Subset handler, selector and attachment sections
+ *	refer to elements through those indices.
+ */
+enum UGBSectionType
+{
+	UGB_END = 0,
+	UGB_VERTICES = 1,
+	UGB_ELEMENTS = 2,
+	UGB_SUBSET_HANDLER = 3,
+	UGB_SELECTOR = 4,
+	UGB_ATTACHMENT = 5
+};
+
+static const char UGB_MAGIC[8] = {'U', 'G', 'B', 'G', 'R', 'I', 'D', '\0'};
+static const uint32 UGB_VERSION = 1;
+static const uint32 UGB_ENDIANESS = 0x01020304;
+
+///	elements in the order in which they are stored in the file
+struct UGBElements
+{
+	vector<Vertex*>	vrts;
+	vector<Edge*>	edges;
+	vector<Face*>	faces;
+	vector<Volume*>	vols;
+};
+
+static inline size_t UGBPadding(size_t size)
+{
+	return (8 - size % 8) % 8;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	writing
+template <class T>
+static inline void UGBWrite(BinaryBuffer& buf, const T& val)
+{
+	buf.write((const char*)&val, sizeof(T));
+}
+
+static void UGBWritePadding(BinaryBuffer& buf)
+{
+	static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	buf.write(zeros, UGBPadding(buf.write_pos()));
+}
+
+static void UGBWriteString(BinaryBuffer& buf, const string& str)
+{
+	UGBWrite(buf, (uint64)str.size());
+	buf.write(str.c_str(), str.size());
+	UGBWritePadding(buf);
+}
+
+///	writes a section header followed by the given arrays. Pads the payload.
+static void UGBWriteSection(ofstream& out, uint32 type,
+							const char* data1, size_t size1,
+							const char* data2 = NULL, size_t size2 = 0)
+{
+	static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	const uint32 head[2] = {type, 0};
+	const uint64 size = size1 + size2 + UGBPadding(size1 + size2);
+	out.write((const char*)head, sizeof(head));
+	out.write((const char*)&size, sizeof(size));
+	if(size1 > 0)
+		out.write(data1, size1);
+	if(size2 > 0)
+		out.write(data2, size2);
+	out.write(zeros, UGBPadding(size1 + size2));
+}
+
+static void UGBWriteSection(ofstream& out, uint32 type, BinaryBuffer& buf)
+{
+	UGBWriteSection(out, type, buf.buffer(), buf.write_pos());
+}
+
+template <class TElem>
+static void UGBWriteElements(ofstream& out, Grid& grid,
+							 Grid::VertexAttachmentAccessor<AInt>& aaInd,
+							 vector<typename TElem::grid_base_object*>& elemsOut)
+{
+	typedef typename Grid::traits<TElem>::iterator	iter_t;
+	const uint64 num = grid.num<TElem>();
+	if(num == 0)
+		return;
+
+	const uint32 numCorners = (uint32)TElem::NUM_VERTICES;
+	vector<int> inds;
+	inds.reserve(num * numCorners);
+	elemsOut.reserve(elemsOut.size() + num);
+
+	for(iter_t iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		for(uint32 i = 0; i < numCorners; ++i)
+			inds.push_back(aaInd[e->vertex(i)]);
+		elemsOut.push_back(e);
+	}
+
+	BinaryBuffer head;
+	UGBWrite(head, (uint32)geometry_traits<TElem>::REFERENCE_OBJECT_ID);
+	UGBWrite(head, numCorners);
+	UGBWrite(head, num);
+	UGBWriteSection(out, UGB_ELEMENTS, head.buffer(), head.write_pos(),
+					(const char*)&inds.front(), inds.size() * sizeof(int));
+}
+
+template <class TElem>
+static void UGBWriteSubsetIndices(BinaryBuffer& buf, ISubsetHandler& sh,
+								  const vector<TElem*>& elems)
+{
+	for(size_t i = 0; i < elems.size(); ++i)
+		UGBWrite(buf, (int)sh.get_subset_index(elems[i]));
+	UGBWritePadding(buf);
+}
+
+static void UGBWriteSubsetHandler(ofstream& out, ISubsetHandler& sh,
+								  const char* name, const UGBElements& elems)
+{
+	BinaryBuffer buf;
+	UGBWriteString(buf, name ? string(name) : string());
+
+	UGBWrite(buf, (uint64)sh.num_subsets());
+	for(int i = 0; i < sh.num_subsets(); ++i){
+		const SubsetInfo& si = sh.subset_info(i);
+		UGBWriteString(buf, si.name);
+		for(int j = 0; j < 4; ++j)
+			UGBWrite(buf, (double)si.color[j]);
+		UGBWrite(buf, (int)si.materialIndex);
+		UGBWrite(buf, (uint32)si.subsetState);
+	}
+
+//	element types which are not supported by the handler are skipped
+	const uint64 counts[4] = {
+		sh.elements_are_supported(SHE_VERTEX) ? elems.vrts.size() : 0,
+		sh.elements_are_supported(SHE_EDGE) ? elems.edges.size() : 0,
+		sh.elements_are_supported(SHE_FACE) ? elems.faces.size() : 0,
+		sh.elements_are_supported(SHE_VOLUME) ? elems.vols.size() : 0};
+
+	buf.write((const char*)counts, sizeof(counts));
+	if(counts[0] > 0) UGBWriteSubsetIndices(buf, sh, elems.vrts);
+	if(counts[1] > 0) UGBWriteSubsetIndices(buf, sh, elems.edges);
+	if(counts[2] > 0) UGBWriteSubsetIndices(buf, sh, elems.faces);
+	if(counts[3] > 0) UGBWriteSubsetIndices(buf, sh, elems.vols);
+
+	UGBWriteSection(out, UGB_SUBSET_HANDLER, buf);
+}
+
+template <class TElem>
+static void UGBWriteSelectionStates(BinaryBuffer& buf, ISelector& sel,
+									const vector<TElem*>& elems)
+{
+	for(size_t i = 0; i < elems.size(); ++i)
+		UGBWrite(buf, sel.get_selection_status(elems[i]));
+	UGBWritePadding(buf);
+}
+
+static void UGBWriteSelector(ofstream& out, ISelector& sel,
+							 const UGBElements& elems)
+{
+	BinaryBuffer buf;
+	const uint64 counts[4] = {
+		sel.elements_are_supported(SE_VERTEX) ? elems.vrts.size() : 0,
+		sel.elements_are_supported(SE_EDGE) ? elems.edges.size() : 0,
+		sel.elements_are_supported(SE_FACE) ? elems.faces.size() : 0,
+		sel.elements_are_supported(SE_VOLUME) ? elems.vols.size() : 0};
+
+	buf.write((const char*)counts, sizeof(counts));
+	if(counts[0] > 0) UGBWriteSelectionStates(buf, sel, elems.vrts);
+	if(counts[1] > 0) UGBWriteSelectionStates(buf, sel, elems.edges);
+	if(counts[2] > 0) UGBWriteSelectionStates(buf, sel, elems.faces);
+	if(counts[3] > 0) UGBWriteSelectionStates(buf, sel, elems.vols);
+
+	UGBWriteSection(out, UGB_SELECTOR, buf);
+}
+
+///	writes all global attachments which are attached to elements of type TElem
+template <class TElem>
+static void UGBWriteAttachments(ofstream& out, Grid& grid,
+								const vector<TElem*>& elems)
+{
+	const vector<string>& names = GlobalAttachments::declared_attachment_names();
+	for(size_t i = 0; i < names.size(); ++i){
+		const string& name = names[i];
+		if(!GlobalAttachments::is_attached<TElem>(grid, name))
+			continue;
+
+		GridDataSerializationHandler handler;
+		GlobalAttachments::add_data_serializer<TElem>(handler, grid, name);
+		BinaryBuffer data;
+		handler.serialize(data, elems.begin(), elems.end());
+
+		BinaryBuffer head;
+		UGBWriteString(head, name);
+		UGBWriteString(head, GlobalAttachments::type_name(name));
+		UGBWrite(head, (uint32)TElem::BASE_OBJECT_ID);
+		UGBWrite(head, (uint32)GlobalAttachments::attachment_pass_on_behaviour(name));
+		UGBWrite(head, (uint64)elems.size());
+		UGBWrite(head, (uint64)data.write_pos());
+
+		UGBWriteSection(out, UGB_ATTACHMENT, head.buffer(), head.write_pos(),
+						data.buffer(), data.write_pos());
+	}
+}
+
+
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, const char* filename,
+				   ISubsetHandler** ppSH, const char** shNames, int numSHs,
+				   ISelector** ppSel, int numSels,
+				   TAPosition& aPos)
+{
+	PROFILE_FUNC_GROUP("grid");
+	typedef typename TAPosition::ValueType	vector_t;
+	const int dim = (int)vector_t::Size;
+
+	if(!grid.has_vertex_attachment(aPos)){
+		UG_LOG("ERROR in SaveGridToUGB: position attachment is not attached to the grid.\n");
+		return false;
+	}
+
+	if(grid.num<Vertex>() != grid.num<RegularVertex>()
+	   || grid.num<Edge>() != grid.num<RegularEdge>()
+	   || grid.num<Face>() != grid.num<Triangle>() + grid.num<Quadrilateral>())
+	{
+		UG_LOG("ERROR in SaveGridToUGB: constrained or constraining elements "
+			   "are not supported by the ugb format. Please use ugx instead.\n");
+		return false;
+	}
+
+	ofstream out(filename, ios::binary);
+	if(!out){
+		UG_LOG("ERROR in SaveGridToUGB: couldn't open file: " << filename << endl);
+		return false;
+	}
+
+	out.write(UGB_MAGIC, sizeof(UGB_MAGIC));
+	const uint32 header[4] = {UGB_VERSION, UGB_ENDIANESS, (uint32)dim,
+							  (uint32)sizeof(int)};
+	out.write((const char*)header, sizeof(header));
+
+//	vertices. Their indices are stored in aInd to write the element corners.
+	UGBElements elems;
+	AInt aInd;
+	grid.attach_to_vertices(aInd);
+	Grid::VertexAttachmentAccessor<AInt> aaInd(grid, aInd);
+	{
+		Grid::VertexAttachmentAccessor<TAPosition> aaPos(grid, aPos);
+		const uint64 num = grid.num<Vertex>();
+		vector<double> coords;
+		coords.reserve(num * dim);
+		elems.vrts.reserve(num);
+
+		for(VertexIterator iter = grid.vertices_begin();
+			iter != grid.vertices_end(); ++iter)
+		{
+			Vertex* vrt = *iter;
+			aaInd[vrt] = (int)elems.vrts.size();
+			elems.vrts.push_back(vrt);
+			const vector_t& p = aaPos[vrt];
+			for(int i = 0; i < dim; ++i)
+				coords.push_back(p[i]);
+		}
+
+		UGBWriteSection(out, UGB_VERTICES, (const char*)&num, sizeof(num),
+						(const char*)&coords.front(),
+						coords.size() * sizeof(double));
+	}
+
+//	elements, grouped by their reference object type
+	UGBWriteElements<RegularEdge>(out, grid, aaInd, elems.edges);
+	UGBWriteElements<Triangle>(out, grid, aaInd, elems.faces);
+	UGBWriteElements<Quadrilateral>(out, grid, aaInd, elems.faces);
+	UGBWriteElements<Tetrahedron>(out, grid, aaInd, elems.vols);
+	UGBWriteElements<Pyramid>(out, grid, aaInd, elems.vols);
+	UGBWriteElements<Prism>(out, grid, aaInd, elems.vols);
+	UGBWriteElements<Hexahedron>(out, grid, aaInd, elems.vols);
+	UGBWriteElements<Octahedron>(out, grid, aaInd, elems.vols);
+
+	grid.detach_from_vertices(aInd);
+
+	if(elems.vols.size() != grid.num<Volume>()){
+		UG_LOG("ERROR in SaveGridToUGB: unsupported volume type encountered.\n");
+		return false;
+	}
+
+	for(int i = 0; i < numSHs; ++i)
+		UGBWriteSubsetHandler(out, *ppSH[i], shNames ? shNames[i] : NULL, elems);
+
+	for(int i = 0; i < numSels; ++i)
+		UGBWriteSelector(out, *ppSel[i], elems);
+
+	UGBWriteAttachments(out, grid, elems.vrts);
+	UGBWriteAttachments(out, grid, elems.edges);
+	UGBWriteAttachments(out, grid, elems.faces);
+	UGBWriteAttachments(out, grid, elems.vols);
+
+	UGBWriteSection(out, UGB_END, NULL, 0);
+
+	if(!out){
+		UG_LOG("ERROR in SaveGridToUGB: couldn't write to file: " << filename << endl);
+		return false;
+	}
+	return true;
+}
+
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh,
+				   const char* filename, TAPosition& aPos)
+{
+	ISubsetHandler* psh = &sh;
+	const char* shName = "defSH";
+	return SaveGridToUGB(grid, filename, &psh, &shName, 1, NULL, 0, aPos);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	reading
+///	Sequential access to a block of the mapped file.
+/**	All accesses are checked against the size of the block. Once an access
+ * failed, ok() returns false and all further reads return NULL or zero.*/
+class UGBReader
+{
+	public:
+		UGBReader(const char* data, size_t size) :
+			m_data(data), m_size(size), m_pos(0), m_ok(true)	{}
+
+		bool ok() const				{return m_ok;}
+		size_t remaining() const	{return m_size - m_pos;}
+
+		template <class T>
+		T read()
+		{
+			T val = T();
+			if(require(1, sizeof(T))){
+				memcpy(&val, m_data + m_pos, sizeof(T));
+				m_pos += sizeof(T);
+			}
+			return val;
+		}
+
+	///	returns a pointer to num consecutive entries of type T and skips the padding
+		template <class T>
+		const T* read_array(uint64 num)
+		{
+			if(!require(num, sizeof(T)))
+				return NULL;
+			const T* p = reinterpret_cast<const T*>(m_data + m_pos);
+			m_pos += num * sizeof(T);
+			skip_padding();
+			return p;
+		}
+
+		string read_string()
+		{
+			const uint64 len = read<uint64>();
+			const char* p = read_array<char>(len);
+			if(!p)
+				return string();
+			return string(p, len);
+		}
+
+	private:
+		bool require(uint64 num, size_t elemSize)
+		{
+			if(m_ok && num > remaining() / elemSize)
+				m_ok = false;
+			return m_ok;
+		}
+
+		void skip_padding()
+		{
+			const size_t pad = UGBPadding(m_pos);
+			if(pad > remaining())
+				m_ok = false;
+			else
+				m_pos += pad;
+		}
+
+		const char*	m_data;
+		size_t		m_size;
+		size_t		m_pos;
+		bool		m_ok;
+};
+
+static uint32 UGBNumCorners(uint32 roid)
+{
+	switch(roid){
+		case ROID_EDGE:				return 2;
+		case ROID_TRIANGLE:			return 3;
+		case ROID_QUADRILATERAL:	return 4;
+		case ROID_TETRAHEDRON:		return 4;
+		case ROID_PYRAMID:			return 5;
+		case ROID_PRISM:			return 6;
+		case ROID_HEXAHEDRON:		return 8;
+		case ROID_OCTAHEDRON:		return 6;
+		default:					return 0;
+	}
+}
+
+template <class TVector>
+static bool UGBReadVertices(Grid& grid, UGBReader& in, int posDim,
+							Grid::VertexAttachmentAccessor<Attachment<TVector> >& aaPos,
+							vector<Vertex*>& vrts)
+{
+	const int dim = (int)TVector::Size;
+	const int minDim = min(dim, posDim);
+
+	const uint64 num = in.read<uint64>();
+	if(num > in.remaining())
+		return false;
+	const double* coords = in.read_array<double>(num * posDim);
+	if(!coords)
+		return false;
+
+	grid.reserve<Vertex>(grid.num<Vertex>() + num);
+	vrts.reserve(vrts.size() + num);
+
+	for(uint64 i = 0; i < num; ++i, coords += posDim){
+		Vertex* vrt = *grid.create<RegularVertex>();
+		TVector& p = aaPos[vrt];
+		for(int j = 0; j < minDim; ++j)
+			p[j] = coords[j];
+		for(int j = minDim; j < dim; ++j)
+			p[j] = 0;
+		vrts.push_back(vrt);
+	}
+	return true;
+}
+
+static bool UGBReadElements(Grid& grid, UGBReader& in, UGBElements& elems)
+{
+	const uint32 roid = in.read<uint32>();
+	const uint32 numCorners = in.read<uint32>();
+	const uint64 num = in.read<uint64>();
+
+	if(numCorners == 0 || numCorners != UGBNumCorners(roid)){
+		UG_LOG("ERROR in LoadGridFromUGB: unsupported element type: " << roid << endl);
+		return false;
+	}
+	if(num > in.remaining())
+		return false;
+	const int* inds = in.read_array<int>(num * numCorners);
+	if(!inds)
+		return false;
+
+	switch(roid){
+		case ROID_EDGE:
+			grid.reserve<Edge>(grid.num<Edge>() + num);
+			elems.edges.reserve(elems.edges.size() + num);
+			break;
+		case ROID_TRIANGLE:
+		case ROID_QUADRILATERAL:
+			grid.reserve<Face>(grid.num<Face>() + num);
+			elems.faces.reserve(elems.faces.size() + num);
+			break;
+		default:
+			grid.reserve<Volume>(grid.num<Volume>() + num);
+			elems.vols.reserve(elems.vols.size() + num);
+			break;
+	}
+
+	const vector<Vertex*>& vrts = elems.vrts;
+	Vertex* v[8];
+	for(uint64 i = 0; i < num; ++i, inds += numCorners){
+		for(uint32 j = 0; j < numCorners; ++j){
+			if(inds[j] < 0 || (size_t)inds[j] >= vrts.size()){
+				UG_LOG("ERROR in LoadGridFromUGB: bad vertex index: " << inds[j] << endl);
+				return false;
+			}
+			v[j] = vrts[inds[j]];
+		}
+
+		switch(roid){
+			case ROID_EDGE:
+				elems.edges.push_back(*grid.create<RegularEdge>(
+						EdgeDescriptor(v[0], v[1])));
+				break;
+			case ROID_TRIANGLE:
+				elems.faces.push_back(*grid.create<Triangle>(
+						TriangleDescriptor(v[0], v[1], v[2])));
+				break;
+			case ROID_QUADRILATERAL:
+				elems.faces.push_back(*grid.create<Quadrilateral>(
+						QuadrilateralDescriptor(v[0], v[1], v[2], v[3])));
+				break;
+			case ROID_TETRAHEDRON:
+				elems.vols.push_back(*grid.create<Tetrahedron>(
+						TetrahedronDescriptor(v[0], v[1], v[2], v[3])));
+				break;
+			case ROID_PYRAMID:
+				elems.vols.push_back(*grid.create<Pyramid>(
+						PyramidDescriptor(v[0], v[1], v[2], v[3], v[4])));
+				break;
+			case ROID_PRISM:
+				elems.vols.push_back(*grid.create<Prism>(
+						PrismDescriptor(v[0], v[1], v[2], v[3], v[4], v[5])));
+				break;
+			case ROID_HEXAHEDRON:
+				elems.vols.push_back(*grid.create<Hexahedron>(
+						HexahedronDescriptor(v[0], v[1], v[2], v[3],
+											 v[4], v[5], v[6], v[7])));
+				break;
+			case ROID_OCTAHEDRON:
+				elems.vols.push_back(*grid.create<Octahedron>(
+						OctahedronDescriptor(v[0], v[1], v[2], v[3], v[4], v[5])));
+				break;
+		}
+	}
+	return true;
+}
+
+template <class TElem>
+static bool UGBReadSubsetIndices(UGBReader& in, ISubsetHandler* sh,
+								 uint64 num, const vector<TElem*>& elems)
+{
+	if(num == 0)
+		return true;
+	if(num != elems.size())
+		return false;
+	const int* inds = in.read_array<int>(num);
+	if(!inds)
+		return false;
+	if(sh){
+		for(size_t i = 0; i < elems.size(); ++i){
+			if(inds[i] >= 0)
+				sh->assign_subset(elems[i], inds[i]);
+		}
+	}
+	return true;
+}
+
+///	reads a subset handler section. If sh is NULL, the section is only parsed.
+static bool UGBReadSubsetHandler(UGBReader& in, ISubsetHandler* sh,
+								 const UGBElements& elems)
+{
+	const uint64 numSubsets = in.read<uint64>();
+	for(uint64 i = 0; i < numSubsets && in.ok(); ++i){
+		string name = in.read_string();
+		vector4 color;
+		for(int j = 0; j < 4; ++j)
+			color[j] = in.read<double>();
+		const int materialIndex = in.read<int>();
+		const uint32 subsetState = in.read<uint32>();
+
+		if(sh){
+			sh->subset_required((int)i);
+			SubsetInfo& si = sh->subset_info((int)i);
+			si.name = name;
+			si.color = color;
+			si.materialIndex = materialIndex;
+			si.subsetState = subsetState;
+		}
+	}
+
+	const uint64* counts = in.read_array<uint64>(4);
+	if(!counts)
+		return false;
+
+	return UGBReadSubsetIndices(in, sh, counts[0], elems.vrts)
+		&& UGBReadSubsetIndices(in, sh, counts[1], elems.edges)
+		&& UGBReadSubsetIndices(in, sh, counts[2], elems.faces)
+		&& UGBReadSubsetIndices(in, sh, counts[3], elems.vols);
+}
+
+template <class TElem>
+static bool UGBReadSelectionStates(UGBReader& in, ISelector* sel, uint shElem,
+								   uint64 num, const vector<TElem*>& elems)
+{
+	if(num == 0)
+		return true;
+	if(num != elems.size())
+		return false;
+	const byte* states = in.read_array<byte>(num);
+	if(!states)
+		return false;
+	if(sel && sel->elements_are_supported(shElem)){
+		for(size_t i = 0; i < elems.size(); ++i){
+			if(states[i])
+				sel->select(elems[i], states[i]);
+		}
+	}
+	return true;
+}
+
+static bool UGBReadSelector(UGBReader& in, ISelector* sel,
+							const UGBElements& elems)
+{
+	const uint64* counts = in.read_array<uint64>(4);
+	if(!counts)
+		return false;
+
+	return UGBReadSelectionStates(in, sel, SE_VERTEX, counts[0], elems.vrts)
+		&& UGBReadSelectionStates(in, sel, SE_EDGE, counts[1], elems.edges)
+		&& UGBReadSelectionStates(in, sel, SE_FACE, counts[2], elems.faces)
+		&& UGBReadSelectionStates(in, sel, SE_VOLUME, counts[3], elems.vols);
+}
+
+template <class TElem>
+static bool UGBReadAttachmentValues(Grid& grid, const string& name,
+									const char* data, size_t size,
+									const vector<TElem*>& elems)
+{
+	GlobalAttachments::attach<TElem>(grid, name);
+
+	GridDataSerializationHandler handler;
+	GlobalAttachments::add_data_serializer<TElem>(handler, grid, name);
+
+	BinaryBuffer buf(size);
+	buf.write(data, size);
+
+	handler.deserialization_starts();
+	handler.deserialize(buf, elems.begin(), elems.end());
+	handler.deserialization_done();
+
+	return buf.read_pos() == size;
+}
+
+static bool UGBReadAttachment(Grid& grid, UGBReader& in,
+							  const UGBElements& elems)
+{
+	const string name = in.read_string();
+	const string type = in.read_string();
+	const uint32 objType = in.read<uint32>();
+	const bool passOn = in.read<uint32>() != 0;
+	const uint64 num = in.read<uint64>();
+	const uint64 size = in.read<uint64>();
+	const char* data = in.read_array<char>(size);
+	if(!data)
+		return false;
+
+	if(!GlobalAttachments::is_declared(name)){
+		if(GlobalAttachments::type_is_registered(type))
+			GlobalAttachments::declare_attachment(name, type, passOn);
+		else
+			return true;
+	}
+
+	if(type.compare(GlobalAttachments::type_name(name)) != 0){
+		UG_LOG("ERROR in LoadGridFromUGB: attachment type mismatch for '" << name
+			   << "'. Expecting type: " << GlobalAttachments::type_name(name)
+			   << ", but given type is: " << type << endl);
+		return false;
+	}
+
+	bool retVal = false;
+	switch(objType){
+		case VERTEX:
+			retVal = (num == elems.vrts.size())
+				&& UGBReadAttachmentValues(grid, name, data, size, elems.vrts);
+			break;
+		case EDGE:
+			retVal = (num == elems.edges.size())
+				&& UGBReadAttachmentValues(grid, name, data, size, elems.edges);
+			break;
+		case FACE:
+			retVal = (num == elems.faces.size())
+				&& UGBReadAttachmentValues(grid, name, data, size, elems.faces);
+			break;
+		case VOLUME:
+			retVal = (num == elems.vols.size())
+				&& UGBReadAttachmentValues(grid, name, data, size, elems.vols);
+			break;
+	}
+
+	if(!retVal){
+		UG_LOG("ERROR in LoadGridFromUGB: bad data for attachment '" << name << "'\n");
+	}
+	return retVal;
+}
+
+///	returns the index of the target for the i-th stored subset handler or -1
+static int UGBTargetIndex(const string& name, int i,
+						  const char** names, int numTargets)
+{
+	if(!names)
+		return i < numTargets ? i : -1;
+
+	for(int j = 0; j < numTargets; ++j){
+		if(name.compare(names[j]) == 0)
+			return j;
+	}
+	return -1;
+}
+
+
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, const char* filename,
+					 ISubsetHandler** ppSH, const char** shNames, int numSHs,
+					 ISelector** ppSel, int numSels,
+					 TAPosition& aPos)
+{
+	PROFILE_FUNC_GROUP("grid");
+
+	MappedFile file;
+	if(!file.open(filename)){
+		UG_LOG("ERROR in LoadGridFromUGB: couldn't open file: " << filename << endl);
+		return false;
+	}
+
+	UGBReader in(file.data(), file.size());
+
+//	check the header
+	const char* magic = in.read_array<char>(sizeof(UGB_MAGIC));
+	const uint32 version = in.read<uint32>();
+	const uint32 endianess = in.read<uint32>();
+	const uint32 posDim = in.read<uint32>();
+	const uint32 intSize = in.read<uint32>();
+
+	if(!magic || memcmp(magic, UGB_MAGIC, sizeof(UGB_MAGIC)) != 0){
+		UG_LOG("ERROR in LoadGridFromUGB: not a ugb file: " << filename << endl);
+		return false;
+	}
+	if(version != UGB_VERSION){
+		UG_LOG("ERROR in LoadGridFromUGB: bad file-version: " << version
+			   << ". Expected " << UGB_VERSION << ".\n");
+		return false;
+	}
+	if(endianess != UGB_ENDIANESS){
+		UG_LOG("ERROR in LoadGridFromUGB: wrong endianess\n");
+		return false;
+	}
+	if(intSize != sizeof(int) || posDim < 1 || posDim > 3){
+		UG_LOG("ERROR in LoadGridFromUGB: bad header in file: " << filename << endl);
+		return false;
+	}
+
+	if(!grid.has_vertex_attachment(aPos))
+		grid.attach_to_vertices(aPos);
+	Grid::VertexAttachmentAccessor<TAPosition> aaPos(grid, aPos);
+
+//	to avoid problems with autgenerated elements we'll deactivate
+//	all options and reactivate them later on
+	uint gridOptions = grid.get_options();
+	grid.set_options(GRIDOPT_NONE);
+
+	UGBElements elems;
+	int shCount = 0;
+	int selCount = 0;
+	bool retVal = true;
+//	the grid options have to be restored, even if reading fails with an exception
+	try{
+		while(retVal){
+			const uint32 type = in.read<uint32>();
+			in.read<uint32>();
+			const uint64 size = in.read<uint64>();
+			const char* payload = in.read_array<char>(size);
+			if(!in.ok()){
+				retVal = false;
+				break;
+			}
+
+			if(type == UGB_END)
+				break;
+
+			UGBReader sec(payload, size);
+			switch(type){
+				case UGB_VERTICES:
+					retVal = UGBReadVertices(grid, sec, (int)posDim, aaPos, elems.vrts);
+					break;
+				case UGB_ELEMENTS:
+					retVal = UGBReadElements(grid, sec, elems);
+					break;
+				case UGB_SUBSET_HANDLER:{
+					const string name = sec.read_string();
+					int target = UGBTargetIndex(name, shCount++, shNames, numSHs);
+					retVal = UGBReadSubsetHandler(sec, target >= 0 ? ppSH[target] : NULL,
+												  elems);
+				}break;
+				case UGB_SELECTOR:{
+					int target = UGBTargetIndex(string(), selCount++, NULL, numSels);
+					retVal = UGBReadSelector(sec, target >= 0 ? ppSel[target] : NULL,
+											 elems);
+				}break;
+				case UGB_ATTACHMENT:
+					retVal = UGBReadAttachment(grid, sec, elems);
+					break;
+				default:
+				//	sections of unknown type are skipped
+					break;
+			}
+			retVal = retVal && sec.ok();
+		}
+	}
+	catch(...){
+		grid.set_options(gridOptions);
+		throw;
+	}
+
+	grid.set_options(gridOptions);
+
+	if(!retVal){
+		UG_LOG("ERROR in LoadGridFromUGB: corrupt file: " << filename << endl);
+	}
+	return retVal;
+}
+
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh,
+					 const char* filename, TAPosition& aPos)
+{
+	ISubsetHandler* psh = &sh;
+	return LoadGridFromUGB(grid, filename, &psh, NULL, 1, NULL, 0, aPos);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	explicit instantiations
+template bool SaveGridToUGB(Grid&, const char*, ISubsetHandler**, const char**,
+							int, ISelector**, int, APosition1&);
+template bool SaveGridToUGB(Grid&, const char*, ISubsetHandler**, const char**,
+							int, ISelector**, int, APosition2&);
+template bool SaveGridToUGB(Grid&, const char*, ISubsetHandler**, const char**,
+							int, ISelector**, int, APosition3&);
+
+template bool SaveGridToUGB(Grid&, ISubsetHandler&, const char*, APosition1&);
+template bool SaveGridToUGB(Grid&, ISubsetHandler&, const char*, APosition2&);
+template bool SaveGridToUGB(Grid&, ISubsetHandler&, const char*, APosition3&);
+
+template bool LoadGridFromUGB(Grid&, const char*, ISubsetHandler**, const char**,
+							  int, ISelector**, int, APosition1&);
+template bool LoadGridFromUGB(Grid&, const char*, ISubsetHandler**, const char**,
+							  int, ISelector**, int, APosition2&);
+template bool LoadGridFromUGB(Grid&, const char*, ISubsetHandler**, const char**,
+							  int, ISelector**, int, APosition3&);
+
+template bool LoadGridFromUGB(Grid&, ISubsetHandler&, const char*, APosition1&);
+template bool LoadGridFromUGB(Grid&, ISubsetHandler&, const char*, APosition2&);
+template bool LoadGridFromUGB(Grid&, ISubsetHandler&, const char*, APosition3&);
+
+}//	end of namespace
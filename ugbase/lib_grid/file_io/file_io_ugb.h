@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGB__
+#define __H__LIB_GRID__FILE_IO_UGB__
+
+#include "lib_grid/grid/grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+#include "lib_grid/tools/selector_interface.h"
+#include "lib_grid/common_attachments.h"
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+///	Writes a grid to the binary ugb format.
+/**	The ugb format is the binary counterpart of ugx. Vertex coordinates,
+ * element corner indices, subset indices and selection states are stored
+ * in typed arrays, so that a file can be loaded from a memory mapping in a
+ * single pass. Global attachments (see GlobalAttachments) which are attached
+ * to the grid are written, too.
+ *
+ * Subset handlers are stored together with the names given in shNames (which
+ * may be NULL). Grids with hanging nodes (constrained or constraining
+ * elements) are not supported. Use ugx for those.
+ *
+ * The position attachment can be of any MathVector type, especially
+ * ug::aPosition, ug::aPosition2 and ug::aPosition1.
+ */
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, const char* filename,
+				   ISubsetHandler** ppSH, const char** shNames, int numSHs,
+				   ISelector** ppSel, int numSels,
+				   TAPosition& aPos);
+
+///	Writes a grid and one subset handler to the binary ugb format.
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh,
+				   const char* filename, TAPosition& aPos);
+
+
+////////////////////////////////////////////////////////////////////////
+///	Reads a grid from the binary ugb format.
+/**	The file is mapped into memory (see MappedFile) and the grid is built in
+ * a single pass over its contents.
+ *
+ * If shNames is specified, each subset handler stored in the file is read
+ * into the handler ppSH[i] with shNames[i] equal to its stored name. Otherwise
+ * the stored subset handlers are assigned to ppSH by position. The same
+ * holds for selectors. Stored global attachments are declared if required
+ * and attached to the grid.
+ *
+ * If the dimension of aPos differs from the dimension stored in the file,
+ * surplus coordinates are dropped and missing ones are set to 0.
+ */
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, const char* filename,
+					 ISubsetHandler** ppSH, const char** shNames, int numSHs,
+					 ISelector** ppSel, int numSels,
+					 TAPosition& aPos);
+
+///	Reads a grid and its first subset handler from the binary ugb format.
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh,
+					 const char* filename, TAPosition& aPos);
+
+}//	end of namespace
+
+#endif
@@ -409,6 +409,18 @@ class UG_API Grid
 	///	this method creates a new volume, which has the same type as pCloneMe.
 		VolumeIterator create_by_cloning(Volume* pCloneMe, const IVertexGroup& vv, GridObject* pParent = NULL);
 
+	///	replaces an element by a newly allocated instance of the same type
+	/**	The new element takes the place of elem as in create_and_replace,
+	 * i.e. observers are notified with replacesParent = true and
+	 * pass_on_values is called. elem is deleted. This can be used to
+	 * relocate elements in memory (see CompactGridObjectStorage).
+	 *
+	 * TElem has to be one of the base types Vertex, Edge, Face or Volume.
+	 * Returns NULL (and leaves elem untouched) if elem does not support
+	 * create_empty_instance.*/
+		template <class TElem>
+		TElem* relocate(TElem* elem);
+
 	///	Reserves memory for the creation of the given object type
 	/**	Calls to this method are optional, but can improve runtime.
 	 * Specify the total number of objects which the grid should be
@@ -31,6 +31,7 @@
  */
 
 #include "grid_base_objects.h"
+#include "grid_object_pool.h"
 #include "grid_util.h"
 
 namespace ug
@@ -39,6 +40,18 @@ namespace ug
 const char* GRID_BASE_OBJECT_SINGULAR_NAMES[] = {"vertex", "edge", "face", "volume"};
 const char* GRID_BASE_OBJECT_PLURAL_NAMES[] = {"vertices", "edges", "faces", "volume"};
 
+////////////////////////////////////////////////////////////////////////
+//	allocation of grid objects
+void* GridObject::operator new(std::size_t size)
+{
+	return GridObjectPool::allocate(size);
+}
+
+void GridObject::operator delete(void* p, std::size_t size)
+{
+	GridObjectPool::deallocate(p, size);
+}
+
 ////////////////////////////////////////////////////////////////////////
 //	implementation of edge
 bool Edge::get_opposing_side(Vertex* v, Vertex** vrtOut)
@@ -153,7 +153,7 @@ template<> class attachment_traits<Volume*, ElementStorage<Volume> >;
  *
  * \ingroup lib_grid_grid_objects
  */
-class UG_API GridObject/* : public SmallObject<>*/
+class UG_API GridObject
 {
 	friend class Grid;
 	friend class attachment_traits<Vertex*, ElementStorage<Vertex> >;
@@ -164,6 +164,14 @@ class UG_API GridObject/* : public SmallObject<>*/
 	public:
 		virtual ~GridObject()	{}
 
+	///	allocation of grid objects is performed through the GridObjectPool
+	/**	Since the destructor is virtual, size always is the size of the
+	 * concrete type (see grid_object_pool.h).
+	 * \{ */
+		static void* operator new(std::size_t size);
+		static void operator delete(void* p, std::size_t size);
+	/** \} */
+
 	///	create an instance of the derived type
 	/**	Make sure to overload this method in derivates of this class!*/
 		virtual GridObject* create_empty_instance() const {return NULL;}
@@ -126,6 +126,21 @@ Grid::create_and_replace(typename geometry_traits<TGeomObj>::grid_base_object* p
 	}
 }
 
+template <class TElem>
+TElem* Grid::relocate(TElem* elem)
+{
+	STATIC_ASSERT(geometry_traits<TElem>::CONTAINER_SECTION == -1
+		&&	geometry_traits<TElem>::BASE_OBJECT_ID != -1,
+		only_base_types_can_be_relocated);
+
+	TElem* geomObj = static_cast<TElem*>(elem->create_empty_instance());
+	if(!geomObj)
+		return NULL;
+
+	register_and_replace_element(geomObj, elem);
+	return geomObj;
+}
+
 ////////////////////////////////////////////////////////////////////////
 template <class TGeomObj>
 void Grid::reserve(size_t num)
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <new>
+#include "grid_object_pool.h"
+
+namespace ug
+{
+
+GridObjectPool::GridObjectPool() :
+	m_vPool(MAX_OBJECT_SIZE / ALIGNMENT + 1, (PoolAllocator*)NULL),
+	m_bEnabled(false),
+	m_bSequential(false)
+{
+}
+
+GridObjectPool& GridObjectPool::inst()
+{
+//	the instance is never destroyed, since grids may still release their
+//	objects during static destruction
+	static GridObjectPool* pool = new GridObjectPool;
+	return *pool;
+}
+
+PoolAllocator* GridObjectPool::pool(std::size_t size)
+{
+	if(size > MAX_OBJECT_SIZE)
+		return NULL;
+
+	const std::size_t sizeClass = (size + ALIGNMENT - 1) / ALIGNMENT;
+	PoolAllocator*& p = m_vPool[sizeClass];
+	if(!p && m_bEnabled){
+		const std::size_t blockSize = sizeClass * ALIGNMENT;
+		p = new PoolAllocator(blockSize, CHUNK_SIZE / blockSize);
+		p->set_sequential(m_bSequential);
+	}
+	return p;
+}
+
+void* GridObjectPool::allocate(std::size_t size)
+{
+	GridObjectPool& gop = inst();
+	if(gop.m_bEnabled){
+		if(PoolAllocator* p = gop.pool(size))
+			return p->allocate();
+	}
+	return ::operator new(size);
+}
+
+void GridObjectPool::deallocate(void* p, std::size_t size)
+{
+	PoolAllocator* pa = inst().pool(size);
+	if(pa && pa->owns(p))
+		pa->deallocate(p);
+	else
+		::operator delete(p);
+}
+
+void GridObjectPool::set_sequential(bool bSequential)
+{
+	GridObjectPool& gop = inst();
+	gop.m_bSequential = bSequential;
+	for(size_t i = 0; i < gop.m_vPool.size(); ++i){
+		if(gop.m_vPool[i])
+			gop.m_vPool[i]->set_sequential(bSequential);
+	}
+}
+
+std::size_t GridObjectPool::num_pooled_objects()
+{
+	GridObjectPool& gop = inst();
+	std::size_t num = 0;
+	for(size_t i = 0; i < gop.m_vPool.size(); ++i){
+		if(gop.m_vPool[i])
+			num += gop.m_vPool[i]->num_used_blocks();
+	}
+	return num;
+}
+
+std::size_t GridObjectPool::num_reserved_bytes()
+{
+	GridObjectPool& gop = inst();
+	std::size_t num = 0;
+	for(size_t i = 0; i < gop.m_vPool.size(); ++i){
+		PoolAllocator* pa = gop.m_vPool[i];
+		if(pa)
+			num += pa->num_chunks() * pa->num_blocks_per_chunk() * pa->block_size();
+	}
+	return num;
+}
+
+}//	end of namespace
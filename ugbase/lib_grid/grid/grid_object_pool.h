@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_GRID__GRID_OBJECT_POOL__
+#define __H__UG__LIB_GRID__GRID_OBJECT_POOL__
+
+#include <cstddef>
+#include <vector>
+#include "common/ug_config.h"
+#include "common/allocators/pool_allocator.h"
+
+namespace ug
+{
+
+///	Pool allocation of grid objects
+/**	All vertices, edges, faces and volumes are created through the class
+ * specific operator new of GridObject, which forwards to this singleton.
+ * If pool allocation is enabled, objects are allocated from a PoolAllocator
+ * per object size (i.e. objects of the same concrete type are stored in the
+ * same contiguous chunks). Otherwise the global operator new is used.
+ *
+ * Pool allocation may be enabled or disabled at any time: on deallocation
+ * the origin of each object is determined, so that objects which were
+ * created before the switch are released correctly.
+ *
+ * In sequential mode newly allocated objects are placed consecutively in
+ * fresh chunks. This is used by CompactGridObjectStorage to reorder the
+ * objects of a grid in memory.
+ *
+ * Like Grid itself, the pool is not thread safe. Since one pool is shared by
+ * all grids, this also holds for different grids: grid objects must not be
+ * created or erased by several threads at the same time, even if each thread
+ * works on a grid of its own. Pool allocation is disabled by default.
+ */
+class UG_API GridObjectPool
+{
+	public:
+	///	enables or disables pool allocation of newly created grid objects
+		static void enable(bool bEnable)	{inst().m_bEnabled = bEnable;}
+
+	///	returns true if newly created grid objects are allocated from pools
+		static bool enabled()				{return inst().m_bEnabled;}
+
+		static void* allocate(std::size_t size);
+		static void deallocate(void* p, std::size_t size);
+
+	///	enables or disables the sequential mode of all pools
+		static void set_sequential(bool bSequential);
+
+	///	returns the number of objects which currently live in pools
+		static std::size_t num_pooled_objects();
+
+	///	returns the number of bytes which are currently reserved by the pools
+		static std::size_t num_reserved_bytes();
+
+	private:
+		GridObjectPool();
+		static GridObjectPool& inst();
+
+		PoolAllocator* pool(std::size_t size);
+
+	private:
+	///	pools are created for objects of at most this size (in bytes)
+		static const std::size_t MAX_OBJECT_SIZE = 512;
+	///	the size of the objects is rounded up to a multiple of this value
+		static const std::size_t ALIGNMENT = sizeof(void*);
+	///	approximate size of a chunk in bytes
+		static const std::size_t CHUNK_SIZE = 256 * 1024;
+
+		std::vector<PoolAllocator*> m_vPool;
+		bool m_bEnabled;
+		bool m_bSequential;
+};
+
+}//	end of namespace
+
+#endif
@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "partitioned_grid_io.h"
+#include "distributed_grid.h"
+#include "parallelization_util.h"
+#include "common/serialization.h"
+#include "common/util/binary_buffer.h"
+#include "common/profiler/profiler.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/global_attachments.h"
+#include "pcl/parallel_file.h"
+
+using namespace std;
+
+namespace ug{
+
+//	the magic numbers are used to make sure that the stream is read correctly
+static const int PGIO_MAGIC_NUMBER_1 = 81234671;
+static const int PGIO_MAGIC_NUMBER_2 = 36591024;
+static const int PGIO_VERSION = 1;
+
+static const int PGIO_INTERFACE_TYPES[] = {INT_H_MASTER, INT_H_SLAVE,
+										   INT_V_MASTER, INT_V_SLAVE};
+static const int PGIO_NUM_INTERFACE_TYPES = 4;
+
+
+////////////////////////////////////////////////////////////////////////////////
+///	returns the number of processes which wrote the combined parallel file
+/**	The number is stored at the beginning of the file (see
+ * pcl::WriteCombinedParallelFile). It is read by the first process of procComm
+ * and communicated to all others. -1 is returned if the file can't be read.*/
+static int NumProcsInCombinedFile(const char* filename,
+								  const pcl::ProcessCommunicator& procComm)
+{
+	int numProcs = -1;
+	if(procComm.get_local_proc_id() == 0){
+		ifstream in(filename, ios::binary);
+		if(!(in && in.read((char*)&numProcs, sizeof(numProcs))))
+			numProcs = -1;
+	}
+	procComm.broadcast(numProcs);
+	return numProcs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+///	writes the interfaces of all layouts for TElem as lists of local indices
+template <class TElem>
+static void WriteLayouts(BinaryBuffer& out, GridLayoutMap& glm,
+						 MultiElementAttachmentAccessor<AInt>& aaInd)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Layout	Layout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface	Interface;
+
+	for(int i_type = 0; i_type < PGIO_NUM_INTERFACE_TYPES; ++i_type){
+		int intfcType = PGIO_INTERFACE_TYPES[i_type];
+		if(!glm.has_layout<TElem>(intfcType)){
+			Serialize(out, (int)0);
+			continue;
+		}
+
+		Layout& layout = glm.get_layout<TElem>(intfcType);
+		int numIntfcs = 0;
+		for(size_t lvl = 0; lvl < layout.num_levels(); ++lvl){
+			for(typename Layout::iterator iter = layout.begin(lvl);
+				iter != layout.end(lvl); ++iter)
+			{
+				++numIntfcs;
+			}
+		}
+
+		Serialize(out, numIntfcs);
+		for(size_t lvl = 0; lvl < layout.num_levels(); ++lvl){
+			for(typename Layout::iterator iter = layout.begin(lvl);
+				iter != layout.end(lvl); ++iter)
+			{
+				Interface& intfc = layout.interface(iter);
+				Serialize(out, (int)lvl);
+				Serialize(out, layout.proc_id(iter));
+				Serialize(out, (int)intfc.size());
+				for(typename Interface::iterator i_elem = intfc.begin();
+					i_elem != intfc.end(); ++i_elem)
+				{
+					Serialize(out, aaInd[intfc.get_element(i_elem)]);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///	reads the interfaces written by WriteLayouts and sorts them by global ids
+template <class TElem>
+static void ReadLayouts(BinaryBuffer& in, MultiGrid& mg, GridLayoutMap& glm,
+						const vector<TElem*>& elems)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Layout	Layout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface	Interface;
+
+	for(int i_type = 0; i_type < PGIO_NUM_INTERFACE_TYPES; ++i_type){
+		int intfcType = PGIO_INTERFACE_TYPES[i_type];
+		int numIntfcs = Deserialize<int>(in);
+		if(numIntfcs == 0)
+			continue;
+
+		Layout& layout = glm.get_layout<TElem>(intfcType);
+		for(int i_intfc = 0; i_intfc < numIntfcs; ++i_intfc){
+			int lvl = Deserialize<int>(in);
+			int procID = Deserialize<int>(in);
+			int numEntries = Deserialize<int>(in);
+			UG_COND_THROW(lvl < 0 || numEntries < 0,
+						  "LoadPartitionedGrid: Invalid interface description.");
+
+			Interface& intfc = layout.interface(procID, lvl);
+			for(int i = 0; i < numEntries; ++i){
+				int ind = Deserialize<int>(in);
+				UG_COND_THROW(ind < 0 || ind >= (int)elems.size(),
+							  "LoadPartitionedGrid: Bad element index in interface: "
+							  << ind);
+				intfc.push_back(elems[ind]);
+			}
+		}
+
+	//	entries of matching interfaces on different processes have to be
+	//	in the same order. This is guaranteed by sorting them by global ids.
+		CompareByAttachment<TElem, AGeomObjID> gidCmp(mg, aGeomObjID);
+		layout.sort_interface_entries(gidCmp);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class TElem>
+static void AttachIfMissing(Grid& g, AGeomObjID& aID)
+{
+	if(!g.has_attachment<TElem>(aID))
+		g.attach_to<TElem>(aID);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///	writes all attached global attachments together with their declarations
+static void WriteGlobalAttachments(BinaryBuffer& out, MultiGrid& mg)
+{
+	const vector<string>& names = GlobalAttachments::declared_attachment_names();
+
+	vector<string> attachedNames;
+	vector<int> attachedTo;
+	for(size_t i = 0; i < names.size(); ++i){
+		int b = 0;
+		if(GlobalAttachments::is_attached<Vertex>(mg, names[i]))	b |= 1;
+		if(GlobalAttachments::is_attached<Edge>(mg, names[i]))		b |= 1<<1;
+		if(GlobalAttachments::is_attached<Face>(mg, names[i]))		b |= 1<<2;
+		if(GlobalAttachments::is_attached<Volume>(mg, names[i]))	b |= 1<<3;
+		if(b){
+			attachedNames.push_back(names[i]);
+			attachedTo.push_back(b);
+		}
+	}
+
+	Serialize(out, (int)attachedNames.size());
+	for(size_t i = 0; i < attachedNames.size(); ++i){
+		const string& name = attachedNames[i];
+		int b = attachedTo[i];
+
+		GridDataSerializationHandler handler;
+		if(b & 1)		GlobalAttachments::add_data_serializer<Vertex>(handler, mg, name);
+		if(b & 1<<1)	GlobalAttachments::add_data_serializer<Edge>(handler, mg, name);
+		if(b & 1<<2)	GlobalAttachments::add_data_serializer<Face>(handler, mg, name);
+		if(b & 1<<3)	GlobalAttachments::add_data_serializer<Volume>(handler, mg, name);
+
+		BinaryBuffer data;
+		handler.write_infos(data);
+		handler.serialize(data, mg.get_grid_objects());
+
+		Serialize(out, name);
+		Serialize(out, string(GlobalAttachments::type_name(name)));
+		Serialize(out, (int)GlobalAttachments::attachment_pass_on_behaviour(name));
+		Serialize(out, b);
+		Serialize(out, (size_t)data.write_pos());
+		out.write(data.buffer(), data.write_pos());
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///	reads the global attachments written by WriteGlobalAttachments
+/**	Attachments whose type is not registered on the local process are skipped.*/
+static void ReadGlobalAttachments(BinaryBuffer& in, MultiGrid& mg,
+								  vector<Vertex*>& vrts, vector<Edge*>& edges,
+								  vector<Face*>& faces, vector<Volume*>& vols)
+{
+	int numAttachments = Deserialize<int>(in);
+	for(int i = 0; i < numAttachments; ++i){
+		string name = Deserialize<string>(in);
+		string type = Deserialize<string>(in);
+		bool passOn = (Deserialize<int>(in) != 0);
+		int b = Deserialize<int>(in);
+		size_t dataSize = Deserialize<size_t>(in);
+		size_t dataEnd = in.read_pos() + dataSize;
+
+		if(!GlobalAttachments::is_declared(name)){
+			if(GlobalAttachments::type_is_registered(type))
+				GlobalAttachments::declare_attachment(name, type, passOn);
+			else{
+				UG_LOG("WARNING in LoadPartitionedGrid: Skipping global attachment '"
+					   << name << "' of unregistered type '" << type << "'.\n");
+				in.set_read_pos(dataEnd);
+				continue;
+			}
+		}
+
+		UG_COND_THROW(type.compare(GlobalAttachments::type_name(name)) != 0,
+					  "Attachment type mismatch. Expecting type: " <<
+					  GlobalAttachments::type_name(name)
+					  << ", but given type is: " << type);
+
+		GridDataSerializationHandler handler;
+		if(b & 1){
+			GlobalAttachments::attach<Vertex>(mg, name);
+			GlobalAttachments::add_data_serializer<Vertex>(handler, mg, name);
+		}
+		if(b & 1<<1){
+			GlobalAttachments::attach<Edge>(mg, name);
+			GlobalAttachments::add_data_serializer<Edge>(handler, mg, name);
+		}
+		if(b & 1<<2){
+			GlobalAttachments::attach<Face>(mg, name);
+			GlobalAttachments::add_data_serializer<Face>(handler, mg, name);
+		}
+		if(b & 1<<3){
+			GlobalAttachments::attach<Volume>(mg, name);
+			GlobalAttachments::add_data_serializer<Volume>(handler, mg, name);
+		}
+
+		handler.deserialization_starts();
+		handler.read_infos(in);
+		handler.deserialize(in, vrts.begin(), vrts.end());
+		handler.deserialize(in, edges.begin(), edges.end());
+		handler.deserialize(in, faces.begin(), faces.end());
+		handler.deserialize(in, vols.begin(), vols.end());
+		handler.deserialization_done();
+
+		UG_COND_THROW(in.read_pos() != dataEnd,
+					  "LoadPartitionedGrid: Size mismatch while reading global attachment '"
+					  << name << "'.");
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SavePartitionedGrid(MultiGrid& mg, const char* filename,
+						 GridDataSerializationHandler& serializer,
+						 const pcl::ProcessCommunicator& procComm)
+{
+	PROFILE_FUNC_GROUP("grid");
+
+	UG_COND_THROW(!mg.is_parallel(),
+				  "SavePartitionedGrid can only be called on parallel grids.");
+
+	DistributedGridManager& distGridMgr = *mg.distributed_grid_manager();
+	GridLayoutMap& glm = distGridMgr.grid_layout_map();
+
+//	the global ids are used to match interface entries on load
+	CreateAndDistributeGlobalIDs<Vertex>(mg, glm);
+	CreateAndDistributeGlobalIDs<Edge>(mg, glm);
+	CreateAndDistributeGlobalIDs<Face>(mg, glm);
+	CreateAndDistributeGlobalIDs<Volume>(mg, glm);
+	MultiElementAttachmentAccessor<AGeomObjID> aaID(mg, aGeomObjID);
+
+	AInt aLocalInd("partitioned-grid-io-tmp-local-index");
+	mg.attach_to_all(aLocalInd);
+	MultiElementAttachmentAccessor<AInt> aaInd(mg, aLocalInd);
+
+	BinaryBuffer out;
+	Serialize(out, PGIO_MAGIC_NUMBER_1);
+	Serialize(out, PGIO_VERSION);
+
+	GridObjectCollection goc = mg.get_grid_objects();
+	SerializeMultiGridElements(mg, goc, aaInd, out, &aaID);
+
+	serializer.write_infos(out);
+	serializer.serialize(out, goc);
+
+	WriteGlobalAttachments(out, mg);
+
+	WriteLayouts<Vertex>(out, glm, aaInd);
+	WriteLayouts<Edge>(out, glm, aaInd);
+	WriteLayouts<Face>(out, glm, aaInd);
+	WriteLayouts<Volume>(out, glm, aaInd);
+
+	Serialize(out, PGIO_MAGIC_NUMBER_2);
+
+	mg.detach_from_all(aLocalInd);
+
+	pcl::WriteCombinedParallelFile(out, filename, procComm);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LoadPartitionedGrid(MultiGrid& mg, const char* filename,
+						 GridDataSerializationHandler& serializer,
+						 const pcl::ProcessCommunicator& procComm)
+{
+	PROFILE_FUNC_GROUP("grid");
+
+	UG_COND_THROW(!mg.is_parallel(),
+				  "LoadPartitionedGrid can only be called on parallel grids.");
+
+//	the chunks of the file are assigned to the processes by rank. The check is
+//	done here, since all processes have to leave consistently.
+	int numProcsInFile = NumProcsInCombinedFile(filename, procComm);
+	if(numProcsInFile < 0){
+		UG_LOG("ERROR in LoadPartitionedGrid: Could not read " << filename << ".\n");
+		return false;
+	}
+	if(numProcsInFile != (int)procComm.size()){
+		UG_LOG("ERROR in LoadPartitionedGrid: " << filename << " was written by "
+			   << numProcsInFile << " processes, but is read by " << procComm.size()
+			   << " processes. Partitioned grids have to be loaded with the same "
+			   "number of processes which saved them.\n");
+		return false;
+	}
+
+	BinaryBuffer in;
+	pcl::ReadCombinedParallelFile(in, filename, procComm);
+
+	if(Deserialize<int>(in) != PGIO_MAGIC_NUMBER_1){
+		UG_LOG("ERROR in LoadPartitionedGrid: " << filename
+			   << " is not a partitioned grid file.\n");
+		return false;
+	}
+
+	int version = Deserialize<int>(in);
+	if(version != PGIO_VERSION){
+		UG_LOG("ERROR in LoadPartitionedGrid: Unsupported file version "
+			   << version << " in " << filename << ".\n");
+		return false;
+	}
+
+	DistributedGridManager& distGridMgr = *mg.distributed_grid_manager();
+	GridLayoutMap& glm = distGridMgr.grid_layout_map();
+	SPMessageHub msgHub = mg.message_hub();
+
+//	the layouts are rebuilt from the file
+	distGridMgr.enable_interface_management(false);
+	msgHub->post_message(GridMessage_Creation(GMCT_CREATION_STARTS));
+
+	mg.clear_geometry();
+	glm.clear();
+
+	AttachIfMissing<Vertex>(mg, aGeomObjID);
+	AttachIfMissing<Edge>(mg, aGeomObjID);
+	AttachIfMissing<Face>(mg, aGeomObjID);
+	AttachIfMissing<Volume>(mg, aGeomObjID);
+	MultiElementAttachmentAccessor<AGeomObjID> aaID(mg, aGeomObjID);
+
+	vector<Vertex*>	vrts;
+	vector<Edge*> edges;
+	vector<Face*> faces;
+	vector<Volume*> vols;
+
+	serializer.deserialization_starts();
+	DeserializeMultiGridElements(mg, in, &vrts, &edges, &faces, &vols, &aaID);
+
+	serializer.read_infos(in);
+	serializer.deserialize(in, vrts.begin(), vrts.end());
+	serializer.deserialize(in, edges.begin(), edges.end());
+	serializer.deserialize(in, faces.begin(), faces.end());
+	serializer.deserialize(in, vols.begin(), vols.end());
+
+	ReadGlobalAttachments(in, mg, vrts, edges, faces, vols);
+
+	ReadLayouts<Vertex>(in, mg, glm, vrts);
+	ReadLayouts<Edge>(in, mg, glm, edges);
+	ReadLayouts<Face>(in, mg, glm, faces);
+	ReadLayouts<Volume>(in, mg, glm, vols);
+
+	if(Deserialize<int>(in) != PGIO_MAGIC_NUMBER_2){
+		UG_THROW("ERROR in LoadPartitionedGrid: "
+				 "Magic number mismatch after deserialization.\n");
+	}
+
+	glm.remove_empty_interfaces();
+	distGridMgr.enable_interface_management(true);
+	distGridMgr.grid_layouts_changed(false);
+
+	msgHub->post_message(GridMessage_Creation(GMCT_CREATION_STOPS));
+	serializer.deserialization_done();
+
+	return true;
+}
+
+}// end of namespace
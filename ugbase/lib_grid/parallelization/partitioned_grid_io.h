@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__partitioned_grid_io__
+#define __H__UG__partitioned_grid_io__
+
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "pcl/pcl_process_communicator.h"
+
+namespace ug{
+
+///	writes the local part of a distributed grid together with its interfaces to a combined file.
+/**	Each process writes its own partition into one combined parallel file
+ * (see pcl::WriteCombinedParallelFile). Besides the grid elements the file
+ * contains the global ids of all elements, the horizontal and vertical interfaces
+ * of the local GridLayoutMap, all data registered at the given serializer and all
+ * attached global attachments.
+ *
+ * Global ids are (re)created through CreateAndDistributeGlobalIDs. The method
+ * thus has to be called on all processes of procComm.
+ *
+ * Files written by this method can be read through LoadPartitionedGrid.
+ */
+bool SavePartitionedGrid(MultiGrid& mg, const char* filename,
+						 GridDataSerializationHandler& serializer,
+						 const pcl::ProcessCommunicator& procComm =
+												pcl::ProcessCommunicator());
+
+///	loads the local part of a distributed grid from a file written by SavePartitionedGrid.
+/**	Every process reads only the chunk which was written by the process with
+ * the same rank. The local grid and its GridLayoutMap are cleared and rebuilt
+ * from the file. Interface entries are sorted by the global ids of their
+ * elements, so that matching interfaces on different processes are ordered
+ * consistently.
+ *
+ * The file has to be read with the same number of processes that was used
+ * to write it.
+ *
+ * The serializer has to contain the same serializers in the same order as
+ * the one which was passed to SavePartitionedGrid.
+ *
+ * The method posts the following messages to the message hub of the specified grid:
+ * 	- GridMessage_Creation(GMCT_CREATION_STARTS) before the local grid is cleared
+ * 	- GridMessage_Creation(GMCT_CREATION_STOPS) after the local grid has been rebuilt completely
+ */
+bool LoadPartitionedGrid(MultiGrid& mg, const char* filename,
+						 GridDataSerializationHandler& serializer,
+						 const pcl::ProcessCommunicator& procComm =
+												pcl::ProcessCommunicator());
+
+}// end of namespace
+
+#endif
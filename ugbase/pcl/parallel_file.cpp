@@ -67,7 +67,7 @@ void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename
 
 	if(bFirst)
 	{
-		int numProcs = pcl::NumProcs();
+		int numProcs = (int)pc.size();
 		MPI_File_write(fh, &numProcs, sizeof(numProcs), MPI_BYTE, &status);
 		for(size_t i=0; i<allNextOffsets.size(); i++)
 		{
@@ -107,7 +107,7 @@ void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename,
 	{
 		int numProcs;
 		MPI_File_read(fh, &numProcs, sizeof(numProcs), MPI_BYTE, &status);
-		UG_COND_THROW(numProcs != pcl::NumProcs(), "checkPoint numProcs = " << numProcs << ", but running on " << pcl::NumProcs());
+		UG_COND_THROW(numProcs != (int)pc.size(), "checkPoint numProcs = " << numProcs << ", but running on " << pc.size());
 
 		for(size_t i=1; i<allNextOffsets.size(); i++)
 		{